@@ -0,0 +1,117 @@
+#include "common/Literals.hpp"
+#include "controllers/completion/sources/EmoteIndex.hpp"
+#include "messages/Emote.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::completion;
+using namespace literals;
+
+namespace {
+
+std::vector<EmoteItem> readItems(const QString &name)
+{
+    QFile file(u":/bench/seventvemotes-%1.json"_s.arg(name));
+    if (!file.open(QFile::ReadOnly))
+    {
+        _exit(1);
+    }
+    auto doc = QJsonDocument::fromJson(file.readAll()).object();
+    auto emotes = seventv::detail::parseEmotes(
+        doc["emote_set"_L1]["emotes"_L1].toArray(), false);
+
+    std::vector<EmoteItem> items;
+    for (const auto &[emoteName, emote] : emotes)
+    {
+        items.push_back({
+            .emote = emote,
+            .searchName = emoteName.string,
+            .tabCompletionName = emoteName.string,
+            .displayName = emote->name.string,
+            .providerName = u"Channel 7TV"_s,
+        });
+    }
+    return items;
+}
+
+/// What a user types while completing some of the emotes
+std::vector<QString> makeQueries(const std::vector<EmoteItem> &items)
+{
+    std::vector<QString> queries;
+    for (size_t i = 0; i < items.size(); i += 25)
+    {
+        const auto &name = items[i].searchName;
+        for (qsizetype len = 1; len <= std::min<qsizetype>(name.size(), 4);
+             len++)
+        {
+            queries.push_back(name.left(len));
+        }
+    }
+    return queries;
+}
+
+/// The linear scan over all items done before the index existed
+void BM_EmoteCompletionScan(benchmark::State &state, const QString &name)
+{
+    auto items = readItems(name);
+    auto queries = makeQueries(items);
+
+    for (auto _ : state)
+    {
+        for (const auto &query : queries)
+        {
+            std::vector<EmoteItem> out;
+            for (const auto &item : items)
+            {
+                if (item.searchName.contains(query, Qt::CaseInsensitive))
+                {
+                    out.push_back(item);
+                }
+            }
+            benchmark::DoNotOptimize(out);
+        }
+    }
+}
+
+void BM_EmoteCompletionIndex(benchmark::State &state, const QString &name)
+{
+    EmoteIndex index(readItems(name));
+    auto queries = makeQueries(index.items());
+
+    for (auto _ : state)
+    {
+        for (const auto &query : queries)
+        {
+            std::vector<EmoteItem> out;
+            index.collect(query.toCaseFolded(), out);
+            benchmark::DoNotOptimize(out);
+        }
+    }
+}
+
+void BM_EmoteCompletionBuildIndex(benchmark::State &state,
+                                  const QString &name)
+{
+    auto items = readItems(name);
+
+    for (auto _ : state)
+    {
+        EmoteIndex index(items);
+        benchmark::DoNotOptimize(index);
+    }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_EmoteCompletionScan, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_EmoteCompletionIndex, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_EmoteCompletionBuildIndex, nymn, u"nymn"_s);
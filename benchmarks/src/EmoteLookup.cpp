@@ -0,0 +1,161 @@
+#include "common/Atomic.hpp"
+#include "common/Literals.hpp"
+#include "messages/Emote.hpp"
+#include "messages/MergedEmoteMap.hpp"
+#include "providers/recentmessages/Impl.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+
+#include <benchmark/benchmark.h>
+#include <IrcMessage>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+QJsonObject readJsonObject(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
+    {
+        _exit(1);
+    }
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+/// Splits the PRIVMSGs of the recent messages fixture into words
+std::vector<EmoteName> readWords(const QString &name)
+{
+    auto ircMessages = recentmessages::detail::parseRecentMessages(
+        readJsonObject(u":/bench/recentmessages-%1.json"_s.arg(name)));
+
+    std::vector<EmoteName> words;
+    for (auto *ircMessage : ircMessages)
+    {
+        if (auto *privmsg =
+                dynamic_cast<Communi::IrcPrivateMessage *>(ircMessage))
+        {
+            for (const auto &word :
+                 privmsg->content().split(' ', Qt::SkipEmptyParts))
+            {
+                words.push_back({word});
+            }
+        }
+        delete ircMessage;
+    }
+    return words;
+}
+
+std::shared_ptr<const EmoteMap> readSeventvEmotes(const QString &name)
+{
+    auto doc = readJsonObject(u":/bench/seventvemotes-%1.json"_s.arg(name));
+    return std::make_shared<const EmoteMap>(seventv::detail::parseEmotes(
+        doc["emote_set"_L1]["emotes"_L1].toArray(), false));
+}
+
+/// The channel's 7TV emotes surrounded by empty providers, as most channels
+/// only use some of the providers.
+void BM_EmoteLookupSeparate(benchmark::State &state, const QString &name)
+{
+    auto words = readWords(name);
+    std::array<Atomic<std::shared_ptr<const EmoteMap>>,
+               MergedEmoteMap::SOURCE_COUNT>
+        maps;
+    for (auto &map : maps)
+    {
+        map.set(EMPTY_EMOTE_MAP);
+    }
+    maps[static_cast<size_t>(MergedEmoteMap::Source::SeventvChannel)].set(
+        readSeventvEmotes(name));
+
+    for (auto _ : state)
+    {
+        for (const auto &word : words)
+        {
+            EmotePtr found;
+            for (const auto &map : maps)
+            {
+                auto emotes = map.get();
+                auto it = emotes->find(word);
+                if (it != emotes->end())
+                {
+                    found = it->second;
+                    break;
+                }
+            }
+            benchmark::DoNotOptimize(found);
+        }
+    }
+}
+
+void BM_EmoteLookupMerged(benchmark::State &state, const QString &name)
+{
+    auto words = readWords(name);
+    MergedEmoteMap::Sources sources;
+    sources[static_cast<size_t>(MergedEmoteMap::Source::SeventvChannel)] =
+        readSeventvEmotes(name);
+    Atomic<std::shared_ptr<const MergedEmoteMap>> merged(
+        std::make_shared<const MergedEmoteMap>(sources));
+
+    for (auto _ : state)
+    {
+        for (const auto &word : words)
+        {
+            auto found = merged.get()->find(word);
+            benchmark::DoNotOptimize(found);
+        }
+    }
+}
+
+void BM_EmoteLookupUpdate(benchmark::State &state, const QString &name)
+{
+    auto emotes = readSeventvEmotes(name);
+    auto merged = std::make_shared<const MergedEmoteMap>();
+
+    for (auto _ : state)
+    {
+        merged = merged->withSource(MergedEmoteMap::Source::SeventvChannel,
+                                    emotes);
+        benchmark::DoNotOptimize(merged);
+        merged = merged->withSource(MergedEmoteMap::Source::SeventvChannel,
+                                    EMPTY_EMOTE_MAP);
+        benchmark::DoNotOptimize(merged);
+    }
+}
+
+/// A live update replacing one emote, as done for 7TV and BTTV events
+void BM_EmoteLookupLiveUpdate(benchmark::State &state, const QString &name)
+{
+    Atomic<std::shared_ptr<const EmoteMap>> emotes(readSeventvEmotes(name));
+    auto merged = std::make_shared<const MergedEmoteMap>()->withSource(
+        MergedEmoteMap::Source::SeventvChannel, emotes.get());
+    auto replaced = emotes.get()->begin()->second;
+    auto replacement = std::make_shared<const Emote>(*replaced);
+
+    for (auto _ : state)
+    {
+        EmoteMap updated = *emotes.get();
+        updated[replaced->name] = replacement;
+        emotes.set(std::make_shared<const EmoteMap>(std::move(updated)));
+        std::swap(replaced, replacement);
+
+        merged = merged->withSource(MergedEmoteMap::Source::SeventvChannel,
+                                    emotes.get());
+        benchmark::DoNotOptimize(merged);
+    }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_EmoteLookupSeparate, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_EmoteLookupMerged, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_EmoteLookupUpdate, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_EmoteLookupLiveUpdate, nymn, u"nymn"_s);
@@ -0,0 +1,148 @@
+#include "common/Channel.hpp"
+#include "common/Literals.hpp"
+#include "controllers/filters/lang/Filter.hpp"
+#include "controllers/filters/lang/MessageContext.hpp"
+#include "messages/Message.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "mocks/TwitchIrcServer.hpp"
+#include "providers/recentmessages/Impl.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+
+#include <benchmark/benchmark.h>
+#include <IrcMessage>
+#include <QFile>
+#include <QJsonDocument>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::filters;
+using namespace literals;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    ITwitchIrcServer *getTwitch() override
+    {
+        return &this->twitch;
+    }
+
+    mock::MockTwitchIrcServer twitch;
+};
+
+/// Reads "key/value,key/value" badge tags
+std::vector<std::pair<QString, QString>> parseBadgeTag(const QString &tag)
+{
+    std::vector<std::pair<QString, QString>> badges;
+    for (const auto &badge : tag.split(',', Qt::SkipEmptyParts))
+    {
+        auto parts = badge.split('/');
+        badges.emplace_back(parts.at(0), parts.value(1));
+    }
+    return badges;
+}
+
+/// Reads the PRIVMSGs of the recent messages fixture into messages with the
+/// fields filters read
+std::vector<MessagePtr> readMessages(const QString &name)
+{
+    QFile file(u":/bench/recentmessages-%1.json"_s.arg(name));
+    if (!file.open(QFile::ReadOnly))
+    {
+        _exit(1);
+    }
+
+    auto ircMessages = recentmessages::detail::parseRecentMessages(
+        QJsonDocument::fromJson(file.readAll()).object());
+
+    std::vector<MessagePtr> messages;
+    for (auto *ircMessage : ircMessages)
+    {
+        if (auto *privmsg =
+                dynamic_cast<Communi::IrcPrivateMessage *>(ircMessage))
+        {
+            auto tags = privmsg->tags();
+
+            auto msg = std::make_shared<Message>();
+            msg->loginName = privmsg->nick();
+            msg->displayName = tags.value("display-name").toString();
+            msg->userID = tags.value("user-id").toString();
+            msg->channelName = privmsg->target().mid(1);
+            msg->usernameColor = QColor(tags.value("color").toString());
+            msg->messageText = privmsg->content();
+            for (const auto &[key, value] :
+                 parseBadgeTag(tags.value("badges").toString()))
+            {
+                msg->badges.emplace_back(key, value);
+            }
+            for (const auto &[key, value] :
+                 parseBadgeTag(tags.value("badge-info").toString()))
+            {
+                msg->badgeInfos[key] = value;
+            }
+            messages.emplace_back(std::move(msg));
+        }
+        delete ircMessage;
+    }
+    return messages;
+}
+
+Filter parseFilter(const QString &text)
+{
+    auto result = Filter::fromString(text);
+    if (!std::holds_alternative<Filter>(result))
+    {
+        _exit(1);
+    }
+    return std::move(std::get<Filter>(result));
+}
+
+/// Builds the map with all identifiers and evaluates the expression tree
+void BM_FilterContextMap(benchmark::State &state, const QString &filterText)
+{
+    MockApplication app;
+    Channel channel(u"nymn"_s, Channel::Type::Twitch);
+    auto messages = readMessages(u"nymn"_s);
+    auto filter = parseFilter(filterText);
+
+    for (auto _ : state)
+    {
+        for (const auto &msg : messages)
+        {
+            auto result = filter.execute(buildContextMap(msg, &channel));
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+/// Evaluates the compiled filter, reading only the used identifiers
+void BM_FilterCompiled(benchmark::State &state, const QString &filterText)
+{
+    MockApplication app;
+    Channel channel(u"nymn"_s, Channel::Type::Twitch);
+    auto messages = readMessages(u"nymn"_s);
+    auto filter = parseFilter(filterText);
+
+    for (auto _ : state)
+    {
+        for (const auto &msg : messages)
+        {
+            MessageContext context(msg, &channel);
+            auto result = filter.matches(context);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+}  // namespace
+
+// clang-format off
+BENCHMARK_CAPTURE(BM_FilterContextMap, name, u"author.name == \"forsen\""_s);
+BENCHMARK_CAPTURE(BM_FilterCompiled, name, u"author.name == \"forsen\""_s);
+BENCHMARK_CAPTURE(BM_FilterContextMap, badges, u"author.subbed && !(author.badges contains \"moderator\")"_s);
+BENCHMARK_CAPTURE(BM_FilterCompiled, badges, u"author.subbed && !(author.badges contains \"moderator\")"_s);
+BENCHMARK_CAPTURE(BM_FilterContextMap, content, u"message.length > 20 || message.content match r\"^!\\w+\""_s);
+BENCHMARK_CAPTURE(BM_FilterCompiled, content, u"message.length > 20 || message.content match r\"^!\\w+\""_s);
+// clang-format on
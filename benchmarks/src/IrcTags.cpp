@@ -0,0 +1,124 @@
+#include "providers/twitch/IrcTags.hpp"
+
+#include <benchmark/benchmark.h>
+#include <IrcMessage>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+std::vector<std::unique_ptr<Communi::IrcMessage>> readRecentMessages()
+{
+    QFile file(":/bench/recentmessages-nymn.json");
+    if (!file.open(QFile::ReadOnly))
+    {
+        _exit(1);
+    }
+
+    std::vector<std::unique_ptr<Communi::IrcMessage>> messages;
+    const auto lines = QJsonDocument::fromJson(file.readAll())
+                           .object()
+                           .value("messages")
+                           .toArray();
+    for (const auto &line : lines)
+    {
+        messages.emplace_back(Communi::IrcMessage::fromData(
+            line.toString().toUtf8(), nullptr));
+    }
+    return messages;
+}
+
+/// Looks up the tags MessageBuilder::makeIrcMessage reads for a PRIVMSG
+/// through Communi's QVariantMap
+void BM_TagLookupCommuni(benchmark::State &state)
+{
+    auto messages = readRecentMessages();
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            auto tags = message->tags();
+            benchmark::DoNotOptimize(tags.value("user-id").toString());
+            benchmark::DoNotOptimize(tags.value("color").toString());
+            benchmark::DoNotOptimize(tags.value("id").toString());
+            benchmark::DoNotOptimize(tags.value("room-id").toString());
+            benchmark::DoNotOptimize(tags.contains("source-room-id"));
+            benchmark::DoNotOptimize(tags.contains("rm-deleted"));
+            benchmark::DoNotOptimize(tags.value("msg-id").toString());
+            benchmark::DoNotOptimize(tags.value("first-msg").toString());
+            benchmark::DoNotOptimize(tags.contains("bits"));
+            benchmark::DoNotOptimize(tags.contains("reply-parent-msg-id"));
+            benchmark::DoNotOptimize(tags.value("user-type").toString());
+            benchmark::DoNotOptimize(tags.value("badge-info").toString());
+            benchmark::DoNotOptimize(tags.value("badges").toString());
+            benchmark::DoNotOptimize(tags.value("display-name").toString());
+            benchmark::DoNotOptimize(tags.value("emotes").toString());
+            benchmark::DoNotOptimize(tags.contains("historical"));
+        }
+    }
+}
+
+/// Parses the raw line and looks up the same tags through IrcTags
+void BM_TagLookupFlat(benchmark::State &state)
+{
+    auto messages = readRecentMessages();
+
+    for (auto _ : state)
+    {
+        for (const auto &message : messages)
+        {
+            auto tags = IrcTags::fromMessage(message.get());
+            benchmark::DoNotOptimize(tags.value(IrcTag::UserId));
+            benchmark::DoNotOptimize(tags.value(IrcTag::Color));
+            benchmark::DoNotOptimize(tags.value(IrcTag::Id));
+            benchmark::DoNotOptimize(tags.value(IrcTag::RoomId));
+            benchmark::DoNotOptimize(tags.contains(IrcTag::SourceRoomId));
+            benchmark::DoNotOptimize(tags.contains(IrcTag::RmDeleted));
+            benchmark::DoNotOptimize(tags.raw(IrcTag::MsgId));
+            benchmark::DoNotOptimize(tags.raw(IrcTag::FirstMsg));
+            benchmark::DoNotOptimize(tags.contains(IrcTag::Bits));
+            benchmark::DoNotOptimize(tags.contains(IrcTag::ReplyParentMsgId));
+            benchmark::DoNotOptimize(tags.raw(IrcTag::UserType));
+            benchmark::DoNotOptimize(tags.value(IrcTag::BadgeInfo));
+            benchmark::DoNotOptimize(tags.value(IrcTag::Badges));
+            benchmark::DoNotOptimize(tags.unescaped(IrcTag::DisplayName));
+            benchmark::DoNotOptimize(tags.value(IrcTag::Emotes));
+            benchmark::DoNotOptimize(tags.contains(IrcTag::Historical));
+        }
+    }
+}
+
+/// Only parses the raw lines into IrcTags
+void BM_ParseIrcTags(benchmark::State &state)
+{
+    auto messages = readRecentMessages();
+    std::vector<QByteArray> lines;
+    lines.reserve(messages.size());
+    for (const auto &message : messages)
+    {
+        lines.emplace_back(message->toData());
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto &line : lines)
+        {
+            IrcTags tags(line);
+            benchmark::DoNotOptimize(tags);
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_TagLookupCommuni);
+BENCHMARK(BM_TagLookupFlat);
+BENCHMARK(BM_ParseIrcTags);
@@ -0,0 +1,113 @@
+#include "messages/layouts/MessageLayoutElement.hpp"
+#include "messages/MessageColor.hpp"
+#include "messages/MessageElement.hpp"
+#include "singletons/Fonts.hpp"
+#include "util/BumpArena.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QColor>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+/// The number of messages that are laid out in every iteration
+constexpr size_t MESSAGES = 1000;
+
+struct DestroyOnly {
+    void operator()(MessageLayoutElement *element) const
+    {
+        std::destroy_at(element);
+    }
+};
+
+/// Creates @a state.range(0) elements per message - every element on its own
+/// heap allocation (the previous design)
+void BM_LayoutElementsHeap(benchmark::State &state)
+{
+    TextElement creator("forsen", MessageElementFlag::Text,
+                        MessageColor::Text);
+    QString word("forsen");
+    std::vector<std::vector<std::unique_ptr<MessageLayoutElement>>> messages(
+        MESSAGES);
+    size_t allocations = 0;
+
+    for (auto _ : state)
+    {
+        for (auto &elements : messages)
+        {
+            elements.clear();
+            for (int i = 0; i < state.range(0); i++)
+            {
+                elements.emplace_back(std::make_unique<TextLayoutElement>(
+                    creator, word, QSizeF(42, 18), QColor(Qt::white),
+                    FontStyle::ChatMedium, 1.F));
+                allocations++;
+            }
+            benchmark::DoNotOptimize(elements.data());
+        }
+    }
+
+    state.counters["allocations"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+/// Creates @a state.range(0) elements per message in an arena per message,
+/// like MessageLayoutContainer does
+void BM_LayoutElementsArena(benchmark::State &state)
+{
+    TextElement creator("forsen", MessageElementFlag::Text,
+                        MessageColor::Text);
+    QString word("forsen");
+
+    struct Message {
+        BumpArena arena;
+        std::vector<std::unique_ptr<MessageLayoutElement, DestroyOnly>>
+            elements;
+    };
+    std::vector<Message> messages(MESSAGES);
+    size_t allocations = 0;
+
+    for (auto _ : state)
+    {
+        for (auto &message : messages)
+        {
+            message.elements.clear();
+            if (message.arena.blockCount() > 1)
+            {
+                // the blocks are merged into one
+                allocations++;
+            }
+            message.arena.reset();
+            auto blocks = message.arena.blockCount();
+
+            for (int i = 0; i < state.range(0); i++)
+            {
+                message.elements.emplace_back(
+                    message.arena.create<TextLayoutElement>(
+                        creator, word, QSizeF(42, 18), QColor(Qt::white),
+                        FontStyle::ChatMedium, 1.F));
+            }
+            allocations += message.arena.blockCount() - blocks;
+            benchmark::DoNotOptimize(message.elements.data());
+        }
+    }
+
+    size_t capacity = 0;
+    for (const auto &message : messages)
+    {
+        capacity += message.arena.capacity();
+    }
+    state.counters["allocations"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    state.counters["arenaBytes"] = static_cast<double>(capacity);
+}
+
+}  // namespace
+
+BENCHMARK(BM_LayoutElementsHeap)->Arg(10)->Arg(50);
+BENCHMARK(BM_LayoutElementsArena)->Arg(10)->Arg(50);
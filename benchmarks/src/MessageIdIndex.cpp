@@ -0,0 +1,95 @@
+#include "messages/MessageIdIndex.hpp"
+
+#include "messages/LimitedQueue.hpp"
+#include "messages/Message.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+constexpr size_t BUFFER_SIZE = 10000;
+
+std::vector<MessagePtr> makeMessages()
+{
+    std::vector<MessagePtr> messages;
+    messages.reserve(BUFFER_SIZE);
+    for (size_t i = 0; i < BUFFER_SIZE; i++)
+    {
+        auto msg = std::make_shared<Message>();
+        msg->id = QStringLiteral("c1ab1f44-8d76-4a3c-9a2b-%1")
+                      .arg(i, 12, 10, QChar('0'));
+        messages.emplace_back(std::move(msg));
+    }
+    return messages;
+}
+
+/// Looks up the message @a state.range(0) messages from the bottom by
+/// scanning the buffer (the previous implementation)
+void BM_FindMessageByIdScan(benchmark::State &state)
+{
+    auto messages = makeMessages();
+    LimitedQueue<MessagePtr> queue(BUFFER_SIZE);
+    for (const auto &msg : messages)
+    {
+        queue.pushBack(msg);
+    }
+    auto id = messages[BUFFER_SIZE - 1 - state.range(0)]->id;
+
+    for (auto _ : state)
+    {
+        auto found = queue.rfind([&](const MessagePtr &msg) {
+            return msg->id == id;
+        });
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+/// Looks up the message @a state.range(0) messages from the bottom in the
+/// index
+void BM_FindMessageByIdIndex(benchmark::State &state)
+{
+    auto messages = makeMessages();
+    MessageIdIndex index;
+    for (const auto &msg : messages)
+    {
+        index.addNewest(msg);
+    }
+    auto id = messages[BUFFER_SIZE - 1 - state.range(0)]->id;
+
+    for (auto _ : state)
+    {
+        auto found = index.find(id);
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+/// Adds messages to a full buffer, evicting the oldest one each time
+void BM_MessageIdIndexPushEvict(benchmark::State &state)
+{
+    auto messages = makeMessages();
+    LimitedQueue<MessagePtr> queue(BUFFER_SIZE / 2);
+    MessageIdIndex index;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto &msg = messages[i++ % BUFFER_SIZE];
+        MessagePtr deleted;
+        if (queue.pushBack(msg, deleted))
+        {
+            index.remove(deleted);
+        }
+        index.addNewest(msg);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_FindMessageByIdScan)->Arg(10)->Arg(1000)->Arg(9999);
+BENCHMARK(BM_FindMessageByIdIndex)->Arg(10)->Arg(1000)->Arg(9999);
+BENCHMARK(BM_MessageIdIndexPushEvict);
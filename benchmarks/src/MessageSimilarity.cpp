@@ -0,0 +1,170 @@
+#include "common/Literals.hpp"
+#include "messages/LimitedQueue.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageSimilarity.hpp"
+#include "providers/recentmessages/Impl.hpp"
+
+#include <benchmark/benchmark.h>
+#include <IrcMessage>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTime>
+
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+constexpr size_t CHANNEL_BUFFER_SIZE = 10000;
+
+const SimilarityOptions OPTIONS{
+    .maxMessages = 3,
+    .maxDelay = 5,
+    .bySameUser = false,
+    .threshold = 0.9F,
+};
+
+/// Reads the PRIVMSGs of the recent messages fixture into plain messages
+std::vector<MessagePtr> readMessages(const QString &name)
+{
+    QFile file(u":/bench/recentmessages-%1.json"_s.arg(name));
+    if (!file.open(QFile::ReadOnly))
+    {
+        _exit(1);
+    }
+
+    auto ircMessages = recentmessages::detail::parseRecentMessages(
+        QJsonDocument::fromJson(file.readAll()).object());
+
+    auto now = QTime::currentTime();
+    std::vector<MessagePtr> messages;
+    for (auto *ircMessage : ircMessages)
+    {
+        if (auto *privmsg =
+                dynamic_cast<Communi::IrcPrivateMessage *>(ircMessage))
+        {
+            auto msg = std::make_shared<Message>();
+            msg->loginName = privmsg->nick();
+            msg->messageText = privmsg->content();
+            msg->parseTime = now;
+            messages.emplace_back(std::move(msg));
+        }
+        delete ircMessage;
+    }
+    return messages;
+}
+
+/// The implementation before the SimilarityIndex - kept for comparison
+float naiveRelativeSimilarity(QStringView str1, QStringView str2)
+{
+    using SizeType = QStringView::size_type;
+
+    std::vector<std::vector<int>> tree(str1.size(),
+                                       std::vector<int>(str2.size(), 0));
+    int z = 0;
+
+    for (SizeType i = 0; i < str1.size(); ++i)
+    {
+        for (SizeType j = 0; j < str2.size(); ++j)
+        {
+            if (str1[i] == str2[j])
+            {
+                if (i == 0 || j == 0)
+                {
+                    tree[i][j] = 1;
+                }
+                else
+                {
+                    tree[i][j] = tree[i - 1][j - 1] + 1;
+                }
+                z = std::max(tree[i][j], z);
+            }
+            else
+            {
+                tree[i][j] = 0;
+            }
+        }
+    }
+
+    if (z == 0)
+    {
+        return 0.F;
+    }
+
+    auto div = std::max<>({static_cast<SizeType>(1), str1.size(), str2.size()});
+
+    return float(z) / float(div);
+}
+
+bool naiveIsSimilar(const MessagePtr &msg,
+                    const std::vector<MessagePtr> &messages)
+{
+    float similarityPercent = 0.0F;
+    auto now = QTime::currentTime();
+
+    for (const auto &prevMsg : messages | std::views::reverse |
+                                   std::views::take(OPTIONS.maxMessages))
+    {
+        if (prevMsg->parseTime.secsTo(now) >= OPTIONS.maxDelay)
+        {
+            break;
+        }
+        if (OPTIONS.bySameUser && msg->loginName != prevMsg->loginName)
+        {
+            continue;
+        }
+        similarityPercent =
+            std::max(similarityPercent,
+                     naiveRelativeSimilarity(msg->messageText,
+                                             prevMsg->messageText));
+    }
+
+    return similarityPercent > OPTIONS.threshold;
+}
+
+void BM_SimilarityNaive(benchmark::State &state, const QString &name)
+{
+    auto messages = readMessages(name);
+    LimitedQueue<MessagePtr> queue(CHANNEL_BUFFER_SIZE);
+    for (size_t i = 0; i < CHANNEL_BUFFER_SIZE; ++i)
+    {
+        queue.pushBack(messages[i % messages.size()]);
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto &msg : messages)
+        {
+            benchmark::DoNotOptimize(naiveIsSimilar(msg, queue.getSnapshot()));
+            queue.pushBack(msg);
+        }
+    }
+}
+
+void BM_SimilarityIndex(benchmark::State &state, const QString &name)
+{
+    auto messages = readMessages(name);
+    SimilarityIndex index;
+    for (const auto &msg : messages)
+    {
+        index.add(msg, OPTIONS.maxMessages);
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto &msg : messages)
+        {
+            benchmark::DoNotOptimize(index.isSimilar(*msg, OPTIONS));
+            index.add(msg, OPTIONS.maxMessages);
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_SimilarityNaive, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_SimilarityIndex, nymn, u"nymn"_s);
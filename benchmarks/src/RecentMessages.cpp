@@ -2,6 +2,9 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "messages/Emote.hpp"
+#include "messages/layouts/MessageLayout.hpp"
+#include "messages/layouts/MessageLayoutContext.hpp"
+#include "messages/MessageElement.hpp"
 #include "mocks/BaseApplication.hpp"
 #include "mocks/DisabledStreamerMode.hpp"
 #include "mocks/EmoteController.hpp"
@@ -19,6 +22,7 @@
 #include "providers/twitch/TwitchBadges.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "singletons/Resources.hpp"
+#include "singletons/WindowManager.hpp"
 
 #include <benchmark/benchmark.h>
 #include <QFile>
@@ -26,7 +30,9 @@
 #include <QJsonDocument>
 #include <QString>
 
+#include <memory>
 #include <optional>
+#include <vector>
 
 using namespace chatterino;
 using namespace literals;
@@ -38,9 +44,16 @@ class MockApplication : public mock::BaseApplication
 public:
     MockApplication()
         : highlights(this->settings, &this->accounts)
+        , windowManager(this->args, this->paths_, this->settings, this->theme,
+                        this->fonts)
     {
     }
 
+    WindowManager *getWindows() override
+    {
+        return &this->windowManager;
+    }
+
     EmoteController *getEmotes() override
     {
         return &this->emotes;
@@ -131,6 +144,7 @@ public:
     FfzEmotes ffzEmotes;
     SeventvEmotes seventvEmotes;
     DisabledStreamerMode streamerMode;
+    WindowManager windowManager;
 };
 
 std::optional<QJsonDocument> tryReadJsonFile(const QString &path)
@@ -256,6 +270,49 @@ public:
     }
 };
 
+class LayoutRecentMessages : public RecentMessages
+{
+public:
+    explicit LayoutRecentMessages(const QString &name_)
+        : RecentMessages(name_)
+    {
+    }
+
+    void run(benchmark::State &state)
+    {
+        auto parsed = recentmessages::detail::parseRecentMessages(
+            this->messages.object());
+        auto built =
+            recentmessages::detail::buildRecentMessages(parsed, &this->chan);
+
+        std::vector<std::unique_ptr<MessageLayout>> layouts;
+        for (const auto &message : built)
+        {
+            layouts.emplace_back(std::make_unique<MessageLayout>(message));
+        }
+
+        MessageColors colors;
+        int width = 400;
+        for (auto _ : state)
+        {
+            // Changing the width forces a relayout, like resizing a split
+            width = width == 400 ? 401 : 400;
+            for (const auto &layout : layouts)
+            {
+                layout->layout(
+                    {
+                        .messageColors = colors,
+                        .flags = MessageElementFlag::Default,
+                        .width = width,
+                        .scale = 1,
+                        .imageScale = 1,
+                    },
+                    false);
+            }
+        }
+    }
+};
+
 void BM_ParseRecentMessages(benchmark::State &state, const QString &name)
 {
     ParseRecentMessages bench(name);
@@ -268,7 +325,14 @@ void BM_BuildRecentMessages(benchmark::State &state, const QString &name)
     bench.run(state);
 }
 
+void BM_LayoutRecentMessages(benchmark::State &state, const QString &name)
+{
+    LayoutRecentMessages bench(name);
+    bench.run(state);
+}
+
 }  // namespace
 
 BENCHMARK_CAPTURE(BM_ParseRecentMessages, nymn, u"nymn"_s);
 BENCHMARK_CAPTURE(BM_BuildRecentMessages, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_LayoutRecentMessages, nymn, u"nymn"_s);
@@ -0,0 +1,60 @@
+#include "common/Literals.hpp"
+#include "messages/Emote.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+QByteArray readFixture(const QString &name)
+{
+    QFile file(u":/bench/seventvemotes-%1.json"_s.arg(name));
+    if (!file.open(QFile::ReadOnly))
+    {
+        _exit(1);
+    }
+    return file.readAll();
+}
+
+/// Builds a QJsonDocument of the user first (the previous approach)
+void BM_SeventvEmotesDocument(benchmark::State &state, const QString &name)
+{
+    auto data = readFixture(name);
+
+    for (auto _ : state)
+    {
+        auto json = QJsonDocument::fromJson(data).object();
+        auto emotes = seventv::detail::parseEmotes(
+            json["emote_set"_L1]["emotes"_L1].toArray(), false);
+        benchmark::DoNotOptimize(emotes);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            data.size());
+}
+
+void BM_SeventvEmotesReader(benchmark::State &state, const QString &name)
+{
+    auto data = readFixture(name);
+
+    for (auto _ : state)
+    {
+        auto user = seventv::detail::readEmoteSet(data, false);
+        benchmark::DoNotOptimize(user);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            data.size());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_SeventvEmotesDocument, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_SeventvEmotesReader, nymn, u"nymn"_s);
@@ -22,6 +22,11 @@ public:
     MOCK_METHOD(void, closeChannel,
                 (const QString &channelName, const QString &platformName),
                 (override));
+
+    MOCK_METHOD(std::vector<LogMatch>, searchLogs,
+                (const QString &channelName, const QString &platformName,
+                 const LogQuery &query),
+                (override));
 };
 
 class EmptyLogging : public ILogging
@@ -42,6 +47,13 @@ public:
     {
         //
     }
+
+    std::vector<LogMatch> searchLogs(const QString &channelName,
+                                     const QString &platformName,
+                                     const LogQuery &query) override
+    {
+        return {};
+    }
 };
 
 }  // namespace chatterino::mock
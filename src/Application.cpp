@@ -2,6 +2,7 @@
 
 #include "common/Args.hpp"
 #include "common/Channel.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/Version.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/commands/Command.hpp"
@@ -30,6 +31,7 @@
 #include "controllers/twitch/LiveController.hpp"
 #include "controllers/userdata/UserDataController.hpp"
 #include "debug/AssertInGuiThread.hpp"
+#include "messages/EmoteSnapshot.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/bttv/BttvLiveUpdates.hpp"
@@ -233,6 +235,7 @@ void Application::initialize(Settings &settings, const Paths &paths)
     {
         getSettings()->currentVersion.setValue(CHATTERINO_VERSION);
     }
+    NetworkCache::initGlobal();
     this->emotes->initialize();
 
     this->accounts->load();
@@ -608,6 +611,7 @@ void Application::aboutToQuit()
 
     this->hotkeys->save();
     this->windows->save();
+    EmoteSnapshot::saveGlobal();
 
     this->windows->closeAll();
 }
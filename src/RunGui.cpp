@@ -246,13 +246,10 @@ void runGui(QApplication &a, const Paths &paths, Settings &settings,
 
     updates.deleteOldFiles();
 
-    // Clear the cache 1 minute after start.
-    QTimer::singleShot(60 * 1000, [cachePath = paths.cacheDirectory(),
-                                   crashDirectory = paths.crashdumpDirectory,
+    // Clear old files 1 minute after start. The HTTP cache in the cache
+    // directory evicts its files itself (see NetworkCache).
+    QTimer::singleShot(60 * 1000, [crashDirectory = paths.crashdumpDirectory,
                                    avatarPath = paths.twitchProfileAvatars] {
-        std::ignore = QtConcurrent::run([cachePath] {
-            clearCache(cachePath);
-        });
         std::ignore = QtConcurrent::run([avatarPath] {
             clearCache(avatarPath);
         });
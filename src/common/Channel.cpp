@@ -117,8 +117,11 @@ void Channel::addMessage(MessagePtr message, MessageContext context,
 
     if (this->messages_.pushBack(message, deleted))
     {
+        this->idIndex_.remove(deleted);
         this->messageRemovedFromStart(deleted);
     }
+    this->idIndex_.addNewest(message);
+    this->addToSimilarityIndex(message);
 
     this->messageAppended.invoke(message, overridingFlags);
 }
@@ -175,8 +178,23 @@ void Channel::addMessagesAtStart(const std::vector<MessagePtr> &_messages)
         msg->freeze();
     }
 
+    bool wasEmpty = !this->hasMessages();
     std::vector<MessagePtr> addedMessages =
         this->messages_.pushFront(_messages);
+    // The most recent of the added messages takes precedence
+    for (auto it = addedMessages.rbegin(); it != addedMessages.rend(); ++it)
+    {
+        this->idIndex_.addOlder(*it);
+    }
+
+    if (wasEmpty)
+    {
+        // The added messages are now the most recent ones
+        for (const auto &msg : addedMessages)
+        {
+            this->addToSimilarityIndex(msg);
+        }
+    }
 
     if (addedMessages.size() != 0)
     {
@@ -200,7 +218,16 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
     {
         // There are no messages in this channel yet so we can just insert them
         // at the front in order
-        this->messages_.pushFront(messages);
+        auto addedMessages = this->messages_.pushFront(messages);
+        for (auto it = addedMessages.rbegin(); it != addedMessages.rend();
+             ++it)
+        {
+            this->idIndex_.addOlder(*it);
+        }
+        for (const auto &msg : messages)
+        {
+            this->addToSimilarityIndex(msg);
+        }
         this->filledInMessages.invoke(messages);
         return;
     }
@@ -251,7 +278,11 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
                 // Therefore, we can put the current message directly before. We
                 // assume that the messages we are filling in are in ascending
                 // order by serverReceivedTime.
-                this->messages_.insertBefore(snapshotMsg, msg);
+                std::optional<MessagePtr> evicted;
+                if (this->messages_.insertBefore(snapshotMsg, msg, &evicted))
+                {
+                    this->indexFilledInMessage(msg, evicted);
+                }
                 insertedFlag = true;
                 break;
             }
@@ -262,7 +293,13 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
             // We never found a message already in the channel that came after
             // the current message. Put it at the end and make sure to update
             // which message is considered "the end".
-            this->messages_.insertAfter(lastMsg, msg);
+            std::optional<MessagePtr> evicted;
+            if (this->messages_.insertAfter(lastMsg, msg, &evicted))
+            {
+                this->indexFilledInMessage(msg, evicted);
+            }
+            // Not added to the similarity index: messages that arrived while
+            // these were loaded are more recent and already in it
             lastMsg = msg;
         }
     }
@@ -283,6 +320,7 @@ void Channel::replaceMessage(const MessagePtr &message,
 
     if (index >= 0)
     {
+        this->replaceInIdIndex(message, replacement);
         this->messageReplaced.invoke((size_t)index, message, replacement);
     }
 }
@@ -294,6 +332,7 @@ void Channel::replaceMessage(size_t index, const MessagePtr &replacement)
     MessagePtr prev;
     if (this->messages_.replaceItem(index, replacement, &prev))
     {
+        this->replaceInIdIndex(prev, replacement);
         this->messageReplaced.invoke(index, prev, replacement);
     }
 }
@@ -306,6 +345,7 @@ void Channel::replaceMessage(size_t hint, const MessagePtr &message,
     auto index = this->messages_.replaceItem(hint, message, replacement);
     if (index >= 0)
     {
+        this->replaceInIdIndex(message, replacement);
         this->messageReplaced.invoke(hint, message, replacement);
     }
 }
@@ -322,27 +362,59 @@ void Channel::disableMessage(const QString &messageID)
 void Channel::clearMessages()
 {
     this->messages_.clear();
+    this->idIndex_.clear();
+    this->similarityIndex_.clear();
     this->messagesCleared.invoke();
 }
 
 MessagePtr Channel::findMessageByID(QStringView messageID)
 {
-    MessagePtr res;
+    if (messageID.isEmpty())
+    {
+        return nullptr;
+    }
+    return this->idIndex_.find(messageID);
+}
 
-    if (auto msg = this->messages_.rfind([messageID](const MessagePtr &msg) {
-            return msg->id == messageID;
-        });
-        msg)
+void Channel::applySimilarityFilters(const MessagePtr &message) const
+{
+    setSimilarityFlags(message, this->similarityIndex_);
+}
+
+void Channel::addToSimilarityIndex(const MessagePtr &message)
+{
+    if (!getSettings()->similarityEnabled)
     {
-        res = *msg;
+        return;
     }
 
-    return res;
+    auto capacity =
+        std::max(1, getSettings()->hideSimilarMaxMessagesToCheck.getValue());
+    this->similarityIndex_.add(message, static_cast<size_t>(capacity));
 }
 
-void Channel::applySimilarityFilters(const MessagePtr &message) const
+void Channel::indexFilledInMessage(const MessagePtr &message,
+                                   const std::optional<MessagePtr> &evicted)
+{
+    if (evicted)
+    {
+        this->idIndex_.remove(*evicted);
+    }
+    this->idIndex_.addOlder(message);
+}
+
+void Channel::replaceInIdIndex(const MessagePtr &message,
+                               const MessagePtr &replacement)
 {
-    setSimilarityFlags(message, this->messages_.getSnapshot());
+    if (message->id == replacement->id)
+    {
+        this->idIndex_.replace(message, replacement);
+        return;
+    }
+
+    // The replaced message might have hidden an older message with the same
+    // ID, so we can't update the index in place. This is rare.
+    this->idIndex_.rebuild(this->getMessageSnapshot());
 }
 
 MessageSinkTraits Channel::sinkTraits() const
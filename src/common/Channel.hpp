@@ -4,6 +4,8 @@
 #include "controllers/completion/TabCompletionModel.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/MessageFlag.hpp"
+#include "messages/MessageIdIndex.hpp"
+#include "messages/MessageSimilarity.hpp"
 #include "messages/MessageSink.hpp"
 
 #include <magic_enum/magic_enum.hpp>
@@ -148,8 +150,22 @@ protected:
     QString platform_;
 
 private:
+    /// Adds @a message to the similarity index if similarity checks are enabled
+    void addToSimilarityIndex(const MessagePtr &message);
+    /// Updates the ID index after @a message was filled in, which removed
+    /// @a evicted from the start of the buffer (if any)
+    void indexFilledInMessage(const MessagePtr &message,
+                              const std::optional<MessagePtr> &evicted);
+    /// Updates the ID index after @a message was replaced by @a replacement
+    void replaceInIdIndex(const MessagePtr &message,
+                          const MessagePtr &replacement);
+
     const QString name_;
     LimitedQueue<MessagePtr> messages_;
+    /// The messages in messages_ by their ID
+    MessageIdIndex idIndex_;
+    /// The most recent messages, used for similarity checks
+    SimilarityIndex similarityIndex_;
     Type type_;
     bool anythingLogged_ = false;
     QTimer clearCompletionModelTimer_;
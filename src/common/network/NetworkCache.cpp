@@ -0,0 +1,649 @@
+#include "common/network/NetworkCache.hpp"
+
+#include "Application.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "singletons/Paths.hpp"
+#include "singletons/Settings.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QLocale>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+constexpr quint32 INDEX_MAGIC = 0x43484e43;  // CHNC
+constexpr quint32 INDEX_VERSION = 1;
+const QString INDEX_FILE_NAME = QStringLiteral("index.dat");
+
+constexpr int MAX_IO_THREADS = 2;
+constexpr auto SAVE_INTERVAL = 60s;
+
+constexpr int64_t MS_PER_SECOND = 1000;
+constexpr int64_t MS_PER_DAY = 24 * 60 * 60 * MS_PER_SECOND;
+/// Freshness of responses without any caching headers. Before the cache
+/// had an index, all files were reused for 14 days.
+constexpr int64_t DEFAULT_FRESHNESS_MS = 14 * MS_PER_DAY;
+/// Upper bound for the freshness estimated from Last-Modified
+constexpr int64_t MAX_HEURISTIC_FRESHNESS_MS = 7 * MS_PER_DAY;
+/// Avoids overflows on absurd max-age values (~10 years)
+constexpr int64_t MAX_AGE_LIMIT_S = 10LL * 365 * 24 * 60 * 60;
+
+int64_t currentMs()
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+/// Parses an HTTP date (RFC 9110 IMF-fixdate) like
+/// "Wed, 21 Oct 2015 07:28:00 GMT"
+QDateTime parseHttpDate(const QByteArray &value)
+{
+    auto dt = QLocale::c().toDateTime(
+        QString::fromLatin1(value).trimmed(),
+        QStringLiteral("ddd, dd MMM yyyy HH:mm:ss 'GMT'"));
+    if (dt.isValid())
+    {
+        dt.setTimeZone(QTimeZone::utc());
+    }
+    return dt;
+}
+
+/// Cached files are named after the SHA-256 hash of the request
+bool isCacheKey(const QString &name)
+{
+    return name.size() == 64 && std::ranges::all_of(name, [](QChar c) {
+               auto ch = c.unicode();
+               return (ch >= u'0' && ch <= u'9') || (ch >= u'a' && ch <= u'f');
+           });
+}
+
+const auto ENTRIES_COUNTER = DebugCount::counter("http cache entries");
+const auto SIZE_COUNTER =
+    DebugCount::counter("http cache size", DebugCount::Flag::DataSize);
+const auto HITS_COUNTER = DebugCount::counter("http cache hits");
+const auto REVALIDATED_COUNTER = DebugCount::counter("http cache revalidated");
+const auto MISSES_COUNTER = DebugCount::counter("http cache misses");
+const auto EVICTIONS_COUNTER = DebugCount::counter("http cache evictions");
+const auto HIT_RATE_COUNTER = DebugCount::counter("http cache hit rate (%)");
+
+// Shared between global(), configureGlobal() and saveGlobal()
+std::mutex globalMutex;
+std::shared_ptr<NetworkCache> globalCache;
+
+}  // namespace
+
+namespace chatterino {
+
+NetworkCache::Policy NetworkCache::Policy::fromHeaders(
+    const QByteArray &cacheControl, const QByteArray &expires,
+    const QByteArray &etag, const QByteArray &lastModified, int64_t nowMs)
+{
+    Policy policy{
+        .store = true,
+        .expiresAt = nowMs + DEFAULT_FRESHNESS_MS,
+        .etag = etag.trimmed(),
+        .lastModified = lastModified.trimmed(),
+    };
+
+    std::optional<int64_t> maxAge;
+    bool noCache = false;
+    for (const auto &part : cacheControl.split(','))
+    {
+        auto directive = part.trimmed().toLower();
+        if (directive == "no-store")
+        {
+            policy.store = false;
+        }
+        else if (directive == "no-cache")
+        {
+            noCache = true;
+        }
+        else if (directive.startsWith("max-age="))
+        {
+            bool ok = false;
+            auto seconds = directive.mid(8).toLongLong(&ok);
+            if (ok)
+            {
+                maxAge = std::clamp<int64_t>(seconds, 0, MAX_AGE_LIMIT_S);
+            }
+        }
+    }
+
+    if (noCache)
+    {
+        // Must be revalidated before every use
+        policy.expiresAt = nowMs;
+    }
+    else if (maxAge)
+    {
+        policy.expiresAt = nowMs + (*maxAge * MS_PER_SECOND);
+    }
+    else if (!expires.isEmpty())
+    {
+        // Invalid dates (e.g. "0") mean the response is already expired
+        auto date = parseHttpDate(expires);
+        policy.expiresAt = date.isValid() ? date.toMSecsSinceEpoch() : nowMs;
+    }
+    else if (!policy.lastModified.isEmpty())
+    {
+        // Heuristic freshness: 10% of the time since the last modification
+        auto date = parseHttpDate(policy.lastModified);
+        if (date.isValid())
+        {
+            auto age = std::max<int64_t>(nowMs - date.toMSecsSinceEpoch(), 0);
+            policy.expiresAt =
+                nowMs + std::min(age / 10, MAX_HEURISTIC_FRESHNESS_MS);
+        }
+    }
+
+    return policy;
+}
+
+NetworkCache::Policy NetworkCache::Policy::fromReply(const QNetworkReply &reply)
+{
+    return fromHeaders(reply.rawHeader("Cache-Control"),
+                       reply.rawHeader("Expires"), reply.rawHeader("ETag"),
+                       reply.rawHeader("Last-Modified"), currentMs());
+}
+
+bool NetworkCache::Lookup::canRevalidate() const
+{
+    return !this->etag.isEmpty() || !this->lastModified.isEmpty();
+}
+
+NetworkCache::NetworkCache(QString directory, int64_t maxBytes)
+    : directory_(std::move(directory))
+    , lastSave_(std::chrono::steady_clock::now())
+    , maxBytes_(maxBytes)
+{
+}
+
+NetworkCache::~NetworkCache() = default;
+
+std::shared_ptr<NetworkCache> NetworkCache::global()
+{
+    std::lock_guard lock(globalMutex);
+    return globalCache;
+}
+
+void NetworkCache::initGlobal()
+{
+    assertInGuiThread();
+
+    // The settings are read here, on the GUI thread, and not on the threads
+    // that use the cache
+    auto update = [] {
+        auto maxBytes =
+            static_cast<int64_t>(getSettings()->cacheMaxSize.getValue()) *
+            1024 * 1024;
+        configureGlobal(getApp()->getPaths().cacheDirectory(), maxBytes);
+    };
+    getSettings()->cacheMaxSize.connect(update, false);
+    getSettings()->cachePath.connect(update, false);
+    update();
+}
+
+void NetworkCache::configureGlobal(const QString &directory, int64_t maxBytes)
+{
+    std::lock_guard lock(globalMutex);
+    if (globalCache && globalCache->directory() == directory)
+    {
+        globalCache->setMaxBytes(maxBytes);
+        return;
+    }
+
+    if (globalCache)
+    {
+        // The cache directory was changed in the settings
+        globalCache->save();
+    }
+    globalCache = std::make_shared<NetworkCache>(directory, maxBytes);
+}
+
+void NetworkCache::saveGlobal()
+{
+    // Let pending writes finish, so they end up in the index
+    pool().waitForDone(1000);
+
+    std::lock_guard lock(globalMutex);
+    if (globalCache)
+    {
+        globalCache->save();
+    }
+}
+
+void NetworkCache::run(std::function<void()> fn)
+{
+    pool().start(std::move(fn));
+}
+
+QThreadPool &NetworkCache::pool()
+{
+    // Intentionally leaked - see ImageDecoder::instance
+    static auto *pool = [] {
+        auto *pool = new QThreadPool;
+        pool->setObjectName("NetworkCache");
+        pool->setMaxThreadCount(MAX_IO_THREADS);
+        return pool;
+    }();
+    return *pool;
+}
+
+std::optional<NetworkCache::Lookup> NetworkCache::read(const QString &key)
+{
+    auto nowMs = currentMs();
+    Lookup lookup;
+    {
+        std::lock_guard lock(this->mutex_);
+        this->ensureLoaded();
+
+        auto it = this->entries_.find(key);
+        if (it == this->entries_.end())
+        {
+            this->misses_++;
+            this->updateDebugCounts();
+            return std::nullopt;
+        }
+
+        const auto &entry = *it->second;
+        lookup.fresh = entry.expiresAt > nowMs;
+        lookup.etag = entry.etag;
+        lookup.lastModified = entry.lastModified;
+        this->touch(it->second, nowMs);
+    }
+
+    QFile file(this->filePath(key));
+    if (file.open(QIODevice::ReadOnly))
+    {
+        lookup.data = file.readAll();
+    }
+
+    if (lookup.data.isEmpty())
+    {
+        qCDebug(chatterinoCache) << "Cached file for" << key
+                                 << "is missing or empty";
+        this->remove(key);
+        std::lock_guard lock(this->mutex_);
+        this->misses_++;
+        this->updateDebugCounts();
+        return std::nullopt;
+    }
+
+    if (lookup.fresh)
+    {
+        this->hits_++;
+        std::lock_guard lock(this->mutex_);
+        this->updateDebugCounts();
+    }
+    return lookup;
+}
+
+void NetworkCache::write(const QString &key, const QByteArray &data,
+                         const Policy &policy)
+{
+    if (!policy.store || data.isEmpty())
+    {
+        return;
+    }
+
+    QSaveFile file(this->filePath(key));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() ||
+        !file.commit())
+    {
+        qCWarning(chatterinoCache) << "Failed to write" << file.fileName()
+                                   << file.errorString();
+        return;
+    }
+
+    bool shouldSave = false;
+    {
+        std::lock_guard lock(this->mutex_);
+        this->ensureLoaded();
+
+        auto it = this->entries_.find(key);
+        if (it != this->entries_.end())
+        {
+            // The stored response was stale and got replaced
+            this->misses_++;
+            this->erase(it->second);
+        }
+
+        this->insert({
+            .key = key,
+            .size = data.size(),
+            .lastAccess = currentMs(),
+            .expiresAt = policy.expiresAt,
+            .etag = policy.etag,
+            .lastModified = policy.lastModified,
+        });
+        this->evict();
+        this->updateDebugCounts();
+
+        shouldSave = std::chrono::steady_clock::now() - this->lastSave_ >
+                     SAVE_INTERVAL;
+    }
+
+    if (shouldSave)
+    {
+        this->save();
+    }
+}
+
+void NetworkCache::refresh(const QString &key, const Policy &policy)
+{
+    std::lock_guard lock(this->mutex_);
+    this->ensureLoaded();
+
+    this->revalidated_++;
+
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end())
+    {
+        this->updateDebugCounts();
+        return;
+    }
+
+    auto &entry = *it->second;
+    entry.expiresAt = policy.expiresAt;
+    if (!policy.etag.isEmpty())
+    {
+        entry.etag = policy.etag;
+    }
+    if (!policy.lastModified.isEmpty())
+    {
+        entry.lastModified = policy.lastModified;
+    }
+    this->touch(it->second, currentMs());
+    this->updateDebugCounts();
+}
+
+void NetworkCache::remove(const QString &key)
+{
+    std::lock_guard lock(this->mutex_);
+    this->ensureLoaded();
+
+    auto it = this->entries_.find(key);
+    if (it != this->entries_.end())
+    {
+        this->erase(it->second);
+        this->updateDebugCounts();
+    }
+    QFile::remove(this->filePath(key));
+}
+
+void NetworkCache::clear()
+{
+    // The directory is shared with other caches (e.g. the emote snapshot),
+    // so only our own files are removed
+    std::vector<QString> keys;
+    {
+        std::lock_guard lock(this->mutex_);
+        this->ensureLoaded();
+
+        keys.reserve(this->lru_.size());
+        for (const auto &entry : this->lru_)
+        {
+            keys.push_back(entry.key);
+        }
+
+        this->lru_.clear();
+        this->entries_.clear();
+        this->totalBytes_ = 0;
+        this->dirty_ = true;
+        this->updateDebugCounts();
+    }
+
+    // A response that's stored again in the meantime might be removed here,
+    // read() treats it as a miss then
+    for (const auto &key : keys)
+    {
+        QFile::remove(this->filePath(key));
+    }
+    this->save();
+}
+
+void NetworkCache::setMaxBytes(int64_t maxBytes)
+{
+    this->maxBytes_ = maxBytes;
+}
+
+void NetworkCache::save()
+{
+    QByteArray bytes;
+    {
+        std::lock_guard lock(this->mutex_);
+        if (!this->loaded_ || !this->dirty_)
+        {
+            return;
+        }
+
+        QDataStream stream(&bytes, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << INDEX_MAGIC << INDEX_VERSION
+               << static_cast<quint64>(this->lru_.size());
+        for (const auto &entry : this->lru_)
+        {
+            stream << entry.key.toLatin1() << static_cast<qint64>(entry.size)
+                   << static_cast<qint64>(entry.lastAccess)
+                   << static_cast<qint64>(entry.expiresAt) << entry.etag
+                   << entry.lastModified;
+        }
+
+        this->dirty_ = false;
+        this->lastSave_ = std::chrono::steady_clock::now();
+    }
+
+    QSaveFile file(this->filePath(INDEX_FILE_NAME));
+    if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size() ||
+        !file.commit())
+    {
+        qCWarning(chatterinoCache)
+            << "Failed to save cache index" << file.errorString();
+    }
+}
+
+const QString &NetworkCache::directory() const
+{
+    return this->directory_;
+}
+
+NetworkCache::Stats NetworkCache::stats() const
+{
+    std::lock_guard lock(this->mutex_);
+    return {
+        .hits = this->hits_,
+        .misses = this->misses_,
+        .revalidated = this->revalidated_,
+        .evictions = this->evictions_,
+        .entries = static_cast<int64_t>(this->lru_.size()),
+        .bytes = this->totalBytes_,
+    };
+}
+
+QString NetworkCache::filePath(const QString &key) const
+{
+    return this->directory_ + '/' + key;
+}
+
+void NetworkCache::ensureLoaded()
+{
+    if (this->loaded_)
+    {
+        return;
+    }
+    this->loaded_ = true;
+
+    QDir().mkpath(this->directory_);
+    if (!this->loadIndex())
+    {
+        this->scanDirectory();
+    }
+    this->evict();
+    this->updateDebugCounts();
+}
+
+bool NetworkCache::loadIndex()
+{
+    QFile file(this->filePath(INDEX_FILE_NAME));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint64 count = 0;
+    stream >> magic >> version >> count;
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION)
+    {
+        qCWarning(chatterinoCache) << "Ignoring cache index with unknown format";
+        return false;
+    }
+
+    // Entries are stored most recently used first
+    for (quint64 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+    {
+        QByteArray key;
+        qint64 size = 0;
+        qint64 lastAccess = 0;
+        qint64 expiresAt = 0;
+        Entry entry;
+        stream >> key >> size >> lastAccess >> expiresAt >> entry.etag >>
+            entry.lastModified;
+        entry.key = QString::fromLatin1(key);
+        entry.size = size;
+        entry.lastAccess = lastAccess;
+        entry.expiresAt = expiresAt;
+
+        if (stream.status() != QDataStream::Ok || !isCacheKey(entry.key) ||
+            this->entries_.contains(entry.key))
+        {
+            continue;
+        }
+
+        this->totalBytes_ += entry.size;
+        auto it = this->lru_.insert(this->lru_.end(), std::move(entry));
+        this->entries_.emplace(it->key, it);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        // Keep what we could read, the rest will be fetched again
+        qCWarning(chatterinoCache) << "Cache index is truncated";
+        this->dirty_ = true;
+    }
+
+    qCDebug(chatterinoCache) << "Loaded cache index with" << this->lru_.size()
+                             << "entries," << this->totalBytes_ << "bytes";
+    return true;
+}
+
+void NetworkCache::scanDirectory()
+{
+    std::vector<Entry> found;
+    QDirIterator it(this->directory_, QDir::Files);
+    while (it.hasNext())
+    {
+        it.next();
+        auto info = it.fileInfo();
+        if (!isCacheKey(info.fileName()))
+        {
+            continue;
+        }
+
+        auto modified = info.lastModified().toMSecsSinceEpoch();
+        found.push_back({
+            .key = info.fileName(),
+            .size = info.size(),
+            .lastAccess = modified,
+            .expiresAt = modified + DEFAULT_FRESHNESS_MS,
+            .etag = {},
+            .lastModified = {},
+        });
+    }
+
+    std::ranges::sort(found, [](const auto &a, const auto &b) {
+        return a.lastAccess > b.lastAccess;
+    });
+    for (auto &entry : found)
+    {
+        this->totalBytes_ += entry.size;
+        auto lruIt = this->lru_.insert(this->lru_.end(), std::move(entry));
+        this->entries_.emplace(lruIt->key, lruIt);
+    }
+
+    this->dirty_ = true;
+    qCDebug(chatterinoCache) << "Indexed" << this->lru_.size()
+                             << "existing cache files";
+}
+
+void NetworkCache::touch(EntryList::iterator it, int64_t nowMs)
+{
+    it->lastAccess = nowMs;
+    this->lru_.splice(this->lru_.begin(), this->lru_, it);
+    this->dirty_ = true;
+}
+
+void NetworkCache::insert(Entry entry)
+{
+    this->totalBytes_ += entry.size;
+    this->lru_.push_front(std::move(entry));
+    this->entries_.emplace(this->lru_.front().key, this->lru_.begin());
+    this->dirty_ = true;
+}
+
+void NetworkCache::erase(EntryList::iterator it)
+{
+    this->totalBytes_ -= it->size;
+    this->entries_.erase(it->key);
+    this->lru_.erase(it);
+    this->dirty_ = true;
+}
+
+void NetworkCache::evict()
+{
+    auto maxBytes = this->maxBytes_.load();
+    while (this->totalBytes_ > maxBytes && !this->lru_.empty())
+    {
+        auto last = std::prev(this->lru_.end());
+        QFile::remove(this->filePath(last->key));
+        this->erase(last);
+        this->evictions_++;
+    }
+}
+
+void NetworkCache::updateDebugCounts() const
+{
+    auto hits = this->hits_.load() + this->revalidated_.load();
+    auto total = hits + this->misses_.load();
+
+    ENTRIES_COUNTER.set(static_cast<int64_t>(this->lru_.size()));
+    SIZE_COUNTER.set(this->totalBytes_);
+    HITS_COUNTER.set(this->hits_);
+    REVALIDATED_COUNTER.set(this->revalidated_);
+    MISSES_COUNTER.set(this->misses_);
+    EVICTIONS_COUNTER.set(this->evictions_);
+    if (total > 0)
+    {
+        HIT_RATE_COUNTER.set(hits * 100 / total);
+    }
+}
+
+}  // namespace chatterino
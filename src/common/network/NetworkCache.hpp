@@ -0,0 +1,180 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+class QNetworkReply;
+class QThreadPool;
+
+namespace chatterino {
+
+/// A size-bounded cache of HTTP responses on disk.
+///
+/// Every response is stored in its own file named after its key (the hash of
+/// the request). The metadata of all files is kept in an index
+/// (`index.dat`), which is read once when the cache is first used and saved
+/// periodically and on shutdown. When the total size of all files exceeds
+/// the budget, the least recently used files are removed.
+///
+/// All methods do blocking file I/O - use run() to execute them on the
+/// cache's own threads.
+class NetworkCache
+{
+public:
+    /// The freshness information of a response
+    struct Policy {
+        /// False if the response must not be stored (`no-store`)
+        bool store = true;
+        /// The time (ms since epoch) until which the response is fresh. After
+        /// that, it has to be revalidated.
+        int64_t expiresAt = 0;
+        QByteArray etag;
+        QByteArray lastModified;
+
+        /// Parses the policy from the given response headers.
+        ///
+        /// The freshness is taken from the `Cache-Control` header
+        /// (`max-age`, `no-cache`, `no-store`), `Expires` or, if neither is
+        /// present, estimated from `Last-Modified`. Responses without any of
+        /// these headers are fresh for 14 days.
+        static Policy fromHeaders(const QByteArray &cacheControl,
+                                  const QByteArray &expires,
+                                  const QByteArray &etag,
+                                  const QByteArray &lastModified,
+                                  int64_t nowMs);
+        static Policy fromReply(const QNetworkReply &reply);
+    };
+
+    struct Lookup {
+        QByteArray data;
+        /// True if the data can be used without asking the server
+        bool fresh = false;
+        QByteArray etag;
+        QByteArray lastModified;
+
+        /// Returns true if the response can be revalidated with a
+        /// conditional request
+        bool canRevalidate() const;
+    };
+
+    struct Stats {
+        int64_t hits = 0;
+        int64_t misses = 0;
+        int64_t revalidated = 0;
+        int64_t evictions = 0;
+        int64_t entries = 0;
+        int64_t bytes = 0;
+    };
+
+    /// @param directory The directory to store the files and the index in
+    /// @param maxBytes The maximum size of all cached files
+    NetworkCache(QString directory, int64_t maxBytes);
+    ~NetworkCache();
+
+    NetworkCache(const NetworkCache &) = delete;
+    NetworkCache &operator=(const NetworkCache &) = delete;
+    NetworkCache(NetworkCache &&) = delete;
+    NetworkCache &operator=(NetworkCache &&) = delete;
+
+    /// Returns the cache for the current cache directory or nullptr if
+    /// initGlobal() wasn't called yet
+    static std::shared_ptr<NetworkCache> global();
+    /// Creates the global cache and updates it when the cache settings
+    /// change. Must be called on the GUI thread.
+    static void initGlobal();
+    /// Uses @a directory with at most @a maxBytes for the global cache
+    static void configureGlobal(const QString &directory, int64_t maxBytes);
+    /// Saves the index of the global cache if it was used
+    static void saveGlobal();
+
+    /// Runs @a fn on one of the cache's I/O threads
+    static void run(std::function<void()> fn);
+
+    /// Reads the response stored under @a key and marks it as recently used.
+    /// Returns std::nullopt if there's no such response.
+    std::optional<Lookup> read(const QString &key);
+
+    /// Stores @a data under @a key and evicts old responses if the cache is
+    /// over budget.
+    void write(const QString &key, const QByteArray &data,
+               const Policy &policy);
+
+    /// Updates the freshness of @a key after the server confirmed that the
+    /// stored response is still valid (HTTP 304)
+    void refresh(const QString &key, const Policy &policy);
+
+    void remove(const QString &key);
+
+    /// Removes all responses from the cache. Other files in the directory
+    /// are kept.
+    void clear();
+
+    void setMaxBytes(int64_t maxBytes);
+
+    /// Writes the index to disk if it changed since it was last saved
+    void save();
+
+    const QString &directory() const;
+    Stats stats() const;
+
+private:
+    struct Entry {
+        QString key;
+        int64_t size = 0;
+        int64_t lastAccess = 0;
+        int64_t expiresAt = 0;
+        QByteArray etag;
+        QByteArray lastModified;
+    };
+    using EntryList = std::list<Entry>;
+
+    QString filePath(const QString &key) const;
+
+    /// Loads the index from disk if it wasn't loaded yet
+    void ensureLoaded();
+    bool loadIndex();
+    /// Builds an index from the files in the directory (used if there's no
+    /// index yet)
+    void scanDirectory();
+
+    /// Moves @a it to the front of the LRU list
+    void touch(EntryList::iterator it, int64_t nowMs);
+    void insert(Entry entry);
+    void erase(EntryList::iterator it);
+    /// Removes the least recently used entries until the cache is in budget
+    void evict();
+
+    void updateDebugCounts() const;
+
+    const QString directory_;
+
+    mutable std::mutex mutex_;
+    bool loaded_ = false;
+    bool dirty_ = false;
+    std::chrono::steady_clock::time_point lastSave_;
+
+    /// All entries, most recently used first
+    EntryList lru_;
+    std::unordered_map<QString, EntryList::iterator> entries_;
+    int64_t totalBytes_ = 0;
+    std::atomic<int64_t> maxBytes_;
+
+    std::atomic<int64_t> hits_ = 0;
+    std::atomic<int64_t> misses_ = 0;
+    std::atomic<int64_t> revalidated_ = 0;
+    std::atomic<int64_t> evictions_ = 0;
+
+    static QThreadPool &pool();
+};
+
+}  // namespace chatterino
@@ -26,6 +26,15 @@ enum class NetworkRequestType {
     Patch,
 };
 
+/// Queued requests with a higher priority are sent first
+enum class NetworkPriority {
+    /// Requests for things the user is looking at
+    High,
+    Normal,
+    /// Requests for things that aren't visible
+    Low,
+};
+
 // parseHeaderList takes a list of headers in string form,
 // where each header pair is separated by semicolons (;) and the header name and value is divided by a colon (:)
 //
@@ -1,5 +1,7 @@
 #include "common/network/NetworkManager.hpp"
 
+#include "common/network/NetworkCache.hpp"
+
 #include <QNetworkAccessManager>
 
 namespace chatterino {
@@ -25,6 +27,8 @@ void NetworkManager::deinit()
     assert(NetworkManager::workerThread);
     assert(NetworkManager::accessManager);
 
+    NetworkCache::saveGlobal();
+
     // delete the access manager first:
     // - put the event on the worker thread
     // - wait for it to process
@@ -1,11 +1,11 @@
 #include "common/network/NetworkPrivate.hpp"
 
 #include "Application.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/network/NetworkResult.hpp"
-#include "common/network/NetworkTask.hpp"
+#include "common/network/NetworkScheduler.hpp"
 #include "common/QLogging.hpp"
-#include "singletons/Paths.hpp"
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
@@ -14,7 +14,6 @@
 #include <magic_enum/magic_enum.hpp>
 #include <QCryptographicHash>
 #include <QElapsedTimer>
-#include <QFile>
 #include <QNetworkReply>
 #include <QtConcurrent>
 
@@ -30,6 +29,10 @@ namespace {
 
 using namespace chatterino;
 
+const auto NETWORK_DATA_COUNTER = DebugCount::counter("NetworkData");
+const auto REQUEST_STARTED_COUNTER =
+    DebugCount::counter("http request started");
+
 void runCallback(bool concurrent, auto &&fn)
 {
     if (concurrent)
@@ -44,38 +47,49 @@ void runCallback(bool concurrent, auto &&fn)
 
 void loadUncached(std::shared_ptr<NetworkData> &&data)
 {
-    DebugCount::increase("http request started");
-
-    NetworkRequester requester;
-    auto *worker = new NetworkTask(std::move(data));
-
-    worker->moveToThread(NetworkManager::workerThread);
+    REQUEST_STARTED_COUNTER.increase();
 
-    QObject::connect(&requester, &NetworkRequester::requestUrl, worker,
-                     &NetworkTask::run);
-
-    requester.requestUrl();
+    // The scheduler decides when the request is actually sent
+    QMetaObject::invokeMethod(NetworkManager::accessManager, [data] {
+        NetworkScheduler::instance().schedule(data);
+    });
 }
 
-void loadCached(std::shared_ptr<NetworkData> &&data)
+void loadCached(const std::shared_ptr<NetworkCache> &cache,
+                std::shared_ptr<NetworkData> &&data)
 {
-    QFile cachedFile(getApp()->getPaths().cacheDirectory() + "/" +
-                     data->getHash());
-
-    if (!cachedFile.exists() || !cachedFile.open(QIODevice::ReadOnly))
+    auto cached = cache->read(data->getHash());
+    if (!cached)
     {
         loadUncached(std::move(data));
         return;
     }
 
-    // XXX: check if bytes is empty?
-    QByteArray bytes = cachedFile.readAll();
+    if (!cached->fresh)
+    {
+        if (cached->canRevalidate())
+        {
+            // The hash was computed above, so the headers don't change it
+            if (!cached->etag.isEmpty())
+            {
+                data->request.setRawHeader("If-None-Match", cached->etag);
+            }
+            if (!cached->lastModified.isEmpty())
+            {
+                data->request.setRawHeader("If-Modified-Since",
+                                           cached->lastModified);
+            }
+            data->revalidating = std::move(cached->data);
+        }
+        loadUncached(std::move(data));
+        return;
+    }
 
     qCDebug(chatterinoHTTP).noquote() << data->typeString() << "[CACHED] 200"
                                       << data->request.url().toString();
 
     data->emitSuccess(
-        {NetworkResult::NetworkError::NoError, QVariant(200), bytes});
+        {NetworkResult::NetworkError::NoError, QVariant(200), cached->data});
     data->emitFinally();
 }
 
@@ -85,12 +99,12 @@ namespace chatterino {
 
 NetworkData::NetworkData()
 {
-    DebugCount::increase("NetworkData");
+    NETWORK_DATA_COUNTER.increase();
 }
 
 NetworkData::~NetworkData()
 {
-    DebugCount::decrease("NetworkData");
+    NETWORK_DATA_COUNTER.decrease();
 }
 
 QString NetworkData::getHash()
@@ -214,10 +228,11 @@ QString NetworkData::typeString() const
 
 void load(std::shared_ptr<NetworkData> &&data)
 {
-    if (data->cache)
+    auto cache = data->cache ? NetworkCache::global() : nullptr;
+    if (cache)
     {
-        std::ignore = QtConcurrent::run([data = std::move(data)]() mutable {
-            loadCached(std::move(data));
+        NetworkCache::run([cache, data = std::move(data)]() mutable {
+            loadCached(cache, std::move(data));
         });
     }
     else
@@ -17,14 +17,6 @@ namespace chatterino {
 
 class NetworkResult;
 
-class NetworkRequester : public QObject
-{
-    Q_OBJECT
-
-Q_SIGNALS:
-    void requestUrl();
-};
-
 class NetworkData
 {
 public:
@@ -41,11 +33,19 @@ public:
     bool cache{};
     bool executeConcurrently{};
 
+    /// Set if the cached response is stale and the request asks the server
+    /// whether it's still valid. Contains the cached response.
+    std::optional<QByteArray> revalidating;
+
     NetworkSuccessCallback onSuccess;
     NetworkErrorCallback onError;
     NetworkFinallyCallback finally;
 
     NetworkRequestType requestType = NetworkRequestType::Get;
+    NetworkPriority priority = NetworkPriority::Normal;
+    /// Requests of a group can be raised in priority while they're queued
+    /// (see raiseNetworkPriority)
+    QString priorityGroup;
 
     QByteArray payload;
     std::unique_ptr<QHttpMultiPart, DeleteLater> multiPartPayload;
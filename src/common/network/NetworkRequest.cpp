@@ -1,6 +1,8 @@
 #include "common/network/NetworkRequest.hpp"
 
+#include "common/network/NetworkManager.hpp"
 #include "common/network/NetworkPrivate.hpp"
+#include "common/network/NetworkScheduler.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
 
@@ -11,6 +13,15 @@
 
 #include <cassert>
 
+namespace {
+
+using namespace chatterino;
+
+thread_local NetworkPriority defaultPriority = NetworkPriority::Normal;
+thread_local QString defaultPriorityGroup;
+
+}  // namespace
+
 namespace chatterino {
 
 NetworkRequest::NetworkRequest(const std::string &url,
@@ -122,6 +133,12 @@ NetworkRequest NetworkRequest::timeout(int ms) &&
     return std::move(*this);
 }
 
+NetworkRequest NetworkRequest::priority(NetworkPriority priority) &&
+{
+    this->data->priority = priority;
+    return std::move(*this);
+}
+
 NetworkRequest NetworkRequest::concurrent() &&
 {
     this->data->executeConcurrently = true;
@@ -189,6 +206,8 @@ void NetworkRequest::initializeDefaultValues()
                                .toUtf8();
 
     this->data->request.setRawHeader("User-Agent", userAgent);
+    this->data->priority = defaultPriority;
+    this->data->priorityGroup = defaultPriorityGroup;
 }
 
 NetworkRequest NetworkRequest::json(const QJsonArray &root) &&
@@ -223,4 +242,33 @@ NetworkRequest NetworkRequest::ignoreSslErrors(bool ignore) &&
 }
 #endif
 
+NetworkPriorityScope::NetworkPriorityScope(NetworkPriority priority,
+                                           QString group)
+    : previous_(defaultPriority)
+    , previousGroup_(std::move(defaultPriorityGroup))
+{
+    defaultPriority = priority;
+    defaultPriorityGroup = std::move(group);
+}
+
+NetworkPriorityScope::~NetworkPriorityScope()
+{
+    defaultPriority = this->previous_;
+    defaultPriorityGroup = std::move(this->previousGroup_);
+}
+
+void raiseNetworkPriority(const QString &group, NetworkPriority priority)
+{
+    if (group.isEmpty() || !NetworkManager::accessManager)
+    {
+        return;
+    }
+
+    QMetaObject::invokeMethod(NetworkManager::accessManager,
+                              [group, priority] {
+                                  network::detail::NetworkScheduler::instance()
+                                      .raisePriority(group, priority);
+                              });
+}
+
 }  // namespace chatterino
@@ -64,6 +64,9 @@ public:
     NetworkRequest headerList(
         const std::vector<std::pair<QByteArray, QByteArray>> &headers) &&;
     NetworkRequest timeout(int ms) &&;
+    /// Sets the priority of the request. Defaults to the priority of the
+    /// innermost NetworkPriorityScope on this thread, or Normal.
+    NetworkRequest priority(NetworkPriority priority) &&;
     NetworkRequest concurrent() &&;
     NetworkRequest multiPart(QHttpMultiPart *payload) &&;
     /**
@@ -86,4 +89,35 @@ private:
     void initializeDefaultValues();
 };
 
+/// Sets the default priority of requests created on the current thread for
+/// as long as it's alive.
+///
+/// Useful for functions that start many requests through other functions,
+/// such as loading everything a channel needs when it's joined.
+///
+/// If @a group is set, the requests can later be raised in priority with
+/// raiseNetworkPriority.
+class NetworkPriorityScope
+{
+public:
+    explicit NetworkPriorityScope(NetworkPriority priority,
+                                  QString group = {});
+    ~NetworkPriorityScope();
+
+    NetworkPriorityScope(const NetworkPriorityScope &) = delete;
+    NetworkPriorityScope(NetworkPriorityScope &&) = delete;
+    NetworkPriorityScope &operator=(const NetworkPriorityScope &) = delete;
+    NetworkPriorityScope &operator=(NetworkPriorityScope &&) = delete;
+
+private:
+    NetworkPriority previous_;
+    QString previousGroup_;
+};
+
+/// Raises all requests of @a group that haven't been sent yet to at least
+/// @a priority.
+///
+/// Used when something becomes visible after its requests were queued.
+void raiseNetworkPriority(const QString &group, NetworkPriority priority);
+
 }  // namespace chatterino
@@ -0,0 +1,241 @@
+#include "common/network/NetworkScheduler.hpp"
+
+#include "common/network/NetworkManager.hpp"
+#include "common/network/NetworkPrivate.hpp"
+#include "common/network/NetworkTask.hpp"
+#include "util/DebugCount.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+#include <QThread>
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+using namespace chatterino;
+
+const auto QUEUED_COUNTER = DebugCount::counter("http requests queued");
+const auto IN_FLIGHT_COUNTER = DebugCount::counter("http requests in flight");
+const auto DEDUPLICATED_COUNTER =
+    DebugCount::counter("http requests deduplicated");
+const auto RAISED_COUNTER =
+    DebugCount::counter("http requests raised in priority");
+
+bool canShare(const NetworkData &data)
+{
+    return data.requestType == NetworkRequestType::Get &&
+           data.payload.isEmpty() && !data.multiPartPayload;
+}
+
+}  // namespace
+
+namespace chatterino::network::detail {
+
+static_assert(magic_enum::enum_count<NetworkPriority>() == 3);
+
+NetworkScheduler &NetworkScheduler::instance()
+{
+    assert(QThread::currentThread() == NetworkManager::workerThread);
+
+    // Intentionally leaked - tasks might still finish while the worker
+    // thread stops
+    static auto *scheduler = new NetworkScheduler;
+    return *scheduler;
+}
+
+void NetworkScheduler::schedule(std::shared_ptr<NetworkData> data)
+{
+    QString hash;
+    if (canShare(*data))
+    {
+        hash = data->getHash();
+        auto it = this->shared_.find(hash);
+        if (it != this->shared_.end())
+        {
+            if (it->second.timeout == data->timeout)
+            {
+                auto priority = data->priority;
+                it->second.waiting.emplace_back(std::move(data));
+                DEDUPLICATED_COUNTER.increase();
+
+                // The request we wait for might still be queued with a
+                // lower priority
+                this->raiseQueued(
+                    [&](const Queued &queued) {
+                        return queued.hash == hash;
+                    },
+                    priority);
+                return;
+            }
+            // Another request for the same thing is already shared
+            hash.clear();
+        }
+        else
+        {
+            this->shared_.emplace(hash, Shared{.timeout = data->timeout});
+        }
+    }
+
+    auto host = data->request.url().host();
+    auto priority = static_cast<size_t>(data->priority);
+    auto group = data->priorityGroup;
+    this->hosts_[host].queues[priority].push_back({
+        .task = new NetworkTask(std::move(data)),
+        .seq = this->nextSeq_++,
+        .hash = std::move(hash),
+        .group = std::move(group),
+    });
+    QUEUED_COUNTER.increase();
+
+    this->dispatch();
+}
+
+void NetworkScheduler::raisePriority(const QString &group,
+                                     NetworkPriority priority)
+{
+    if (group.isEmpty())
+    {
+        return;
+    }
+
+    auto raised = this->raiseQueued(
+        [&](const Queued &queued) {
+            return queued.group == group;
+        },
+        priority);
+    RAISED_COUNTER.increase(static_cast<int64_t>(raised));
+}
+
+size_t NetworkScheduler::raiseQueued(
+    const std::function<bool(const Queued &)> &pred, NetworkPriority priority)
+{
+    auto target = static_cast<size_t>(priority);
+    size_t moved = 0;
+    for (auto &[name, host] : this->hosts_)
+    {
+        auto &targetQueue = host.queues[target];
+        // Queues with a higher index have a lower priority
+        for (size_t from = target + 1; from < PRIORITY_COUNT; from++)
+        {
+            auto &queue = host.queues[from];
+            for (auto it = queue.begin(); it != queue.end();)
+            {
+                if (!pred(*it))
+                {
+                    ++it;
+                    continue;
+                }
+
+                // Keep the queue ordered by the time requests were scheduled
+                auto pos = std::upper_bound(
+                    targetQueue.begin(), targetQueue.end(), it->seq,
+                    [](uint64_t seq, const Queued &queued) {
+                        return seq < queued.seq;
+                    });
+                targetQueue.insert(pos, std::move(*it));
+                it = queue.erase(it);
+                moved++;
+            }
+        }
+    }
+    return moved;
+}
+
+std::vector<std::shared_ptr<NetworkData>> NetworkScheduler::finished(
+    NetworkTask *task)
+{
+    auto it = this->running_.find(task);
+    if (it == this->running_.end())
+    {
+        return {};
+    }
+
+    std::vector<std::shared_ptr<NetworkData>> waiting;
+    if (!it->second.hash.isEmpty())
+    {
+        auto sharedIt = this->shared_.find(it->second.hash);
+        if (sharedIt != this->shared_.end())
+        {
+            waiting = std::move(sharedIt->second.waiting);
+            this->shared_.erase(sharedIt);
+        }
+    }
+
+    this->hosts_[it->second.host].inFlight--;
+    this->running_.erase(it);
+    this->inFlight_--;
+    IN_FLIGHT_COUNTER.decrease();
+
+    this->dispatch();
+    return waiting;
+}
+
+void NetworkScheduler::dispatch()
+{
+    // Tasks that fail to start finish while they're being dispatched
+    if (this->dispatching_)
+    {
+        return;
+    }
+    this->dispatching_ = true;
+
+    while (this->inFlight_ < MAX_IN_FLIGHT)
+    {
+        // The oldest request with the highest priority of all hosts that
+        // have room for another request
+        const QString *bestName = nullptr;
+        Host *bestHost = nullptr;
+        std::deque<Queued> *bestQueue = nullptr;
+        size_t bestPriority = 0;
+        for (auto &[name, host] : this->hosts_)
+        {
+            if (host.inFlight >= MAX_PER_HOST)
+            {
+                continue;
+            }
+            for (size_t priority = 0; priority < PRIORITY_COUNT; priority++)
+            {
+                auto &queue = host.queues[priority];
+                if (queue.empty())
+                {
+                    continue;
+                }
+                if (!bestQueue || priority < bestPriority ||
+                    (priority == bestPriority &&
+                     queue.front().seq < bestQueue->front().seq))
+                {
+                    bestName = &name;
+                    bestHost = &host;
+                    bestQueue = &queue;
+                    bestPriority = priority;
+                }
+                break;
+            }
+        }
+
+        if (!bestQueue)
+        {
+            break;
+        }
+
+        auto queued = std::move(bestQueue->front());
+        bestQueue->pop_front();
+        QUEUED_COUNTER.decrease();
+
+        Running running{
+            .host = *bestName,
+            .hash = std::move(queued.hash),
+        };
+        bestHost->inFlight++;
+        this->running_.emplace(queued.task, std::move(running));
+        this->inFlight_++;
+        IN_FLIGHT_COUNTER.increase();
+
+        queued.task->run();
+    }
+
+    this->dispatching_ = false;
+}
+
+}  // namespace chatterino::network::detail
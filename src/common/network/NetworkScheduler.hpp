@@ -0,0 +1,110 @@
+#pragma once
+
+#include "common/network/NetworkCommon.hpp"
+
+#include <QString>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+class NetworkData;
+
+}  // namespace chatterino
+
+namespace chatterino::network::detail {
+
+class NetworkTask;
+
+/// Decides when requests are sent.
+///
+/// Requests are queued by priority and sent in order, with at most
+/// MAX_IN_FLIGHT requests in flight in total and at most MAX_PER_HOST
+/// requests per host. Requests of the same priority are sent in the order
+/// they were scheduled.
+///
+/// While a GET request is queued or in flight, an identical GET request
+/// (same URL, headers and timeout) doesn't send a request of its own.
+/// Instead, it gets the result of the first one. If it has a higher
+/// priority, the first one is raised to its priority while it's queued.
+///
+/// Only used from the network worker thread.
+class NetworkScheduler
+{
+public:
+    static constexpr size_t MAX_IN_FLIGHT = 32;
+    static constexpr size_t MAX_PER_HOST = 6;
+
+    static NetworkScheduler &instance();
+
+    /// Sends the request once there's room for it
+    void schedule(std::shared_ptr<NetworkData> data);
+
+    /// Raises all queued requests of @a group to at least @a priority
+    ///
+    /// Requests keep their position relative to the other requests of the
+    /// new priority.
+    void raisePriority(const QString &group, NetworkPriority priority);
+
+    /// Called once @a task has finished (or failed to start).
+    ///
+    /// @returns The requests that were waiting for the result of @a task
+    std::vector<std::shared_ptr<NetworkData>> finished(NetworkTask *task);
+
+private:
+    static constexpr size_t PRIORITY_COUNT = 3;
+
+    struct Queued {
+        NetworkTask *task;
+        uint64_t seq;
+        /// Set if identical requests can wait for this one
+        QString hash;
+        /// See NetworkData::priorityGroup
+        QString group;
+    };
+
+    struct Running {
+        QString host;
+        QString hash;
+    };
+
+    struct Host {
+        /// One queue per priority
+        std::array<std::deque<Queued>, PRIORITY_COUNT> queues;
+        size_t inFlight = 0;
+    };
+
+    /// A GET request that identical requests wait for
+    struct Shared {
+        std::optional<std::chrono::milliseconds> timeout;
+        std::vector<std::shared_ptr<NetworkData>> waiting;
+    };
+
+    /// Moves all queued requests for which @a pred returns true to the
+    /// queue of @a priority if that's higher than their current one.
+    ///
+    /// @returns The number of moved requests
+    size_t raiseQueued(const std::function<bool(const Queued &)> &pred,
+                       NetworkPriority priority);
+
+    /// Sends queued requests until a limit is reached
+    void dispatch();
+
+    std::unordered_map<QString, Host> hosts_;
+    std::unordered_map<NetworkTask *, Running> running_;
+    /// Request hash -> shared GET request
+    std::unordered_map<QString, Shared> shared_;
+    size_t inFlight_ = 0;
+    uint64_t nextSeq_ = 0;
+    bool dispatching_ = false;
+};
+
+}  // namespace chatterino::network::detail
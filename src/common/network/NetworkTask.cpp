@@ -1,17 +1,24 @@
 #include "common/network/NetworkTask.hpp"
 
-#include "Application.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/network/NetworkPrivate.hpp"
 #include "common/network/NetworkResult.hpp"
+#include "common/network/NetworkScheduler.hpp"
 #include "common/QLogging.hpp"
-#include "singletons/Paths.hpp"
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
 
-#include <QFile>
 #include <QNetworkReply>
-#include <QtConcurrent>
+
+namespace {
+
+using chatterino::DebugCount;
+
+const auto REQUEST_SUCCESS_COUNTER =
+    DebugCount::counter("http request success");
+
+}  // namespace
 
 namespace chatterino::network::detail {
 
@@ -22,6 +29,8 @@ NetworkTask::NetworkTask(std::shared_ptr<NetworkData> &&data)
 
 NetworkTask::~NetworkTask()
 {
+    this->done();
+
     if (this->reply_)
     {
         this->reply_->deleteLater();
@@ -33,6 +42,7 @@ void NetworkTask::run()
     this->reply_ = this->createReply();
     if (!this->reply_)
     {
+        this->cancelWaiting();
         this->deleteLater();
         return;
     }
@@ -140,17 +150,82 @@ void NetworkTask::logReply()
 
 void NetworkTask::writeToCache(const QByteArray &bytes) const
 {
-    std::ignore = QtConcurrent::run([data = this->data_, bytes] {
-        QFile cachedFile(getApp()->getPaths().cacheDirectory() + "/" +
-                         data->getHash());
-
-        if (cachedFile.open(QIODevice::WriteOnly))
-        {
-            cachedFile.write(bytes);
-        }
+    auto policy = NetworkCache::Policy::fromReply(*this->reply_);
+    if (!policy.store)
+    {
+        return;
+    }
+
+    auto cache = NetworkCache::global();
+    if (!cache)
+    {
+        return;
+    }
+    NetworkCache::run([cache, data = this->data_, bytes, policy] {
+        cache->write(data->getHash(), bytes, policy);
     });
 }
 
+void NetworkTask::revalidated()
+{
+    auto policy = NetworkCache::Policy::fromReply(*this->reply_);
+    if (auto cache = NetworkCache::global())
+    {
+        NetworkCache::run([cache, data = this->data_, policy] {
+            cache->refresh(data->getHash(), policy);
+        });
+    }
+
+    qCDebug(chatterinoHTTP).noquote()
+        << this->data_->typeString() << "[REVALIDATED] 304"
+        << this->data_->request.url().toString();
+
+    this->emitSuccess({NetworkResult::NetworkError::NoError, QVariant(200),
+                       *this->data_->revalidating});
+}
+
+void NetworkTask::emitSuccess(NetworkResult &&result)
+{
+    for (const auto &waiting : this->done())
+    {
+        waiting->emitSuccess(NetworkResult(result));
+        waiting->emitFinally();
+    }
+    this->data_->emitSuccess(std::move(result));
+    this->data_->emitFinally();
+}
+
+void NetworkTask::emitError(NetworkResult &&result)
+{
+    for (const auto &waiting : this->done())
+    {
+        waiting->emitError(NetworkResult(result));
+        waiting->emitFinally();
+    }
+    this->data_->emitError(std::move(result));
+    this->data_->emitFinally();
+}
+
+void NetworkTask::cancelWaiting()
+{
+    for (const auto &waiting : this->done())
+    {
+        waiting->emitError(
+            {NetworkResult::NetworkError::OperationCanceledError, {}, {}});
+        waiting->emitFinally();
+    }
+}
+
+std::vector<std::shared_ptr<NetworkData>> NetworkTask::done()
+{
+    if (this->done_)
+    {
+        return {};
+    }
+    this->done_ = true;
+    return NetworkScheduler::instance().finished(this);
+}
+
 void NetworkTask::timeout()
 {
     AbandonObject guard(this);
@@ -164,8 +239,7 @@ void NetworkTask::timeout()
         << this->data_->typeString() << "[timed out]"
         << this->data_->request.url().toString();
 
-    this->data_->emitError({NetworkResult::NetworkError::TimeoutError, {}, {}});
-    this->data_->emitFinally();
+    this->emitError({NetworkResult::NetworkError::TimeoutError, {}, {}});
 }
 
 void NetworkTask::finished()
@@ -186,15 +260,20 @@ void NetworkTask::finished()
         qCDebug(chatterinoHTTP).noquote()
             << this->data_->typeString() << "[cancelled]"
             << this->data_->request.url().toString();
+        this->cancelWaiting();
         return;
     }
 
     if (reply->error() != QNetworkReply::NoError)
     {
         this->logReply();
-        this->data_->emitError({reply->error(), status, reply->readAll()});
-        this->data_->emitFinally();
+        this->emitError({reply->error(), status, reply->readAll()});
+        return;
+    }
 
+    if (this->data_->revalidating && status.toInt() == 304)
+    {
+        this->revalidated();
         return;
     }
 
@@ -205,10 +284,9 @@ void NetworkTask::finished()
         this->writeToCache(bytes);
     }
 
-    DebugCount::increase("http request success");
+    REQUEST_SUCCESS_COUNTER.increase();
     this->logReply();
-    this->data_->emitSuccess({reply->error(), status, bytes});
-    this->data_->emitFinally();
+    this->emitSuccess({reply->error(), status, bytes});
 }
 
 }  // namespace chatterino::network::detail
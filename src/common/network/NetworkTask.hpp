@@ -4,12 +4,14 @@
 #include <QTimer>
 
 #include <memory>
+#include <vector>
 
 class QNetworkReply;
 
 namespace chatterino {
 
 class NetworkData;
+class NetworkResult;
 
 }  // namespace chatterino
 
@@ -37,10 +39,25 @@ private:
 
     void logReply();
     void writeToCache(const QByteArray &bytes) const;
+    /// Called when the server confirmed that the stale cached response is
+    /// still valid
+    void revalidated();
+
+    /// Emits @a result to this request and all requests waiting for it
+    void emitSuccess(NetworkResult &&result);
+    /// Emits @a result to this request and all requests waiting for it
+    void emitError(NetworkResult &&result);
+    /// Finishes this request without a result. The requests waiting for it
+    /// weren't cancelled themselves, so they get an OperationCanceledError.
+    void cancelWaiting();
+    /// Tells the scheduler that this request is done. Only the first call
+    /// returns the requests that wait for its result.
+    std::vector<std::shared_ptr<NetworkData>> done();
 
     std::shared_ptr<NetworkData> data_;
     QNetworkReply *reply_{};  // parent: default (accessManager)
     QTimer *timer_{};         // parent: this
+    bool done_ = false;
 
     // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private Q_SLOTS:
@@ -0,0 +1,211 @@
+#include "controllers/completion/sources/EmoteIndex.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "providers/emoji/Emojis.hpp"
+
+#include <algorithm>
+
+namespace chatterino::completion {
+
+namespace {
+
+struct CachedEmoteIndex {
+    std::weak_ptr<const EmoteMap> map;
+    QString providerName;
+    std::shared_ptr<const EmoteIndex> index;
+};
+
+struct CachedEmojiIndex {
+    /// The first emoji - emojis are only ever loaded as a whole
+    std::weak_ptr<EmojiData> first;
+    size_t count = 0;
+    std::shared_ptr<const EmoteIndex> index;
+};
+
+std::vector<CachedEmoteIndex> &emoteIndexCache()
+{
+    static std::vector<CachedEmoteIndex> cache;
+    return cache;
+}
+
+CachedEmojiIndex &emojiIndexCache()
+{
+    static CachedEmojiIndex cache;
+    return cache;
+}
+
+void addEmotes(std::vector<EmoteItem> &out, const EmoteMap &map,
+               const QString &providerName)
+{
+    for (auto &&emote : map)
+    {
+        out.push_back({.emote = emote.second,
+                       .searchName = emote.first.string,
+                       .tabCompletionName = emote.first.string,
+                       .displayName = emote.second->name.string,
+                       .providerName = providerName,
+                       .isEmoji = false});
+    }
+}
+
+void addEmojis(std::vector<EmoteItem> &out, const std::vector<EmojiPtr> &map)
+{
+    for (const auto &emoji : map)
+    {
+        for (auto &&shortCode : emoji->shortCodes)
+        {
+            out.push_back(
+                {.emote = emoji->emote,
+                 .searchName = shortCode,
+                 .tabCompletionName = QStringLiteral(":%1:").arg(shortCode),
+                 .displayName = shortCode,
+                 .providerName = "Emoji",
+                 .isEmoji = true});
+        }
+    };
+}
+
+}  // namespace
+
+EmoteIndex::EmoteIndex(std::vector<EmoteItem> items)
+    : items_(std::move(items))
+{
+    size_t totalLength = 0;
+    this->folded_.reserve(this->items_.size());
+    for (const auto &item : this->items_)
+    {
+        totalLength += static_cast<size_t>(
+            this->folded_.emplace_back(item.searchName.toCaseFolded()).size());
+    }
+
+    this->suffixes_.reserve(totalLength);
+    for (size_t i = 0; i < this->folded_.size(); i++)
+    {
+        auto length = static_cast<uint32_t>(this->folded_[i].size());
+        for (uint32_t offset = 0; offset < length; offset++)
+        {
+            this->suffixes_.push_back({
+                .item = static_cast<uint32_t>(i),
+                .offset = offset,
+            });
+        }
+    }
+
+    std::ranges::sort(this->suffixes_, [this](Suffix a, Suffix b) {
+        return this->suffix(a).compare(this->suffix(b)) < 0;
+    });
+}
+
+std::shared_ptr<const EmoteIndex> EmoteIndex::forEmotes(
+    const std::shared_ptr<const EmoteMap> &map, const QString &providerName)
+{
+    assertInGuiThread();
+
+    auto &cache = emoteIndexCache();
+    // Indices of replaced emote maps aren't needed anymore
+    std::erase_if(cache, [](const auto &cached) {
+        return cached.map.expired();
+    });
+
+    for (const auto &cached : cache)
+    {
+        if (cached.providerName == providerName && cached.map.lock() == map)
+        {
+            return cached.index;
+        }
+    }
+
+    std::vector<EmoteItem> items;
+    items.reserve(map->size());
+    addEmotes(items, *map, providerName);
+
+    auto index = std::make_shared<const EmoteIndex>(std::move(items));
+    cache.push_back({
+        .map = map,
+        .providerName = providerName,
+        .index = index,
+    });
+    return index;
+}
+
+std::shared_ptr<const EmoteIndex> EmoteIndex::forEmojis(
+    const std::vector<EmojiPtr> &emojis)
+{
+    assertInGuiThread();
+
+    auto &cache = emojiIndexCache();
+    std::shared_ptr<EmojiData> first;
+    if (!emojis.empty())
+    {
+        first = emojis.front();
+    }
+
+    if (cache.index && cache.count == emojis.size() &&
+        cache.first.lock() == first)
+    {
+        return cache.index;
+    }
+
+    std::vector<EmoteItem> items;
+    addEmojis(items, emojis);
+
+    cache = {
+        .first = first,
+        .count = emojis.size(),
+        .index = std::make_shared<const EmoteIndex>(std::move(items)),
+    };
+    return cache.index;
+}
+
+const std::vector<EmoteItem> &EmoteIndex::items() const
+{
+    return this->items_;
+}
+
+void EmoteIndex::collect(QStringView foldedQuery,
+                         std::vector<EmoteItem> &out) const
+{
+    if (foldedQuery.isEmpty())
+    {
+        out.insert(out.end(), this->items_.begin(), this->items_.end());
+        return;
+    }
+
+    // All suffixes starting with the query are next to each other
+    auto [first, last] = std::ranges::equal_range(
+        this->suffixes_, foldedQuery,
+        [](QStringView a, QStringView b) {
+            return a.compare(b) < 0;
+        },
+        [&](Suffix s) {
+            return this->suffix(s).left(foldedQuery.size());
+        });
+    if (first == last)
+    {
+        return;
+    }
+
+    // A name can contain the query multiple times
+    std::vector<uint32_t> matches;
+    matches.reserve(static_cast<size_t>(last - first));
+    for (auto it = first; it != last; it++)
+    {
+        matches.push_back(it->item);
+    }
+    std::ranges::sort(matches);
+    auto duplicates = std::ranges::unique(matches);
+    matches.erase(duplicates.begin(), duplicates.end());
+
+    out.reserve(out.size() + matches.size());
+    for (auto i : matches)
+    {
+        out.push_back(this->items_[i]);
+    }
+}
+
+QStringView EmoteIndex::suffix(Suffix s) const
+{
+    return QStringView(this->folded_[s.item]).mid(s.offset);
+}
+
+}  // namespace chatterino::completion
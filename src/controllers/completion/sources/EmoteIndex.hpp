@@ -0,0 +1,74 @@
+#pragma once
+
+#include "controllers/completion/sources/EmoteSource.hpp"
+#include "messages/Emote.hpp"
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+struct EmojiData;
+using EmojiPtr = std::shared_ptr<EmojiData>;
+
+}  // namespace chatterino
+
+namespace chatterino::completion {
+
+/// A case-folded suffix index over the EmoteItems of one emote provider.
+///
+/// Every suffix of every case-folded search name is kept in a sorted array,
+/// so the items containing a query are found with two binary searches
+/// instead of scanning all items.
+///
+/// Indices for emote maps are cached per map snapshot. Since emote maps are
+/// immutable and replaced as a whole, an index is only rebuilt for the
+/// provider whose emotes changed - all other providers (and channels sharing
+/// the same global emotes) reuse their existing index.
+class EmoteIndex
+{
+public:
+    explicit EmoteIndex(std::vector<EmoteItem> items);
+
+    /// Returns the (cached) index for the emotes in @a map
+    ///
+    /// Must only be called from the GUI thread.
+    static std::shared_ptr<const EmoteIndex> forEmotes(
+        const std::shared_ptr<const EmoteMap> &map,
+        const QString &providerName);
+
+    /// Returns the (cached) index for the shortcodes of @a emojis
+    ///
+    /// Must only be called from the GUI thread.
+    static std::shared_ptr<const EmoteIndex> forEmojis(
+        const std::vector<EmojiPtr> &emojis);
+
+    const std::vector<EmoteItem> &items() const;
+
+    /// Appends all items whose search name contains @a foldedQuery to @a out.
+    ///
+    /// The query must already be case-folded (see QString::toCaseFolded).
+    /// Items are appended in the same order as in items(). An empty query
+    /// matches all items.
+    void collect(QStringView foldedQuery, std::vector<EmoteItem> &out) const;
+
+private:
+    struct Suffix {
+        uint32_t item;
+        uint32_t offset;
+    };
+
+    QStringView suffix(Suffix s) const;
+
+    std::vector<EmoteItem> items_;
+    /// Case-folded search names, same order as items_
+    std::vector<QString> folded_;
+    /// Sorted by the suffix they point to
+    std::vector<Suffix> suffixes_;
+};
+
+}  // namespace chatterino::completion
@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/completion/sources/EmoteIndex.hpp"
 #include "controllers/completion/sources/Helpers.hpp"
 #include "controllers/emotes/EmoteController.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
@@ -15,41 +16,6 @@
 
 namespace chatterino::completion {
 
-namespace {
-
-void addEmotes(std::vector<EmoteItem> &out, const EmoteMap &map,
-               const QString &providerName)
-{
-    for (auto &&emote : map)
-    {
-        out.push_back({.emote = emote.second,
-                       .searchName = emote.first.string,
-                       .tabCompletionName = emote.first.string,
-                       .displayName = emote.second->name.string,
-                       .providerName = providerName,
-                       .isEmoji = false});
-    }
-}
-
-void addEmojis(std::vector<EmoteItem> &out, const std::vector<EmojiPtr> &map)
-{
-    for (const auto &emoji : map)
-    {
-        for (auto &&shortCode : emoji->shortCodes)
-        {
-            out.push_back(
-                {.emote = emoji->emote,
-                 .searchName = shortCode,
-                 .tabCompletionName = QStringLiteral(":%1:").arg(shortCode),
-                 .displayName = shortCode,
-                 .providerName = "Emoji",
-                 .isEmoji = true});
-        }
-    };
-}
-
-}  // namespace
-
 EmoteSource::EmoteSource(const Channel *channel,
                          std::unique_ptr<EmoteStrategy> strategy,
                          ActionCallback callback)
@@ -62,10 +28,31 @@ EmoteSource::EmoteSource(const Channel *channel,
 void EmoteSource::update(const QString &query)
 {
     this->output_.clear();
-    if (this->strategy_)
+    if (!this->strategy_)
+    {
+        return;
+    }
+
+    // All strategies only match items containing the query without its
+    // leading ':' and '~' (ignoring case), so only rank those.
+    QStringView needle = query;
+    if (needle.startsWith(u':'))
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        needle = needle.mid(1);
     }
+    if (needle.startsWith(u'~'))
+    {
+        needle = needle.mid(1);
+    }
+    auto foldedNeedle = needle.toString().toCaseFolded();
+
+    std::vector<EmoteItem> candidates;
+    for (const auto &index : this->indices_)
+    {
+        index->collect(foldedNeedle, candidates);
+    }
+
+    this->strategy_->apply(candidates, this->output_, query);
 }
 
 void EmoteSource::addToListModel(GenericListModel &model, size_t maxCount) const
@@ -90,53 +77,41 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
 {
     auto *app = getApp();
 
-    std::vector<EmoteItem> emotes;
+    std::vector<std::shared_ptr<const EmoteIndex>> indices;
+    auto addEmotes = [&](const std::shared_ptr<const EmoteMap> &map,
+                         const QString &providerName) {
+        if (map)
+        {
+            indices.push_back(EmoteIndex::forEmotes(map, providerName));
+        }
+    };
+
     const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
     // returns true also for special Twitch channels (/live, /mentions, /whispers, etc.)
     if (channel->isTwitchChannel())
     {
         if (tc)
         {
-            if (auto twitch = tc->localTwitchEmotes())
-            {
-                addEmotes(emotes, *twitch, "Local Twitch Emotes");
-            }
+            addEmotes(tc->localTwitchEmotes(), "Local Twitch Emotes");
 
             auto user = getApp()->getAccounts()->twitch.getCurrent();
-            addEmotes(emotes, **user->accessEmotes(), "Twitch Emote");
+            addEmotes(*user->accessEmotes(), "Twitch Emote");
 
             // TODO extract "Channel {BetterTTV,7TV,FrankerFaceZ}" text into a #define.
-            if (auto bttv = tc->bttvEmotes())
-            {
-                addEmotes(emotes, *bttv, "Channel BetterTTV");
-            }
-            if (auto ffz = tc->ffzEmotes())
-            {
-                addEmotes(emotes, *ffz, "Channel FrankerFaceZ");
-            }
-            if (auto seventv = tc->seventvEmotes())
-            {
-                addEmotes(emotes, *seventv, "Channel 7TV");
-            }
+            addEmotes(tc->bttvEmotes(), "Channel BetterTTV");
+            addEmotes(tc->ffzEmotes(), "Channel FrankerFaceZ");
+            addEmotes(tc->seventvEmotes(), "Channel 7TV");
         }
 
-        if (auto bttvG = app->getBttvEmotes()->emotes())
-        {
-            addEmotes(emotes, *bttvG, "Global BetterTTV");
-        }
-        if (auto ffzG = app->getFfzEmotes()->emotes())
-        {
-            addEmotes(emotes, *ffzG, "Global FrankerFaceZ");
-        }
-        if (auto seventvG = app->getSeventvEmotes()->globalEmotes())
-        {
-            addEmotes(emotes, *seventvG, "Global 7TV");
-        }
+        addEmotes(app->getBttvEmotes()->emotes(), "Global BetterTTV");
+        addEmotes(app->getFfzEmotes()->emotes(), "Global FrankerFaceZ");
+        addEmotes(app->getSeventvEmotes()->globalEmotes(), "Global 7TV");
     }
 
-    addEmojis(emotes, app->getEmotes()->getEmojis()->getEmojis());
+    indices.push_back(
+        EmoteIndex::forEmojis(app->getEmotes()->getEmojis()->getEmojis()));
 
-    this->items_ = std::move(emotes);
+    this->indices_ = std::move(indices);
 }
 
 const std::vector<EmoteItem> &EmoteSource::output() const
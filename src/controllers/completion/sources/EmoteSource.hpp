@@ -13,6 +13,8 @@
 
 namespace chatterino::completion {
 
+class EmoteIndex;
+
 struct EmoteItem {
     /// Emote image to show in input popup
     EmotePtr emote{};
@@ -56,7 +58,8 @@ private:
     std::unique_ptr<EmoteStrategy> strategy_;
     ActionCallback callback_;
 
-    std::vector<EmoteItem> items_{};
+    /// One index per emote provider, in the order items are completed in
+    std::vector<std::shared_ptr<const EmoteIndex>> indices_{};
     std::vector<EmoteItem> output_{};
 };
 
@@ -58,10 +58,10 @@ bool FilterRecord::valid() const
     return this->filter_ != nullptr;
 }
 
-bool FilterRecord::filter(const filters::ContextMap &context) const
+bool FilterRecord::filter(filters::MessageContext &context) const
 {
     assert(this->valid());
-    return this->filter_->execute(context).toBool();
+    return this->filter_->matches(context);
 }
 
 bool FilterRecord::operator==(const FilterRecord &other) const
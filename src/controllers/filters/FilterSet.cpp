@@ -1,6 +1,7 @@
 #include "controllers/filters/FilterSet.hpp"
 
 #include "controllers/filters/FilterRecord.hpp"
+#include "controllers/filters/lang/MessageContext.hpp"
 #include "singletons/Settings.hpp"
 
 namespace chatterino {
@@ -42,7 +43,7 @@ bool FilterSet::filter(const MessagePtr &m, ChannelPtr channel) const
         return true;
     }
 
-    filters::ContextMap context = filters::buildContextMap(m, channel.get());
+    filters::MessageContext context(m, channel.get());
     for (const auto &f : this->filters_.values())
     {
         if (!f->valid() || !f->filter(context))
@@ -0,0 +1,80 @@
+#include "controllers/filters/lang/CompiledExpression.hpp"
+
+#include "controllers/filters/lang/Types.hpp"
+
+namespace chatterino::filters {
+
+CompiledExpression CompiledExpression::fromConstant(const QVariant &value)
+{
+    CompiledExpression compiled{
+        .evaluator =
+            Evaluator<QVariant>([value](MessageContext & /*context*/) {
+                return value;
+            }),
+        .constant = value,
+    };
+
+    if (variantIs(value, QMetaType::QString))
+    {
+        compiled.evaluator = Evaluator<QString>(
+            [string = value.toString()](MessageContext & /*context*/) {
+                return string;
+            });
+    }
+    else if (variantIs(value, QMetaType::QStringList))
+    {
+        compiled.evaluator = Evaluator<QStringList>(
+            [list = value.toStringList()](MessageContext & /*context*/) {
+                return list;
+            });
+    }
+    else if (variantIs(value, QMetaType::Int))
+    {
+        compiled.evaluator = Evaluator<int>(
+            [integer = value.toInt()](MessageContext & /*context*/) {
+                return integer;
+            });
+    }
+    else if (variantIs(value, QMetaType::Bool))
+    {
+        compiled.evaluator = Evaluator<bool>(
+            [boolean = value.toBool()](MessageContext & /*context*/) {
+                return boolean;
+            });
+    }
+
+    return compiled;
+}
+
+Evaluator<QVariant> CompiledExpression::boxed() const
+{
+    return std::visit(
+        [](const auto &evaluator) -> Evaluator<QVariant> {
+            using T = std::decay_t<decltype(evaluator)>;
+            if constexpr (std::is_same_v<T, Evaluator<QVariant>>)
+            {
+                return evaluator;
+            }
+            else
+            {
+                return [evaluator](MessageContext &context) {
+                    return QVariant::fromValue(evaluator(context));
+                };
+            }
+        },
+        this->evaluator);
+}
+
+Evaluator<bool> CompiledExpression::toBool() const
+{
+    if (const auto *boolean = this->get<bool>())
+    {
+        return *boolean;
+    }
+
+    return [evaluator = this->boxed()](MessageContext &context) {
+        return evaluator(context).toBool();
+    };
+}
+
+}  // namespace chatterino::filters
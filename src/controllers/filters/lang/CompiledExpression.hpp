@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QColor>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <functional>
+#include <optional>
+#include <variant>
+
+namespace chatterino::filters {
+
+class MessageContext;
+
+template <typename T>
+using Evaluator = std::function<T(MessageContext &)>;
+
+/// An expression compiled to a tree of closures.
+///
+/// Expressions whose result has a known C++ type (e.g. `author.name` or
+/// `flags.reply && !flags.automod`) evaluate to that type directly. Only
+/// expressions whose result depends on the runtime types of their operands
+/// evaluate to a QVariant and use the same rules as Expression::execute.
+struct CompiledExpression {
+    std::variant<Evaluator<bool>, Evaluator<int>, Evaluator<QString>,
+                 Evaluator<QStringList>, Evaluator<QColor>,
+                 Evaluator<QVariant>>
+        evaluator;
+
+    /// The value of the expression if it doesn't depend on the message
+    std::optional<QVariant> constant;
+
+    /// Compiles a constant value. Strings, string lists, integers and
+    /// booleans get a typed evaluator.
+    static CompiledExpression fromConstant(const QVariant &value);
+
+    /// Returns the typed evaluator if this expression evaluates to @a T
+    template <typename T>
+    const Evaluator<T> *get() const
+    {
+        return std::get_if<Evaluator<T>>(&this->evaluator);
+    }
+
+    /// Returns an evaluator that boxes the result in a QVariant
+    Evaluator<QVariant> boxed() const;
+
+    /// Returns an evaluator that converts the result to a boolean like
+    /// QVariant::toBool does
+    Evaluator<bool> toBool() const;
+};
+
+}  // namespace chatterino::filters
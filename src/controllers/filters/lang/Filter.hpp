@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/filters/lang/CompiledExpression.hpp"
 #include "controllers/filters/lang/expressions/Expression.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
@@ -24,8 +25,15 @@ namespace chatterino::filters {
 // i.e. if all the variables and operators being used have compatible types.
 extern const QMap<QString, Type> MESSAGE_TYPING_CONTEXT;
 
+/// Builds a map of all identifiers for the message @a m.
+///
+/// Filters don't need this, they read the values they use through a
+/// MessageContext. This is mostly useful to evaluate filters with execute()
+/// for debugging.
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel);
 
+class MessageContext;
+
 class Filter;
 struct FilterError {
     QString message;
@@ -39,7 +47,12 @@ public:
     static FilterResult fromString(const QString &str);
 
     Type returnType() const;
+    /// Evaluates the expression tree with the values in @a context
     QVariant execute(const ContextMap &context) const;
+    /// Evaluates the compiled filter for the message in @a context
+    QVariant execute(MessageContext &context) const;
+    /// Evaluates the compiled filter and converts the result to a boolean
+    bool matches(MessageContext &context) const;
 
     QString filterString() const;
     QString debugString(const TypingContext &context) const;
@@ -49,6 +62,8 @@ private:
 
     ExpressionPtr expression_;
     Type returnType_;
+    CompiledExpression compiled_;
+    Evaluator<bool> predicate_;
 };
 
 }  // namespace chatterino::filters
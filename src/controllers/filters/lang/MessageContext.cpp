@@ -0,0 +1,206 @@
+#include "controllers/filters/lang/MessageContext.hpp"
+
+#include "Application.hpp"
+#include "common/Channel.hpp"
+#include "messages/Message.hpp"
+#include "providers/twitch/ChannelPointReward.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+#include "providers/twitch/TwitchChannel.hpp"
+#include "providers/twitch/TwitchIrcServer.hpp"
+
+#include <QHash>
+
+namespace {
+
+using namespace chatterino;
+using namespace chatterino::filters;
+
+template <typename T, typename Fn>
+CompiledExpression compiled(Fn &&fn)
+{
+    return {.evaluator = Evaluator<T>(std::forward<Fn>(fn))};
+}
+
+CompiledExpression messageFlag(MessageFlag flag)
+{
+    return compiled<bool>([flag](MessageContext &ctx) {
+        return ctx.message().flags.has(flag);
+    });
+}
+
+/// Maps the identifiers in MESSAGE_TYPING_CONTEXT to their compiled form
+const QHash<QString, CompiledExpression> &identifiers()
+{
+    static const QHash<QString, CompiledExpression> identifiers{
+        {"author.badges", compiled<QStringList>([](MessageContext &ctx) {
+             return ctx.badges();
+         })},
+        {"author.color", compiled<QColor>([](MessageContext &ctx) {
+             return ctx.message().usernameColor;
+         })},
+        {"author.name", compiled<QString>([](MessageContext &ctx) {
+             return ctx.message().displayName;
+         })},
+        {"author.user_id", compiled<QString>([](MessageContext &ctx) {
+             return ctx.message().userID;
+         })},
+        {"author.no_color", compiled<bool>([](MessageContext &ctx) {
+             return !ctx.message().usernameColor.isValid();
+         })},
+        {"author.subbed", compiled<bool>([](MessageContext &ctx) {
+             return ctx.subscribed();
+         })},
+        {"author.sub_length", compiled<int>([](MessageContext &ctx) {
+             return ctx.subLength();
+         })},
+
+        {"channel.name", compiled<QString>([](MessageContext &ctx) {
+             return ctx.message().channelName;
+         })},
+        {"channel.watching", compiled<bool>([](MessageContext &ctx) {
+             return ctx.watching();
+         })},
+        {"channel.live", compiled<bool>([](MessageContext &ctx) {
+             return ctx.live();
+         })},
+
+        {"flags.action", messageFlag(MessageFlag::Action)},
+        {"flags.highlighted", messageFlag(MessageFlag::Highlighted)},
+        {"flags.points_redeemed", messageFlag(MessageFlag::RedeemedHighlight)},
+        {"flags.sub_message", messageFlag(MessageFlag::Subscription)},
+        {"flags.system_message", messageFlag(MessageFlag::System)},
+        {"flags.reward_message", messageFlag(MessageFlag::RedeemedChannelPointReward)},
+        {"flags.first_message", messageFlag(MessageFlag::FirstMessage)},
+        {"flags.elevated_message", messageFlag(MessageFlag::ElevatedMessage)},
+        {"flags.hype_chat", messageFlag(MessageFlag::ElevatedMessage)},
+        {"flags.cheer_message", messageFlag(MessageFlag::CheerMessage)},
+        {"flags.whisper", messageFlag(MessageFlag::Whisper)},
+        {"flags.reply", messageFlag(MessageFlag::ReplyMessage)},
+        {"flags.automod", messageFlag(MessageFlag::AutoMod)},
+        {"flags.restricted", messageFlag(MessageFlag::RestrictedMessage)},
+        {"flags.monitored", messageFlag(MessageFlag::MonitoredMessage)},
+        {"flags.shared", messageFlag(MessageFlag::SharedMessage)},
+        {"flags.similar", messageFlag(MessageFlag::Similar)},
+
+        {"message.content", compiled<QString>([](MessageContext &ctx) {
+             return ctx.message().messageText;
+         })},
+        {"message.length", compiled<int>([](MessageContext &ctx) {
+             return static_cast<int>(ctx.message().messageText.length());
+         })},
+
+        {"reward.title", compiled<QString>([](MessageContext &ctx) {
+             const auto &reward = ctx.message().reward;
+             return reward ? reward->title : QString();
+         })},
+        {"reward.cost", compiled<int>([](MessageContext &ctx) {
+             const auto &reward = ctx.message().reward;
+             return reward ? reward->cost : -1;
+         })},
+        {"reward.id", compiled<QString>([](MessageContext &ctx) {
+             const auto &reward = ctx.message().reward;
+             return reward ? reward->id : QString();
+         })},
+    };
+    return identifiers;
+}
+
+}  // namespace
+
+namespace chatterino::filters {
+
+MessageContext::MessageContext(const MessagePtr &message, Channel *channel)
+    : message_(*message)
+    , channel_(channel)
+{
+}
+
+const Message &MessageContext::message() const
+{
+    return this->message_;
+}
+
+const QStringList &MessageContext::badges()
+{
+    if (!this->badges_)
+    {
+        QStringList badges;
+        badges.reserve(this->message_.badges.size());
+        for (const auto &e : this->message_.badges)
+        {
+            badges << e.key_;
+        }
+        this->badges_ = std::move(badges);
+    }
+    return *this->badges_;
+}
+
+bool MessageContext::subscribed()
+{
+    this->loadSubscription();
+    return *this->subscribed_;
+}
+
+int MessageContext::subLength()
+{
+    this->loadSubscription();
+    return this->subLength_;
+}
+
+bool MessageContext::watching()
+{
+    if (!this->watching_)
+    {
+        auto watchingChannel =
+            getApp()->getTwitch()->getWatchingChannel().get();
+        this->watching_ = !watchingChannel->getName().isEmpty() &&
+                          watchingChannel->getName().compare(
+                              this->message_.channelName,
+                              Qt::CaseInsensitive) == 0;
+    }
+    return *this->watching_;
+}
+
+bool MessageContext::live()
+{
+    auto *tc = dynamic_cast<TwitchChannel *>(this->channel_);
+    return this->channel_ && !this->channel_->isEmpty() && tc && tc->isLive();
+}
+
+void MessageContext::loadSubscription()
+{
+    if (this->subscribed_)
+    {
+        return;
+    }
+
+    this->subscribed_ = false;
+    for (const auto &subBadge : {"subscriber", "founder"})
+    {
+        if (!this->badges().contains(subBadge))
+        {
+            continue;
+        }
+        this->subscribed_ = true;
+        auto it = this->message_.badgeInfos.find(subBadge);
+        if (it != this->message_.badgeInfos.end())
+        {
+            this->subLength_ = it->second.toInt();
+        }
+    }
+}
+
+CompiledExpression compileIdentifier(const QString &identifier)
+{
+    auto it = identifiers().find(identifier);
+    if (it != identifiers().end())
+    {
+        return it.value();
+    }
+
+    return {.evaluator = Evaluator<QVariant>([](MessageContext & /*ctx*/) {
+                return QVariant();
+            })};
+}
+
+}  // namespace chatterino::filters
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "controllers/filters/lang/CompiledExpression.hpp"
+
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <optional>
+
+namespace chatterino {
+
+class Channel;
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+}  // namespace chatterino
+
+namespace chatterino::filters {
+
+/// The values of the filter identifiers for one message.
+///
+/// Values that need some work to compute (e.g. `author.badges`) are computed
+/// the first time a filter reads them and are shared between all filters
+/// evaluated with this context.
+class MessageContext
+{
+public:
+    MessageContext(const MessagePtr &message, Channel *channel);
+
+    const Message &message() const;
+
+    /// author.badges
+    const QStringList &badges();
+    /// author.subbed
+    bool subscribed();
+    /// author.sub_length
+    int subLength();
+    /// channel.watching
+    bool watching();
+    /// channel.live
+    bool live();
+
+private:
+    void loadSubscription();
+
+    const Message &message_;
+    Channel *channel_;
+
+    std::optional<QStringList> badges_;
+    std::optional<bool> subscribed_;
+    int subLength_ = 0;
+    std::optional<bool> watching_;
+};
+
+/// Compiles a reference to the filter identifier @a identifier (e.g.
+/// `author.name`).
+///
+/// Unknown identifiers evaluate to an invalid QVariant.
+CompiledExpression compileIdentifier(const QString &identifier);
+
+}  // namespace chatterino::filters
@@ -2,8 +2,13 @@
 
 #include <QRegularExpression>
 
+#include <functional>
+#include <optional>
+
 namespace {
 
+using namespace chatterino::filters;
+
 /// Loosely compares `lhs` with `rhs`.
 /// This attempts to convert both variants to a common type if they're not equal.
 bool looselyCompareVariants(QVariant &lhs, QVariant &rhs)
@@ -37,23 +42,10 @@ bool looselyCompareVariants(QVariant &lhs, QVariant &rhs)
     return lhs == rhs;
 }
 
-}  // namespace
-
-namespace chatterino::filters {
-
-BinaryOperation::BinaryOperation(TokenType op, ExpressionPtr left,
-                                 ExpressionPtr right)
-    : op_(op)
-    , left_(std::move(left))
-    , right_(std::move(right))
-{
-}
-
-QVariant BinaryOperation::execute(const ContextMap &context) const
+/// Applies @a op to two dynamically typed values
+QVariant evaluate(TokenType op, QVariant left, QVariant right)
 {
-    auto left = this->left_->execute(context);
-    auto right = this->right_->execute(context);
-    switch (this->op_)
+    switch (op)
     {
         case PLUS:
             if (variantIs(left, QMetaType::QString) &&
@@ -269,6 +261,307 @@ QVariant BinaryOperation::execute(const ContextMap &context) const
     }
 }
 
+/// Combines two typed evaluators with @a fn
+template <typename R, typename L, typename Rhs, typename Fn>
+CompiledExpression combine(const Evaluator<L> &left, const Evaluator<Rhs> &right,
+                           Fn fn)
+{
+    return {.evaluator = Evaluator<R>(
+                [left, right, fn](MessageContext &context) -> R {
+                    return fn(left(context), right(context));
+                })};
+}
+
+/// Compiles @a op for operands whose types are known at compile time.
+///
+/// The results must match evaluate() for the same operands. Returns
+/// std::nullopt if the operand types have no typed implementation.
+std::optional<CompiledExpression> compileTyped(TokenType op,
+                                               const CompiledExpression &left,
+                                               const CompiledExpression &right)
+{
+    const auto *leftString = left.get<QString>();
+    const auto *rightString = right.get<QString>();
+    const auto *leftInt = left.get<int>();
+    const auto *rightInt = right.get<int>();
+    const auto *leftBool = left.get<bool>();
+    const auto *rightBool = right.get<bool>();
+    const auto *leftList = left.get<QStringList>();
+
+    switch (op)
+    {
+        case PLUS:
+            if (leftString && rightString)
+            {
+                return combine<QString>(*leftString, *rightString,
+                                        [](QString a, const QString &b) {
+                                            return a.append(b);
+                                        });
+            }
+            if (leftString && rightInt)
+            {
+                return combine<QString>(*leftString, *rightInt,
+                                        [](QString a, int b) {
+                                            return a.append(QString::number(b));
+                                        });
+            }
+            if (leftString && rightBool)
+            {
+                return combine<QString>(
+                    *leftString, *rightBool, [](QString a, bool b) {
+                        return a.append(b ? QStringLiteral("true")
+                                          : QStringLiteral("false"));
+                    });
+            }
+            if (leftInt && rightInt)
+            {
+                return combine<int>(*leftInt, *rightInt, std::plus<>{});
+            }
+            break;
+        case MINUS:
+            if (leftInt && rightInt)
+            {
+                return combine<int>(*leftInt, *rightInt, std::minus<>{});
+            }
+            break;
+        case MULTIPLY:
+            if (leftInt && rightInt)
+            {
+                return combine<int>(*leftInt, *rightInt, std::multiplies<>{});
+            }
+            break;
+        case DIVIDE:
+            if (leftInt && rightInt)
+            {
+                return combine<int>(*leftInt, *rightInt, std::divides<>{});
+            }
+            break;
+        case MOD:
+            if (leftInt && rightInt)
+            {
+                return combine<int>(*leftInt, *rightInt, std::modulus<>{});
+            }
+            break;
+        case OR:
+            if (leftBool && rightBool)
+            {
+                return CompiledExpression{
+                    .evaluator = Evaluator<bool>(
+                        [lhs = *leftBool,
+                         rhs = *rightBool](MessageContext &context) {
+                            return lhs(context) || rhs(context);
+                        }),
+                };
+            }
+            break;
+        case AND:
+            if (leftBool && rightBool)
+            {
+                return CompiledExpression{
+                    .evaluator = Evaluator<bool>(
+                        [lhs = *leftBool,
+                         rhs = *rightBool](MessageContext &context) {
+                            return lhs(context) && rhs(context);
+                        }),
+                };
+            }
+            break;
+        case EQ:
+        case NEQ: {
+            const bool eq = op == EQ;
+            if (leftString && rightString)
+            {
+                return combine<bool>(
+                    *leftString, *rightString,
+                    [eq](const QString &a, const QString &b) {
+                        return (a.compare(b, Qt::CaseInsensitive) == 0) == eq;
+                    });
+            }
+            if (leftInt && rightInt)
+            {
+                return combine<bool>(*leftInt, *rightInt, [eq](int a, int b) {
+                    return (a == b) == eq;
+                });
+            }
+            if (leftBool && rightBool)
+            {
+                return combine<bool>(*leftBool, *rightBool,
+                                     [eq](bool a, bool b) {
+                                         return (a == b) == eq;
+                                     });
+            }
+        }
+        break;
+        case LT:
+            if (leftInt && rightInt)
+            {
+                return combine<bool>(*leftInt, *rightInt, std::less<>{});
+            }
+            break;
+        case GT:
+            if (leftInt && rightInt)
+            {
+                return combine<bool>(*leftInt, *rightInt, std::greater<>{});
+            }
+            break;
+        case LTE:
+            if (leftInt && rightInt)
+            {
+                return combine<bool>(*leftInt, *rightInt, std::less_equal<>{});
+            }
+            break;
+        case GTE:
+            if (leftInt && rightInt)
+            {
+                return combine<bool>(*leftInt, *rightInt,
+                                     std::greater_equal<>{});
+            }
+            break;
+        case CONTAINS:
+            if (leftList && rightString)
+            {
+                return combine<bool>(
+                    *leftList, *rightString,
+                    [](const QStringList &list, const QString &string) {
+                        return list.contains(string, Qt::CaseInsensitive);
+                    });
+            }
+            if (leftString && rightString)
+            {
+                return combine<bool>(
+                    *leftString, *rightString,
+                    [](const QString &a, const QString &b) {
+                        return a.contains(b, Qt::CaseInsensitive);
+                    });
+            }
+            break;
+        case STARTS_WITH:
+            if (leftList && rightString)
+            {
+                return combine<bool>(
+                    *leftList, *rightString,
+                    [](const QStringList &list, const QString &string) {
+                        return !list.isEmpty() &&
+                               list.first().compare(
+                                   string, Qt::CaseInsensitive) == 0;
+                    });
+            }
+            if (leftString && rightString)
+            {
+                return combine<bool>(
+                    *leftString, *rightString,
+                    [](const QString &a, const QString &b) {
+                        return a.startsWith(b, Qt::CaseInsensitive);
+                    });
+            }
+            break;
+        case ENDS_WITH:
+            if (leftList && rightString)
+            {
+                return combine<bool>(
+                    *leftList, *rightString,
+                    [](const QStringList &list, const QString &string) {
+                        return !list.isEmpty() &&
+                               list.last().compare(
+                                   string, Qt::CaseInsensitive) == 0;
+                    });
+            }
+            if (leftString && rightString)
+            {
+                return combine<bool>(
+                    *leftString, *rightString,
+                    [](const QString &a, const QString &b) {
+                        return a.endsWith(b, Qt::CaseInsensitive);
+                    });
+            }
+            break;
+        case MATCH: {
+            if (!leftString || !right.constant)
+            {
+                break;
+            }
+
+            const auto &specifier = *right.constant;
+            if (variantIs(specifier, QMetaType::QRegularExpression))
+            {
+                return CompiledExpression{
+                    .evaluator = Evaluator<bool>(
+                        [lhs = *leftString,
+                         regex = specifier.toRegularExpression()](
+                            MessageContext &context) {
+                            return regex.match(lhs(context)).hasMatch();
+                        }),
+                };
+            }
+
+            if (variantIs(specifier, QMetaType::QVariantList))
+            {
+                auto list = specifier.toList();
+                if (list.size() != 2 ||
+                    variantIsNot(list.at(0), QMetaType::QRegularExpression) ||
+                    variantIsNot(list.at(1), QMetaType::Int))
+                {
+                    break;
+                }
+
+                return CompiledExpression{
+                    .evaluator = Evaluator<QString>(
+                        [lhs = *leftString,
+                         regex = list.at(0).toRegularExpression(),
+                         group = list.at(1).toInt()](MessageContext &context) {
+                            auto match = regex.match(lhs(context));
+                            if (match.hasMatch())
+                            {
+                                return match.captured(group);
+                            }
+                            return QString();
+                        }),
+                };
+            }
+        }
+        break;
+        default:
+            break;
+    }
+
+    return std::nullopt;
+}
+
+}  // namespace
+
+namespace chatterino::filters {
+
+BinaryOperation::BinaryOperation(TokenType op, ExpressionPtr left,
+                                 ExpressionPtr right)
+    : op_(op)
+    , left_(std::move(left))
+    , right_(std::move(right))
+{
+}
+
+QVariant BinaryOperation::execute(const ContextMap &context) const
+{
+    return evaluate(this->op_, this->left_->execute(context),
+                    this->right_->execute(context));
+}
+
+CompiledExpression BinaryOperation::compile() const
+{
+    auto left = this->left_->compile();
+    auto right = this->right_->compile();
+
+    if (auto typed = compileTyped(this->op_, left, right))
+    {
+        return *std::move(typed);
+    }
+
+    return {.evaluator = Evaluator<QVariant>(
+                [op = this->op_, lhs = left.boxed(),
+                 rhs = right.boxed()](MessageContext &context) {
+                    return evaluate(op, lhs(context), rhs(context));
+                })};
+}
+
 PossibleType BinaryOperation::synthesizeType(const TypingContext &context) const
 {
     auto leftSyn = this->left_->synthesizeType(context);
@@ -11,6 +11,7 @@ public:
     BinaryOperation(TokenType op, ExpressionPtr left, ExpressionPtr right);
 
     QVariant execute(const ContextMap &context) const override;
+    CompiledExpression compile() const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
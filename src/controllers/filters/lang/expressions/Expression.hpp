@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/filters/lang/CompiledExpression.hpp"
 #include "controllers/filters/lang/Tokenizer.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
@@ -17,6 +18,7 @@ public:
     virtual ~Expression() = default;
 
     virtual QVariant execute(const ContextMap &context) const = 0;
+    virtual CompiledExpression compile() const = 0;
     virtual PossibleType synthesizeType(const TypingContext &context) const = 0;
     virtual QString debug(const TypingContext &context) const = 0;
     virtual QString filterString() const = 0;
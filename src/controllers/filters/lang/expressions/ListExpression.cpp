@@ -1,5 +1,32 @@
 #include "controllers/filters/lang/expressions/ListExpression.hpp"
 
+namespace {
+
+using namespace chatterino::filters;
+
+/// Returns a QStringList if all @a values are strings (for case-insensitive
+/// comparisons) and the list itself otherwise
+QVariant makeList(QList<QVariant> values)
+{
+    for (const auto &value : values)
+    {
+        if (variantIsNot(value, QMetaType::QString))
+        {
+            return values;
+        }
+    }
+
+    QStringList strings;
+    strings.reserve(values.size());
+    for (const auto &value : values)
+    {
+        strings << value.toString();
+    }
+    return strings;
+}
+
+}  // namespace
+
 namespace chatterino::filters {
 
 ListExpression::ListExpression(ExpressionList &&list)
@@ -8,30 +35,76 @@ ListExpression::ListExpression(ExpressionList &&list)
 QVariant ListExpression::execute(const ContextMap &context) const
 {
     QList<QVariant> results;
+    results.reserve(static_cast<qsizetype>(this->list_.size()));
+    for (const auto &exp : this->list_)
+    {
+        results.append(exp->execute(context));
+    }
+
+    return makeList(std::move(results));
+}
+
+CompiledExpression ListExpression::compile() const
+{
+    std::vector<CompiledExpression> items;
+    items.reserve(this->list_.size());
+    bool allConstant = true;
     bool allStrings = true;
     for (const auto &exp : this->list_)
     {
-        auto res = exp->execute(context);
-        if (allStrings && variantIsNot(res, QMetaType::QString))
+        auto item = exp->compile();
+        allConstant = allConstant && item.constant.has_value();
+        allStrings = allStrings && item.get<QString>() != nullptr;
+        items.emplace_back(std::move(item));
+    }
+
+    if (allConstant)
+    {
+        QList<QVariant> values;
+        values.reserve(static_cast<qsizetype>(items.size()));
+        for (const auto &item : items)
         {
-            allStrings = false;
+            values.append(*item.constant);
         }
-        results.append(res);
+        return CompiledExpression::fromConstant(makeList(std::move(values)));
     }
 
-    // if everything is a string return a QStringList for case-insensitive comparison
     if (allStrings)
     {
-        QStringList strings;
-        strings.reserve(results.size());
-        for (const auto &val : results)
+        std::vector<Evaluator<QString>> strings;
+        strings.reserve(items.size());
+        for (const auto &item : items)
         {
-            strings << val.toString();
+            strings.emplace_back(*item.get<QString>());
         }
-        return strings;
+        return {.evaluator = Evaluator<QStringList>(
+                    [strings = std::move(strings)](MessageContext &context) {
+                        QStringList list;
+                        list.reserve(static_cast<qsizetype>(strings.size()));
+                        for (const auto &string : strings)
+                        {
+                            list.append(string(context));
+                        }
+                        return list;
+                    })};
     }
 
-    return results;
+    std::vector<Evaluator<QVariant>> values;
+    values.reserve(items.size());
+    for (const auto &item : items)
+    {
+        values.emplace_back(item.boxed());
+    }
+    return {.evaluator = Evaluator<QVariant>(
+                [values = std::move(values)](MessageContext &context) {
+                    QList<QVariant> list;
+                    list.reserve(static_cast<qsizetype>(values.size()));
+                    for (const auto &value : values)
+                    {
+                        list.append(value(context));
+                    }
+                    return makeList(std::move(list));
+                })};
 }
 
 PossibleType ListExpression::synthesizeType(const TypingContext &context) const
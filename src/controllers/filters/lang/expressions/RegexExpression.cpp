@@ -14,6 +14,11 @@ QVariant RegexExpression::execute(const ContextMap & /*context*/) const
     return this->regex_;
 }
 
+CompiledExpression RegexExpression::compile() const
+{
+    return CompiledExpression::fromConstant(this->regex_);
+}
+
 PossibleType RegexExpression::synthesizeType(
     const TypingContext & /*context*/) const
 {
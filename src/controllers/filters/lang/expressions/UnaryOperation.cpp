@@ -20,6 +20,29 @@ QVariant UnaryOperation::execute(const ContextMap &context) const
     }
 }
 
+CompiledExpression UnaryOperation::compile() const
+{
+    auto right = this->right_->compile();
+    switch (this->op_)
+    {
+        case NOT:
+            if (const auto *boolean = right.get<bool>())
+            {
+                return {.evaluator = Evaluator<bool>(
+                            [operand = *boolean](MessageContext &context) {
+                                return !operand(context);
+                            })};
+            }
+            return {.evaluator = Evaluator<bool>(
+                        [operand = right.boxed()](MessageContext &context) {
+                            auto value = operand(context);
+                            return value.canConvert<bool>() && !value.toBool();
+                        })};
+        default:
+            return CompiledExpression::fromConstant(false);
+    }
+}
+
 PossibleType UnaryOperation::synthesizeType(const TypingContext &context) const
 {
     auto rightSyn = this->right_->synthesizeType(context);
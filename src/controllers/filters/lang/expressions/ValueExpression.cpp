@@ -1,5 +1,6 @@
 #include "controllers/filters/lang/expressions/ValueExpression.hpp"
 
+#include "controllers/filters/lang/MessageContext.hpp"
 #include "controllers/filters/lang/Tokenizer.hpp"
 
 namespace chatterino::filters {
@@ -19,6 +20,15 @@ QVariant ValueExpression::execute(const ContextMap &context) const
     return this->value_;
 }
 
+CompiledExpression ValueExpression::compile() const
+{
+    if (this->type_ == TokenType::IDENTIFIER)
+    {
+        return compileIdentifier(this->value_.toString());
+    }
+    return CompiledExpression::fromConstant(this->value_);
+}
+
 PossibleType ValueExpression::synthesizeType(const TypingContext &context) const
 {
     switch (this->type_)
@@ -12,6 +12,7 @@ public:
     TokenType type();
 
     QVariant execute(const ContextMap &context) const override;
+    CompiledExpression compile() const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
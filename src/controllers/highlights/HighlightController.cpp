@@ -13,45 +13,131 @@
 #include "providers/twitch/TwitchAccount.hpp"  // IWYU pragma: keep
 #include "providers/twitch/TwitchBadge.hpp"
 #include "singletons/Settings.hpp"
+#include "util/PhraseMatcher.hpp"
+
+#include <memory>
 
 namespace {
 
 using namespace chatterino;
 
-auto highlightPhraseCheck(const HighlightPhrase &highlight) -> HighlightCheck
+/// Merges @a from into @a into. Flags are combined, the sound and color of
+/// @a into take precedence.
+void mergeHighlightResult(HighlightResult &into, const HighlightResult &from)
 {
-    return HighlightCheck{
-        [highlight](const auto &args, const auto &badges,
-                    const auto &senderName, const auto &originalMessage,
-                    const auto &flags,
-                    const auto self) -> std::optional<HighlightResult> {
-            (void)args;        // unused
-            (void)badges;      // unused
-            (void)senderName;  // unused
-            (void)flags;       // unused
+    if (from.alert)
+    {
+        if (!into.alert)
+        {
+            into.alert = from.alert;
+        }
+    }
+
+    if (from.playSound)
+    {
+        if (!into.playSound)
+        {
+            into.playSound = from.playSound;
+        }
+    }
+
+    if (from.customSoundUrl)
+    {
+        if (!into.customSoundUrl)
+        {
+            into.customSoundUrl = from.customSoundUrl;
+        }
+    }
+
+    if (from.color)
+    {
+        if (!into.color)
+        {
+            into.color = from.color;
+        }
+    }
+
+    if (from.showInMentions)
+    {
+        if (!into.showInMentions)
+        {
+            into.showInMentions = from.showInMentions;
+        }
+    }
+}
+
+HighlightResult phraseResult(const HighlightPhrase &highlight)
+{
+    std::optional<QUrl> highlightSoundUrl;
+    if (highlight.hasCustomSound())
+    {
+        highlightSoundUrl = highlight.getSoundUrl();
+    }
+
+    return HighlightResult{
+        highlight.hasAlert(),       highlight.hasSound(),
+        highlightSoundUrl,          highlight.getColor(),
+        highlight.showInMentions(),
+    };
+}
 
+/// Checks all message phrases with one pass over the message.
+///
+/// The matcher finds the phrases whose text occurs in the message, which are
+/// then checked in order with their own (word boundary) rules. Regex phrases
+/// are always checked.
+auto highlightPhrasesCheck(std::vector<HighlightPhrase> phrases)
+    -> HighlightCheck
+{
+    auto matcher = std::make_shared<PhraseMatcher>();
+    for (const auto &highlight : phrases)
+    {
+        if (highlight.isRegex())
+        {
+            matcher->addUnindexed();
+        }
+        else
+        {
+            matcher->addLiteral(highlight.getPattern());
+        }
+    }
+    matcher->build();
+
+    return HighlightCheck{
+        [phrases = std::move(phrases), matcher](
+            const auto & /*args*/, const auto & /*badges*/,
+            const auto & /*senderName*/, const auto &originalMessage,
+            const auto & /*flags*/,
+            const auto self) -> std::optional<HighlightResult> {
             if (self)
             {
                 // Phrase checks should ignore highlights from the user
                 return std::nullopt;
             }
 
-            if (!highlight.isMatch(originalMessage))
+            std::optional<HighlightResult> result;
+            for (auto i : matcher->candidates(originalMessage))
             {
-                return std::nullopt;
-            }
+                const auto &highlight = phrases[i];
+                if (!highlight.isMatch(originalMessage))
+                {
+                    continue;
+                }
 
-            std::optional<QUrl> highlightSoundUrl;
-            if (highlight.hasCustomSound())
-            {
-                highlightSoundUrl = highlight.getSoundUrl();
+                if (!result)
+                {
+                    result = phraseResult(highlight);
+                    continue;
+                }
+
+                mergeHighlightResult(*result, phraseResult(highlight));
+                if (result->full())
+                {
+                    break;
+                }
             }
 
-            return HighlightResult{
-                highlight.hasAlert(),       highlight.hasSound(),
-                highlightSoundUrl,          highlight.getColor(),
-                highlight.showInMentions(),
-            };
+            return result;
         }};
 }
 
@@ -187,23 +273,26 @@ void rebuildMessageHighlights(Settings &settings,
     auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
     QString currentUsername = currentUser->getUserName();
 
+    std::vector<HighlightPhrase> phrases;
+
     if (settings.enableSelfHighlight && !currentUsername.isEmpty() &&
         !currentUser->isAnon())
     {
-        HighlightPhrase highlight(
+        phrases.emplace_back(
             currentUsername, settings.showSelfHighlightInMentions,
             settings.enableSelfHighlightTaskbar,
             settings.enableSelfHighlightSound, false, false,
             settings.selfHighlightSoundUrl.getValue(),
             ColorProvider::instance().color(ColorType::SelfHighlight));
-
-        checks.emplace_back(highlightPhraseCheck(highlight));
     }
 
     auto messageHighlights = settings.highlightedMessages.readOnly();
-    for (const auto &highlight : *messageHighlights)
+    phrases.insert(phrases.end(), messageHighlights->begin(),
+                   messageHighlights->end());
+
+    if (!phrases.empty())
     {
-        checks.emplace_back(highlightPhraseCheck(highlight));
+        checks.emplace_back(highlightPhrasesCheck(std::move(phrases)));
     }
 
     if (settings.enableAutomodHighlight)
@@ -481,45 +570,7 @@ std::pair<bool, HighlightResult> HighlightController::check(
         {
             highlighted = true;
 
-            if (checkResult->alert)
-            {
-                if (!result.alert)
-                {
-                    result.alert = checkResult->alert;
-                }
-            }
-
-            if (checkResult->playSound)
-            {
-                if (!result.playSound)
-                {
-                    result.playSound = checkResult->playSound;
-                }
-            }
-
-            if (checkResult->customSoundUrl)
-            {
-                if (!result.customSoundUrl)
-                {
-                    result.customSoundUrl = checkResult->customSoundUrl;
-                }
-            }
-
-            if (checkResult->color)
-            {
-                if (!result.color)
-                {
-                    result.color = checkResult->color;
-                }
-            }
-
-            if (checkResult->showInMentions)
-            {
-                if (!result.showInMentions)
-                {
-                    result.showInMentions = checkResult->showInMentions;
-                }
-            }
+            mergeHighlightResult(result, *checkResult);
 
             if (result.full())
             {
@@ -8,11 +8,56 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
 #include "singletons/Settings.hpp"
+#include "util/PhraseMatcher.hpp"
+
+#include <memory>
+#include <mutex>
 
 namespace {
 
+using namespace chatterino;
 using namespace chatterino::literals;
 
+/// The ignored phrases from the settings with a matcher over their patterns
+struct CompiledIgnorePhrases {
+    std::shared_ptr<const std::vector<IgnorePhrase>> phrases;
+    PhraseMatcher matcher;
+};
+
+/// Returns the compiled form of the current ignored phrases. It's rebuilt
+/// when the phrases in the settings change.
+std::shared_ptr<const CompiledIgnorePhrases> compiledIgnorePhrases()
+{
+    static std::mutex mutex;
+    static std::shared_ptr<const CompiledIgnorePhrases> compiled;
+
+    auto phrases = getSettings()->ignoredMessages.readOnly();
+
+    std::lock_guard lock(mutex);
+    if (compiled && compiled->phrases == phrases)
+    {
+        return compiled;
+    }
+
+    auto next = std::make_shared<CompiledIgnorePhrases>();
+    next->phrases = phrases;
+    for (const auto &phrase : *phrases)
+    {
+        if (phrase.isRegex())
+        {
+            next->matcher.addUnindexed();
+        }
+        else
+        {
+            next->matcher.addLiteral(phrase.getPattern());
+        }
+    }
+    next->matcher.build();
+
+    compiled = std::move(next);
+    return compiled;
+}
+
 /**
   * Computes (only) the replacement of @a match in @a source.
   * The parts before and after the match in @a source are ignored.
@@ -136,9 +181,10 @@ bool isIgnoredMessage(IgnoredMessageParameters &&params)
     if (!params.message.isEmpty())
     {
         // TODO(pajlada): Do we need to check if the phrase is valid first?
-        auto phrases = getSettings()->ignoredMessages.readOnly();
-        for (const auto &phrase : *phrases)
+        auto compiled = compiledIgnorePhrases();
+        for (auto i : compiled->matcher.candidates(params.message))
         {
+            const auto &phrase = (*compiled->phrases)[i];
             if (phrase.isBlock() && phrase.isMatch(params.message))
             {
                 qCDebug(chatterinoMessage)
@@ -269,8 +315,23 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
         }
     };
 
+    // Phrases whose pattern doesn't occur in the content can be skipped, as
+    // long as no replacement changed the content
+    std::vector<size_t> candidates;
+    auto nextCandidate = candidates.cend();
+    bool useCandidates = false;
+    auto compiled = compiledIgnorePhrases();
+    if (&phrases == compiled->phrases.get())
+    {
+        candidates = compiled->matcher.candidates(content);
+        nextCandidate = candidates.cbegin();
+        useCandidates = true;
+    }
+
     auto replaceMessageAt = [&](const IgnorePhrase &phrase, SizeType from,
                                 SizeType length, const QString &replacement) {
+        useCandidates = false;
+
         auto removedEmotes = removeEmotesInRange(from, length);
         content.replace(from, length, replacement);
         auto wordStart = from;
@@ -325,8 +386,18 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
         addReplEmotes(phrase, midExtendedRef, wordStart);
     };
 
-    for (const auto &phrase : phrases)
+    for (size_t i = 0; i < phrases.size(); i++)
     {
+        const auto &phrase = phrases[i];
+        if (useCandidates)
+        {
+            if (nextCandidate == candidates.cend() || *nextCandidate != i)
+            {
+                continue;
+            }
+            ++nextCandidate;
+        }
+
         if (phrase.isBlock())
         {
             continue;
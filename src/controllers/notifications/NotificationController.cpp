@@ -187,36 +187,24 @@ void NotificationController::fetchFakeChannels()
         }
     }
 
-    for (const auto &batch : splitListIntoBatches(channels))
+    // Helix batches the lookups of multiple streams
+    for (const auto &name : channels)
     {
-        getHelix()->fetchStreams(
-            {}, batch,
-            [batch, this](const auto &streams) {
-                std::map<QString, std::optional<HelixStream>,
-                         QCompareCaseInsensitive>
-                    liveStreams;
-                for (const auto &stream : streams)
+        getHelix()->getStreamByName(
+            name,
+            [this, name](bool isLive, const auto &stream) {
+                if (isLive)
                 {
-                    liveStreams.emplace(stream.userLogin, stream);
+                    this->updateFakeChannel(name, stream);
                 }
-
-                for (const auto &name : batch)
+                else
                 {
-                    auto it = liveStreams.find(name);
-                    if (it == liveStreams.end())
-                    {
-                        this->updateFakeChannel(name, std::nullopt);
-                    }
-                    else
-                    {
-                        this->updateFakeChannel(name, it->second);
-                    }
+                    this->updateFakeChannel(name, std::nullopt);
                 }
             },
-            [batch]() {
-                // we done fucked up.
+            [name]() {
                 qCWarning(chatterinoNotification)
-                    << "Failed to fetch live status for " << batch;
+                    << "Failed to fetch live status for" << name;
             },
             []() {
                 // finally
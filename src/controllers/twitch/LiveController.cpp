@@ -3,7 +3,6 @@
 #include "common/QLogging.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
-#include "util/Helpers.hpp"
 
 #include <QDebug>
 
@@ -88,100 +87,36 @@ void TwitchLiveController::request(std::optional<QStringList> optChannelIDs)
         return;
     }
 
-    auto batches =
-        splitListIntoBatches(channelIDs, TwitchLiveController::BATCH_SIZE);
+    qCDebug(LOG) << "Check" << channelIDs.size() << "channels";
 
-    qCDebug(LOG) << "Make" << batches.size() << "requests";
-
-    for (const auto &batch : batches)
+    // Helix batches the lookups of multiple channels
+    for (const auto &channelID : channelIDs)
     {
-        // TODO: Explore making this concurrent
-        getHelix()->fetchStreams(
-            batch, {},
-            [this, batch{batch}](const auto &streams) {
-                std::unordered_map<QString, std::optional<HelixStream>> results;
-
-                for (const auto &channelID : batch)
-                {
-                    results[channelID] = std::nullopt;
-                }
-
-                for (const auto &stream : streams)
-                {
-                    results[stream.userId] = stream;
-                }
-
-                QStringList deadChannels;
-
-                {
-                    std::shared_lock lock(this->channelsMutex);
-                    for (const auto &result : results)
-                    {
-                        auto it = this->channels.find(result.first);
-                        if (it != channels.end())
-                        {
-                            if (auto channel = it->second.ptr.lock(); channel)
-                            {
-                                channel->updateStreamStatus(
-                                    result.second, !it->second.wasChecked);
-                                it->second.wasChecked = true;
-                            }
-                            else
-                            {
-                                deadChannels.append(result.first);
-                            }
-                        }
-                    }
-                }
-
-                if (!deadChannels.isEmpty())
+        getHelix()->getStreamById(
+            channelID,
+            [this, channelID](bool isLive, const auto &stream) {
+                std::optional<HelixStream> result;
+                if (isLive)
                 {
-                    std::unique_lock lock(this->channelsMutex);
-                    for (const auto &deadChannel : deadChannels)
-                    {
-                        this->channels.erase(deadChannel);
-                    }
+                    result = stream;
                 }
+                this->withChannel(channelID, [&](auto &entry, auto &channel) {
+                    channel.updateStreamStatus(result, !entry.wasChecked);
+                    entry.wasChecked = true;
+                });
             },
             [] {
                 qCWarning(LOG) << "Failed stream check request";
             },
             [] {});
 
-        // TODO: Explore making this concurrent
-        getHelix()->fetchChannels(
-            batch,
-            [this, batch{batch}](const auto &helixChannels) {
-                QStringList deadChannels;
-
-                {
-                    std::shared_lock lock(this->channelsMutex);
-                    for (const auto &helixChannel : helixChannels)
-                    {
-                        auto it = this->channels.find(helixChannel.userId);
-                        if (it != this->channels.end())
-                        {
-                            if (auto channel = it->second.ptr.lock(); channel)
-                            {
-                                channel->updateStreamTitle(helixChannel.title);
-                                channel->updateDisplayName(helixChannel.name);
-                            }
-                            else
-                            {
-                                deadChannels.append(helixChannel.userId);
-                            }
-                        }
-                    }
-                }
-
-                if (!deadChannels.isEmpty())
-                {
-                    std::unique_lock lock(this->channelsMutex);
-                    for (const auto &deadChannel : deadChannels)
-                    {
-                        this->channels.erase(deadChannel);
-                    }
-                }
+        getHelix()->getChannel(
+            channelID,
+            [this, channelID](const auto &helixChannel) {
+                this->withChannel(channelID, [&](auto &, auto &channel) {
+                    channel.updateStreamTitle(helixChannel.title);
+                    channel.updateDisplayName(helixChannel.name);
+                });
             },
             [] {
                 qCWarning(LOG) << "Failed stream check request";
@@ -189,4 +124,26 @@ void TwitchLiveController::request(std::optional<QStringList> optChannelIDs)
     }
 }
 
+void TwitchLiveController::withChannel(
+    const QString &channelID,
+    const std::function<void(ChannelEntry &, TwitchChannel &)> &fn)
+{
+    {
+        std::shared_lock lock(this->channelsMutex);
+        auto it = this->channels.find(channelID);
+        if (it == this->channels.end())
+        {
+            return;
+        }
+        if (auto channel = it->second.ptr.lock())
+        {
+            fn(it->second, *channel);
+            return;
+        }
+    }
+
+    std::unique_lock lock(this->channelsMutex);
+    this->channels.erase(channelID);
+}
+
 }  // namespace chatterino
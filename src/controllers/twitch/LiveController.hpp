@@ -6,6 +6,7 @@
 #include <QTimer>
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -34,13 +35,6 @@ public:
     // Controls how quickly new channels have their stream status loaded
     static constexpr std::chrono::seconds IMMEDIATE_REQUEST_INTERVAL{1};
 
-    /**
-     * How many channels to include in a single request
-     *
-     * Should not be more than 100
-     **/
-    static constexpr int BATCH_SIZE{100};
-
     TwitchLiveController();
 
     // Add a Twitch channel to be queried for live status
@@ -54,7 +48,7 @@ private:
     };
 
     /**
-     * Run batched Helix Channels & Stream requests for channels
+     * Run Helix Channels & Stream requests for channels
      *
      * If a list of channel IDs is passed to request, we only make a request for those channels
      *
@@ -63,6 +57,15 @@ private:
      **/
     void request(std::optional<QStringList> optChannelIDs = std::nullopt);
 
+    /**
+     * Run fn with the channel with the given ID if it's still open
+     *
+     * Channels that were closed are removed
+     **/
+    void withChannel(
+        const QString &channelID,
+        const std::function<void(ChannelEntry &, TwitchChannel &)> &fn);
+
     /**
      * List of channel IDs pointing to their Twitch Channel
      *
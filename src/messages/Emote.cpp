@@ -1,11 +1,98 @@
 #include "messages/Emote.hpp"
 
 #include "common/Literals.hpp"
+#include "util/DebugCount.hpp"
 
 #include <QJsonObject>
 
+#include <algorithm>
+#include <mutex>
 #include <unordered_map>
 
+namespace {
+
+using namespace chatterino;
+
+const auto INTERNED_EMOTES = DebugCount::counter("interned emotes");
+const auto INTERNED_SIZE =
+    DebugCount::counter("interned emotes size", DebugCount::Flag::DataSize);
+const auto INTERNED_REUSES = DebugCount::counter("interned emote reuses");
+
+struct InternKey {
+    EmoteProvider provider;
+    QString id;
+    QString name;
+
+    bool operator==(const InternKey &other) const = default;
+};
+
+struct InternKeyHash {
+    size_t operator()(const InternKey &key) const
+    {
+        return qHashMulti(0, static_cast<uint8_t>(key.provider), key.id,
+                          key.name);
+    }
+};
+
+struct InternTable {
+    std::mutex mutex;
+    std::unordered_map<InternKey, std::weak_ptr<const Emote>, InternKeyHash>
+        emotes;
+    /// The table is pruned once it reaches this size
+    size_t pruneAt = 1024;
+
+    /// Removes the entries of freed emotes once the table doubled in size
+    void prune()
+    {
+        if (this->emotes.size() < this->pruneAt)
+        {
+            return;
+        }
+        std::erase_if(this->emotes, [](const auto &it) {
+            return it.second.expired();
+        });
+        this->pruneAt = std::max<size_t>(1024, this->emotes.size() * 2);
+    }
+};
+
+/// The deleter of interned emotes. It remembers the key the emote was
+/// interned with for internedKeyOf().
+struct InternedDeleter {
+    EmoteProvider provider;
+    EmoteId id;
+    int64_t size;
+
+    void operator()(const Emote *ptr) const
+    {
+        INTERNED_EMOTES.decrease();
+        INTERNED_SIZE.decrease(this->size);
+        delete ptr;
+    }
+};
+
+InternTable &internTable()
+{
+    // Leaked, emotes might still be parsed on other threads while exiting
+    static auto *table = new InternTable;
+    return *table;
+}
+
+/// The size of the emote and the strings it holds
+int64_t approximateSize(const Emote &emote)
+{
+    auto chars = emote.name.string.size() + emote.tooltip.string.size() +
+                 emote.homePage.string.size() + emote.id.string.size() +
+                 emote.author.string.size();
+    if (emote.baseName)
+    {
+        chars += emote.baseName->string.size();
+    }
+    return static_cast<int64_t>(sizeof(Emote)) +
+           static_cast<int64_t>(chars * sizeof(QChar));
+}
+
+}  // namespace
+
 namespace chatterino {
 
 using namespace literals;
@@ -64,25 +151,49 @@ EmotePtr cachedOrMakeEmotePtr(Emote &&emote, const EmoteMap &cache)
     return std::make_shared<Emote>(std::move(emote));
 }
 
-EmotePtr cachedOrMakeEmotePtr(
-    Emote &&emote,
-    std::unordered_map<EmoteId, std::weak_ptr<const Emote>> &cache,
-    std::mutex &mutex, const EmoteId &id)
+EmotePtr internEmote(EmoteProvider provider, const EmoteId &id,
+                     Emote &&emote)
 {
-    std::lock_guard<std::mutex> guard(mutex);
-
-    auto shared = cache[id].lock();
-    if (shared && *shared == emote)
+    auto &table = internTable();
+    std::lock_guard guard(table.mutex);
+
+    auto &slot = table.emotes[{
+        .provider = provider,
+        .id = id.string,
+        .name = emote.name.string,
+    }];
+    if (auto shared = slot.lock(); shared && *shared == emote)
     {
-        // reuse old shared_ptr if nothing changed
+        INTERNED_REUSES.increase();
         return shared;
     }
-    else
+
+    auto size = approximateSize(emote);
+    EmotePtr shared(new Emote(std::move(emote)),
+                    InternedDeleter{
+                        .provider = provider,
+                        .id = id,
+                        .size = size,
+                    });
+    INTERNED_EMOTES.increase();
+    INTERNED_SIZE.increase(size);
+    slot = shared;
+
+    table.prune();
+    return shared;
+}
+
+std::optional<InternedEmoteKey> internedKeyOf(const EmotePtr &emote)
+{
+    const auto *deleter = std::get_deleter<InternedDeleter>(emote);
+    if (!deleter)
     {
-        shared = std::make_shared<Emote>(std::move(emote));
-        cache[id] = shared;
-        return shared;
+        return std::nullopt;
     }
+    return InternedEmoteKey{
+        .provider = deleter->provider,
+        .id = deleter->id,
+    };
 }
 
 EmoteMap::const_iterator EmoteMap::findEmote(const QString &emoteNameHint,
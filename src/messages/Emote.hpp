@@ -2,7 +2,9 @@
 
 #include "common/Aliases.hpp"
 #include "messages/ImageSet.hpp"
+#include "util/PersistentHashMap.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -41,9 +43,15 @@ bool operator!=(const Emote &a, const Emote &b);
 
 using EmotePtr = std::shared_ptr<const Emote>;
 
-class EmoteMap : public std::unordered_map<EmoteName, EmotePtr>
+/// The emotes of a provider by their name.
+///
+/// Copies share their structure, so applying a live update to a copy of a
+/// large map only copies a few small nodes.
+class EmoteMap : public PersistentHashMap<EmoteName, EmotePtr>
 {
 public:
+    using PersistentHashMap::PersistentHashMap;
+
     /**
      * Finds an emote by it's id with a hint to it's name.
      *
@@ -63,9 +71,34 @@ inline const std::shared_ptr<const EmoteMap> EMPTY_EMOTE_MAP = std::make_shared<
     const EmoteMap>();  // NOLINT(cert-err58-cpp) -- assume this doesn't throw an exception
 
 EmotePtr cachedOrMakeEmotePtr(Emote &&emote, const EmoteMap &cache);
-EmotePtr cachedOrMakeEmotePtr(
-    Emote &&emote,
-    std::unordered_map<EmoteId, std::weak_ptr<const Emote>> &cache,
-    std::mutex &mutex, const EmoteId &id);
+
+/// The providers whose emotes are shared across channels with internEmote()
+enum class EmoteProvider : uint8_t {
+    Bttv,
+    Ffz,
+    Seventv,
+};
+
+/// Returns the instance of @a emote that's shared by all channels.
+///
+/// Emotes are identified by their provider, @a id and name - aliases of an
+/// emote get their own instance. If the shared instance doesn't equal
+/// @a emote anymore, it's replaced.
+///
+/// Only weak references are kept, so emotes that aren't used by any channel
+/// are freed. The number and size of the live emotes is reported through
+/// DebugCount.
+EmotePtr internEmote(EmoteProvider provider, const EmoteId &id,
+                     Emote &&emote);
+
+/// The provider and ID an emote was interned with
+struct InternedEmoteKey {
+    EmoteProvider provider;
+    EmoteId id;
+};
+
+/// Returns the key @a emote was interned with, or std::nullopt if it wasn't
+/// created by internEmote()
+std::optional<InternedEmoteKey> internedKeyOf(const EmotePtr &emote);
 
 }  // namespace chatterino
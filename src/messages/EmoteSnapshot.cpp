@@ -0,0 +1,613 @@
+#include "messages/EmoteSnapshot.hpp"
+
+#include "Application.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/Image.hpp"
+#include "singletons/Paths.hpp"
+
+#include <QDateTime>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+
+/// "CESN" in little endian
+constexpr uint32_t MAGIC = 0x4e534543;
+constexpr qint64 HEADER_SIZE = 12;
+
+// Intentionally leaked - it's saved in saveGlobal() and must not be
+// destroyed after the application
+EmoteSnapshot *globalSnapshot = nullptr;
+
+/// FNV-1a
+uint64_t checksumOf(QByteArrayView data)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : data)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+int64_t now()
+{
+    return QDateTime::currentSecsSinceEpoch();
+}
+
+class Writer
+{
+public:
+    template <typename T>
+    void number(T value)
+    {
+        auto le = qToLittleEndian(value);
+        this->data.append(reinterpret_cast<const char *>(&le), sizeof(le));
+    }
+
+    void string(const QString &value)
+    {
+        auto utf8 = value.toUtf8();
+        this->number(static_cast<uint32_t>(utf8.size()));
+        this->data.append(utf8);
+    }
+
+    void image(const ImagePtr &image)
+    {
+        if (!image || image->isEmpty())
+        {
+            this->string({});
+            return;
+        }
+        this->string(image->url().string);
+        this->number(static_cast<double>(image->scale()));
+        this->number(static_cast<int32_t>(image->expectedSize().width()));
+        this->number(static_cast<int32_t>(image->expectedSize().height()));
+    }
+
+    void emote(const EmotePtr &emotePtr)
+    {
+        const auto &emote = *emotePtr;
+        this->string(emote.name.string);
+        this->string(emote.tooltip.string);
+        this->string(emote.homePage.string);
+        this->string(emote.id.string);
+        this->string(emote.author.string);
+        this->number(static_cast<uint8_t>(emote.zeroWidth));
+        this->number(static_cast<uint8_t>(emote.baseName.has_value()));
+        if (emote.baseName)
+        {
+            this->string(emote.baseName->string);
+        }
+        this->image(emote.images.getImage1());
+        this->image(emote.images.getImage2());
+        this->image(emote.images.getImage3());
+
+        // 0 if the emote isn't interned, the provider + 1 otherwise
+        auto key = internedKeyOf(emotePtr);
+        if (!key)
+        {
+            this->number(uint8_t{0});
+            return;
+        }
+        auto provider = static_cast<uint8_t>(key->provider);
+        this->number(static_cast<uint8_t>(provider + 1));
+        this->string(key->id.string);
+    }
+
+    QByteArray data;
+};
+
+/// Reads what Writer wrote. All functions return false once the end of the
+/// data is reached.
+class Reader
+{
+public:
+    explicit Reader(QByteArrayView data)
+        : data_(data)
+    {
+    }
+
+    template <typename T>
+    bool number(T &value)
+    {
+        if (this->data_.size() - this->pos_ < qsizetype(sizeof(T)))
+        {
+            return false;
+        }
+        value = qFromLittleEndian<T>(this->data_.data() + this->pos_);
+        this->pos_ += sizeof(T);
+        return true;
+    }
+
+    bool string(QString &value)
+    {
+        uint32_t size = 0;
+        if (!this->number(size) ||
+            this->data_.size() - this->pos_ < qsizetype(size))
+        {
+            return false;
+        }
+        value = QString::fromUtf8(this->data_.sliced(this->pos_, size));
+        this->pos_ += size;
+        return true;
+    }
+
+    bool image(ImagePtr &image)
+    {
+        QString url;
+        if (!this->string(url))
+        {
+            return false;
+        }
+        if (url.isEmpty())
+        {
+            image = Image::getEmpty();
+            return true;
+        }
+
+        double scale = 1;
+        int32_t width = 0;
+        int32_t height = 0;
+        if (!this->number(scale) || !this->number(width) ||
+            !this->number(height))
+        {
+            return false;
+        }
+        image = Image::fromUrl({url}, scale, QSize(width, height));
+        return true;
+    }
+
+    /// Reads an emote. Interned emotes are resolved through internEmote().
+    bool emote(EmotePtr &emotePtr)
+    {
+        Emote emote;
+        uint8_t zeroWidth = 0;
+        uint8_t hasBaseName = 0;
+        if (!this->string(emote.name.string) ||
+            !this->string(emote.tooltip.string) ||
+            !this->string(emote.homePage.string) ||
+            !this->string(emote.id.string) ||
+            !this->string(emote.author.string) || !this->number(zeroWidth) ||
+            !this->number(hasBaseName))
+        {
+            return false;
+        }
+        emote.zeroWidth = zeroWidth != 0;
+        if (hasBaseName != 0)
+        {
+            emote.baseName.emplace();
+            if (!this->string(emote.baseName->string))
+            {
+                return false;
+            }
+        }
+
+        ImagePtr image1;
+        ImagePtr image2;
+        ImagePtr image3;
+        if (!this->image(image1) || !this->image(image2) ||
+            !this->image(image3))
+        {
+            return false;
+        }
+        emote.images = ImageSet(image1, image2, image3);
+
+        uint8_t provider = 0;
+        if (!this->number(provider))
+        {
+            return false;
+        }
+        if (provider == 0)
+        {
+            emotePtr = std::make_shared<const Emote>(std::move(emote));
+            return true;
+        }
+
+        EmoteId id;
+        if (provider > static_cast<uint8_t>(EmoteProvider::Seventv) + 1 ||
+            !this->string(id.string))
+        {
+            return false;
+        }
+        emotePtr = internEmote(static_cast<EmoteProvider>(provider - 1), id,
+                               std::move(emote));
+        return true;
+    }
+
+    qsizetype pos() const
+    {
+        return this->pos_;
+    }
+
+    bool atEnd() const
+    {
+        return this->pos_ == this->data_.size();
+    }
+
+private:
+    QByteArrayView data_;
+    qsizetype pos_ = 0;
+};
+
+}  // namespace
+
+namespace chatterino {
+
+EmoteSnapshot::EmoteSnapshot(QString path)
+    : path_(std::move(path))
+{
+    this->load();
+
+    this->savePool_.setMaxThreadCount(1);
+    this->saveTimer_.setInterval(SAVE_INTERVAL);
+    QObject::connect(&this->saveTimer_, &QTimer::timeout, [this] {
+        this->save();
+    });
+    this->saveTimer_.start();
+}
+
+EmoteSnapshot::~EmoteSnapshot()
+{
+    this->waitForSave();
+    this->unmap();
+}
+
+EmoteSnapshot &EmoteSnapshot::global()
+{
+    assertInGuiThread();
+
+    auto path = getApp()->getPaths().cacheFilePath("emote-snapshot");
+    if (globalSnapshot && globalSnapshot->path() == path)
+    {
+        return *globalSnapshot;
+    }
+
+    if (globalSnapshot)
+    {
+        // The cache directory was changed in the settings
+        globalSnapshot->save();
+        delete globalSnapshot;
+    }
+    globalSnapshot = new EmoteSnapshot(path);
+    return *globalSnapshot;
+}
+
+void EmoteSnapshot::saveGlobal()
+{
+    if (globalSnapshot)
+    {
+        globalSnapshot->save();
+        globalSnapshot->waitForSave();
+    }
+}
+
+const QString &EmoteSnapshot::path() const
+{
+    return this->path_;
+}
+
+std::shared_ptr<const EmoteMap> EmoteSnapshot::emotes(const QString &key)
+{
+    auto data = this->read(key);
+    if (!data)
+    {
+        return nullptr;
+    }
+
+    Reader reader(*data);
+    uint32_t count = 0;
+    if (!reader.number(count))
+    {
+        return nullptr;
+    }
+
+    auto emotes = std::make_shared<EmoteMap>();
+    emotes->reserve(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        EmotePtr emote;
+        if (!reader.emote(emote))
+        {
+            return nullptr;
+        }
+        auto name = emote->name;
+        emotes->emplace(name, std::move(emote));
+    }
+    return emotes;
+}
+
+void EmoteSnapshot::setEmotes(const QString &key, const EmoteMap &emotes)
+{
+    Writer writer;
+    writer.number(static_cast<uint32_t>(emotes.size()));
+    for (const auto &[name, emote] : emotes)
+    {
+        writer.emote(emote);
+    }
+    this->write(key, std::move(writer.data));
+}
+
+std::optional<EmoteSnapshot::BadgeSets> EmoteSnapshot::badgeSets(
+    const QString &key)
+{
+    auto data = this->read(key);
+    if (!data)
+    {
+        return std::nullopt;
+    }
+
+    Reader reader(*data);
+    BadgeSets badgeSets;
+    while (!reader.atEnd())
+    {
+        QString set;
+        QString version;
+        EmotePtr badge;
+        if (!reader.string(set) || !reader.string(version) ||
+            !reader.emote(badge))
+        {
+            return std::nullopt;
+        }
+        badgeSets[set][version] = std::move(badge);
+    }
+    return badgeSets;
+}
+
+void EmoteSnapshot::setBadgeSets(const QString &key,
+                                 const BadgeSets &badgeSets)
+{
+    Writer writer;
+    for (const auto &[set, versions] : badgeSets)
+    {
+        for (const auto &[version, badge] : versions)
+        {
+            writer.string(set);
+            writer.string(version);
+            writer.emote(badge);
+        }
+    }
+    this->write(key, std::move(writer.data));
+}
+
+void EmoteSnapshot::save()
+{
+    assertInGuiThread();
+
+    if (!this->dirty_)
+    {
+        return;
+    }
+
+    // The file is replaced, so entries that are only in the mapping are
+    // copied (and verified) first. Only the first save has to do this.
+    if (this->mapped_)
+    {
+        std::vector<QString> keys;
+        keys.reserve(this->entries_.size());
+        for (const auto &[key, entry] : this->entries_)
+        {
+            keys.push_back(key);
+        }
+        for (const auto &key : keys)
+        {
+            auto bytes = this->read(key);
+            auto it = this->entries_.find(key);
+            if (bytes && it != this->entries_.end() && !it->second.loaded)
+            {
+                it->second.data = bytes->toByteArray();
+                it->second.loaded = true;
+            }
+        }
+        this->unmap();
+    }
+
+    // The data of the entries is implicitly shared, it isn't copied here
+    std::vector<std::pair<QString, Entry>> entries(this->entries_.begin(),
+                                                   this->entries_.end());
+    this->dirty_ = false;
+
+    this->savePool_.start([this, path = this->path_,
+                           entries = std::move(entries)] {
+        if (writeFile(path, entries))
+        {
+            return;
+        }
+
+        // Try again on the next save
+        QMetaObject::invokeMethod(
+            &this->saveTimer_,
+            [this] {
+                this->dirty_ = true;
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void EmoteSnapshot::waitForSave()
+{
+    this->savePool_.waitForDone();
+}
+
+bool EmoteSnapshot::writeFile(
+    const QString &path, const std::vector<std::pair<QString, Entry>> &entries)
+{
+    // Header: magic, version, entry count
+    // Index: key, stored at, checksum, offset, size (per entry)
+    // Data of all entries
+    Writer header;
+    header.number(MAGIC);
+    header.number(VERSION);
+    header.number(static_cast<uint32_t>(entries.size()));
+
+    Writer index;
+    QByteArray data;
+    for (const auto &[key, entry] : entries)
+    {
+        index.string(key);
+        index.number(entry.storedAt);
+        index.number(entry.checksum);
+        index.number(static_cast<uint64_t>(data.size()));
+        index.number(static_cast<uint64_t>(entry.data.size()));
+        data.append(entry.data);
+    }
+
+    // Offsets are relative to the start of the data
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(header.data) != header.data.size() ||
+        file.write(index.data) != index.data.size() ||
+        file.write(data) != data.size() || !file.commit())
+    {
+        qCWarning(chatterinoCache)
+            << "Failed to save emote snapshot" << file.errorString();
+        return false;
+    }
+
+    qCDebug(chatterinoCache)
+        << "Saved emote snapshot with" << entries.size() << "entries";
+    return true;
+}
+
+void EmoteSnapshot::load()
+{
+    this->file_.setFileName(this->path_);
+    if (!this->file_.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    this->mappedSize_ = this->file_.size();
+    if (this->mappedSize_ < HEADER_SIZE)
+    {
+        this->unmap();
+        return;
+    }
+    this->mapped_ = this->file_.map(0, this->mappedSize_);
+    if (!this->mapped_)
+    {
+        this->unmap();
+        return;
+    }
+
+    Reader reader(QByteArrayView(this->mapped_, this->mappedSize_));
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t count = 0;
+    reader.number(magic);
+    reader.number(version);
+    reader.number(count);
+    if (magic != MAGIC || version != VERSION)
+    {
+        qCDebug(chatterinoCache) << "Ignoring emote snapshot of version"
+                                 << version;
+        this->unmap();
+        return;
+    }
+
+    struct IndexEntry {
+        QString key;
+        Entry entry;
+    };
+    std::vector<IndexEntry> index;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        IndexEntry it;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        if (!reader.string(it.key) || !reader.number(it.entry.storedAt) ||
+            !reader.number(it.entry.checksum) || !reader.number(offset) ||
+            !reader.number(size))
+        {
+            qCWarning(chatterinoCache) << "Ignoring broken emote snapshot";
+            this->unmap();
+            return;
+        }
+        it.entry.offset = static_cast<qint64>(offset);
+        it.entry.size = static_cast<qint64>(size);
+        index.emplace_back(std::move(it));
+    }
+
+    // The data starts right after the index
+    auto dataStart = static_cast<qint64>(reader.pos());
+    auto minStoredAt =
+        now() - std::chrono::duration_cast<std::chrono::seconds>(MAX_AGE)
+                    .count();
+    for (auto &it : index)
+    {
+        if (it.entry.storedAt < minStoredAt)
+        {
+            // Dropped on the next save
+            this->dirty_ = true;
+            continue;
+        }
+        it.entry.offset += dataStart;
+        this->entries_.emplace(std::move(it.key), std::move(it.entry));
+    }
+}
+
+void EmoteSnapshot::unmap()
+{
+    if (this->mapped_)
+    {
+        this->file_.unmap(const_cast<uchar *>(this->mapped_));
+        this->mapped_ = nullptr;
+    }
+    this->mappedSize_ = 0;
+    this->file_.close();
+}
+
+std::optional<QByteArrayView> EmoteSnapshot::read(const QString &key)
+{
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end())
+    {
+        return std::nullopt;
+    }
+
+    auto &entry = it->second;
+    if (entry.loaded)
+    {
+        return QByteArrayView(entry.data);
+    }
+
+    // Entries can be empty (e.g. a channel without badges)
+    std::optional<QByteArrayView> data;
+    if (this->mapped_ && entry.offset >= HEADER_SIZE && entry.size >= 0 &&
+        entry.size <= this->mappedSize_ - entry.offset)
+    {
+        data = QByteArrayView(this->mapped_ + entry.offset, entry.size);
+    }
+    if (!data || (!entry.verified && checksumOf(*data) != entry.checksum))
+    {
+        qCWarning(chatterinoCache) << "Dropping broken emote snapshot entry"
+                                   << key;
+        this->entries_.erase(it);
+        this->dirty_ = true;
+        return std::nullopt;
+    }
+    entry.verified = true;
+    return data;
+}
+
+void EmoteSnapshot::write(const QString &key, QByteArray data)
+{
+    assertInGuiThread();
+
+    auto checksum = checksumOf(data);
+    auto &entry = this->entries_[key];
+    entry.data = std::move(data);
+    entry.loaded = true;
+    entry.checksum = checksum;
+    entry.storedAt = now();
+    entry.verified = true;
+    this->dirty_ = true;
+}
+
+}  // namespace chatterino
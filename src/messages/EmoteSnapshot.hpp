@@ -0,0 +1,116 @@
+#pragma once
+
+#include "messages/Emote.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// A binary snapshot of emote maps and badge sets, so they can be shown
+/// right after starting, while they're loaded again in the background.
+///
+/// The snapshot is a single file, which is memory-mapped when it's opened.
+/// Entries are only decoded once they're requested. Every entry has a
+/// checksum and the time it was stored. Entries that don't match their
+/// checksum or are older than MAX_AGE are dropped. Files with another
+/// VERSION are ignored and replaced on the next save.
+///
+/// Emotes created by internEmote() are stored with their provider and are
+/// interned again when they're read.
+///
+/// Changes are written every SAVE_INTERVAL and by saveGlobal(). The file is
+/// written on a worker thread from the encoded entries, which are immutable
+/// once stored.
+///
+/// Only used from the GUI thread.
+class EmoteSnapshot
+{
+public:
+    static constexpr uint32_t VERSION = 2;
+    static constexpr std::chrono::hours MAX_AGE{24 * 7};
+    static constexpr std::chrono::minutes SAVE_INTERVAL{5};
+
+    /// Set ID -> version -> badge
+    using BadgeSets =
+        std::unordered_map<QString, std::unordered_map<QString, EmotePtr>>;
+
+    explicit EmoteSnapshot(QString path);
+    ~EmoteSnapshot();
+
+    EmoteSnapshot(const EmoteSnapshot &) = delete;
+    EmoteSnapshot(EmoteSnapshot &&) = delete;
+    EmoteSnapshot &operator=(const EmoteSnapshot &) = delete;
+    EmoteSnapshot &operator=(EmoteSnapshot &&) = delete;
+
+    /// Returns the snapshot in the cache directory
+    static EmoteSnapshot &global();
+    /// Writes the global snapshot if it was used and changed
+    static void saveGlobal();
+
+    const QString &path() const;
+
+    /// Returns the emotes stored as @a key, or nullptr if there are none
+    std::shared_ptr<const EmoteMap> emotes(const QString &key);
+    void setEmotes(const QString &key, const EmoteMap &emotes);
+
+    /// Returns the badges stored as @a key
+    std::optional<BadgeSets> badgeSets(const QString &key);
+    void setBadgeSets(const QString &key, const BadgeSets &badgeSets);
+
+    /// Starts writing the snapshot on a worker thread if anything changed
+    /// since it was last written
+    void save();
+    /// Blocks until the snapshot started by save() is written
+    void waitForSave();
+
+private:
+    struct Entry {
+        /// The encoded entry. Only valid if `loaded` is set.
+        QByteArray data;
+        /// False if the entry is only in the mapped file
+        bool loaded = false;
+        qint64 offset = 0;
+        qint64 size = 0;
+        uint64_t checksum = 0;
+        /// Seconds since epoch
+        int64_t storedAt = 0;
+        bool verified = false;
+    };
+
+    void load();
+    void unmap();
+    /// Returns the encoded entry for @a key, or std::nullopt if there's no
+    /// valid entry
+    std::optional<QByteArrayView> read(const QString &key);
+    void write(const QString &key, QByteArray data);
+
+    /// Writes @a entries to @a path. Runs on a worker thread.
+    static bool writeFile(const QString &path,
+                          const std::vector<std::pair<QString, Entry>> &entries);
+
+    const QString path_;
+    QFile file_;
+    const uchar *mapped_ = nullptr;
+    qint64 mappedSize_ = 0;
+
+    std::unordered_map<QString, Entry> entries_;
+    bool dirty_ = false;
+    QTimer saveTimer_;
+    /// Runs one save at a time, so they're written in order
+    QThreadPool savePool_;
+};
+
+}  // namespace chatterino
@@ -8,6 +8,7 @@
 #include "controllers/emotes/EmoteController.hpp"
 #include "debug/AssertInGuiThread.hpp"
 #include "debug/Benchmark.hpp"
+#include "messages/ImageDecoder.hpp"
 #include "singletons/helper/GifTimer.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/DebugCount.hpp"
@@ -28,11 +29,56 @@ const auto IMAGE_POOL_CLEANUP_INTERVAL = std::chrono::minutes(1);
 // Duration since last usage of Image pixmap before expiration of frames
 const auto IMAGE_POOL_IMAGE_LIFETIME = std::chrono::minutes(10);
 
+namespace {
+
+using chatterino::DebugCount;
+
+const auto IMAGES_COUNTER = DebugCount::counter("images");
+const auto LOADED_IMAGES_COUNTER = DebugCount::counter("loaded images");
+const auto ANIMATED_IMAGES_COUNTER = DebugCount::counter("animated images");
+const auto IMAGE_BYTES_COUNTER =
+    DebugCount::counter("image bytes", DebugCount::Flag::DataSize);
+const auto IMAGE_BYTES_LOADED_COUNTER = DebugCount::counter(
+    "image bytes (ever loaded)", DebugCount::Flag::DataSize);
+const auto IMAGE_BYTES_UNLOADED_COUNTER = DebugCount::counter(
+    "image bytes (ever unloaded)", DebugCount::Flag::DataSize);
+
+}  // namespace
+
 namespace chatterino::detail {
 
+const QPixmap &Frame::toPixmap() const
+{
+    assertInGuiThread();
+
+    if (this->pixmap.isNull() && !this->image.isNull())
+    {
+        this->pixmap = QPixmap::fromImage(std::move(this->image));
+    }
+    return this->pixmap;
+}
+
+int64_t Frame::memoryUsage() const
+{
+    QSize sz;
+    int depth = 0;
+    if (!this->pixmap.isNull())
+    {
+        sz = this->pixmap.size();
+        depth = this->pixmap.depth();
+    }
+    else
+    {
+        sz = this->image.size();
+        depth = this->image.depth();
+    }
+
+    return int64_t(sz.width()) * int64_t(sz.height()) * depth / 8;
+}
+
 Frames::Frames()
 {
-    DebugCount::increase("images");
+    IMAGES_COUNTER.increase();
 }
 
 Frames::Frames(QList<Frame> &&frames)
@@ -47,15 +93,20 @@ Frames::Frames(QList<Frame> &&frames)
         return;
     }
 
-    DebugCount::increase("images");
+    IMAGES_COUNTER.increase();
     if (!this->empty())
     {
-        DebugCount::increase("loaded images");
+        LOADED_IMAGES_COUNTER.increase();
+    }
+
+    for (const auto &frame : this->items_)
+    {
+        this->memoryUsage_ += frame.memoryUsage();
     }
 
     if (this->animated())
     {
-        DebugCount::increase("animated images");
+        ANIMATED_IMAGES_COUNTER.increase();
 
         this->gifTimerConnection_ =
             app->getEmotes()->getGIFTimer()->signal.connect([this] {
@@ -81,43 +132,29 @@ Frames::Frames(QList<Frame> &&frames)
         this->processOffset();
     }
 
-    DebugCount::increase("image bytes", this->memoryUsage());
-    DebugCount::increase("image bytes (ever loaded)", this->memoryUsage());
+    IMAGE_BYTES_COUNTER.increase(this->memoryUsage_);
+    IMAGE_BYTES_LOADED_COUNTER.increase(this->memoryUsage_);
 }
 
 Frames::~Frames()
 {
     assertInGuiThread();
-    DebugCount::decrease("images");
+    IMAGES_COUNTER.decrease();
     if (!this->empty())
     {
-        DebugCount::decrease("loaded images");
+        LOADED_IMAGES_COUNTER.decrease();
     }
 
     if (this->animated())
     {
-        DebugCount::decrease("animated images");
+        ANIMATED_IMAGES_COUNTER.decrease();
     }
-    DebugCount::decrease("image bytes", this->memoryUsage());
-    DebugCount::increase("image bytes (ever unloaded)", this->memoryUsage());
+    IMAGE_BYTES_COUNTER.decrease(this->memoryUsage_);
+    IMAGE_BYTES_UNLOADED_COUNTER.increase(this->memoryUsage_);
 
     this->gifTimerConnection_.disconnect();
 }
 
-int64_t Frames::memoryUsage() const
-{
-    int64_t usage = 0;
-    for (const auto &frame : this->items_)
-    {
-        auto sz = frame.image.size();
-        auto area = sz.width() * sz.height();
-        auto memory = area * frame.image.depth() / 8;
-
-        usage += memory;
-    }
-    return usage;
-}
-
 void Frames::advance()
 {
     this->durationOffset_ += GIF_FRAME_LENGTH;
@@ -152,12 +189,13 @@ void Frames::clear()
     assertInGuiThread();
     if (!this->empty())
     {
-        DebugCount::decrease("loaded images");
+        LOADED_IMAGES_COUNTER.decrease();
     }
-    DebugCount::decrease("image bytes", this->memoryUsage());
-    DebugCount::increase("image bytes (ever unloaded)", this->memoryUsage());
+    IMAGE_BYTES_COUNTER.decrease(this->memoryUsage_);
+    IMAGE_BYTES_UNLOADED_COUNTER.increase(this->memoryUsage_);
 
     this->items_.clear();
+    this->memoryUsage_ = 0;
     this->index_ = 0;
     this->durationOffset_ = 0;
     this->gifTimerConnection_.disconnect();
@@ -180,7 +218,7 @@ std::optional<QPixmap> Frames::current() const
         return std::nullopt;
     }
 
-    return this->items_[this->index_].image;
+    return this->items_[this->index_].toPixmap();
 }
 
 std::optional<QPixmap> Frames::first() const
@@ -190,7 +228,7 @@ std::optional<QPixmap> Frames::first() const
         return std::nullopt;
     }
 
-    return this->items_.front().image;
+    return this->items_.front().toPixmap();
 }
 
 QList<Frame> readFrames(QImageReader &reader, const Url &url)
@@ -200,8 +238,8 @@ QList<Frame> readFrames(QImageReader &reader, const Url &url)
 
     for (int index = 0; index < reader.imageCount(); ++index)
     {
-        auto pixmap = QPixmap::fromImageReader(&reader);
-        if (!pixmap.isNull())
+        auto image = reader.read();
+        if (!image.isNull())
         {
             // It seems that browsers have special logic for fast animations.
             // This implements Chrome and Firefox's behavior which uses
@@ -215,7 +253,8 @@ QList<Frame> readFrames(QImageReader &reader, const Url &url)
             }
             duration = std::max(20, duration);
             frames.append(Frame{
-                .image = std::move(pixmap),
+                .image = std::move(image),
+                .pixmap = {},
                 .duration = duration,
             });
         }
@@ -392,7 +431,11 @@ void Image::setPixmap(const QPixmap &pixmap)
 {
     auto setFrames = [shared = this->shared_from_this(), pixmap]() {
         shared->frames_ = std::make_unique<detail::Frames>(
-            QList<detail::Frame>{detail::Frame{pixmap, 1}});
+            QList<detail::Frame>{detail::Frame{
+                .image = {},
+                .pixmap = pixmap,
+                .duration = 1,
+            }});
     };
 
     if (isGuiThread())
@@ -425,6 +468,7 @@ std::optional<QPixmap> Image::pixmapOrLoad() const
     // Any time this Image is painted, this method is invoked.
     // See src/messages/layouts/MessageLayoutElement.cpp ImageLayoutElement::paint, for example.
     this->lastUsed_ = std::chrono::steady_clock::now();
+    this->requestedVisible_ = true;
 
     this->load();
 
@@ -451,6 +495,11 @@ qreal Image::scale() const
     return this->scale_;
 }
 
+QSize Image::expectedSize() const
+{
+    return this->expectedSize_;
+}
+
 bool Image::isEmpty() const
 {
     return this->empty_;
@@ -517,49 +566,31 @@ void Image::actuallyLoad()
 
             assert(!isAppAboutToQuit());
 
-            QBuffer buffer;
-            buffer.setData(result.getData());
-            QImageReader reader(&buffer);
-
-            if (!reader.canRead())
-            {
-                qCDebug(chatterinoImage)
-                    << "Error: image cant be read " << shared->url().string;
-                shared->empty_ = true;
-                return;
-            }
-
-            const auto size = reader.size();
-            if (size.isEmpty())
-            {
-                shared->empty_ = true;
-                return;
-            }
-
-            // returns 1 for non-animated formats
-            if (reader.imageCount() <= 0)
-            {
-                qCDebug(chatterinoImage)
-                    << "Error: image has less than 1 frame "
-                    << shared->url().string << ": " << reader.errorString();
-                shared->empty_ = true;
-                return;
-            }
-
-            // use "double" to prevent int overflows
-            if (double(size.width()) * double(size.height()) *
-                    double(reader.imageCount()) * 4.0 >
-                double(Image::maxBytesRam))
-            {
-                qCDebug(chatterinoImage) << "image too large in RAM";
-
-                shared->empty_ = true;
-                return;
-            }
-
-            auto parsed = detail::readFrames(reader, shared->url());
-
-            assignFrames(shared, parsed);
+            // Images that were painted while loading are decoded first. The
+            // others were only requested during layout.
+            auto priority = shared->requestedVisible_
+                                ? ImageDecoder::Priority::Visible
+                                : ImageDecoder::Priority::Prefetch;
+            ImageDecoder::instance().submit(
+                priority, weak,
+                [weak, data = result.getData()] {
+                    auto shared = weak.lock();
+                    if (!shared || isAppAboutToQuit())
+                    {
+                        return;
+                    }
+                    shared->decode(data);
+                },
+                [weak] {
+                    // Load the image again once it's requested (the response
+                    // is cached by then)
+                    postToThread([weak] {
+                        if (auto shared = weak.lock())
+                        {
+                            shared->shouldLoad_ = true;
+                        }
+                    });
+                });
         })
         .onError([weak](auto /*result*/) {
             auto shared = weak.lock();
@@ -576,6 +607,53 @@ void Image::actuallyLoad()
         .execute();
 }
 
+void Image::decode(const QByteArray &data)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    QImageReader reader(&buffer);
+
+    if (!reader.canRead())
+    {
+        qCDebug(chatterinoImage)
+            << "Error: image cant be read " << this->url().string;
+        this->empty_ = true;
+        return;
+    }
+
+    const auto size = reader.size();
+    if (size.isEmpty())
+    {
+        this->empty_ = true;
+        return;
+    }
+
+    // returns 1 for non-animated formats
+    if (reader.imageCount() <= 0)
+    {
+        qCDebug(chatterinoImage) << "Error: image has less than 1 frame "
+                                 << this->url().string << ": "
+                                 << reader.errorString();
+        this->empty_ = true;
+        return;
+    }
+
+    // use "double" to prevent int overflows
+    if (double(size.width()) * double(size.height()) *
+            double(reader.imageCount()) * 4.0 >
+        double(Image::maxBytesRam))
+    {
+        qCDebug(chatterinoImage) << "image too large in RAM";
+
+        this->empty_ = true;
+        return;
+    }
+
+    auto parsed = detail::readFrames(reader, this->url());
+
+    detail::assignFrames(this->weak_from_this(), std::move(parsed));
+}
+
 void Image::expireFrames()
 {
     assertInGuiThread();
@@ -604,13 +682,6 @@ ImageExpirationPool::ImageExpirationPool()
     this->freeTimer_->start(
         std::chrono::duration_cast<std::chrono::milliseconds>(
             IMAGE_POOL_CLEANUP_INTERVAL));
-
-    // configure all debug counts used by images
-    DebugCount::configure("image bytes", DebugCount::Flag::DataSize);
-    DebugCount::configure("image bytes (ever loaded)",
-                          DebugCount::Flag::DataSize);
-    DebugCount::configure("image bytes (ever unloaded)",
-                          DebugCount::Flag::DataSize);
 }
 
 ImageExpirationPool &ImageExpirationPool::instance()
@@ -4,6 +4,7 @@
 
 #include <boost/variant.hpp>
 #include <pajlada/signals/signal.hpp>
+#include <QImage>
 #include <QList>
 #include <QPixmap>
 #include <QString>
@@ -26,8 +27,19 @@ class Image;
 namespace chatterino::detail {
 
 struct Frame {
-    QPixmap image;
+    /// The decoded frame. Frames are decoded off the GUI thread, so they're
+    /// only converted to a QPixmap once they're first used.
+    mutable QImage image;
+    /// The pixmap of this frame. Only valid once toPixmap() was called.
+    mutable QPixmap pixmap;
     int duration;
+
+    /// Returns the pixmap of this frame, converting (and releasing) the
+    /// decoded image if necessary. Must be called from the GUI thread.
+    const QPixmap &toPixmap() const;
+
+    /// Returns the (approximate) amount of memory used by this frame in bytes
+    int64_t memoryUsage() const;
 };
 
 class Frames
@@ -51,9 +63,11 @@ public:
     std::optional<QPixmap> first() const;
 
 private:
-    int64_t memoryUsage() const;
     void processOffset();
     QList<Frame> items_;
+    /// Memory used by all frames. Cached, because the pixmaps are created
+    /// lazily and might have a different depth than the decoded images.
+    int64_t memoryUsage_{0};
     QList<Frame>::size_type index_{0};
     int durationOffset_{0};
     pajlada::Signals::Connection gifTimerConnection_;
@@ -92,9 +106,12 @@ public:
     const Url &url() const;
     bool loaded() const;
     // either returns the current pixmap, or triggers loading it (lazy loading)
+    // Images loaded through this are decoded before ones loaded through load()
     std::optional<QPixmap> pixmapOrLoad() const;
     void load() const;
     qreal scale() const;
+    /// The size this image is expected to have before it's loaded
+    QSize expectedSize() const;
     bool isEmpty() const;
     int width() const;
     int height() const;
@@ -111,6 +128,9 @@ private:
 
     void setPixmap(const QPixmap &pixmap);
     void actuallyLoad();
+    /// Decodes the downloaded @a data and assigns the frames to this image.
+    /// Called from a decoder thread.
+    void decode(const QByteArray &data);
     void expireFrames();
 
     const Url url_{};
@@ -124,6 +144,9 @@ private:
     std::atomic_bool empty_{false};
 
     bool shouldLoad_{false};
+    /// Set once the image was requested for painting. Used to prioritize
+    /// decoding of visible images.
+    mutable std::atomic_bool requestedVisible_{false};
 
     mutable std::chrono::time_point<std::chrono::steady_clock> lastUsed_;
 
@@ -0,0 +1,168 @@
+#include "messages/ImageDecoder.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+
+namespace {
+
+using chatterino::DebugCount;
+
+const auto QUEUE_COUNTER = DebugCount::counter("image decode queue");
+const auto DECODES_COUNTER = DebugCount::counter("image decodes");
+const auto DROPPED_COUNTER = DebugCount::counter("image decodes dropped");
+const auto WAIT_AVG_COUNTER = DebugCount::counter("image decode wait avg (us)");
+const auto DECODE_AVG_COUNTER =
+    DebugCount::counter("image decode time avg (us)");
+
+// Upper bound of threads used for decoding images. Decoding is CPU bound, so
+// we don't want to use more than half of the cores - the GUI thread and the
+// network threads need them too.
+constexpr int MAX_DECODER_THREADS = 4;
+
+int64_t toMicros(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+}
+
+}  // namespace
+
+namespace chatterino {
+
+ImageDecoder::ImageDecoder()
+    : pool_(new QThreadPool)
+{
+    this->pool_->setObjectName("ImageDecoder");
+    this->pool_->setMaxThreadCount(std::clamp(QThread::idealThreadCount() / 2,
+                                              1, MAX_DECODER_THREADS));
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+    this->pool_->setThreadPriority(QThread::LowPriority);
+#endif
+}
+
+ImageDecoder &ImageDecoder::instance()
+{
+    // Intentionally leaked - decoding threads might still be running when
+    // static destructors run.
+    static auto *instance = new ImageDecoder;
+    return *instance;
+}
+
+void ImageDecoder::submit(Priority priority, std::weak_ptr<const void> owner,
+                          std::function<void()> job,
+                          std::function<void()> onDropped)
+{
+    std::vector<Job> dropped;
+    {
+        std::lock_guard lock(this->mutex_);
+        dropped = this->makeRoom();
+
+        auto &queue =
+            priority == Priority::Visible ? this->visible_ : this->prefetch_;
+        queue.push_back({
+            .fn = std::move(job),
+            .onDropped = std::move(onDropped),
+            .owner = std::move(owner),
+            .queuedAt = std::chrono::steady_clock::now(),
+        });
+    }
+    QUEUE_COUNTER.increase();
+
+    for (const auto &droppedJob : dropped)
+    {
+        if (droppedJob.onDropped)
+        {
+            droppedJob.onDropped();
+        }
+    }
+
+    // Every submitted job starts exactly one task. The task doesn't run the
+    // job it was started for, but the most important one at that time.
+    this->pool_->start([this] {
+        this->runNext();
+    });
+}
+
+std::vector<ImageDecoder::Job> ImageDecoder::makeRoom()
+{
+    std::vector<Job> dropped;
+    if (this->visible_.size() + this->prefetch_.size() < MAX_QUEUED)
+    {
+        return dropped;
+    }
+
+    auto isExpired = [](const Job &job) {
+        return job.owner.expired();
+    };
+    auto removed = std::erase_if(this->visible_, isExpired) +
+                   std::erase_if(this->prefetch_, isExpired);
+
+    if (removed == 0)
+    {
+        auto &queue =
+            this->prefetch_.empty() ? this->visible_ : this->prefetch_;
+        dropped.push_back(std::move(queue.front()));
+        queue.pop_front();
+        removed = 1;
+        DROPPED_COUNTER.increase();
+    }
+
+    QUEUE_COUNTER.decrease(static_cast<int64_t>(removed));
+    return dropped;
+}
+
+size_t ImageDecoder::queueDepth() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->visible_.size() + this->prefetch_.size();
+}
+
+void ImageDecoder::runNext()
+{
+    Job job;
+    {
+        std::lock_guard lock(this->mutex_);
+        auto &queue =
+            this->visible_.empty() ? this->prefetch_ : this->visible_;
+        if (queue.empty())
+        {
+            return;
+        }
+        job = std::move(queue.front());
+        queue.pop_front();
+    }
+    QUEUE_COUNTER.decrease();
+
+    if (job.owner.expired())
+    {
+        return;
+    }
+
+    auto startedAt = std::chrono::steady_clock::now();
+    job.fn();
+    auto finishedAt = std::chrono::steady_clock::now();
+
+    int64_t count = 0;
+    int64_t avgWaitUs = 0;
+    int64_t avgDecodeUs = 0;
+    {
+        std::lock_guard lock(this->mutex_);
+        this->decodedCount_++;
+        this->totalWaitUs_ += toMicros(startedAt - job.queuedAt);
+        this->totalDecodeUs_ += toMicros(finishedAt - startedAt);
+
+        count = this->decodedCount_;
+        avgWaitUs = this->totalWaitUs_ / count;
+        avgDecodeUs = this->totalDecodeUs_ / count;
+    }
+
+    DECODES_COUNTER.set(count);
+    WAIT_AVG_COUNTER.set(avgWaitUs);
+    DECODE_AVG_COUNTER.set(avgDecodeUs);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class QThreadPool;
+
+namespace chatterino {
+
+/// A small, bounded thread pool that decodes downloaded images.
+///
+/// Jobs are queued in two classes: images that were requested while painting
+/// (visible) are decoded before images that were only requested while laying
+/// out messages (prefetch). Within a class, jobs run in FIFO order.
+///
+/// At most MAX_QUEUED jobs wait in the queues. Jobs whose owner expired are
+/// dropped first when the queues are full, then the oldest prefetch jobs and
+/// then the oldest visible jobs. Dropped jobs are reported through their
+/// drop handler.
+///
+/// The pool is only responsible for scheduling - the actual decoding is done
+/// by the submitted function.
+class ImageDecoder
+{
+public:
+    enum class Priority : std::uint8_t {
+        Prefetch,
+        Visible,
+    };
+
+    static constexpr size_t MAX_QUEUED = 256;
+
+    static ImageDecoder &instance();
+
+    ImageDecoder(const ImageDecoder &) = delete;
+    ImageDecoder &operator=(const ImageDecoder &) = delete;
+    ImageDecoder(ImageDecoder &&) = delete;
+    ImageDecoder &operator=(ImageDecoder &&) = delete;
+
+    /// Queues @a job to be run on one of the decoder threads.
+    ///
+    /// @a job is skipped if @a owner expired before it runs. @a onDropped is
+    /// called (on any thread) if the job is dropped while @a owner is still
+    /// alive, because the queues are full.
+    void submit(Priority priority, std::weak_ptr<const void> owner,
+                std::function<void()> job,
+                std::function<void()> onDropped = {});
+
+    /// Returns the number of jobs that are waiting to be run
+    size_t queueDepth() const;
+
+private:
+    ImageDecoder();
+    ~ImageDecoder() = default;
+
+    struct Job {
+        std::function<void()> fn;
+        std::function<void()> onDropped;
+        std::weak_ptr<const void> owner;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+    /// Makes room for one job if the queues are full.
+    ///
+    /// @returns The dropped jobs of owners that are still alive
+    std::vector<Job> makeRoom();
+
+    /// Takes the next job from the queues (visible jobs first) and runs it
+    void runNext();
+
+    mutable std::mutex mutex_;
+    std::deque<Job> visible_;
+    std::deque<Job> prefetch_;
+
+    // Running totals used for the average latencies in the debug counts
+    int64_t decodedCount_ = 0;
+    int64_t totalWaitUs_ = 0;
+    int64_t totalDecodeUs_ = 0;
+
+    QThreadPool *pool_;
+};
+
+}  // namespace chatterino
@@ -265,14 +265,19 @@ public:
 
     /**
      * @brief Inserts the given item before another item
-     * 
+     *
+     * If the queue is full, the first item is removed to make room. If the
+     * queue is full and needle is the first item, nothing is inserted.
+     *
      * @param[in] needle the item to use as positional reference
      * @param[in] item the item to insert before needle
+     * @param[out] evicted (optional) the item that was removed to make room
      * @tparam Equality function object to use for comparison
      * @return true if an insertion took place
      */
     template <typename Equals = std::equal_to<T>>
-    bool insertBefore(const T &needle, const T &item)
+    bool insertBefore(const T &needle, const T &item,
+                      std::optional<T> *evicted = nullptr)
     {
         std::unique_lock lock(this->mutex_);
 
@@ -281,8 +286,7 @@ public:
         {
             if (eq(*it, needle))
             {
-                this->buffer_.insert(it, item);
-                return true;
+                return this->insertAt(it, item, evicted);
             }
         }
 
@@ -291,14 +295,18 @@ public:
 
     /**
      * @brief Inserts the given item after another item
-     * 
+     *
+     * If the queue is full, the first item is removed to make room.
+     *
      * @param[in] needle the item to use as positional reference
      * @param[in] item the item to insert after needle
+     * @param[out] evicted (optional) the item that was removed to make room
      * @tparam Equality function object to use for comparison
      * @return true if an insertion took place
      */
     template <typename Equals = std::equal_to<T>>
-    bool insertAfter(const T &needle, const T &item)
+    bool insertAfter(const T &needle, const T &item,
+                     std::optional<T> *evicted = nullptr)
     {
         std::unique_lock lock(this->mutex_);
 
@@ -308,8 +316,7 @@ public:
             if (eq(*it, needle))
             {
                 ++it;  // advance to insert after it
-                this->buffer_.insert(it, item);
-                return true;
+                return this->insertAt(it, item, evicted);
             }
         }
 
@@ -423,6 +430,31 @@ public:
     }
 
 private:
+    /**
+     * @brief Inserts @a item before @a it
+     *
+     * Mirrors boost::circular_buffer::insert: a full buffer drops its first
+     * item, or drops @a item if it would become the first item.
+     * This does not lock.
+     */
+    bool insertAt(typename boost::circular_buffer<T>::iterator it,
+                  const T &item, std::optional<T> *evicted)
+    {
+        if (this->buffer_.full())
+        {
+            if (it == this->buffer_.begin())
+            {
+                return false;
+            }
+            if (evicted)
+            {
+                *evicted = this->buffer_.front();
+            }
+        }
+        this->buffer_.insert(it, item);
+        return true;
+    }
+
     mutable std::shared_mutex mutex_;
 
     const size_t limit_;
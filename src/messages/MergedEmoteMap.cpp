@@ -0,0 +1,183 @@
+#include "messages/MergedEmoteMap.hpp"
+
+#include "messages/Emote.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+
+size_t filterIndex(QStringView name, size_t bits)
+{
+    if (name.isEmpty())
+    {
+        return 0;
+    }
+
+    uint64_t key = (uint64_t(name.front().unicode()) << 32) |
+                   (uint64_t(name.back().unicode()) << 16) |
+                   uint64_t(std::min<qsizetype>(name.size(), 0xffff));
+    // Fibonacci hashing
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) % bits;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+std::atomic<uint64_t> MergedEmoteMap::currentGlobalGeneration{0};
+
+MergedEmoteMap::MergedEmoteMap()
+{
+    this->sources_.fill(EMPTY_EMOTE_MAP);
+}
+
+MergedEmoteMap::MergedEmoteMap(const Sources &sources)
+    : sources_(sources)
+{
+    for (auto &source : this->sources_)
+    {
+        if (!source)
+        {
+            source = EMPTY_EMOTE_MAP;
+        }
+    }
+
+    // Insert in reverse priority, so earlier sources overwrite later ones
+    for (const auto &source : this->sources_ | std::views::reverse)
+    {
+        for (const auto &[name, emote] : *source)
+        {
+            this->emotes_.insert_or_assign(name, emote);
+        }
+    }
+
+    this->rebuildFilter();
+}
+
+std::shared_ptr<const MergedEmoteMap> MergedEmoteMap::withSource(
+    Source source, std::shared_ptr<const EmoteMap> emotes) const
+{
+    // Copying only shares the emotes, replaceSource() copies what it changes
+    auto updated = std::make_shared<MergedEmoteMap>(*this);
+    updated->replaceSource(source, std::move(emotes));
+    return updated;
+}
+
+std::shared_ptr<const MergedEmoteMap> MergedEmoteMap::withGlobals(
+    uint64_t generation, std::shared_ptr<const EmoteMap> ffz,
+    std::shared_ptr<const EmoteMap> bttv,
+    std::shared_ptr<const EmoteMap> seventv) const
+{
+    auto updated = std::make_shared<MergedEmoteMap>(*this);
+    updated->globalGeneration_ = generation;
+
+    bool changed = updated->replaceSource(Source::FfzGlobal, std::move(ffz));
+    changed |= updated->replaceSource(Source::BttvGlobal, std::move(bttv));
+    changed |=
+        updated->replaceSource(Source::SeventvGlobal, std::move(seventv));
+    if (changed)
+    {
+        updated->rebuildFilter();
+    }
+    return updated;
+}
+
+EmotePtr MergedEmoteMap::find(const EmoteName &name) const
+{
+    if (this->definitelyMissing(name.string))
+    {
+        return nullptr;
+    }
+
+    auto it = this->emotes_.find(name);
+    if (it == this->emotes_.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+bool MergedEmoteMap::definitelyMissing(QStringView name) const
+{
+    return !this->filter_.test(filterIndex(name, FILTER_BITS));
+}
+
+const std::shared_ptr<const EmoteMap> &MergedEmoteMap::source(
+    Source source) const
+{
+    return this->sources_[static_cast<size_t>(source)];
+}
+
+size_t MergedEmoteMap::size() const
+{
+    return this->emotes_.size();
+}
+
+uint64_t MergedEmoteMap::builtForGlobalGeneration() const
+{
+    return this->globalGeneration_;
+}
+
+uint64_t MergedEmoteMap::globalGeneration()
+{
+    return currentGlobalGeneration.load(std::memory_order_acquire);
+}
+
+void MergedEmoteMap::globalsChanged()
+{
+    currentGlobalGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool MergedEmoteMap::replaceSource(Source source,
+                                   std::shared_ptr<const EmoteMap> emotes)
+{
+    if (!emotes)
+    {
+        emotes = EMPTY_EMOTE_MAP;
+    }
+
+    auto &current = this->sources_[static_cast<size_t>(source)];
+    if (current == emotes)
+    {
+        return false;
+    }
+
+    // Only the names that differ between the previous and the new map can
+    // change. Live updates share most of their nodes with the previous map.
+    auto previous = std::exchange(current, std::move(emotes));
+    previous->forEachDifference(*current, [this](const EmoteName &name) {
+        this->resolve(name);
+    });
+    return true;
+}
+
+void MergedEmoteMap::resolve(const EmoteName &name)
+{
+    for (const auto &source : this->sources_)
+    {
+        auto it = source->find(name);
+        if (it != source->end())
+        {
+            this->emotes_.insert_or_assign(name, it->second);
+            this->filter_.set(filterIndex(name.string, FILTER_BITS));
+            return;
+        }
+    }
+
+    this->emotes_.erase(name);
+}
+
+void MergedEmoteMap::rebuildFilter()
+{
+    this->filter_.reset();
+    for (const auto &[name, emote] : this->emotes_)
+    {
+        this->filter_.set(filterIndex(name.string, FILTER_BITS));
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "common/Aliases.hpp"
+#include "util/PersistentHashMap.hpp"
+
+#include <QStringView>
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+class EmoteMap;
+
+/// An immutable map of all third-party emotes that can be used in a channel.
+///
+/// The emotes of all providers are merged into a single map, so resolving a
+/// word only needs one lookup. Words that can't be an emote are rejected
+/// before hashing them.
+///
+/// Changes to a provider's map are applied with withSource(), which only
+/// re-resolves the names that differ between the old and new map of that
+/// provider. The merged map shares its structure with the map it was created
+/// from, so this doesn't copy all emotes.
+class MergedEmoteMap
+{
+public:
+    /// The providers in the order their emotes are resolved. Emotes from
+    /// earlier providers take precedence over later ones.
+    enum class Source : uint8_t {
+        FfzChannel,
+        BttvChannel,
+        SeventvChannel,
+        FfzGlobal,
+        BttvGlobal,
+        SeventvGlobal,
+    };
+    static constexpr size_t SOURCE_COUNT = 6;
+    using Sources = std::array<std::shared_ptr<const EmoteMap>, SOURCE_COUNT>;
+
+    /// Creates a map without any emotes
+    MergedEmoteMap();
+    explicit MergedEmoteMap(const Sources &sources);
+
+    /// Returns a copy of this map with the emotes of @a source replaced by
+    /// @a emotes.
+    std::shared_ptr<const MergedEmoteMap> withSource(
+        Source source, std::shared_ptr<const EmoteMap> emotes) const;
+
+    /// Returns a copy of this map with the global emotes replaced.
+    ///
+    /// @param generation The value of globalGeneration() before the global
+    ///                   maps were read.
+    std::shared_ptr<const MergedEmoteMap> withGlobals(
+        uint64_t generation, std::shared_ptr<const EmoteMap> ffz,
+        std::shared_ptr<const EmoteMap> bttv,
+        std::shared_ptr<const EmoteMap> seventv) const;
+
+    /// Returns the emote with the given name or an empty pointer
+    EmotePtr find(const EmoteName &name) const;
+
+    /// Returns true if there's no emote with the given name.
+    ///
+    /// This only looks at the first and last character and the length of
+    /// @a name, so it's much cheaper than find(). A return value of false
+    /// doesn't mean that there is an emote with this name.
+    bool definitelyMissing(QStringView name) const;
+
+    const std::shared_ptr<const EmoteMap> &source(Source source) const;
+
+    size_t size() const;
+
+    /// The value of globalGeneration() at the time the global sources were
+    /// set in this map.
+    uint64_t builtForGlobalGeneration() const;
+
+    /// Returns a counter that's incremented every time a global emote map
+    /// changes.
+    static uint64_t globalGeneration();
+    /// Must be called after a global emote map changed
+    static void globalsChanged();
+
+private:
+    /// Replaces the emotes of @a source in place. Returns true if the emotes
+    /// changed.
+    bool replaceSource(Source source, std::shared_ptr<const EmoteMap> emotes);
+    /// Looks up @a name in all sources and updates the merged map and the
+    /// filter
+    void resolve(const EmoteName &name);
+    /// Clears the bits of removed names from the filter
+    void rebuildFilter();
+
+    Sources sources_;
+    PersistentHashMap<EmoteName, EmotePtr> emotes_;
+
+    static constexpr size_t FILTER_BITS = 4096;
+    /// Bloom-like filter over (first character, last character, length) of
+    /// all names in `emotes_`. Bits of removed names are only cleared by
+    /// rebuildFilter(), until then they're false positives.
+    std::bitset<FILTER_BITS> filter_;
+
+    // Never built for any generation, so the globals are set on first use
+    uint64_t globalGeneration_ = std::numeric_limits<uint64_t>::max();
+
+    static std::atomic<uint64_t> currentGlobalGeneration;
+};
+
+}  // namespace chatterino
@@ -18,15 +18,21 @@ namespace chatterino {
 
 using namespace literals;
 
+namespace {
+
+const auto MESSAGES_COUNTER = DebugCount::counter("messages");
+
+}  // namespace
+
 Message::Message()
     : parseTime(QTime::currentTime())
 {
-    DebugCount::increase("messages");
+    MESSAGES_COUNTER.increase();
 }
 
 Message::~Message()
 {
-    DebugCount::decrease("messages");
+    MESSAGES_COUNTER.decrease();
 }
 
 ScrollbarHighlight Message::getScrollBarHighlight() const
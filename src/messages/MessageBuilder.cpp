@@ -11,6 +11,7 @@
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "controllers/userdata/UserDataController.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/Message.hpp"
@@ -28,6 +29,7 @@
 #include "providers/seventv/SeventvEmotes.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/ChannelPointReward.hpp"
+#include "providers/twitch/IrcTags.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
 #include "providers/twitch/TwitchBadges.hpp"
@@ -194,7 +196,7 @@ QString stylizeUsername(const QString &username, const Message &message)
     // The full string that will be rendered in the chat widget
     QString usernameText;
 
-    switch (getSettings()->usernameDisplayMode.getValue())
+    switch (getSettings()->messageBuildSettings()->usernameDisplayMode)
     {
         case UsernameDisplayMode::Username: {
             usernameText = username;
@@ -277,7 +279,8 @@ void appendBadges(MessageBuilder *builder, const std::vector<Badge> &badges,
             tooltip = QString("Twitch cheer %0").arg(cheerAmount);
         }
         else if (badge.key_ == "moderator" &&
-                 getSettings()->useCustomFfzModeratorBadges)
+                 getSettings()->messageBuildSettings()
+                     ->useCustomFfzModeratorBadges)
         {
             if (auto customModBadge = twitchChannel->ffzCustomModBadge())
             {
@@ -290,7 +293,8 @@ void appendBadges(MessageBuilder *builder, const std::vector<Badge> &badges,
                 continue;
             }
         }
-        else if (badge.key_ == "vip" && getSettings()->useCustomFfzVipBadges)
+        else if (badge.key_ == "vip" &&
+                 getSettings()->messageBuildSettings()->useCustomFfzVipBadges)
         {
             if (auto customVipBadge = twitchChannel->ffzCustomVipBadge())
             {
@@ -428,35 +432,18 @@ EmotePtr parseEmote(TwitchChannel *twitchChannel, const EmoteName &name)
     //  - BetterTTV Global
     //  - 7TV Global
 
+    if (twitchChannel != nullptr)
+    {
+        // The merged map already encodes this order
+        return twitchChannel->mergedEmotes()->find(name);
+    }
+
     const auto *globalFfzEmotes = getApp()->getFfzEmotes();
     const auto *globalBttvEmotes = getApp()->getBttvEmotes();
     const auto *globalSeventvEmotes = getApp()->getSeventvEmotes();
 
     std::optional<EmotePtr> emote{};
 
-    if (twitchChannel != nullptr)
-    {
-        // Check for channel emotes
-
-        emote = twitchChannel->ffzEmote(name);
-        if (emote)
-        {
-            return *emote;
-        }
-
-        emote = twitchChannel->bttvEmote(name);
-        if (emote)
-        {
-            return *emote;
-        }
-
-        emote = twitchChannel->seventvEmote(name);
-        if (emote)
-        {
-            return *emote;
-        }
-    }
-
     // Check for global emotes
 
     emote = globalFfzEmotes->emote(name);
@@ -1013,7 +1000,16 @@ void MessageBuilder::addLink(const linkparser::Parsed &parsedLink,
                                    MessageElementFlag::Text, this->textColor_);
     }
 
-    getApp()->getLinkResolver()->resolve(el->linkInfo());
+    if (isGuiThread())
+    {
+        getApp()->getLinkResolver()->resolve(el->linkInfo());
+    }
+    else
+    {
+        // The link info has to live on the GUI thread to receive the
+        // resolved info. It's resolved in finishIrcMessage().
+        el->linkInfo()->moveToThread(QCoreApplication::instance()->thread());
+    }
 }
 
 bool MessageBuilder::isIgnored(const QString &originalMessage,
@@ -1087,6 +1083,11 @@ void MessageBuilder::appendChannelPointRewardMessage(
         return;
     }
 
+    this->appendChannelPointReward(reward);
+}
+
+void MessageBuilder::appendChannelPointReward(const ChannelPointReward &reward)
+{
     this->emplace<TimestampElement>();
     QString redeemed = "Redeemed";
     QStringList textList;
@@ -1519,24 +1520,110 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
     const MessageParseArgs &args, /* mutable */ QString content,
     const QString::size_type messageOffset,
     const std::shared_ptr<MessageThread> &thread, const MessagePtr &parent)
+{
+    auto context = MessageBuilder::prepareIrcMessage(channel, ircMessage, args,
+                                                     content, thread, parent);
+    if (!context)
+    {
+        return {};
+    }
+
+    auto built = MessageBuilder::buildIrcMessage(
+        channel, *context, ircMessage, args, std::move(content), messageOffset);
+    MessageBuilder::finishIrcMessage(*context, built.first);
+    return built;
+}
+
+std::optional<IrcMessageContext> MessageBuilder::prepareIrcMessage(
+    /* mutable */ Channel *channel, const Communi::IrcMessage *ircMessage,
+    const MessageParseArgs &args, const QString &content,
+    const std::shared_ptr<MessageThread> &thread, const MessagePtr &parent)
 {
     assert(ircMessage != nullptr);
     assert(channel != nullptr);
 
-    auto tags = ircMessage->tags();
+    auto tags = IrcTags::fromMessage(ircMessage);
     if (args.allowIgnore)
     {
         bool ignored = MessageBuilder::isIgnored(
-            content, tags.value("user-id").toString(), channel);
+            content, tags.value(IrcTag::UserId), channel);
         if (ignored)
         {
-            return {};
+            return std::nullopt;
+        }
+    }
+
+    IrcMessageContext context{
+        .thread = thread,
+        .parent = parent,
+        .subscribedThread = thread && thread->subscribed(),
+    };
+
+    auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel);
+    MessageBuilder::parseRoomID(tags, twitchChannel);
+    MessageBuilder::parseSharedChatInfo(tags, twitchChannel, context);
+
+    if (!args.channelPointRewardId.isEmpty())
+    {
+        if (auto *source =
+                dynamic_cast<TwitchChannel *>(context.sourceChannel.get()))
+        {
+            twitchChannel = source;
+        }
+        assert(twitchChannel != nullptr);
+
+        auto reward =
+            twitchChannel->channelPointReward(args.channelPointRewardId);
+        if (reward && !isIgnoredMessage({
+                          .message = {},
+                          .twitchUserID = reward->user.id,
+                          .isMod = channel->isMod(),
+                          .isBroadcaster = channel->isBroadcaster(),
+                      }))
+        {
+            context.reward =
+                std::make_shared<const ChannelPointReward>(std::move(*reward));
+        }
+    }
+
+    return context;
+}
+
+void MessageBuilder::finishIrcMessage(const IrcMessageContext &context,
+                                      const MessagePtrMut &message)
+{
+    if (!message)
+    {
+        return;
+    }
+
+    if (context.thread)
+    {
+        context.thread->addToThread(std::weak_ptr<const Message>(message));
+    }
+
+    for (const auto &element : message->elements)
+    {
+        if (auto *link = dynamic_cast<LinkElement *>(element.get()))
+        {
+            getApp()->getLinkResolver()->resolve(link->linkInfo());
         }
     }
+}
+
+std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::buildIrcMessage(
+    /* mutable */ Channel *channel, const IrcMessageContext &context,
+    const Communi::IrcMessage *ircMessage, const MessageParseArgs &args,
+    /* mutable */ QString content, const QString::size_type messageOffset)
+{
+    assert(ircMessage != nullptr);
+    assert(channel != nullptr);
+
+    auto tags = IrcTags::fromMessage(ircMessage);
 
     auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel);
 
-    auto userID = tags.value("user-id").toString();
+    auto userID = tags.value(IrcTag::UserId);
 
     MessageBuilder builder;
     builder.parseUsernameColor(tags, userID);
@@ -1559,53 +1646,61 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
 
     builder.parseMessageID(tags);
 
-    MessageBuilder::parseRoomID(tags, twitchChannel);
-    twitchChannel = builder.parseSharedChatInfo(tags, twitchChannel);
+    if (context.sharedMessage)
+    {
+        builder->flags.set(MessageFlag::SharedMessage);
+    }
+    if (context.sourceChannel)
+    {
+        // avoid duplicate pings
+        builder->flags.set(MessageFlag::DoNotTriggerNotification);
+
+        if (auto *source =
+                dynamic_cast<TwitchChannel *>(context.sourceChannel.get()))
+        {
+            twitchChannel = source;
+        }
+    }
 
     // If it is a reward it has to be appended first
     if (!args.channelPointRewardId.isEmpty())
     {
-        assert(twitchChannel != nullptr);
-        auto reward =
-            twitchChannel->channelPointReward(args.channelPointRewardId);
-        if (reward)
+        if (context.reward)
         {
-            builder.appendChannelPointRewardMessage(*reward, channel->isMod(),
-                                                    channel->isBroadcaster());
+            builder.appendChannelPointReward(*context.reward);
         }
         builder->flags.set(MessageFlag::RedeemedChannelPointReward);
     }
 
     builder.appendChannelName(channel);
 
-    if (tags.contains("rm-deleted"))
+    if (tags.contains(IrcTag::RmDeleted))
     {
         builder->flags.set(MessageFlag::Disabled);
     }
 
-    if (tags.contains("msg-id") &&
-        tags["msg-id"].toString().split(';').contains("highlighted-message"))
+    if (tags.raw(IrcTag::MsgId) == "highlighted-message")
     {
         builder->flags.set(MessageFlag::RedeemedHighlight);
     }
 
-    if (tags.contains("first-msg") && tags["first-msg"].toString() == "1")
+    if (tags.raw(IrcTag::FirstMsg) == "1")
     {
         builder->flags.set(MessageFlag::FirstMessage);
     }
 
-    if (tags.contains("pinned-chat-paid-amount"))
+    if (tags.contains(IrcTag::PinnedChatPaidAmount))
     {
         builder->flags.set(MessageFlag::ElevatedMessage);
     }
 
-    if (tags.contains("bits"))
+    if (tags.contains(IrcTag::Bits))
     {
         builder->flags.set(MessageFlag::CheerMessage);
     }
 
     // reply threads
-    builder.parseThread(content, tags, channel, thread, parent);
+    builder.parseThread(content, tags, channel, context);
 
     // timestamp
     builder->serverReceivedTime = calculateMessageTime(ircMessage);
@@ -1618,8 +1713,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
             return false;
         }
 
-        if (tags.value("user-type").toString() == "mod" &&
-            !args.isStaffOrBroadcaster)
+        if (tags.raw(IrcTag::UserType) == "mod" && !args.isStaffOrBroadcaster)
         {
             // You cannot timeout moderators UNLESS you are Twitch Staff or the broadcaster of the channel
             return false;
@@ -1632,7 +1726,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
         builder.emplace<TwitchModerationElement>();
     }
 
-    builder.appendTwitchBadges(tags, twitchChannel);
+    builder.appendTwitchBadges(tags, twitchChannel, context);
 
     builder.appendChatterinoBadges(userID);
     builder.appendFfzBadges(twitchChannel, userID);
@@ -1643,12 +1737,11 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
     TextState textState{.twitchChannel = twitchChannel};
     QString bits;
 
-    auto iterator = tags.find("bits");
-    if (iterator != tags.end())
+    if (tags.contains(IrcTag::Bits))
     {
+        bits = tags.value(IrcTag::Bits);
         textState.hasBits = true;
-        textState.bitsLeft = iterator.value().toInt();
-        bits = iterator.value().toString();
+        textState.bitsLeft = bits.toInt();
     }
 
     // Twitch emotes
@@ -1683,23 +1776,24 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
 
     // highlights
     HighlightAlert highlight = builder.parseHighlights(tags, content, args);
-    if (tags.contains("historical"))
+    if (tags.contains(IrcTag::Historical))
     {
         highlight.playSound = false;
         highlight.windowAlert = false;
     }
 
     // highlighting incoming whispers if requested per setting
-    if (args.isReceivedWhisper && getSettings()->highlightInlineWhispers)
+    if (args.isReceivedWhisper &&
+        getSettings()->messageBuildSettings()->highlightInlineWhispers)
     {
         builder->flags.set(MessageFlag::HighlightedWhisper);
         builder->highlightColor =
             ColorProvider::instance().color(ColorType::Whisper);
     }
 
-    if (!args.isReceivedWhisper && tags.value("msg-id") != "announcement")
+    if (!args.isReceivedWhisper && tags.raw(IrcTag::MsgId) != "announcement")
     {
-        if (thread)
+        if (const auto &thread = context.thread)
         {
             auto &img = getResources().buttons.replyThreadDark;
             builder
@@ -1791,7 +1885,8 @@ void MessageBuilder::addTextOrEmote(TextState &state, QString string)
         }
     }
 
-    if (state.twitchChannel != nullptr && getSettings()->findAllUsernames)
+    if (state.twitchChannel != nullptr &&
+        getSettings()->messageBuildSettings()->findAllUsernames)
     {
         auto match = allUsernamesMentionRegex.match(string);
         QString username = match.captured(1);
@@ -1853,7 +1948,7 @@ TextElement *MessageBuilder::emplaceSystemTextAndUpdate(const QString &text,
                                       MessageColor::System);
 }
 
-void MessageBuilder::parseUsernameColor(const QVariantMap &tags,
+void MessageBuilder::parseUsernameColor(const IrcTags &tags,
                                         const QString &userID)
 {
     const auto *userData = getApp()->getUserData();
@@ -1869,20 +1964,17 @@ void MessageBuilder::parseUsernameColor(const QVariantMap &tags,
         }
     }
 
-    const auto iterator = tags.find("color");
-    if (iterator != tags.end())
+    if (const auto color = tags.value(IrcTag::Color); !color.isEmpty())
     {
-        if (const auto color = iterator.value().toString(); !color.isEmpty())
-        {
-            this->usernameColor_ = QColor(color);
-            this->message().usernameColor = this->usernameColor_;
-            return;
-        }
+        this->usernameColor_ = QColor(color);
+        this->message().usernameColor = this->usernameColor_;
+        return;
     }
 
-    if (getSettings()->colorizeNicknames && tags.contains("user-id"))
+    if (getSettings()->messageBuildSettings()->colorizeNicknames &&
+        tags.contains(IrcTag::UserId))
     {
-        this->usernameColor_ = getRandomColor(tags.value("user-id").toString());
+        this->usernameColor_ = getRandomColor(tags.value(IrcTag::UserId));
         this->message().usernameColor = this->usernameColor_;
     }
 }
@@ -1913,17 +2005,15 @@ void MessageBuilder::parseUsername(const Communi::IrcMessage *ircMessage,
     }
 }
 
-void MessageBuilder::parseMessageID(const QVariantMap &tags)
+void MessageBuilder::parseMessageID(const IrcTags &tags)
 {
-    auto iterator = tags.find("id");
-
-    if (iterator != tags.end())
+    if (tags.contains(IrcTag::Id))
     {
-        this->message().id = iterator.value().toString();
+        this->message().id = tags.value(IrcTag::Id);
     }
 }
 
-QString MessageBuilder::parseRoomID(const QVariantMap &tags,
+QString MessageBuilder::parseRoomID(const IrcTags &tags,
                                     TwitchChannel *twitchChannel)
 {
     if (twitchChannel == nullptr)
@@ -1931,11 +2021,9 @@ QString MessageBuilder::parseRoomID(const QVariantMap &tags,
         return {};
     }
 
-    auto iterator = tags.find("room-id");
-
-    if (iterator != std::end(tags))
+    if (tags.contains(IrcTag::RoomId))
     {
-        auto roomID = iterator->toString();
+        auto roomID = tags.value(IrcTag::RoomId);
         if (twitchChannel->roomId() != roomID)
         {
             if (twitchChannel->roomId().isEmpty())
@@ -1956,54 +2044,66 @@ QString MessageBuilder::parseRoomID(const QVariantMap &tags,
     return {};
 }
 
-TwitchChannel *MessageBuilder::parseSharedChatInfo(const QVariantMap &tags,
-                                                   TwitchChannel *twitchChannel)
+void MessageBuilder::parseSharedChatInfo(const IrcTags &tags,
+                                         TwitchChannel *twitchChannel,
+                                         IrcMessageContext &context)
 {
     if (!twitchChannel)
     {
-        return twitchChannel;
+        return;
     }
 
-    if (auto it = tags.find("source-room-id"); it != tags.end())
+    if (tags.contains(IrcTag::SourceRoomId))
     {
-        auto sourceRoom = it.value().toString();
+        auto sourceRoom = tags.value(IrcTag::SourceRoomId);
         if (twitchChannel->roomId() != sourceRoom)
         {
-            this->message().flags.set(MessageFlag::SharedMessage);
+            context.sharedMessage = true;
 
             auto sourceChan =
                 getApp()->getTwitch()->getChannelOrEmptyByID(sourceRoom);
             if (sourceChan && !sourceChan->isEmpty())
             {
-                // avoid duplicate pings
-                this->message().flags.set(
-                    MessageFlag::DoNotTriggerNotification);
+                context.sourceChannel = sourceChan;
+            }
+
+            if (!sourceRoom.isEmpty())
+            {
+                auto twitchUser =
+                    getApp()->getTwitchUsers()->resolveID({sourceRoom});
+                auto &source = context.sharedChatSource;
+                source.profilePictureUrl = twitchUser->profilePictureUrl;
+                source.login = twitchUser->name;
 
-                auto *chan = dynamic_cast<TwitchChannel *>(sourceChan.get());
-                if (chan)
+                if (context.sourceChannel)
+                {
+                    // We have the source channel open, but we still need to load the profile picture URL
+                    source.name = context.sourceChannel->getName();
+                }
+                else
                 {
-                    return chan;
+                    source.name = twitchUser->displayName;
                 }
             }
         }
     }
-    return twitchChannel;
 }
 
 void MessageBuilder::parseThread(const QString &messageContent,
-                                 const QVariantMap &tags,
+                                 const IrcTags &tags,
                                  const Channel *channel,
-                                 const std::shared_ptr<MessageThread> &thread,
-                                 const MessagePtr &parent)
+                                 const IrcMessageContext &context)
 {
+    const auto &thread = context.thread;
+    const auto &parent = context.parent;
     if (thread)
     {
-        // set references
+        // set references - the message is added to the thread in
+        // finishIrcMessage()
         this->message().replyThread = thread;
         this->message().replyParent = parent;
-        thread->addToThread(std::weak_ptr{this->message_});
 
-        if (thread->subscribed())
+        if (context.subscribedThread)
         {
             this->message().flags.set(MessageFlag::SubscribedThread);
         }
@@ -2051,15 +2151,13 @@ void MessageBuilder::parseThread(const QString &messageContent,
                 color, FontStyle::ChatMediumSmall)
             ->setLink({Link::ViewThread, thread->rootId()});
     }
-    else if (tags.find("reply-parent-msg-id") != tags.end())
+    else if (tags.contains(IrcTag::ReplyParentMsgId))
     {
         // Message is a reply but we couldn't find the original message.
         // Render the message using the additional reply tags
 
-        auto replyDisplayName = tags.find("reply-parent-display-name");
-        auto replyBody = tags.find("reply-parent-msg-body");
-
-        if (replyDisplayName != tags.end() && replyBody != tags.end())
+        if (tags.contains(IrcTag::ReplyParentDisplayName) &&
+            tags.contains(IrcTag::ReplyParentMsgBody))
         {
             QString body;
 
@@ -2069,16 +2167,15 @@ void MessageBuilder::parseThread(const QString &messageContent,
                 MessageColor::System, FontStyle::ChatMediumSmall);
 
             bool ignored = MessageBuilder::isIgnored(
-                messageContent, tags.value("reply-parent-user-id").toString(),
-                channel);
+                messageContent, tags.value(IrcTag::ReplyParentUserId), channel);
             if (ignored)
             {
                 body = QString("[Blocked user]");
             }
             else
             {
-                auto name = replyDisplayName->toString();
-                body = parseTagString(replyBody->toString());
+                auto name = tags.value(IrcTag::ReplyParentDisplayName);
+                body = tags.unescaped(IrcTag::ReplyParentMsgBody);
 
                 this->emplace<TextElement>(
                         "@" + name + ":", MessageElementFlag::RepliedMessage,
@@ -2095,7 +2192,7 @@ void MessageBuilder::parseThread(const QString &messageContent,
     }
 }
 
-HighlightAlert MessageBuilder::parseHighlights(const QVariantMap &tags,
+HighlightAlert MessageBuilder::parseHighlights(const IrcTags &tags,
                                                const QString &originalMessage,
                                                const MessageParseArgs &args)
 {
@@ -2150,7 +2247,7 @@ void MessageBuilder::appendChannelName(const Channel *channel)
         ->setLink(link);
 }
 
-void MessageBuilder::appendUsername(const QVariantMap &tags,
+void MessageBuilder::appendUsername(const IrcTags &tags,
                                     const MessageParseArgs &args)
 {
     auto *app = getApp();
@@ -2158,11 +2255,9 @@ void MessageBuilder::appendUsername(const QVariantMap &tags,
     QString username = this->message_->loginName;
     QString localizedName;
 
-    auto iterator = tags.find("display-name");
-    if (iterator != tags.end())
+    if (tags.contains(IrcTag::DisplayName))
     {
-        QString displayName =
-            parseTagString(iterator.value().toString()).trimmed();
+        QString displayName = tags.unescaped(IrcTag::DisplayName).trimmed();
 
         if (QString::compare(displayName, username, Qt::CaseInsensitive) == 0)
         {
@@ -2234,7 +2329,8 @@ Outcome MessageBuilder::tryAppendEmote(TwitchChannel *twitchChannel,
         return Failure;
     }
 
-    if (emote->zeroWidth && getSettings()->enableZeroWidthEmotes &&
+    if (emote->zeroWidth &&
+        getSettings()->messageBuildSettings()->enableZeroWidthEmotes &&
         !this->isEmpty())
     {
         // Attempt to merge current zero-width emote into any previous emotes
@@ -2369,8 +2465,9 @@ void MessageBuilder::addWords(
     }
 }
 
-void MessageBuilder::appendTwitchBadges(const QVariantMap &tags,
-                                        TwitchChannel *twitchChannel)
+void MessageBuilder::appendTwitchBadges(const IrcTags &tags,
+                                        TwitchChannel *twitchChannel,
+                                        const IrcMessageContext &context)
 {
     if (twitchChannel == nullptr)
     {
@@ -2379,34 +2476,10 @@ void MessageBuilder::appendTwitchBadges(const QVariantMap &tags,
 
     if (this->message().flags.has(MessageFlag::SharedMessage))
     {
-        const QString sourceId = tags["source-room-id"].toString();
-        QString sourceName;
-        QString sourceProfilePicture;
-        QString sourceLogin;
-
-        if (sourceId.isEmpty())
-        {
-            sourceName = "";
-        }
-        else
-        {
-            auto twitchUser = getApp()->getTwitchUsers()->resolveID({sourceId});
-            sourceProfilePicture = twitchUser->profilePictureUrl;
-            sourceLogin = twitchUser->name;
-
-            if (twitchChannel->roomId() == sourceId)
-            {
-                // We have the source channel open, but we still need to load the profile picture URL
-                sourceName = twitchChannel->getName();
-            }
-            else
-            {
-                sourceName = twitchUser->displayName;
-            }
-        }
-
+        const auto &source = context.sharedChatSource;
         this->emplace<BadgeElement>(
-            makeSharedChatBadge(sourceName, sourceProfilePicture, sourceLogin),
+            makeSharedChatBadge(source.name, source.profilePictureUrl,
+                                source.login),
             MessageElementFlag::BadgeSharedChannel);
     }
 
@@ -2478,7 +2551,7 @@ Outcome MessageBuilder::tryAppendCheermote(TextState &state,
 
     int cheerValue = match.captured(1).toInt();
 
-    if (getSettings()->stackBits)
+    if (getSettings()->messageBuildSettings()->stackBits)
     {
         if (state.bitsStacked)
         {
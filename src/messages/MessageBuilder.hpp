@@ -14,6 +14,7 @@
 
 #include <ctime>
 #include <memory>
+#include <optional>
 #include <utility>
 
 namespace chatterino {
@@ -35,6 +36,7 @@ struct HelixVip;
 using HelixModerator = HelixVip;
 struct ChannelPointReward;
 struct TwitchEmoteOccurrence;
+class IrcTags;
 
 namespace linkparser {
 struct Parsed;
@@ -88,6 +90,34 @@ struct HighlightAlert {
     bool playSound = false;
     bool windowAlert = false;
 };
+
+/// The state of a channel an IRC message is built against
+///
+/// It's captured before building, so the message itself can be built on
+/// another thread.
+/// @see MessageBuilder::prepareIrcMessage()
+struct IrcMessageContext {
+    /// The reply thread this message is part of (if any)
+    std::shared_ptr<MessageThread> thread;
+    /// The message this message is directly replying to (if any)
+    MessagePtr parent;
+    bool subscribedThread = false;
+
+    /// The message was sent in another channel of a shared chat
+    bool sharedMessage = false;
+    /// The channel a shared chat message was sent in, if it's open. Badges and
+    /// emotes are taken from this channel.
+    std::shared_ptr<Channel> sourceChannel;
+    /// The redeemed channel point reward, unless its redeemer is ignored
+    std::shared_ptr<const ChannelPointReward> reward;
+
+    /// The user the channel of a shared chat message belongs to
+    struct {
+        QString name;
+        QString login;
+        QString profilePictureUrl;
+    } sharedChatSource;
+};
 class MessageBuilder
 {
 public:
@@ -234,6 +264,35 @@ public:
         const std::shared_ptr<MessageThread> &thread = {},
         const MessagePtr &parent = {});
 
+    /// @brief The part of makeIrcMessage() before building.
+    ///
+    /// Updates the channel from the message (e.g. its room-ID) and captures
+    /// the state of the channel the message is built against.
+    ///
+    /// @returns The context to build the message with or `std::nullopt` if
+    ///          the message is ignored.
+    static std::optional<IrcMessageContext> prepareIrcMessage(
+        Channel *channel, const Communi::IrcMessage *ircMessage,
+        const MessageParseArgs &args, const QString &content,
+        const std::shared_ptr<MessageThread> &thread,
+        const MessagePtr &parent);
+
+    /// @brief Builds a message prepared by prepareIrcMessage().
+    ///
+    /// Unlike makeIrcMessage(), this can be called from any thread. It only
+    /// reads from @a channel. The built message still has to be passed to
+    /// finishIrcMessage() on the thread that prepared it.
+    static std::pair<MessagePtrMut, HighlightAlert> buildIrcMessage(
+        Channel *channel, const IrcMessageContext &context,
+        const Communi::IrcMessage *ircMessage, const MessageParseArgs &args,
+        QString content, QString::size_type messageOffset);
+
+    /// @brief The part of makeIrcMessage() after building.
+    ///
+    /// Adds @a message to its reply thread and starts resolving its links.
+    static void finishIrcMessage(const IrcMessageContext &context,
+                                 const MessagePtrMut &message);
+
     static MessagePtrMut makeSystemMessageWithUser(
         const QString &text, const QString &loginName,
         const QString &displayName, const MessageColor &userColor,
@@ -271,48 +330,50 @@ private:
     std::unique_ptr<MessageElement> releaseBack();
 
     void parse();
-    void parseUsernameColor(const QVariantMap &tags, const QString &userID);
+    void parseUsernameColor(const IrcTags &tags, const QString &userID);
     void parseUsername(const Communi::IrcMessage *ircMessage,
                        TwitchChannel *twitchChannel,
                        bool trimSubscriberUsername);
-    void parseMessageID(const QVariantMap &tags);
+    void parseMessageID(const IrcTags &tags);
 
     /// Parses the room-ID this message was received in
     ///
     /// @returns The room-ID
-    static QString parseRoomID(const QVariantMap &tags,
+    static QString parseRoomID(const IrcTags &tags,
                                TwitchChannel *twitchChannel);
 
-    /// Parses the shared-chat information from this message.
+    /// Parses the shared-chat information from this message into @a context.
     ///
     /// @param tags The tags of the received message
     /// @param twitchChannel The channel this message was received in
-    /// @returns The source channel - the channel this message originated from.
-    ///          If there's no channel currently open, @a twitchChannel is
-    ///          returned.
-    TwitchChannel *parseSharedChatInfo(const QVariantMap &tags,
-                                       TwitchChannel *twitchChannel);
+    /// @param context Receives the source channel - the channel this message
+    ///                originated from - if it's currently open.
+    static void parseSharedChatInfo(const IrcTags &tags,
+                                    TwitchChannel *twitchChannel,
+                                    IrcMessageContext &context);
 
     // Parse & build thread information into the message
-    // Will read information from thread_ or from IRC tags
-    void parseThread(const QString &messageContent, const QVariantMap &tags,
+    // Will read information from the context's thread or from IRC tags
+    void parseThread(const QString &messageContent, const IrcTags &tags,
                      const Channel *channel,
-                     const std::shared_ptr<MessageThread> &thread,
-                     const MessagePtr &parent);
+                     const IrcMessageContext &context);
     // parseHighlights only updates the visual state of the message, but leaves the playing of alerts and sounds to the triggerHighlights function
-    HighlightAlert parseHighlights(const QVariantMap &tags,
+    HighlightAlert parseHighlights(const IrcTags &tags,
                                    const QString &originalMessage,
                                    const MessageParseArgs &args);
 
     void appendChannelName(const Channel *channel);
-    void appendUsername(const QVariantMap &tags, const MessageParseArgs &args);
+    /// Like appendChannelPointRewardMessage, but without checking if the
+    /// redeemer is ignored
+    void appendChannelPointReward(const ChannelPointReward &reward);
+    void appendUsername(const IrcTags &tags, const MessageParseArgs &args);
 
     void addWords(const QStringList &words,
                   const std::vector<TwitchEmoteOccurrence> &twitchEmotes,
                   TextState &state);
 
-    void appendTwitchBadges(const QVariantMap &tags,
-                            TwitchChannel *twitchChannel);
+    void appendTwitchBadges(const IrcTags &tags, TwitchChannel *twitchChannel,
+                            const IrcMessageContext &context);
     void appendChatterinoBadges(const QString &userID);
     void appendFfzBadges(TwitchChannel *twitchChannel, const QString &userID);
     void appendSeventvBadges(const QString &userID);
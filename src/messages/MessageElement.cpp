@@ -31,6 +31,8 @@ using namespace literals;
 
 namespace {
 
+const auto MESSAGE_ELEMENTS_COUNTER = DebugCount::counter("message elements");
+
 // Computes the bounding box for the given vector of images
 QSizeF getBoundingBoxSize(const std::vector<ImagePtr> &images)
 {
@@ -51,12 +53,12 @@ QSizeF getBoundingBoxSize(const std::vector<ImagePtr> &images)
 MessageElement::MessageElement(MessageElementFlags flags)
     : flags_(flags)
 {
-    DebugCount::increase("message elements");
+    MESSAGE_ELEMENTS_COUNTER.increase();
 }
 
 MessageElement::~MessageElement()
 {
-    DebugCount::decrease("message elements");
+    MESSAGE_ELEMENTS_COUNTER.decrease();
 }
 
 MessageElement *MessageElement::setLink(const Link &link)
@@ -130,7 +132,7 @@ void ImageElement::addToContainer(MessageLayoutContainer &container,
 {
     if (ctx.flags.hasAny(this->getFlags()))
     {
-        container.addElement(new ImageLayoutElement(
+        container.addElement(container.makeElement<ImageLayoutElement>(
             *this, this->image_, this->image_->size() * container.getScale()));
     }
 }
@@ -162,8 +164,10 @@ void CircularImageElement::addToContainer(MessageLayoutContainer &container,
         auto imgSize = QSize(this->image_->width(), this->image_->height()) *
                        container.getScale();
 
-        container.addElement(new ImageWithCircleBackgroundLayoutElement(
-            *this, this->image_, imgSize, this->background_, this->padding_));
+        container.addElement(
+            container.makeElement<ImageWithCircleBackgroundLayoutElement>(
+                *this, this->image_, imgSize, this->background_,
+                this->padding_));
     }
 }
 
@@ -216,7 +220,8 @@ void EmoteElement::addToContainer(MessageLayoutContainer &container,
 
             auto size = image->size() * container.getScale() * emoteScale;
 
-            container.addElement(this->makeImageLayoutElement(image, size));
+            container.addElement(
+                this->makeImageLayoutElement(container, image, size));
             return;
         }
     }
@@ -231,9 +236,9 @@ void EmoteElement::addToContainer(MessageLayoutContainer &container,
 }
 
 MessageLayoutElement *EmoteElement::makeImageLayoutElement(
-    const ImagePtr &image, QSizeF size)
+    MessageLayoutContainer &container, const ImagePtr &image, QSizeF size)
 {
-    return new ImageLayoutElement(*this, image, size);
+    return container.makeElement<ImageLayoutElement>(*this, image, size);
 }
 
 void EmoteElement::ensureText(bool asFallback)
@@ -307,7 +312,7 @@ void LayeredEmoteElement::addToContainer(MessageLayoutContainer &container,
             }
 
             container.addElement(this->makeImageLayoutElement(
-                images, individualSizes, largestSize));
+                container, images, individualSizes, largestSize));
         }
         else
         {
@@ -339,10 +344,11 @@ std::vector<ImagePtr> LayeredEmoteElement::getLoadedImages(float scale)
 }
 
 MessageLayoutElement *LayeredEmoteElement::makeImageLayoutElement(
-    const std::vector<ImagePtr> &images, const std::vector<QSizeF> &sizes,
-    QSizeF largestSize)
+    MessageLayoutContainer &container, const std::vector<ImagePtr> &images,
+    const std::vector<QSizeF> &sizes, QSizeF largestSize)
 {
-    return new LayeredImageLayoutElement(*this, images, sizes, largestSize);
+    return container.makeElement<LayeredImageLayoutElement>(
+        *this, images, sizes, largestSize);
 }
 
 void LayeredEmoteElement::updateTooltips()
@@ -482,7 +488,7 @@ void BadgeElement::addToContainer(MessageLayoutContainer &container,
         }
 
         container.addElement(this->makeImageLayoutElement(
-            image, image->size() * container.getScale()));
+            container, image, image->size() * container.getScale()));
     }
 }
 
@@ -492,9 +498,10 @@ EmotePtr BadgeElement::getEmote() const
 }
 
 MessageLayoutElement *BadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, QSizeF size)
+    MessageLayoutContainer &container, const ImagePtr &image, QSizeF size)
 {
-    auto *element = new ImageLayoutElement(*this, image, size);
+    auto *element =
+        container.makeElement<ImageLayoutElement>(*this, image, size);
 
     return element;
 }
@@ -516,11 +523,11 @@ ModBadgeElement::ModBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *ModBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, QSizeF size)
+    MessageLayoutContainer &container, const ImagePtr &image, QSizeF size)
 {
     static const QColor modBadgeBackgroundColor("#34AE0A");
 
-    auto *element = new ImageWithBackgroundLayoutElement(
+    auto *element = container.makeElement<ImageWithBackgroundLayoutElement>(
         *this, image, size, modBadgeBackgroundColor);
 
     return element;
@@ -542,9 +549,10 @@ VipBadgeElement::VipBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *VipBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, QSizeF size)
+    MessageLayoutContainer &container, const ImagePtr &image, QSizeF size)
 {
-    auto *element = new ImageLayoutElement(*this, image, size);
+    auto *element =
+        container.makeElement<ImageLayoutElement>(*this, image, size);
 
     return element;
 }
@@ -566,10 +574,10 @@ FfzBadgeElement::FfzBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *FfzBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, QSizeF size)
+    MessageLayoutContainer &container, const ImagePtr &image, QSizeF size)
 {
-    auto *element =
-        new ImageWithBackgroundLayoutElement(*this, image, size, this->color);
+    auto *element = container.makeElement<ImageWithBackgroundLayoutElement>(
+        *this, image, size, this->color);
 
     return element;
 }
@@ -613,7 +621,7 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
                 auto color = this->color_.getColor(ctx.messageColors);
                 app->getThemes()->normalizeColor(color);
 
-                auto *e = new TextLayoutElement(
+                auto *e = container.makeElement<TextLayoutElement>(
                     *this, text, QSizeF(width, metrics.height()), color,
                     this->style_, container.getScale());
                 e->setTrailingSpace(hasTrailingSpace);
@@ -623,7 +631,8 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
                 return e;
             };
 
-            auto width = metrics.horizontalAdvance(word);
+            auto width = app->getFonts()->getWordWidth(
+                this->style_, container.getScale(), word);
 
             // see if the text fits in the current line
             if (container.fitsInLine(width))
@@ -856,7 +865,7 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
             auto color = this->color_.getColor(ctx.messageColors);
             app->getThemes()->normalizeColor(color);
 
-            auto *e = new TextLayoutElement(
+            auto *e = container.makeElement<TextLayoutElement>(
                 *this, text, QSizeF(width, metrics.height()), color,
                 this->style_, container.getScale());
             e->setTrailingSpace(hasTrailingSpace);
@@ -910,8 +919,8 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
                     {
                         auto emoteScale = getSettings()->emoteScale.getValue();
 
-                        auto currentWidth =
-                            metrics.horizontalAdvance(currentText);
+                        auto currentWidth = app->getFonts()->getWordWidth(
+                            this->style_, container.getScale(), currentText);
                         auto emoteSize =
                             image->size() * emoteScale * container.getScale();
 
@@ -929,7 +938,9 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
                         currentText.clear();
 
                         container.addElementNoLineBreak(
-                            (new ImageLayoutElement(*this, image, emoteSize))
+                            container
+                                .makeElement<ImageLayoutElement>(*this, image,
+                                                                 emoteSize)
                                 ->setLink(this->getLink())
                                 ->setTrailingSpace(false));
                     }
@@ -945,7 +956,8 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
         // Add the last of the pending message text to the container.
         if (!currentText.isEmpty())
         {
-            auto width = metrics.horizontalAdvance(currentText);
+            auto width = app->getFonts()->getWordWidth(
+                this->style_, container.getScale(), currentText);
             container.addElementNoLineBreak(
                 getTextLayoutElement(currentText, width, false));
         }
@@ -1122,7 +1134,8 @@ TextElement *TimestampElement::formatTime(const QTime &time)
 {
     static QLocale locale("en_US");
 
-    QString format = locale.toString(time, getSettings()->timestampFormat);
+    QString format = locale.toString(
+        time, getSettings()->messageBuildSettings()->timestampFormat);
 
     auto *text =
         new TextElement(format, MessageElementFlag::Timestamp,
@@ -1171,15 +1184,17 @@ void TwitchModerationElement::addToContainer(MessageLayoutContainer &container,
             if (const auto &image = action.getImage())
             {
                 container.addElement(
-                    (new ImageLayoutElement(*this, *image, size))
+                    container
+                        .makeElement<ImageLayoutElement>(*this, *image, size)
                         ->setLink(Link(Link::UserAction, action.getAction())));
             }
             else
             {
                 container.addElement(
-                    (new TextIconLayoutElement(*this, action.getLine1(),
-                                               action.getLine2(),
-                                               container.getScale(), size))
+                    container
+                        .makeElement<TextIconLayoutElement>(
+                            *this, action.getLine1(), action.getLine2(),
+                            container.getScale(), size)
                         ->setLink(Link(Link::UserAction, action.getAction())));
             }
         }
@@ -1235,7 +1250,7 @@ void ScalingImageElement::addToContainer(MessageLayoutContainer &container,
             return;
         }
 
-        container.addElement(new ImageLayoutElement(
+        container.addElement(container.makeElement<ImageLayoutElement>(
             *this, image, image->size() * container.getScale()));
     }
 }
@@ -1265,9 +1280,9 @@ void ReplyCurveElement::addToContainer(MessageLayoutContainer &container,
     if (ctx.flags.hasAny(this->getFlags()))
     {
         float scale = container.getScale();
-        container.addElement(
-            new ReplyCurveLayoutElement(*this, width * scale, thickness * scale,
-                                        radius * scale, margin * scale));
+        container.addElement(container.makeElement<ReplyCurveLayoutElement>(
+            *this, width * scale, thickness * scale, radius * scale,
+            margin * scale));
     }
 }
 
@@ -381,8 +381,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    virtual MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                         QSizeF size);
+    virtual MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        QSizeF size);
 
 private:
     void ensureText(bool asFallback);
@@ -424,8 +425,8 @@ public:
 
 private:
     MessageLayoutElement *makeImageLayoutElement(
-        const std::vector<ImagePtr> &image, const std::vector<QSizeF> &sizes,
-        QSizeF largestSize);
+        MessageLayoutContainer &container, const std::vector<ImagePtr> &image,
+        const std::vector<QSizeF> &sizes, QSizeF largestSize);
 
     QString getCopyString() const;
     void updateTooltips();
@@ -451,8 +452,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    virtual MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                         QSizeF size);
+    virtual MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        QSizeF size);
 
 private:
     EmotePtr emote_;
@@ -466,8 +468,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 QSizeF size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        QSizeF size) override;
 };
 
 class VipBadgeElement : public BadgeElement
@@ -478,8 +481,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 QSizeF size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        QSizeF size) override;
 };
 
 class FfzBadgeElement : public BadgeElement
@@ -491,8 +495,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 QSizeF size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        QSizeF size) override;
     const QColor color;
 };
 
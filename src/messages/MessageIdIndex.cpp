@@ -0,0 +1,112 @@
+#include "messages/MessageIdIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <QHash>
+
+#include <cassert>
+#include <mutex>
+
+namespace chatterino {
+
+size_t MessageIdIndex::Hash::operator()(QStringView id) const noexcept
+{
+    return qHash(id);
+}
+
+MessagePtr MessageIdIndex::find(QStringView id) const
+{
+    std::shared_lock lock(this->mutex_);
+
+    auto it = this->messages_.find(id);
+    if (it == this->messages_.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void MessageIdIndex::addNewest(const MessagePtr &message)
+{
+    if (message->id.isEmpty())
+    {
+        return;
+    }
+
+    std::unique_lock lock(this->mutex_);
+    this->messages_.insert_or_assign(message->id, message);
+}
+
+void MessageIdIndex::addOlder(const MessagePtr &message)
+{
+    if (message->id.isEmpty())
+    {
+        return;
+    }
+
+    std::unique_lock lock(this->mutex_);
+    this->messages_.try_emplace(message->id, message);
+}
+
+void MessageIdIndex::remove(const MessagePtr &message)
+{
+    if (message->id.isEmpty())
+    {
+        return;
+    }
+
+    std::unique_lock lock(this->mutex_);
+    auto it = this->messages_.find(message->id);
+    // a newer message with the same ID might still be in the buffer
+    if (it != this->messages_.end() && it->second == message)
+    {
+        this->messages_.erase(it);
+    }
+}
+
+void MessageIdIndex::replace(const MessagePtr &message,
+                             const MessagePtr &replacement)
+{
+    assert(message->id == replacement->id);
+
+    if (message->id.isEmpty())
+    {
+        return;
+    }
+
+    std::unique_lock lock(this->mutex_);
+    auto it = this->messages_.find(message->id);
+    if (it != this->messages_.end() && it->second == message)
+    {
+        it->second = replacement;
+    }
+}
+
+void MessageIdIndex::rebuild(const std::vector<MessagePtr> &messages)
+{
+    std::unique_lock lock(this->mutex_);
+
+    this->messages_.clear();
+    this->messages_.reserve(messages.size());
+    for (const auto &message : messages)
+    {
+        if (!message->id.isEmpty())
+        {
+            this->messages_.insert_or_assign(message->id, message);
+        }
+    }
+}
+
+void MessageIdIndex::clear()
+{
+    std::unique_lock lock(this->mutex_);
+    this->messages_.clear();
+}
+
+size_t MessageIdIndex::size() const
+{
+    std::shared_lock lock(this->mutex_);
+    return this->messages_.size();
+}
+
+}  // namespace chatterino
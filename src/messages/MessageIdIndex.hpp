@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// Maps message IDs to the messages in a channel's buffer.
+///
+/// If multiple messages in the buffer have the same ID, the index points to
+/// the most recent one (the one closest to the bottom). Messages without an
+/// ID aren't indexed.
+///
+/// This class is thread safe.
+class MessageIdIndex
+{
+public:
+    /// Returns the message with the ID @a id or nullptr if there's none
+    MessagePtr find(QStringView id) const;
+
+    /// Adds @a message, which was added after all other messages
+    void addNewest(const MessagePtr &message);
+    /// Adds @a message, which was added before some other messages. If
+    /// another message with the same ID exists, it's kept.
+    void addOlder(const MessagePtr &message);
+    /// Removes @a message if it's indexed
+    void remove(const MessagePtr &message);
+    /// Replaces @a message with @a replacement, which has the same ID
+    void replace(const MessagePtr &message, const MessagePtr &replacement);
+
+    /// Rebuilds the index from all messages in the buffer (oldest first)
+    void rebuild(const std::vector<MessagePtr> &messages);
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct Hash {
+        using is_transparent = void;
+
+        size_t operator()(QStringView id) const noexcept;
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<QString, MessagePtr, Hash, std::equal_to<>> messages_;
+};
+
+}  // namespace chatterino
@@ -12,34 +12,94 @@ namespace {
 
 using namespace chatterino;
 
-float relativeSimilarity(QStringView str1, QStringView str2)
+template <std::ranges::bidirectional_range T>
+bool inMessages(const MessagePtr &msg, const T &messages,
+                const SimilarityOptions &options)
+{
+    auto now = QTime::currentTime();
+    auto signature = similarity::detail::bigramSignature(msg->messageText);
+
+    for (const auto &prevMsg : messages | std::views::reverse |
+                                   std::views::take(options.maxMessages))
+    {
+        if (prevMsg->parseTime.secsTo(now) >= options.maxDelay)
+        {
+            break;
+        }
+        if (options.bySameUser && msg->loginName != prevMsg->loginName)
+        {
+            continue;
+        }
+        if (similarity::detail::exceedsSimilarity(
+                msg->messageText, signature, prevMsg->messageText,
+                similarity::detail::bigramSignature(prevMsg->messageText),
+                options.threshold))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// Returns true if @a message should be checked for similarity at all
+bool shouldCheckSimilarity(const MessagePtr &message)
+{
+    if (!getSettings()->similarityEnabled)
+    {
+        return false;
+    }
+
+    bool isMyself =
+        message->loginName ==
+        getApp()->getAccounts()->twitch.getCurrent()->getUserName();
+    bool hideMyself = getSettings()->hideSimilarMyself;
+
+    return !isMyself || hideMyself;
+}
+
+void markSimilar(const MessagePtr &message)
+{
+    message->flags.set(MessageFlag::Similar);
+    if (getSettings()->colorSimilarDisabled)
+    {
+        message->flags.set(MessageFlag::Disabled);
+    }
+}
+
+}  // namespace
+
+namespace chatterino::similarity::detail {
+
+float relativeSimilarity(QStringView a, QStringView b)
 {
     using SizeType = QStringView::size_type;
 
+    if (a.isEmpty() || b.isEmpty())
+    {
+        return 0.F;
+    }
+
     // Longest Common Substring Problem
-    std::vector<std::vector<int>> tree(str1.size(),
-                                       std::vector<int>(str2.size(), 0));
-    int z = 0;
+    //
+    // row[j + 1] holds the length of the common suffix of a[..i] and b[..j].
+    // Iterating j backwards lets us reuse the values from the previous row.
+    thread_local std::vector<int> row;
+    row.assign(static_cast<size_t>(b.size()) + 1, 0);
 
-    for (SizeType i = 0; i < str1.size(); ++i)
+    int z = 0;
+    for (SizeType i = 0; i < a.size(); ++i)
     {
-        for (SizeType j = 0; j < str2.size(); ++j)
+        for (SizeType j = b.size(); j > 0; --j)
         {
-            if (str1[i] == str2[j])
+            if (a[i] == b[j - 1])
             {
-                if (i == 0 || j == 0)
-                {
-                    tree[i][j] = 1;
-                }
-                else
-                {
-                    tree[i][j] = tree[i - 1][j - 1] + 1;
-                }
-                z = std::max(tree[i][j], z);
+                row[j] = row[j - 1] + 1;
+                z = std::max(row[j], z);
             }
             else
             {
-                tree[i][j] = 0;
+                row[j] = 0;
             }
         }
     }
@@ -50,65 +110,213 @@ float relativeSimilarity(QStringView str1, QStringView str2)
         return 0.F;
     }
 
-    auto div = std::max<>({static_cast<SizeType>(1), str1.size(), str2.size()});
+    auto div = std::max<>({static_cast<SizeType>(1), a.size(), b.size()});
 
     return float(z) / float(div);
 }
 
-template <std::ranges::bidirectional_range T>
-float inMessages(const MessagePtr &msg, const T &messages)
+uint64_t bigramSignature(QStringView text)
 {
-    float similarityPercent = 0.0F;
+    uint64_t signature = 0;
+    for (QStringView::size_type i = 1; i < text.size(); ++i)
+    {
+        auto bigram = (uint64_t(text[i - 1].unicode()) << 16) |
+                      uint64_t(text[i].unicode());
+        // Fibonacci hashing - the top 6 bits select one of the 64 bits
+        signature |= uint64_t(1) << ((bigram * 0x9E3779B97F4A7C15ULL) >> 58);
+    }
+    return signature;
+}
 
-    for (const auto &prevMsg :
-         messages | std::views::reverse |
-             std::views::take(getSettings()->hideSimilarMaxMessagesToCheck))
+bool exceedsSimilarity(QStringView a, uint64_t aSignature, QStringView b,
+                       uint64_t bSignature, float threshold)
+{
+    auto longer = std::max(a.size(), b.size());
+    auto shorter = std::min(a.size(), b.size());
+    if (longer == 0)
     {
-        if (prevMsg->parseTime.secsTo(QTime::currentTime()) >=
-            getSettings()->hideSimilarMaxDelay)
-        {
-            break;
-        }
-        if (getSettings()->hideSimilarBySameUser &&
-            msg->loginName != prevMsg->loginName)
-        {
-            continue;
-        }
-        similarityPercent = std::max(
-            similarityPercent,
-            relativeSimilarity(msg->messageText, prevMsg->messageText));
+        return false;
+    }
+
+    // The common substring can't be longer than the shorter string
+    if (float(shorter) / float(longer) <= threshold)
+    {
+        return false;
     }
 
-    return similarityPercent;
+    // If a single character isn't enough, the strings must share a bigram
+    if (float(1) / float(longer) <= threshold &&
+        (aSignature & bSignature) == 0)
+    {
+        return false;
+    }
+
+    return relativeSimilarity(a, b) > threshold;
 }
 
-}  // namespace
+}  // namespace chatterino::similarity::detail
 
 namespace chatterino {
 
-template <std::ranges::bidirectional_range T>
-void setSimilarityFlags(const MessagePtr &message, const T &messages)
+SimilarityOptions SimilarityOptions::fromSettings()
 {
-    if (getSettings()->similarityEnabled)
+    auto *settings = getSettings();
+    return {
+        .maxMessages = settings->hideSimilarMaxMessagesToCheck,
+        .maxDelay = settings->hideSimilarMaxDelay,
+        .bySameUser = settings->hideSimilarBySameUser,
+        .threshold = settings->similarityPercentage,
+    };
+}
+
+bool SimilarityIndex::isSimilar(const Message &message,
+                                const SimilarityOptions &options,
+                                QTime now) const
+{
+    std::lock_guard lock(this->mutex_);
+
+    if (this->window_.empty() || options.maxMessages <= 0)
     {
-        bool isMyself =
-            message->loginName ==
-            getApp()->getAccounts()->twitch.getCurrent()->getUserName();
-        bool hideMyself = getSettings()->hideSimilarMyself;
+        return false;
+    }
 
-        if (isMyself && !hideMyself)
+    // Only the last `maxMessages` messages (of any user) are checked
+    uint64_t minSeq = 0;
+    if (this->nextSeq_ > static_cast<uint64_t>(options.maxMessages))
+    {
+        minSeq = this->nextSeq_ - static_cast<uint64_t>(options.maxMessages);
+    }
+
+    auto signature = similarity::detail::bigramSignature(message.messageText);
+    auto check = [&](const Entry &entry) {
+        return similarity::detail::exceedsSimilarity(
+            message.messageText, signature, entry.message->messageText,
+            entry.signature, options.threshold);
+    };
+    auto isTooOld = [&](const Entry &entry) {
+        return entry.message->parseTime.secsTo(now) >= options.maxDelay;
+    };
+
+    if (options.bySameUser)
+    {
+        auto it = this->byAuthor_.find(message.loginName);
+        if (it == this->byAuthor_.end())
         {
-            return;
+            return false;
         }
 
-        if (inMessages(message, messages) > getSettings()->similarityPercentage)
+        for (auto seq : it->second | std::views::reverse)
         {
-            message->flags.set(MessageFlag::Similar);
-            if (getSettings()->colorSimilarDisabled)
+            if (seq < minSeq)
+            {
+                break;
+            }
+
+            const auto &entry = this->entryAt(seq);
+            if (isTooOld(entry))
             {
-                message->flags.set(MessageFlag::Disabled);
+                break;
             }
+            if (check(entry))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for (const auto &entry : this->window_ | std::views::reverse)
+    {
+        if (entry.seq < minSeq || isTooOld(entry))
+        {
+            break;
         }
+        if (check(entry))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SimilarityIndex::add(const MessagePtr &message, size_t capacity)
+{
+    std::lock_guard lock(this->mutex_);
+
+    auto seq = this->nextSeq_++;
+    this->window_.push_back({
+        .seq = seq,
+        .message = message,
+        .signature = similarity::detail::bigramSignature(message->messageText),
+    });
+    this->byAuthor_[message->loginName].push_back(seq);
+
+    while (this->window_.size() > capacity)
+    {
+        this->popFront();
+    }
+}
+
+void SimilarityIndex::clear()
+{
+    std::lock_guard lock(this->mutex_);
+
+    this->window_.clear();
+    this->byAuthor_.clear();
+}
+
+size_t SimilarityIndex::size() const
+{
+    std::lock_guard lock(this->mutex_);
+
+    return this->window_.size();
+}
+
+const SimilarityIndex::Entry &SimilarityIndex::entryAt(uint64_t seq) const
+{
+    assert(!this->window_.empty() && seq >= this->window_.front().seq);
+    return this->window_[seq - this->window_.front().seq];
+}
+
+void SimilarityIndex::popFront()
+{
+    const auto &front = this->window_.front();
+
+    auto it = this->byAuthor_.find(front.message->loginName);
+    assert(it != this->byAuthor_.end() && it->second.front() == front.seq);
+    it->second.pop_front();
+    if (it->second.empty())
+    {
+        this->byAuthor_.erase(it);
+    }
+
+    this->window_.pop_front();
+}
+
+template <std::ranges::bidirectional_range T>
+void setSimilarityFlags(const MessagePtr &message, const T &messages)
+{
+    if (!shouldCheckSimilarity(message))
+    {
+        return;
+    }
+
+    if (inMessages(message, messages, SimilarityOptions::fromSettings()))
+    {
+        markSimilar(message);
+    }
+}
+
+void setSimilarityFlags(const MessagePtr &message, const SimilarityIndex &index)
+{
+    if (!shouldCheckSimilarity(message))
+    {
+        return;
+    }
+
+    if (index.isSimilar(*message, SimilarityOptions::fromSettings()))
+    {
+        markSimilar(message);
     }
 }
 
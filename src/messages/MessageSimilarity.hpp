@@ -2,10 +2,101 @@
 
 #include "messages/Message.hpp"
 
+#include <QString>
+#include <QStringView>
+#include <QTime>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
 #include <ranges>
+#include <unordered_map>
+
 namespace chatterino {
 
+namespace similarity::detail {
+
+/// Returns the length of the longest common substring of @a a and @a b
+/// relative to the length of the longer string.
+///
+/// This only keeps a single row of the dynamic programming table. The row is
+/// reused between calls, so this doesn't allocate in the common case.
+float relativeSimilarity(QStringView a, QStringView b);
+
+/// Returns a 64 bit signature of all bigrams in @a text.
+///
+/// Two strings can only have a common substring of length two or more if
+/// their signatures intersect.
+uint64_t bigramSignature(QStringView text);
+
+/// Returns true if the relative similarity of @a a and @a b is above
+/// @a threshold.
+///
+/// The lengths and signatures of the strings are used to reject most
+/// candidates before running relativeSimilarity().
+bool exceedsSimilarity(QStringView a, uint64_t aSignature, QStringView b,
+                       uint64_t bSignature, float threshold);
+
+}  // namespace similarity::detail
+
+struct SimilarityOptions {
+    /// The number of previous messages to compare against
+    int maxMessages = 3;
+    /// Stop comparing once a message is older than this (in seconds)
+    int maxDelay = 5;
+    /// Only compare against messages from the same user
+    bool bySameUser = true;
+    /// Messages are similar if their similarity is above this value
+    float threshold = 0.9F;
+
+    static SimilarityOptions fromSettings();
+};
+
+/// A rolling window of the most recent messages in a channel.
+///
+/// This is used to find similar messages without having to look at the full
+/// message buffer of the channel. Messages are indexed by their author, so
+/// checks limited to the same user only look at that user's messages.
+///
+/// This class is thread safe.
+class SimilarityIndex
+{
+public:
+    /// Returns true if @a message is similar to one of the recent messages
+    bool isSimilar(const Message &message, const SimilarityOptions &options,
+                   QTime now = QTime::currentTime()) const;
+
+    /// Adds @a message as the most recent message. Only the last @a capacity
+    /// messages are kept.
+    void add(const MessagePtr &message, size_t capacity);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        uint64_t seq;
+        MessagePtr message;
+        uint64_t signature;
+    };
+
+    const Entry &entryAt(uint64_t seq) const;
+    void popFront();
+
+    mutable std::mutex mutex_;
+
+    /// Sequence number of the next added message
+    uint64_t nextSeq_ = 0;
+    std::deque<Entry> window_;
+    /// Sequence numbers of the messages in window_ by login name
+    std::unordered_map<QString, std::deque<uint64_t>> byAuthor_;
+};
+
 template <std::ranges::bidirectional_range T>
 void setSimilarityFlags(const MessagePtr &message, const T &messages);
 
+void setSimilarityFlags(const MessagePtr &message,
+                        const SimilarityIndex &index);
+
 }  // namespace chatterino
@@ -0,0 +1,55 @@
+#include "messages/layouts/IdleLayout.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+void IdleLayout::reset()
+{
+    *this = {};
+}
+
+void IdleLayout::invalidate()
+{
+    this->invalidated_ = true;
+}
+
+std::optional<IdleLayout::Step> IdleLayout::next(size_t start, size_t count,
+                                                 int64_t pageHeight)
+{
+    pageHeight = std::max<int64_t>(pageHeight, 1);
+    const auto aboveLimit = pageHeight * PAGES;
+    // the messages below the start include the viewport
+    const auto belowLimit = pageHeight * (PAGES + 1);
+
+    Step step;
+    if (this->below_ < belowLimit && start + this->distance_ < count)
+    {
+        step.below = start + this->distance_;
+    }
+    if (this->above_ < aboveLimit && this->distance_ > 0 &&
+        this->distance_ <= start)
+    {
+        step.above = start - this->distance_;
+    }
+
+    if (!step.below && !step.above)
+    {
+        if (this->invalidated_)
+        {
+            this->reset();
+            return this->next(start, count, pageHeight);
+        }
+        return std::nullopt;
+    }
+    return step;
+}
+
+void IdleLayout::advance(int belowHeight, int aboveHeight)
+{
+    this->below_ += belowHeight;
+    this->above_ += aboveHeight;
+    this->distance_++;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace chatterino {
+
+/// Progress of laying out the messages around the viewport while idle.
+///
+/// Starting at the first visible message, messages are laid out in pairs:
+/// one below and one above the top of the viewport, each pair one message
+/// further away than the previous one. A side is done once its messages
+/// cover PAGES viewport heights (the viewport itself is added below) or it
+/// runs out of messages.
+///
+/// This only defers work on the GUI thread, laying out a message still happens
+/// there.
+class IdleLayout
+{
+public:
+    /// Off-screen messages are laid out up to this many viewport heights
+    /// above and below the viewport
+    static constexpr int64_t PAGES = 3;
+
+    /// The messages to lay out in one step
+    struct Step {
+        std::optional<size_t> below;
+        std::optional<size_t> above;
+    };
+
+    /// Starts over from the top of the viewport
+    void reset();
+
+    /// Starts over from the top of the viewport once the current pass is
+    /// done. Starting over right away would never get far while the view
+    /// keeps changing (e.g. during a resize).
+    void invalidate();
+
+    /// Returns the messages to lay out next, or std::nullopt once all
+    /// messages in range were laid out and the layout wasn't invalidated
+    /// since the pass started.
+    ///
+    /// @param start The index of the first visible message
+    /// @param count The number of messages
+    /// @param pageHeight The height of the viewport
+    std::optional<Step> next(size_t start, size_t count, int64_t pageHeight);
+
+    /// Records the new heights of the messages of the last step. A side
+    /// that wasn't part of the step has a height of 0.
+    void advance(int belowHeight, int aboveHeight);
+
+private:
+    /// Distance (in messages) from the first visible message of the next
+    /// messages to lay out
+    size_t distance_ = 0;
+    /// Heights of the messages laid out above and below the top of the
+    /// viewport
+    int64_t above_ = 0;
+    int64_t below_ = 0;
+    /// Set if another pass is needed after this one
+    bool invalidated_ = false;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,157 @@
+#include "messages/layouts/MessageHeightIndex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace {
+
+size_t lowbit(size_t i)
+{
+    return i & (~i + 1);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void MessageHeightIndex::assign(std::vector<int> heights)
+{
+    this->heights_ = std::move(heights);
+    this->front_ = 0;
+    this->frontOffset_ = 0;
+
+    auto n = this->heights_.size();
+    this->tree_.assign(n + 1, 0);
+    for (size_t i = 1; i <= n; i++)
+    {
+        this->tree_[i] += this->heights_[i - 1];
+        auto parent = i + lowbit(i);
+        if (parent <= n)
+        {
+            this->tree_[parent] += this->tree_[i];
+        }
+    }
+}
+
+void MessageHeightIndex::clear()
+{
+    this->heights_.clear();
+    this->tree_.clear();
+    this->front_ = 0;
+    this->frontOffset_ = 0;
+}
+
+void MessageHeightIndex::pushBack(int height)
+{
+    if (this->tree_.empty())
+    {
+        this->tree_.push_back(0);
+    }
+
+    this->heights_.push_back(height);
+
+    // `tree_[i]` covers `(i - lowbit(i), i]`, all but the new height are
+    // already in the tree
+    auto i = this->heights_.size();
+    this->tree_.push_back(height + this->prefixSum(i - 1) -
+                          this->prefixSum(i - lowbit(i)));
+}
+
+void MessageHeightIndex::popFront(size_t count)
+{
+    assert(count <= this->size());
+
+    this->front_ += count;
+    if (this->front_ > this->size())
+    {
+        this->assign({this->heights_.begin() + ptrdiff_t(this->front_),
+                      this->heights_.end()});
+        return;
+    }
+    this->frontOffset_ = this->prefixSum(this->front_);
+}
+
+size_t MessageHeightIndex::size() const
+{
+    return this->heights_.size() - this->front_;
+}
+
+bool MessageHeightIndex::empty() const
+{
+    return this->size() == 0;
+}
+
+int MessageHeightIndex::height(size_t index) const
+{
+    assert(index < this->size());
+    return this->heights_[this->front_ + index];
+}
+
+void MessageHeightIndex::setHeight(size_t index, int height)
+{
+    assert(index < this->size());
+
+    index += this->front_;
+    int64_t delta = height - this->heights_[index];
+    if (delta == 0)
+    {
+        return;
+    }
+    this->heights_[index] = height;
+
+    for (auto i = index + 1; i < this->tree_.size(); i += lowbit(i))
+    {
+        this->tree_[i] += delta;
+    }
+}
+
+int64_t MessageHeightIndex::offsetOf(size_t index) const
+{
+    assert(index <= this->size());
+
+    return this->prefixSum(this->front_ + index) - this->frontOffset_;
+}
+
+int64_t MessageHeightIndex::totalHeight() const
+{
+    return this->offsetOf(this->size());
+}
+
+size_t MessageHeightIndex::indexAt(int64_t y) const
+{
+    if (y < 0 || this->empty())
+    {
+        return 0;
+    }
+
+    // Find the number of messages that end at or before y. Removed messages
+    // end before any y, so they're always included.
+    size_t pos = 0;
+    auto remaining = y + this->frontOffset_;
+    for (auto step = std::bit_floor(this->heights_.size()); step > 0;
+         step >>= 1)
+    {
+        auto next = pos + step;
+        if (next < this->tree_.size() && this->tree_[next] <= remaining)
+        {
+            pos = next;
+            remaining -= this->tree_[next];
+        }
+    }
+    return std::max(pos, this->front_) - this->front_;
+}
+
+int64_t MessageHeightIndex::prefixSum(size_t count) const
+{
+    assert(count < this->tree_.size() || count == 0);
+
+    int64_t sum = 0;
+    for (auto i = count; i > 0; i -= lowbit(i))
+    {
+        sum += this->tree_[i];
+    }
+    return sum;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+
+/// Prefix sums over the heights of a list of message layouts.
+///
+/// This is a Fenwick tree (binary indexed tree), so changing the height of
+/// one message and mapping between a vertical offset and a message index are
+/// O(log n). Building the index is O(n). Messages are added at the end and
+/// removed from the start like in a LimitedQueue, both in amortized
+/// O(log n).
+class MessageHeightIndex
+{
+public:
+    /// Replaces all heights
+    void assign(std::vector<int> heights);
+    void clear();
+
+    /// Adds a message with @a height at the end
+    void pushBack(int height);
+    /// Removes the first @a count messages
+    void popFront(size_t count);
+
+    size_t size() const;
+    bool empty() const;
+
+    int height(size_t index) const;
+    /// Sets the height of the message at @a index
+    void setHeight(size_t index, int height);
+
+    /// Returns the sum of the heights of all messages before @a index
+    int64_t offsetOf(size_t index) const;
+    int64_t totalHeight() const;
+
+    /// Returns the index of the message that contains the offset @a y.
+    ///
+    /// Offsets before the first message map to 0, offsets after the last
+    /// message map to size().
+    size_t indexAt(int64_t y) const;
+
+private:
+    /// Returns the sum of the first @a count entries of `heights_`
+    int64_t prefixSum(size_t count) const;
+
+    /// Includes the heights of removed messages until there are more removed
+    /// messages than remaining ones, the index is compacted then.
+    std::vector<int> heights_;
+    /// 1-based Fenwick tree, `tree_[i]` holds the sum of the heights in
+    /// `(i - lowbit(i), i]`
+    std::vector<int64_t> tree_;
+    /// The number of removed messages at the start of `heights_`
+    size_t front_ = 0;
+    /// The sum of the heights of the removed messages
+    int64_t frontOffset_ = 0;
+};
+
+}  // namespace chatterino
@@ -23,6 +23,10 @@ namespace chatterino {
 
 namespace {
 
+const auto MESSAGE_LAYOUT_COUNTER = DebugCount::counter("message layout");
+const auto DRAWING_BUFFERS_COUNTER =
+    DebugCount::counter("message drawing buffers");
+
 QColor blendColors(const QColor &base, const QColor &apply)
 {
     const qreal &alpha = apply.alphaF();
@@ -37,12 +41,12 @@ QColor blendColors(const QColor &base, const QColor &apply)
 MessageLayout::MessageLayout(MessagePtr message)
     : message_(std::move(message))
 {
-    DebugCount::increase("message layout");
+    MESSAGE_LAYOUT_COUNTER.increase();
 }
 
 MessageLayout::~MessageLayout()
 {
-    DebugCount::decrease("message layout");
+    MESSAGE_LAYOUT_COUNTER.decrease();
 }
 
 const Message *MessageLayout::getMessage()
@@ -355,7 +359,7 @@ QPixmap *MessageLayout::ensureBuffer(QPainter &painter, qreal width, bool clear)
     }
 
     this->bufferValid_ = false;
-    DebugCount::increase("message drawing buffers");
+    DRAWING_BUFFERS_COUNTER.increase();
     return this->buffer_.get();
 }
 
@@ -483,7 +487,7 @@ void MessageLayout::deleteBuffer()
 {
     if (this->buffer_ != nullptr)
     {
-        DebugCount::decrease("message drawing buffers");
+        DRAWING_BUFFERS_COUNTER.decrease();
 
         this->buffer_ = nullptr;
     }
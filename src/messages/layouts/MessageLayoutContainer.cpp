@@ -16,6 +16,7 @@
 #include <QPainter>
 #include <QVarLengthArray>
 
+#include <memory>
 #include <optional>
 
 namespace {
@@ -34,10 +35,17 @@ int maxUncollapsedLines()
 
 namespace chatterino {
 
+void MessageLayoutContainer::ElementDeleter::operator()(
+    MessageLayoutElement *element) const
+{
+    std::destroy_at(element);
+}
+
 void MessageLayoutContainer::beginLayout(qreal width, float scale,
                                          float imageScale, MessageFlags flags)
 {
     this->elements_.clear();
+    this->arena_.reset();
     this->lines_.clear();
 
     this->line_ = 0;
@@ -72,7 +80,7 @@ void MessageLayoutContainer::endLayout()
                                      MessageColor::Link);
         static QString dotdotdotText("...");
 
-        auto *element = new TextLayoutElement(
+        auto *element = this->makeElement<TextLayoutElement>(
             dotdotdot, dotdotdotText,
             QSizeF(this->dotdotdotWidth_, this->textLineHeight_),
             QColor("#00D80A"), FontStyle::ChatMediumBold, this->scale_);
@@ -594,7 +602,7 @@ void MessageLayoutContainer::addElement(MessageLayoutElement *element,
     {
         assert(prevIndex == -2 &&
                "element is still referenced in this->elements_");
-        delete element;
+        ElementDeleter{}(element);
         return;
     }
 
@@ -723,8 +731,7 @@ void MessageLayoutContainer::addElement(MessageLayoutElement *element,
     // add element
     if (isAddingMode)
     {
-        this->elements_.push_back(
-            std::unique_ptr<MessageLayoutElement>(element));
+        this->elements_.emplace_back(element);
     }
 
     // set current x
@@ -3,12 +3,14 @@
 #include "common/Common.hpp"
 #include "common/FlagsEnum.hpp"
 #include "messages/MessageFlag.hpp"
+#include "util/BumpArena.hpp"
 
 #include <QPoint>
 #include <QRect>
 
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #if __has_include(<gtest/gtest_prod.h>)
@@ -46,6 +48,18 @@ struct MessageLayoutContainer {
      */
     void endLayout();
 
+    /**
+     * Create an element of type `T` in this container's arena
+     *
+     * The element must be passed to `addElement` or
+     * `addElementNoLineBreak` afterwards. It lives until the next layout pass.
+     */
+    template <typename T, typename... Args>
+    T *makeElement(Args &&...args)
+    {
+        return this->arena_.create<T>(std::forward<Args>(args)...);
+    }
+
     /**
      * Add the given `element` to this message.
      *
@@ -237,11 +251,11 @@ private:
     ///    indicate no predecessor.
     ///
     /// @param element[in] The element to add. This must be non-null and
-    ///                    allocated with `new`. Ownership is transferred
-    ///                    into this container.
+    ///                    created with @a makeElement. Ownership is
+    ///                    transferred into this container.
     /// @param forceAdd When enabled, @a element will be added regardless of
     ///                 `canAddElements`. If @a element won't be added it will
-    ///                 be `delete`d.
+    ///                 be destroyed.
     /// @param prevIndex Controls the "scenario" (see above). `-2` indicates
     ///                  "regular" mode; other values indicate "repositioning".
     ///                  In case of repositioning, this contains the index of
@@ -371,7 +385,18 @@ private:
     /// either LTR or RTL (afterwards this remains constant).
     TextDirection textDirection_ = TextDirection::Neutral;
 
-    std::vector<std::unique_ptr<MessageLayoutElement>> elements_;
+    /// Only runs the destructor, the memory belongs to @a arena_
+    struct ElementDeleter {
+        void operator()(MessageLayoutElement *element) const;
+    };
+
+    /// Holds the elements of the current layout pass. The memory is reused
+    /// for the next pass instead of allocating every element on its own.
+    /// Must be declared before @a elements_, so it outlives them.
+    BumpArena arena_;
+
+    std::vector<std::unique_ptr<MessageLayoutElement, ElementDeleter>>
+        elements_;
 
     /**
      * A list of lines covering this message
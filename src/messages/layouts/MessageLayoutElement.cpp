@@ -14,8 +14,13 @@
 
 namespace {
 
+using chatterino::DebugCount;
+
 const QChar RTL_EMBED(0x202B);
 
+const auto LAYOUT_ELEMENTS_COUNTER =
+    DebugCount::counter("message layout elements");
+
 void alignRectBottomCenter(QRectF &rect, const QRectF &reference)
 {
     QPointF newCenter(reference.center().x(),
@@ -36,12 +41,12 @@ MessageLayoutElement::MessageLayoutElement(MessageElement &creator, QSizeF size)
     : rect_(QPointF{}, size)
     , creator_(creator)
 {
-    DebugCount::increase("message layout elements");
+    LAYOUT_ELEMENTS_COUNTER.increase();
 }
 
 MessageLayoutElement::~MessageLayoutElement()
 {
-    DebugCount::decrease("message layout elements");
+    LAYOUT_ELEMENTS_COUNTER.decrease();
 }
 
 MessageElement &MessageLayoutElement::getCreator() const
@@ -467,15 +472,14 @@ int TextLayoutElement::getMouseOverIndex(QPointF abs) const
         return 0;
     }
 
-    auto *app = getApp();
-
-    auto metrics = app->getFonts()->getFontMetrics(this->style_, this->scale_);
+    auto *fonts = getApp()->getFonts();
     auto x = this->getRect().left();
 
     for (auto i = 0; i < this->getText().size(); i++)
     {
         auto &&text = this->getText();
-        auto width = metrics.horizontalAdvance(this->getText()[i]);
+        auto width =
+            fonts->getCharWidth(this->style_, this->scale_, this->getText()[i]);
 
         // accept mouse to be at only 50%+ of character width to increase index
         if (x + (width * 0.5) > abs.x())
@@ -502,9 +506,7 @@ int TextLayoutElement::getMouseOverIndex(QPointF abs) const
 
 qreal TextLayoutElement::getXFromIndex(size_t index)
 {
-    auto *app = getApp();
-
-    auto metrics = app->getFonts()->getFontMetrics(this->style_, this->scale_);
+    auto *fonts = getApp()->getFonts();
 
     if (index <= 0)
     {
@@ -515,7 +517,8 @@ qreal TextLayoutElement::getXFromIndex(size_t index)
         qreal x = 0;
         for (size_t i = 0; i < index; i++)
         {
-            x += metrics.horizontalAdvance(
+            x += fonts->getCharWidth(
+                this->style_, this->scale_,
                 this->getText()[static_cast<QString::size_type>(i)]);
         }
         return x + this->getRect().left();
@@ -15,7 +15,8 @@ AuthorPredicate::AuthorPredicate(const QString &authors, bool negate)
     }
 }
 
-bool AuthorPredicate::appliesToImpl(const Message &message)
+bool AuthorPredicate::appliesToImpl(const Message &message,
+                                    MessageFlags /*flags*/)
 {
     return authors_.contains(message.displayName, Qt::CaseInsensitive) ||
            authors_.contains(message.loginName, Qt::CaseInsensitive);
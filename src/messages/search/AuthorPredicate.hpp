@@ -33,7 +33,7 @@ protected:
      * @return true if the message was authored by one of the specified users,
      *         false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message, MessageFlags flags) override;
 
 private:
     /// Holds the user names that will be searched for
@@ -31,7 +31,8 @@ BadgePredicate::BadgePredicate(const QString &badges, bool negate)
     }
 }
 
-bool BadgePredicate::appliesToImpl(const Message &message)
+bool BadgePredicate::appliesToImpl(const Message &message,
+                                   MessageFlags /*flags*/)
 {
     for (const Badge &badge : message.badges)
     {
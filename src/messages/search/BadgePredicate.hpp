@@ -33,7 +33,7 @@ protected:
      * @return true if the message contains a badge listed in the specified badges,
      *         false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message, MessageFlags flags) override;
 
 private:
     /// Holds the badges that will be searched for
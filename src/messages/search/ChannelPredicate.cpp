@@ -15,7 +15,8 @@ ChannelPredicate::ChannelPredicate(const QString &channels, bool negate)
     }
 }
 
-bool ChannelPredicate::appliesToImpl(const Message &message)
+bool ChannelPredicate::appliesToImpl(const Message &message,
+                                     MessageFlags /*flags*/)
 {
     return channels_.contains(message.channelName, Qt::CaseInsensitive);
 }
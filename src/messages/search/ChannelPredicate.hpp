@@ -33,7 +33,7 @@ protected:
      * @return true if the message was sent in one of the specified channels,
      *         false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message, MessageFlags flags) override;
 
 private:
     /// Holds the channel names that will be searched for
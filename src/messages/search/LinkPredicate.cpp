@@ -10,7 +10,8 @@ LinkPredicate::LinkPredicate(bool negate)
 {
 }
 
-bool LinkPredicate::appliesToImpl(const Message &message)
+bool LinkPredicate::appliesToImpl(const Message &message,
+                                  MessageFlags /*flags*/)
 {
     for (const auto &word : message.messageText.split(' ', Qt::SkipEmptyParts))
     {
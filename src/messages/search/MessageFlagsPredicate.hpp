@@ -41,7 +41,7 @@ protected:
      * @return true if the message has at least one of the specified flags,
      *         false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message, MessageFlags flags) override;
 
 private:
     /// Holds the flags that will be searched for
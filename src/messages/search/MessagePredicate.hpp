@@ -1,5 +1,7 @@
 #pragma once
 
+#include "messages/MessageFlag.hpp"
+
 #include <memory>
 
 namespace chatterino {
@@ -26,11 +28,14 @@ public:
      * it's set.
      *
      * @param message the message to check for this predicate
+     * @param flags the flags of the message. Searches pass a copy taken on
+     *              the GUI thread, as `Message::flags` can change while they
+     *              run.
      * @return true if this predicate applies, false otherwise
      **/
-    bool appliesTo(const Message &message)
+    bool appliesTo(const Message &message, MessageFlags flags)
     {
-        auto result = this->appliesToImpl(message);
+        auto result = this->appliesToImpl(message, flags);
         if (this->isNegated_)
         {
             return !result;
@@ -51,9 +56,12 @@ protected:
      * in order to be compatible with other MessagePredicates.
      *
      * @param message the message to check for this predicate
+     * @param flags the flags of the message - use these instead of
+     *              `message.flags`
      * @return true if this predicate applies, false otherwise
      */
-    virtual bool appliesToImpl(const Message &message) = 0;
+    virtual bool appliesToImpl(const Message &message,
+                               MessageFlags flags) = 0;
 
 private:
     const bool isNegated_ = false;
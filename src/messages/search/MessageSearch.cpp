@@ -0,0 +1,169 @@
+#include "messages/search/MessageSearch.hpp"
+
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/Message.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+
+namespace chatterino {
+
+namespace {
+
+constexpr int MAX_SEARCH_THREADS = 8;
+
+/// State shared by all workers of one search
+struct SearchState {
+    std::shared_ptr<const std::vector<MessagePtr>> snapshot;
+    /// The flags of the messages in the snapshot, copied on the GUI thread
+    std::vector<MessageFlags> flags;
+    MessageSearch::BatchCallback onBatch;
+    std::function<void()> onFinished;
+    CancellationToken token;
+    size_t chunkCount = 0;
+
+    /// The next chunk a worker should match
+    std::atomic<size_t> nextChunk = 0;
+
+    // The following are only accessed from the GUI thread
+
+    /// Chunks that are matched but can't be delivered yet, because a chunk
+    /// before them is still being matched
+    std::vector<std::optional<std::vector<MessagePtr>>> pending;
+    /// The first chunk that hasn't been delivered
+    size_t nextDelivery = 0;
+
+    void deliver(size_t chunk, std::vector<MessagePtr> matches)
+    {
+        assertInGuiThread();
+        if (this->token.isCancelled())
+        {
+            return;
+        }
+
+        this->pending[chunk] = std::move(matches);
+        while (this->nextDelivery < this->chunkCount &&
+               this->pending[this->nextDelivery])
+        {
+            auto batch = std::move(*this->pending[this->nextDelivery]);
+            this->pending[this->nextDelivery].reset();
+            this->nextDelivery++;
+
+            if (!batch.empty() && this->onBatch)
+            {
+                this->onBatch(batch);
+            }
+            // a callback might have cancelled the search
+            if (this->token.isCancelled())
+            {
+                return;
+            }
+        }
+
+        if (this->nextDelivery == this->chunkCount && this->onFinished)
+        {
+            this->onFinished();
+        }
+    }
+};
+
+void runWorker(const std::shared_ptr<SearchState> &state,
+               const MessageSearch::Matcher &matcher)
+{
+    const auto &snapshot = *state->snapshot;
+
+    while (!state->token.isCancelled())
+    {
+        auto chunk = state->nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= state->chunkCount)
+        {
+            return;
+        }
+
+        auto begin = chunk * MessageSearch::CHUNK_SIZE;
+        auto end =
+            std::min(begin + MessageSearch::CHUNK_SIZE, snapshot.size());
+
+        std::vector<MessagePtr> matches;
+        for (auto i = begin; i < end; i++)
+        {
+            if (matcher(*snapshot[i], state->flags[i]))
+            {
+                matches.push_back(snapshot[i]);
+            }
+        }
+
+        postToThread([state, chunk, matches{std::move(matches)}]() mutable {
+            state->deliver(chunk, std::move(matches));
+        });
+    }
+}
+
+}  // namespace
+
+CancellationToken MessageSearch::start(
+    std::shared_ptr<const std::vector<MessagePtr>> snapshot,
+    const std::function<Matcher()> &makeMatcher, BatchCallback onBatch,
+    std::function<void()> onFinished)
+{
+    assertInGuiThread();
+
+    auto state = std::make_shared<SearchState>();
+    state->snapshot = std::move(snapshot);
+    state->flags.reserve(state->snapshot->size());
+    for (const auto &message : *state->snapshot)
+    {
+        state->flags.push_back(message->flags);
+    }
+    state->onBatch = std::move(onBatch);
+    state->onFinished = std::move(onFinished);
+    state->token = CancellationToken(false);
+    state->chunkCount =
+        (state->snapshot->size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    state->pending.resize(state->chunkCount);
+
+    auto token = state->token;
+    if (state->chunkCount == 0)
+    {
+        if (state->onFinished)
+        {
+            state->onFinished();
+        }
+        return token;
+    }
+
+    auto workers = std::min(static_cast<size_t>(pool().maxThreadCount()),
+                            state->chunkCount);
+    for (size_t i = 0; i < workers; i++)
+    {
+        pool().start([state, matcher = makeMatcher()] {
+            runWorker(state, matcher);
+        });
+    }
+
+    qCDebug(chatterinoMessage) << "Searching" << state->snapshot->size()
+                               << "messages with" << workers << "workers";
+
+    return token;
+}
+
+QThreadPool &MessageSearch::pool()
+{
+    // Intentionally leaked - see ImageDecoder::instance
+    static auto *pool = [] {
+        auto *pool = new QThreadPool;
+        pool->setObjectName("MessageSearch");
+        pool->setMaxThreadCount(std::clamp(QThread::idealThreadCount() - 1, 1,
+                                           MAX_SEARCH_THREADS));
+        return pool;
+    }();
+    return *pool;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ForwardDecl.hpp"
+#include "messages/MessageFlag.hpp"
+#include "util/CancellationToken.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QThreadPool;
+
+namespace chatterino {
+
+/// Matches the messages of a snapshot on a thread pool.
+///
+/// The snapshot is split into chunks of CHUNK_SIZE messages, which are
+/// matched in parallel. Matched messages are delivered to the GUI thread in
+/// batches (one per chunk with at least one match) and in snapshot order,
+/// so results show up while the search is still running.
+class MessageSearch
+{
+public:
+    /// Returns true if a message should be included in the results.
+    ///
+    /// Matchers run on worker threads, while `Message::flags` can still be
+    /// changed on the GUI thread (e.g. when messages are disabled), so they
+    /// get the flags the message had when the search started.
+    using Matcher = std::function<bool(const Message &, MessageFlags)>;
+    using BatchCallback = std::function<void(const std::vector<MessagePtr> &)>;
+
+    static constexpr size_t CHUNK_SIZE = 256;
+
+    /// Starts searching @a snapshot.
+    ///
+    /// @a makeMatcher is called on the calling thread once for every worker,
+    /// so a matcher is only ever used by a single thread at a time and
+    /// doesn't need to be thread-safe.
+    ///
+    /// @a onBatch and @a onFinished are called on the GUI thread. Neither of
+    /// them is called after the returned token has been cancelled.
+    ///
+    /// @returns A token to cancel the search with. Keep it in a
+    ///          ScopedCancellationToken to cancel the search once it's not
+    ///          needed anymore.
+    static CancellationToken start(
+        std::shared_ptr<const std::vector<MessagePtr>> snapshot,
+        const std::function<Matcher()> &makeMatcher, BatchCallback onBatch,
+        std::function<void()> onFinished = nullptr);
+
+private:
+    static QThreadPool &pool();
+};
+
+}  // namespace chatterino
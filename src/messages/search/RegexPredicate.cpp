@@ -2,21 +2,267 @@
 
 #include "messages/Message.hpp"
 
+#include <algorithm>
+
+namespace {
+
+struct RequiredLiteral {
+    QString text;
+    /// Set if the pattern consists of only this literal
+    bool isWholePattern = false;
+};
+
+/// Returns the index of the last character of a closing @a close at or after
+/// @a i (or the end of @a pattern)
+qsizetype skipTo(const QString &pattern, qsizetype i, QChar close)
+{
+    while (i + 1 < pattern.size() && pattern[i] != close)
+    {
+        i++;
+    }
+    return i;
+}
+
+/// Skips the arguments of the escape sequence whose letter is at @a i (like
+/// the "41" in \x41 or the "{L}" in \p{L})
+///
+/// @returns The index of the last character of the escape sequence
+qsizetype skipEscapeArguments(const QString &pattern, qsizetype i)
+{
+    auto letter = pattern[i];
+    auto next = [&] {
+        return i + 1 < pattern.size() ? pattern[i + 1] : QChar();
+    };
+    auto isHexDigit = [](QChar c) {
+        return c.isDigit() || (c.toLower() >= u'a' && c.toLower() <= u'f');
+    };
+
+    if (letter.isDigit())
+    {
+        // octal escape or back reference
+        while (next().isDigit())
+        {
+            i++;
+        }
+        return i;
+    }
+
+    switch (letter.unicode())
+    {
+        case u'x':
+            if (next() == u'{')
+            {
+                return skipTo(pattern, i + 1, u'}');
+            }
+            for (int n = 0; n < 2 && isHexDigit(next()); n++)
+            {
+                i++;
+            }
+            return i;
+        case u'c':
+            return std::min(i + 1, pattern.size() - 1);
+        case u'p':
+        case u'P':
+            if (next() == u'{')
+            {
+                return skipTo(pattern, i + 1, u'}');
+            }
+            return std::min(i + 1, pattern.size() - 1);
+        case u'k':
+        case u'g':
+            if (next() == u'{')
+            {
+                return skipTo(pattern, i + 1, u'}');
+            }
+            if (next() == u'<')
+            {
+                return skipTo(pattern, i + 1, u'>');
+            }
+            if (next() == u'\'')
+            {
+                return skipTo(pattern, i + 2, u'\'');
+            }
+            if (next() == u'-' || next() == u'+')
+            {
+                i++;
+            }
+            while (next().isDigit())
+            {
+                i++;
+            }
+            return i;
+        case u'o':
+        case u'N':
+            if (next() == u'{')
+            {
+                return skipTo(pattern, i + 1, u'}');
+            }
+            return i;
+        default:
+            return i;
+    }
+}
+
+/// Finds the longest run of literal characters that every match of
+/// @a pattern must contain.
+///
+/// This is conservative: Alternations, groups, character classes and
+/// quantifiers end a run (a quantified character is dropped from it). Only
+/// ASCII characters are considered, as their case-insensitive comparison is
+/// the same for Qt and PCRE.
+RequiredLiteral findRequiredLiteral(const QString &pattern)
+{
+    // Alternations make every literal optional, inline options (like (?x))
+    // change how literals are interpreted and \Q...\E quotes metacharacters.
+    if (pattern.contains(u'|') || pattern.contains(u"(?") ||
+        pattern.contains(u"\\Q"))
+    {
+        return {};
+    }
+
+    QString longest;
+    QString run;
+    bool isWholePattern = true;
+    int depth = 0;
+
+    auto endRun = [&] {
+        if (run.size() > longest.size())
+        {
+            longest = run;
+        }
+        run.clear();
+    };
+
+    for (qsizetype i = 0; i < pattern.size(); i++)
+    {
+        auto c = pattern[i];
+
+        if (c == u'\\' && i + 1 < pattern.size())
+        {
+            i++;
+            c = pattern[i];
+            // \. \* \\ ... are literals, \d \w \x41 ... aren't
+            if (c.isLetterOrNumber() || c.unicode() >= 0x80)
+            {
+                i = skipEscapeArguments(pattern, i);
+                isWholePattern = false;
+                endRun();
+                continue;
+            }
+        }
+        else if (c == u'*' || c == u'?' || c == u'{')
+        {
+            // the quantified character might not be there
+            if (!run.isEmpty())
+            {
+                run.chop(1);
+            }
+            if (c == u'{')
+            {
+                i = skipTo(pattern, i, u'}');
+            }
+            isWholePattern = false;
+            endRun();
+            continue;
+        }
+        else if (c == u'[')
+        {
+            // skip the character class
+            i++;
+            if (i < pattern.size() && pattern[i] == u'^')
+            {
+                i++;
+            }
+            if (i < pattern.size() && pattern[i] == u']')
+            {
+                i++;
+            }
+            while (i < pattern.size() && pattern[i] != u']')
+            {
+                if (pattern[i] == u'\\')
+                {
+                    i++;
+                }
+                i++;
+            }
+            isWholePattern = false;
+            endRun();
+            continue;
+        }
+        else if (c == u'(' || c == u')')
+        {
+            depth += c == u'(' ? 1 : -1;
+            isWholePattern = false;
+            endRun();
+            continue;
+        }
+        else if (c == u'.' || c == u'^' || c == u'$' || c == u'+' ||
+                 c == u'}' || c == u'\\')
+        {
+            isWholePattern = false;
+            endRun();
+            continue;
+        }
+
+        // contents of groups might be quantified as a whole
+        if (depth != 0 || c.unicode() >= 0x80)
+        {
+            isWholePattern = false;
+            endRun();
+            continue;
+        }
+
+        run.append(c);
+    }
+    endRun();
+
+    return {
+        .text = longest,
+        .isWholePattern = isWholePattern && !longest.isEmpty(),
+    };
+}
+
+}  // namespace
+
 namespace chatterino {
 
 RegexPredicate::RegexPredicate(const QString &regex, bool negate)
     : MessagePredicate(negate)
     , regex_(regex, QRegularExpression::CaseInsensitiveOption)
 {
+    if (!this->regex_.isValid())
+    {
+        return;
+    }
+
+    auto literal = findRequiredLiteral(regex);
+    if (!literal.text.isEmpty())
+    {
+        this->literal_ = QStringMatcher(literal.text, Qt::CaseInsensitive);
+        this->isLiteral_ = literal.isWholePattern;
+    }
 }
 
-bool RegexPredicate::appliesToImpl(const Message &message)
+bool RegexPredicate::appliesToImpl(const Message &message,
+                                   MessageFlags /*flags*/)
 {
     if (!regex_.isValid())
     {
         return false;
     }
 
+    if (!this->literal_.pattern().isEmpty())
+    {
+        if (this->literal_.indexIn(message.messageText) < 0)
+        {
+            return false;
+        }
+        if (this->isLiteral_)
+        {
+            return true;
+        }
+    }
+
     QRegularExpressionMatch match = regex_.match(message.messageText);
 
     return match.hasMatch();
@@ -4,6 +4,7 @@
 
 #include <QRegularExpression>
 #include <QString>
+#include <QStringMatcher>
 
 namespace chatterino {
 
@@ -36,11 +37,16 @@ protected:
      * @param message the message to check
      * @return true if the message matches the regex, false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message, MessageFlags flags) override;
 
 private:
     /// Holds the regular expression to match the message against
     QRegularExpression regex_;
+    /// Finds a literal every match has to contain. Messages without it are
+    /// rejected without running the regex. Empty if there's no such literal.
+    QStringMatcher literal_;
+    /// Set if the regex is only a literal, so finding it is enough
+    bool isLiteral_ = false;
 };
 
 }  // namespace chatterino
@@ -7,12 +7,18 @@ namespace chatterino {
 SubstringPredicate::SubstringPredicate(const QString &search)
     : MessagePredicate(false)
     , search_(search)
+    , matcher_(search, Qt::CaseInsensitive)
 {
 }
 
-bool SubstringPredicate::appliesToImpl(const Message &message)
+bool SubstringPredicate::appliesToImpl(const Message &message,
+                                       MessageFlags /*flags*/)
 {
-    return message.searchText.contains(this->search_, Qt::CaseInsensitive);
+    if (message.searchText.size() < this->search_.size())
+    {
+        return false;
+    }
+    return this->matcher_.indexIn(message.searchText) >= 0;
 }
 
 }  // namespace chatterino
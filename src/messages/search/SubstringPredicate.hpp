@@ -3,6 +3,7 @@
 #include "messages/search/MessagePredicate.hpp"
 
 #include <QString>
+#include <QStringMatcher>
 
 namespace chatterino {
 
@@ -34,11 +35,14 @@ protected:
      * @param message the message to check
      * @return true if the message contains the substring, false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message, MessageFlags flags) override;
 
 private:
     /// Holds the substring to search for in a message's `messageText`
     const QString search_;
+    /// Searches for `search_` (case-insensitively) without setting up a
+    /// search for every message
+    const QStringMatcher matcher_;
 };
 
 }  // namespace chatterino
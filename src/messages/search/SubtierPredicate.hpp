@@ -33,7 +33,7 @@ protected:
      * @return true if the message contains a subtier listed in the specified subtiers,
      *         false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message, MessageFlags flags) override;
 
 private:
     /// Holds the subtiers that will be searched for
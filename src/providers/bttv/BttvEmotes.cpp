@@ -7,6 +7,7 @@
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
+#include "messages/MergedEmoteMap.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/bttv/liveupdates/BttvLiveUpdateMessages.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
@@ -59,10 +60,7 @@ Url getEmoteLinkV3(const EmoteId &id, const QString &emoteScale)
 
 EmotePtr cachedOrMake(Emote &&emote, const EmoteId &id)
 {
-    static std::unordered_map<EmoteId, std::weak_ptr<const Emote>> cache;
-    static std::mutex mutex;
-
-    return cachedOrMakeEmotePtr(std::move(emote), cache, mutex, id);
+    return internEmote(EmoteProvider::Bttv, id, std::move(emote));
 }
 
 std::pair<Outcome, EmoteMap> parseGlobalEmotes(const QJsonArray &jsonEmotes,
@@ -265,6 +263,7 @@ void BttvEmotes::loadEmotes()
 void BttvEmotes::setEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
     this->global_.set(std::move(emotes));
+    MergedEmoteMap::globalsChanged();
 }
 
 void BttvEmotes::loadChannel(std::weak_ptr<Channel> channel,
@@ -337,11 +336,10 @@ EmotePtr BttvEmotes::addEmote(
     Atomic<std::shared_ptr<const EmoteMap>> &channelEmoteMap,
     const BttvLiveUpdateEmoteUpdateAddMessage &message)
 {
-    // This copies the map.
     EmoteMap updatedMap = *channelEmoteMap.get();
     auto result = createChannelEmote(channelDisplayName, message.jsonEmote);
 
-    auto emote = std::make_shared<const Emote>(std::move(result.emote));
+    auto emote = cachedOrMake(std::move(result.emote), result.id);
     updatedMap[result.name] = emote;
     channelEmoteMap.set(std::make_shared<EmoteMap>(std::move(updatedMap)));
 
@@ -353,15 +351,13 @@ std::optional<std::pair<EmotePtr, EmotePtr>> BttvEmotes::updateEmote(
     Atomic<std::shared_ptr<const EmoteMap>> &channelEmoteMap,
     const BttvLiveUpdateEmoteUpdateAddMessage &message)
 {
-    // This copies the map.
     EmoteMap updatedMap = *channelEmoteMap.get();
 
     // Step 1: remove the existing emote
+    // BTTV only sends the ID, so this searches all emotes
     auto it = updatedMap.findEmote(QString(), message.emoteID);
     if (it == updatedMap.end())
     {
-        // We already copied the map at this point and are now discarding the copy.
-        // This is fine, because this case should be really rare.
         return std::nullopt;
     }
     auto oldEmotePtr = it->second;
@@ -377,7 +373,8 @@ std::optional<std::pair<EmotePtr, EmotePtr>> BttvEmotes::updateEmote(
     }
 
     auto name = emote.name;
-    auto emotePtr = std::make_shared<const Emote>(std::move(emote));
+    auto id = emote.id;
+    auto emotePtr = cachedOrMake(std::move(emote), id);
     updatedMap[name] = emotePtr;
     channelEmoteMap.set(std::make_shared<EmoteMap>(std::move(updatedMap)));
 
@@ -388,13 +385,10 @@ std::optional<EmotePtr> BttvEmotes::removeEmote(
     Atomic<std::shared_ptr<const EmoteMap>> &channelEmoteMap,
     const BttvLiveUpdateEmoteRemoveMessage &message)
 {
-    // This copies the map.
     EmoteMap updatedMap = *channelEmoteMap.get();
     auto it = updatedMap.findEmote(QString(), message.emoteID);
     if (it == updatedMap.end())
     {
-        // We already copied the map at this point and are now discarding the copy.
-        // This is fine, because this case should be really rare.
         return std::nullopt;
     }
     auto emote = it->second;
@@ -5,6 +5,7 @@
 #include "common/QLogging.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
+#include "messages/MergedEmoteMap.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/ffz/FfzUtil.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
@@ -60,10 +61,7 @@ void fillInEmoteData(const QJsonObject &emote, const QJsonObject &urls,
 
 EmotePtr cachedOrMake(Emote &&emote, const EmoteId &id)
 {
-    static std::unordered_map<EmoteId, std::weak_ptr<const Emote>> cache;
-    static std::mutex mutex;
-
-    return cachedOrMakeEmotePtr(std::move(emote), cache, mutex, id);
+    return internEmote(EmoteProvider::Ffz, id, std::move(emote));
 }
 
 void parseEmoteSetInto(const QJsonObject &emoteSet, const QString &kind,
@@ -264,6 +262,7 @@ void FfzEmotes::loadEmotes()
 void FfzEmotes::setEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
     this->global_.set(std::move(emotes));
+    MergedEmoteMap::globalsChanged();
 }
 
 void FfzEmotes::loadChannel(
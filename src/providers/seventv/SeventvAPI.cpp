@@ -34,16 +34,33 @@ void SeventvAPI::getUserByTwitchID(
         .execute();
 }
 
-void SeventvAPI::getEmoteSet(const QString &emoteSet,
-                             SuccessCallback<const QJsonObject &> &&onSuccess,
-                             ErrorCallback &&onError)
+void SeventvAPI::getRawUserByTwitchID(
+    const QString &twitchID, SuccessCallback<const QByteArray &> &&onSuccess,
+    ErrorCallback &&onError)
+{
+    NetworkRequest(API_URL_USER.arg(twitchID), NetworkRequestType::Get)
+        .timeout(20000)
+        .concurrent()
+        .onSuccess(
+            [callback = std::move(onSuccess)](const NetworkResult &result) {
+                callback(result.getData());
+            })
+        .onError([callback = std::move(onError)](const NetworkResult &result) {
+            callback(result);
+        })
+        .execute();
+}
+
+void SeventvAPI::getRawEmoteSet(const QString &emoteSet,
+                                SuccessCallback<const QByteArray &> &&onSuccess,
+                                ErrorCallback &&onError)
 {
     NetworkRequest(API_URL_EMOTE_SET.arg(emoteSet), NetworkRequestType::Get)
         .timeout(25000)
+        .concurrent()
         .onSuccess(
             [callback = std::move(onSuccess)](const NetworkResult &result) {
-                auto json = result.parseJson();
-                callback(json);
+                callback(result.getData());
             })
         .onError([callback = std::move(onError)](const NetworkResult &result) {
             callback(result);
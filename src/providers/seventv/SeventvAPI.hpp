@@ -2,6 +2,7 @@
 
 #include <functional>
 
+class QByteArray;
 class QString;
 class QJsonObject;
 
@@ -27,9 +28,21 @@ public:
     void getUserByTwitchID(const QString &twitchID,
                            SuccessCallback<const QJsonObject &> &&onSuccess,
                            ErrorCallback &&onError);
-    void getEmoteSet(const QString &emoteSet,
-                     SuccessCallback<const QJsonObject &> &&onSuccess,
-                     ErrorCallback &&onError);
+
+    /// Fetches the same user as getUserByTwitchID, but passes the unparsed
+    /// response to @a onSuccess.
+    ///
+    /// Both callbacks are called on a worker thread.
+    void getRawUserByTwitchID(const QString &twitchID,
+                              SuccessCallback<const QByteArray &> &&onSuccess,
+                              ErrorCallback &&onError);
+
+    /// Fetches an emote set and passes the unparsed response to @a onSuccess.
+    ///
+    /// Both callbacks are called on a worker thread.
+    void getRawEmoteSet(const QString &emoteSet,
+                        SuccessCallback<const QByteArray &> &&onSuccess,
+                        ErrorCallback &&onError);
 
     void updatePresence(const QString &twitchChannelID,
                         const QString &seventvUserID,
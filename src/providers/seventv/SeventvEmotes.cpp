@@ -7,20 +7,28 @@
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
+#include "messages/MergedEmoteMap.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/seventv/eventapi/Dispatch.hpp"
 #include "providers/seventv/SeventvAPI.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "singletons/Settings.hpp"
 #include "util/Helpers.hpp"
+#include "util/PostToThread.hpp"
 
 #include <QJsonArray>
-#include <QJsonDocument>
 #include <QJsonObject>
 #include <QStringView>
 #include <QThread>
+#include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
 
+#include <algorithm>
 #include <array>
+#include <initializer_list>
+#include <string>
+#include <string_view>
 #include <utility>
 
 /**
@@ -41,6 +49,33 @@ using namespace seventv::eventapi;
 const QString CHANNEL_HAS_NO_EMOTES("This channel has no 7TV channel emotes.");
 const QString EMOTE_LINK_FORMAT("https://7tv.app/emotes/%1");
 
+/// The parts of an ImageFile we use
+struct ImageFile {
+    QString name;
+    QString staticName;
+    bool isWebp = false;
+    double width = 0.0;
+    int height = 16;
+};
+
+/// The parts of an ActiveEmote and its emoteData we use
+struct ActiveEmote {
+    QString id;
+    QString name;
+    int flags = 0;
+
+    /// Set if emoteData is a non-empty object
+    bool hasData = false;
+    QString baseName;
+    QString author;
+    bool listed = false;
+    int dataFlags = 0;
+
+    // "//cdn.7tv[...]"
+    QString hostUrl;
+    std::vector<ImageFile> files;
+};
+
 struct CreateEmoteResult {
     Emote emote;
     EmoteId id;
@@ -50,23 +85,130 @@ struct CreateEmoteResult {
 
 EmotePtr cachedOrMake(Emote &&emote, const EmoteId &id)
 {
-    static std::unordered_map<EmoteId, std::weak_ptr<const Emote>> cache;
-    static std::mutex mutex;
+    return internEmote(EmoteProvider::Seventv, id, std::move(emote));
+}
 
-    return cachedOrMakeEmotePtr(std::move(emote), cache, mutex, id);
+std::vector<ImageFile> readImageFiles(const QJsonArray &files)
+{
+    std::vector<ImageFile> result;
+    result.reserve(static_cast<size_t>(files.size()));
+    for (auto fileItem : files)
+    {
+        auto file = fileItem.toObject();
+        result.push_back({
+            .name = file["name"].toString(),
+            .staticName = file["static_name"].toString(),
+            .isWebp = file["format"].toString() == "WEBP",
+            .width = file["width"].toDouble(),
+            .height = file["height"].toInt(16),
+        });
+    }
+    return result;
+}
+
+ActiveEmote readActiveEmote(const QJsonObject &activeEmote)
+{
+    auto emoteData = activeEmote["data"].toObject();
+    auto host = emoteData["host"].toObject();
+    return {
+        .id = activeEmote["id"].toString(),
+        .name = activeEmote["name"].toString(),
+        .flags = activeEmote["flags"].toInt(),
+        .hasData = !emoteData.empty(),
+        .baseName = emoteData["name"].toString(),
+        .author = emoteData["owner"].toObject()["display_name"].toString(),
+        .listed = emoteData["listed"].toBool(),
+        .dataFlags = emoteData["flags"].toInt(),
+        .hostUrl = host["url"].toString(),
+        .files = readImageFiles(host["files"].toArray()),
+    };
 }
 
 /**
   * This decides whether an emote should be displayed
   * as zero-width
   */
-bool isZeroWidthActive(const QJsonObject &activeEmote)
+bool isZeroWidthActive(const ActiveEmote &activeEmote)
 {
-    auto flags = SeventvActiveEmoteFlags(
-        SeventvActiveEmoteFlag(activeEmote.value("flags").toInt()));
+    auto flags =
+        SeventvActiveEmoteFlags(SeventvActiveEmoteFlag(activeEmote.flags));
     return flags.has(SeventvActiveEmoteFlag::ZeroWidth);
 }
 
+ImageSet makeImageSet(const QString &baseUrl,
+                      const std::vector<ImageFile> &files, bool useStatic)
+{
+    std::array<ImagePtr, 4> sizes;
+    double baseWidth = 0.0;
+    size_t nextSize = 0;
+
+    for (const auto &file : files)
+    {
+        if (nextSize >= sizes.size())
+        {
+            break;
+        }
+
+        if (!file.isWebp)
+        {
+            continue;  // We only use webp
+        }
+
+        double width = file.width;
+        double scale = 1.0;  // in relation to first image
+        if (baseWidth > 0.0)
+        {
+            scale = baseWidth / width;
+        }
+        else
+        {
+            // => this is the first image
+            baseWidth = width;
+        }
+
+        const auto &name = useStatic && !file.staticName.isEmpty()
+                               ? file.staticName
+                               : file.name;
+
+        auto image =
+            Image::fromUrl({QString("https:%1/%2").arg(baseUrl, name)}, scale,
+                           {static_cast<int>(width), file.height});
+
+        sizes.at(nextSize) = image;
+        nextSize++;
+    }
+
+    if (nextSize < sizes.size())
+    {
+        // this should be really rare
+        // this means we didn't get all sizes of an emote
+        if (nextSize == 0)
+        {
+            qCDebug(chatterinoSeventv)
+                << "Got file list without any eligible files";
+            // When this emote is typed, chatterino will crash.
+            return ImageSet{};
+        }
+        for (; nextSize < sizes.size(); nextSize++)
+        {
+            sizes.at(nextSize) = Image::getEmpty();
+        }
+    }
+
+    // Typically, 7TV provides four versions (1x, 2x, 3x, and 4x). The 3x
+    // version has a scale factor of 1/3, which is a size other providers don't
+    // provide - they only provide the 4x version (0.25). To be in line with
+    // other providers, we prefer the 4x version but fall back to the 3x one if
+    // it doesn't exist.
+    auto largest = std::move(sizes[3]);
+    if (!largest || largest->isEmpty())
+    {
+        largest = std::move(sizes[2]);
+    }
+
+    return ImageSet{sizes[0], sizes[1], largest};
+}
+
 Tooltip createTooltip(const QString &name, const QString &author, bool isGlobal)
 {
     return Tooltip{QString("%1<br>%2 7TV Emote<br>By: %3")
@@ -86,14 +228,12 @@ Tooltip createAliasedTooltip(const QString &name, const QString &baseName,
                                              : author.toHtmlEscaped())};
 }
 
-CreateEmoteResult createEmote(const QJsonObject &activeEmote,
-                              const QJsonObject &emoteData, bool isGlobal)
+CreateEmoteResult createEmote(const ActiveEmote &activeEmote, bool isGlobal)
 {
-    auto emoteId = EmoteId{activeEmote["id"].toString()};
-    auto emoteName = EmoteName{activeEmote["name"].toString()};
-    auto author =
-        EmoteAuthor{emoteData["owner"].toObject()["display_name"].toString()};
-    auto baseEmoteName = EmoteName{emoteData["name"].toString()};
+    auto emoteId = EmoteId{activeEmote.id};
+    auto emoteName = EmoteName{activeEmote.name};
+    auto author = EmoteAuthor{activeEmote.author};
+    auto baseEmoteName = EmoteName{activeEmote.baseName};
     bool zeroWidth = isZeroWidthActive(activeEmote);
     bool aliasedName = emoteName != baseEmoteName;
     auto tooltip =
@@ -101,7 +241,8 @@ CreateEmoteResult createEmote(const QJsonObject &activeEmote,
             ? createAliasedTooltip(emoteName.string, baseEmoteName.string,
                                    author.string, isGlobal)
             : createTooltip(emoteName.string, author.string, isGlobal);
-    auto imageSet = SeventvEmotes::createImageSet(emoteData, false);
+    auto imageSet =
+        makeImageSet(activeEmote.hostUrl, activeEmote.files, false);
 
     auto emote = Emote({
         emoteName,
@@ -117,18 +258,359 @@ CreateEmoteResult createEmote(const QJsonObject &activeEmote,
     return {emote, emoteId, emoteName, !emote.images.getImage1()->isEmpty()};
 }
 
-bool checkEmoteVisibility(const QJsonObject &emoteData)
+bool checkEmoteVisibility(const ActiveEmote &activeEmote)
 {
-    if (!emoteData["listed"].toBool() &&
-        !getSettings()->showUnlistedSevenTVEmotes)
+    if (!activeEmote.listed && !getSettings()->showUnlistedSevenTVEmotes)
     {
         return false;
     }
-    auto flags =
-        SeventvEmoteFlags(SeventvEmoteFlag(emoteData["flags"].toInt()));
+    auto flags = SeventvEmoteFlags(SeventvEmoteFlag(activeEmote.dataFlags));
     return !flags.has(SeventvEmoteFlag::ContentTwitchDisallowed);
 }
 
+void addActiveEmote(EmoteMap &emotes, const ActiveEmote &activeEmote,
+                    bool isGlobal)
+{
+    if (!activeEmote.hasData || !checkEmoteVisibility(activeEmote))
+    {
+        return;
+    }
+
+    auto result = createEmote(activeEmote, isGlobal);
+    if (!result.hasImages)
+    {
+        // this shouldn't happen but if it does, it will crash,
+        // so we don't add the emote
+        qCDebug(chatterinoSeventv)
+            << "Emote without images:" << activeEmote.id << activeEmote.name;
+        return;
+    }
+    emotes[result.name] = cachedOrMake(std::move(result.emote), result.id);
+}
+
+/**
+ * Creates the emotes of an emote set from the events of rapidjson's Reader
+ * (see seventv::detail::readEmoteSet).
+ *
+ * The reader keeps the names of the objects and arrays it's currently in
+ * ("[]" for array items). Only the values that are used are copied - an
+ * emote is added as soon as its object ends.
+ */
+class EmoteSetReader
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, EmoteSetReader>
+{
+public:
+    explicit EmoteSetReader(bool isGlobal)
+        : emotes_(std::make_shared<EmoteMap>())
+        , isGlobal_(isGlobal)
+    {
+    }
+
+    bool StartObject()
+    {
+        this->enter(false);
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType /* memberCount */)
+    {
+        this->leave();
+        return true;
+    }
+
+    bool StartArray()
+    {
+        this->enter(true);
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType /* elementCount */)
+    {
+        this->leave();
+        return true;
+    }
+
+    bool Key(const char *str, rapidjson::SizeType length, bool /* copy */)
+    {
+        this->key_.assign(str, length);
+        if (this->inEmote({"data"}))
+        {
+            this->emote_.hasData = true;
+        }
+        else if (this->at({}) &&
+                 (this->key_ == "emote_set" || this->key_ == "user"))
+        {
+            this->isUser_ = true;
+        }
+        return true;
+    }
+
+    bool String(const char *str, rapidjson::SizeType length, bool /* copy */)
+    {
+        if (auto *field = this->stringField())
+        {
+            *field = QString::fromUtf8(str, static_cast<qsizetype>(length));
+            return true;
+        }
+
+        std::string_view value(str, length);
+        if (this->inEmote({"data", "host", "files", "[]"}) &&
+            this->key_ == "format")
+        {
+            this->emote_.files.back().isWebp = value == "WEBP";
+        }
+        else if (this->at({"user", "connections", "[]"}) &&
+                 this->key_ == "platform" && value == "TWITCH" &&
+                 !this->twitchConnection_)
+        {
+            this->twitchConnection_ = this->connections_ - 1;
+        }
+        return true;
+    }
+
+    bool Bool(bool value)
+    {
+        if (this->inEmote({"data"}) && this->key_ == "listed")
+        {
+            this->emote_.listed = value;
+        }
+        return true;
+    }
+
+    bool Int(int value)
+    {
+        return this->number(value);
+    }
+
+    bool Uint(unsigned value)
+    {
+        return this->number(value);
+    }
+
+    bool Int64(int64_t value)
+    {
+        return this->number(static_cast<double>(value));
+    }
+
+    bool Uint64(uint64_t value)
+    {
+        return this->number(static_cast<double>(value));
+    }
+
+    bool Double(double value)
+    {
+        return this->number(value);
+    }
+
+    seventv::detail::EmoteSetData finish() &&
+    {
+        seventv::detail::EmoteSetData data{
+            .emotes = std::move(this->emotes_),
+            .id = std::move(this->rootID_),
+            .name = std::move(this->rootName_),
+            .userID = std::move(this->userID_),
+            .twitchConnectionIndex =
+                this->twitchConnection_.value_or(this->connections_),
+        };
+        if (this->isUser_)
+        {
+            data.id = std::move(this->setID_);
+            data.name = std::move(this->setName_);
+        }
+        return data;
+    }
+
+private:
+    struct Level {
+        std::string name;
+        bool isArray = false;
+    };
+
+    /// The name of the value that's read next
+    std::string_view nextName() const
+    {
+        if (this->levels_.empty())
+        {
+            return {};
+        }
+        if (this->levels_.back().isArray)
+        {
+            return "[]";
+        }
+        return this->key_;
+    }
+
+    /// Checks if we're directly in @a path (relative to the root value)
+    bool at(std::initializer_list<std::string_view> path) const
+    {
+        return this->matches(1, path);
+    }
+
+    /// Checks if we're directly in @a path (relative to the current emote)
+    bool inEmote(std::initializer_list<std::string_view> path) const
+    {
+        return this->emoteLevel_ != 0 &&
+               this->matches(this->emoteLevel_ + 1, path);
+    }
+
+    bool matches(size_t from,
+                 std::initializer_list<std::string_view> path) const
+    {
+        if (this->levels_.size() != from + path.size())
+        {
+            return false;
+        }
+        return std::equal(path.begin(), path.end(),
+                          this->levels_.begin() +
+                              static_cast<std::ptrdiff_t>(from),
+                          [](std::string_view name, const Level &level) {
+                              return name == level.name;
+                          });
+    }
+
+    void enter(bool isArray)
+    {
+        this->levels_.push_back({std::string(this->nextName()), isArray});
+        if (isArray)
+        {
+            return;
+        }
+
+        if (this->emoteLevel_ == 0 &&
+            (this->at({"emotes", "[]"}) ||
+             this->at({"emote_set", "emotes", "[]"})))
+        {
+            this->emoteLevel_ = this->levels_.size() - 1;
+            this->emote_ = {};
+        }
+        else if (this->inEmote({"data", "host", "files", "[]"}))
+        {
+            this->emote_.files.emplace_back();
+        }
+        else if (this->at({"user", "connections", "[]"}))
+        {
+            this->connections_++;
+        }
+    }
+
+    void leave()
+    {
+        if (this->emoteLevel_ != 0 &&
+            this->levels_.size() == this->emoteLevel_ + 1)
+        {
+            addActiveEmote(*this->emotes_, this->emote_, this->isGlobal_);
+            this->emoteLevel_ = 0;
+        }
+        this->levels_.pop_back();
+    }
+
+    /// The field the next string is read into (if it's used)
+    QString *stringField()
+    {
+        if (this->emoteLevel_ != 0)
+        {
+            auto &emote = this->emote_;
+            if (this->inEmote({}))
+            {
+                return this->pick({{"id", &emote.id}, {"name", &emote.name}});
+            }
+            if (this->inEmote({"data"}))
+            {
+                return this->pick({{"name", &emote.baseName}});
+            }
+            if (this->inEmote({"data", "owner"}))
+            {
+                return this->pick({{"display_name", &emote.author}});
+            }
+            if (this->inEmote({"data", "host"}))
+            {
+                return this->pick({{"url", &emote.hostUrl}});
+            }
+            if (this->inEmote({"data", "host", "files", "[]"}))
+            {
+                auto &file = emote.files.back();
+                return this->pick({{"name", &file.name},
+                                   {"static_name", &file.staticName}});
+            }
+            return nullptr;
+        }
+
+        if (this->at({}))
+        {
+            return this->pick(
+                {{"id", &this->rootID_}, {"name", &this->rootName_}});
+        }
+        if (this->at({"emote_set"}))
+        {
+            return this->pick(
+                {{"id", &this->setID_}, {"name", &this->setName_}});
+        }
+        if (this->at({"user"}))
+        {
+            return this->pick({{"id", &this->userID_}});
+        }
+        return nullptr;
+    }
+
+    QString *pick(
+        std::initializer_list<std::pair<std::string_view, QString *>> fields)
+    {
+        for (const auto &[key, field] : fields)
+        {
+            if (this->key_ == key)
+            {
+                return field;
+            }
+        }
+        return nullptr;
+    }
+
+    bool number(double value)
+    {
+        if (this->inEmote({}) && this->key_ == "flags")
+        {
+            this->emote_.flags = static_cast<int>(value);
+        }
+        else if (this->inEmote({"data"}) && this->key_ == "flags")
+        {
+            this->emote_.dataFlags = static_cast<int>(value);
+        }
+        else if (this->inEmote({"data", "host", "files", "[]"}))
+        {
+            auto &file = this->emote_.files.back();
+            if (this->key_ == "width")
+            {
+                file.width = value;
+            }
+            else if (this->key_ == "height")
+            {
+                file.height = static_cast<int>(value);
+            }
+        }
+        return true;
+    }
+
+    std::shared_ptr<EmoteMap> emotes_;
+    bool isGlobal_;
+
+    std::vector<Level> levels_;
+    std::string key_;
+
+    /// Index of the emote's object in levels_ (0 if we're not in an emote)
+    size_t emoteLevel_ = 0;
+    ActiveEmote emote_;
+
+    /// Set if the root is a user (with an "emote_set")
+    bool isUser_ = false;
+    QString rootID_;
+    QString rootName_;
+    QString setID_;
+    QString setName_;
+    QString userID_;
+    size_t connections_ = 0;
+    std::optional<size_t> twitchConnection_;
+};
+
 EmotePtr createUpdatedEmote(const EmotePtr &oldEmote,
                             const EmoteUpdateDispatch &dispatch)
 {
@@ -136,15 +618,18 @@ EmotePtr createUpdatedEmote(const EmotePtr &oldEmote,
                         dispatch.emoteName == oldEmote->baseName->string;
 
     auto baseName = oldEmote->baseName.value_or(oldEmote->name);
-    auto emote = std::make_shared<const Emote>(Emote(
-        {EmoteName{dispatch.emoteName}, oldEmote->images,
-         toNonAliased
-             ? createTooltip(dispatch.emoteName, oldEmote->author.string, false)
-             : createAliasedTooltip(dispatch.emoteName, baseName.string,
-                                    oldEmote->author.string, false),
-         oldEmote->homePage, oldEmote->zeroWidth, oldEmote->id,
-         oldEmote->author, makeConditionedOptional(!toNonAliased, baseName)}));
-    return emote;
+    return cachedOrMake(
+        Emote({EmoteName{dispatch.emoteName}, oldEmote->images,
+               toNonAliased ? createTooltip(dispatch.emoteName,
+                                            oldEmote->author.string, false)
+                            : createAliasedTooltip(dispatch.emoteName,
+                                                   baseName.string,
+                                                   oldEmote->author.string,
+                                                   false),
+               oldEmote->homePage, oldEmote->zeroWidth, oldEmote->id,
+               oldEmote->author,
+               makeConditionedOptional(!toNonAliased, baseName)}),
+        oldEmote->id);
 }
 
 }  // namespace
@@ -162,28 +647,31 @@ EmoteMap seventv::detail::parseEmotes(const QJsonArray &emoteSetEmotes,
 
     for (const auto &activeEmoteJson : emoteSetEmotes)
     {
-        auto activeEmote = activeEmoteJson.toObject();
-        auto emoteData = activeEmote["data"].toObject();
+        addActiveEmote(emotes, readActiveEmote(activeEmoteJson.toObject()),
+                       isGlobal);
+    }
 
-        if (emoteData.empty() || !checkEmoteVisibility(emoteData))
-        {
-            continue;
-        }
+    return emotes;
+}
 
-        auto result = createEmote(activeEmote, emoteData, isGlobal);
-        if (!result.hasImages)
-        {
-            // this shouldn't happen but if it does, it will crash,
-            // so we don't add the emote
-            qCDebug(chatterinoSeventv)
-                << "Emote without images:" << activeEmote;
-            continue;
-        }
-        auto ptr = cachedOrMake(std::move(result.emote), result.id);
-        emotes[result.name] = ptr;
+std::optional<EmoteSetData> seventv::detail::readEmoteSet(
+    const QByteArray &json, bool isGlobal)
+{
+    EmoteSetReader handler(isGlobal);
+    rapidjson::MemoryStream stream(json.constData(),
+                                   static_cast<size_t>(json.size()));
+    rapidjson::Reader reader;
+    auto result = reader.Parse(stream, handler);
+    if (result.IsError())
+    {
+        qCWarning(chatterinoSeventv)
+            << "Failed to read 7TV emote set:"
+            << rapidjson::GetParseError_En(result.Code()) << "at offset"
+            << result.Offset();
+        return std::nullopt;
     }
 
-    return emotes;
+    return std::move(handler).finish();
 }
 
 SeventvEmotes::SeventvEmotes()
@@ -221,25 +709,31 @@ void SeventvEmotes::loadGlobalEmotes()
         return;
     }
 
-    readProviderEmotesCache("global", "seventv", [this](auto jsonDoc) {
-        auto emoteMap = parseEmotes(jsonDoc.object()["emotes"].toArray(), true);
-        this->setGlobalEmotes(std::make_shared<EmoteMap>(std::move(emoteMap)));
-    });
+    if (auto cached = readProviderEmotesCacheData("global", "seventv"))
+    {
+        if (auto emoteSet = readEmoteSet(*cached, true))
+        {
+            this->setGlobalEmotes(std::move(emoteSet->emotes));
+        }
+    }
 
     qCDebug(chatterinoSeventv) << "Loading 7TV Global Emotes";
 
-    getApp()->getSeventvAPI()->getEmoteSet(
+    getApp()->getSeventvAPI()->getRawEmoteSet(
         u"global"_s,
-        [this](const auto &json) {
-            writeProviderEmotesCache("global", "seventv",
-                                     QJsonDocument(json).toJson());
-            QJsonArray parsedEmotes = json["emotes"].toArray();
+        [this](const QByteArray &data) {
+            auto emoteSet = readEmoteSet(data, true);
+            if (!emoteSet)
+            {
+                return;
+            }
+            writeProviderEmotesCache("global", "seventv", data);
 
-            auto emoteMap = parseEmotes(parsedEmotes, true);
             qCDebug(chatterinoSeventv)
-                << "Loaded" << emoteMap.size() << "7TV Global Emotes";
-            this->setGlobalEmotes(
-                std::make_shared<EmoteMap>(std::move(emoteMap)));
+                << "Loaded" << emoteSet->emotes->size() << "7TV Global Emotes";
+            postToGuiThread([this, emotes = emoteSet->emotes] {
+                this->setGlobalEmotes(emotes);
+            });
         },
         [](const auto &result) {
             qCWarning(chatterinoSeventv)
@@ -250,6 +744,7 @@ void SeventvEmotes::loadGlobalEmotes()
 void SeventvEmotes::setGlobalEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
     this->global_.set(std::move(emotes));
+    MergedEmoteMap::globalsChanged();
 }
 
 void SeventvEmotes::loadChannelEmotes(
@@ -260,65 +755,52 @@ void SeventvEmotes::loadChannelEmotes(
     qCDebug(chatterinoSeventv)
         << "Reloading 7TV Channel Emotes" << channelId << manualRefresh;
 
-    getApp()->getSeventvAPI()->getUserByTwitchID(
+    getApp()->getSeventvAPI()->getRawUserByTwitchID(
         channelId,
         [callback = std::move(callback), channel, channelId,
-         manualRefresh](const auto &json) {
-            writeProviderEmotesCache(channelId, "seventv",
-                                     QJsonDocument(json).toJson());
-            const auto emoteSet = json["emote_set"].toObject();
-            const auto parsedEmotes = emoteSet["emotes"].toArray();
-
-            auto emoteMap = parseEmotes(parsedEmotes, false);
-            bool hasEmotes = !emoteMap.empty();
+         manualRefresh](const QByteArray &data) {
+            auto user = readEmoteSet(data, false);
+            if (user)
+            {
+                writeProviderEmotesCache(channelId, "seventv", data);
+            }
+            bool hasEmotes = user && !user->emotes->empty();
 
             qCDebug(chatterinoSeventv)
-                << "Loaded" << emoteMap.size() << "7TV Channel Emotes for"
-                << channelId << "manual refresh:" << manualRefresh;
+                << "Loaded" << (hasEmotes ? user->emotes->size() : 0)
+                << "7TV Channel Emotes for" << channelId
+                << "manual refresh:" << manualRefresh;
 
-            if (hasEmotes)
-            {
-                auto user = json["user"].toObject();
-
-                size_t connectionIdx = 0;
-                for (const auto &conn : user["connections"].toArray())
+            postToGuiThread([callback, channel, manualRefresh, hasEmotes,
+                             user = std::move(user)] {
+                if (hasEmotes)
                 {
-                    if (conn.toObject()["platform"].toString() == "TWITCH")
-                    {
-                        break;
-                    }
-                    connectionIdx++;
+                    callback(std::move(*user->emotes),
+                             {user->userID, user->id,
+                              user->twitchConnectionIndex});
                 }
 
-                callback(std::move(emoteMap),
-                         {user["id"].toString(), emoteSet["id"].toString(),
-                          connectionIdx});
-            }
-
-            auto shared = channel.lock();
-            if (!shared)
-            {
-                return;
-            }
-
-            if (manualRefresh)
-            {
-                if (hasEmotes)
+                auto shared = channel.lock();
+                if (!shared)
                 {
-                    shared->addSystemMessage("7TV channel emotes reloaded.");
+                    return;
                 }
-                else
+
+                if (manualRefresh)
                 {
-                    shared->addSystemMessage(CHANNEL_HAS_NO_EMOTES);
+                    if (hasEmotes)
+                    {
+                        shared->addSystemMessage(
+                            "7TV channel emotes reloaded.");
+                    }
+                    else
+                    {
+                        shared->addSystemMessage(CHANNEL_HAS_NO_EMOTES);
+                    }
                 }
-            }
+            });
         },
         [channelId, channel, manualRefresh, cacheHit](const auto &result) {
-            auto shared = channel.lock();
-            if (!shared)
-            {
-                return;
-            }
             if (result.status() == 404)
             {
                 qCWarning(chatterinoSeventv)
@@ -326,16 +808,27 @@ void SeventvEmotes::loadChannelEmotes(
                     << result.parseJson();
                 if (manualRefresh)
                 {
-                    shared->addSystemMessage(CHANNEL_HAS_NO_EMOTES);
+                    postToGuiThread([channel] {
+                        if (auto shared = channel.lock())
+                        {
+                            shared->addSystemMessage(CHANNEL_HAS_NO_EMOTES);
+                        }
+                    });
                 }
+                return;
             }
-            else
-            {
-                // TODO: Auto retry in case of a timeout, with a delay
-                auto errorString = result.formatError();
-                qCWarning(chatterinoSeventv)
-                    << "Error fetching 7TV emotes for channel" << channelId
-                    << ", error" << errorString;
+
+            // TODO: Auto retry in case of a timeout, with a delay
+            auto errorString = result.formatError();
+            qCWarning(chatterinoSeventv)
+                << "Error fetching 7TV emotes for channel" << channelId
+                << ", error" << errorString;
+            postToGuiThread([channel, cacheHit, errorString] {
+                auto shared = channel.lock();
+                if (!shared)
+                {
+                    return;
+                }
                 shared->addSystemMessage(
                     QStringLiteral("Failed to fetch 7TV channel "
                                    "emotes. (Error: %1)")
@@ -345,7 +838,7 @@ void SeventvEmotes::loadChannelEmotes(
                     shared->addSystemMessage(
                         "Using cached 7TV emotes as fallback.");
                 }
-            }
+            });
         });
 }
 
@@ -354,15 +847,14 @@ std::optional<EmotePtr> SeventvEmotes::addEmote(
     const EmoteAddDispatch &dispatch)
 {
     // Check for visibility first, so we don't copy the map.
-    auto emoteData = dispatch.emoteJson["data"].toObject();
-    if (emoteData.empty() || !checkEmoteVisibility(emoteData))
+    auto activeEmote = readActiveEmote(dispatch.emoteJson);
+    if (!activeEmote.hasData || !checkEmoteVisibility(activeEmote))
     {
         return std::nullopt;
     }
 
-    // This copies the map.
     EmoteMap updatedMap = *map.get();
-    auto result = createEmote(dispatch.emoteJson, emoteData, false);
+    auto result = createEmote(activeEmote, false);
     if (!result.hasImages)
     {
         // Incoming emote didn't contain any images, abort
@@ -370,7 +862,7 @@ std::optional<EmotePtr> SeventvEmotes::addEmote(
             << "Emote without images:" << dispatch.emoteJson;
         return std::nullopt;
     }
-    auto emote = std::make_shared<const Emote>(std::move(result.emote));
+    auto emote = cachedOrMake(std::move(result.emote), result.id);
     updatedMap[result.name] = emote;
     map.set(std::make_shared<EmoteMap>(std::move(updatedMap)));
 
@@ -388,7 +880,6 @@ std::optional<EmotePtr> SeventvEmotes::updateEmote(
         return std::nullopt;
     }
 
-    // This copies the map.
     EmoteMap updatedMap = *map.get();
     updatedMap.erase(oldEmote->second->name);
 
@@ -403,13 +894,10 @@ std::optional<EmotePtr> SeventvEmotes::removeEmote(
     Atomic<std::shared_ptr<const EmoteMap>> &map,
     const EmoteRemoveDispatch &dispatch)
 {
-    // This copies the map.
     EmoteMap updatedMap = *map.get();
     auto it = updatedMap.findEmote(dispatch.emoteName, dispatch.emoteID);
     if (it == updatedMap.end())
     {
-        // We already copied the map at this point and are now discarding the copy.
-        // This is fine, because this case should be really rare.
         return std::nullopt;
     }
     auto emote = it->second;
@@ -426,21 +914,26 @@ void SeventvEmotes::getEmoteSet(
 {
     qCDebug(chatterinoSeventv) << "Loading 7TV Emote Set" << emoteSetId;
 
-    getApp()->getSeventvAPI()->getEmoteSet(
+    getApp()->getSeventvAPI()->getRawEmoteSet(
         emoteSetId,
-        [callback = std::move(successCallback), emoteSetId](const auto &json) {
+        [callback = std::move(successCallback), onError = errorCallback,
+         emoteSetId](const QByteArray &data) {
             assert(!isAppAboutToQuit());
 
-            auto parsedEmotes = json["emotes"].toArray();
-
-            auto emoteMap = parseEmotes(parsedEmotes, false);
+            auto emoteSet = readEmoteSet(data, false);
+            if (!emoteSet)
+            {
+                onError(u"Invalid JSON"_s);
+                return;
+            }
 
-            qCDebug(chatterinoSeventv) << "Loaded" << emoteMap.size()
-                                       << "7TV Emotes from" << emoteSetId;
+            qCDebug(chatterinoSeventv)
+                << "Loaded" << emoteSet->emotes->size() << "7TV Emotes from"
+                << emoteSetId;
 
-            callback(std::move(emoteMap), json["name"].toString());
+            callback(std::move(*emoteSet->emotes), emoteSet->name);
         },
-        [emoteSetId, callback = std::move(errorCallback)](const auto &result) {
+        [emoteSetId, callback = errorCallback](const auto &result) {
             callback(result.formatError());
         });
 }
@@ -449,88 +942,8 @@ ImageSet SeventvEmotes::createImageSet(const QJsonObject &emoteData,
                                        bool useStatic)
 {
     auto host = emoteData["host"].toObject();
-    // "//cdn.7tv[...]"
-    auto baseUrl = host["url"].toString();
-    auto files = host["files"].toArray();
-
-    std::array<ImagePtr, 4> sizes;
-    double baseWidth = 0.0;
-    size_t nextSize = 0;
-
-    for (auto fileItem : files)
-    {
-        if (nextSize >= sizes.size())
-        {
-            break;
-        }
-
-        auto file = fileItem.toObject();
-        if (file["format"].toString() != "WEBP")
-        {
-            continue;  // We only use webp
-        }
-
-        double width = file["width"].toDouble();
-        double scale = 1.0;  // in relation to first image
-        if (baseWidth > 0.0)
-        {
-            scale = baseWidth / width;
-        }
-        else
-        {
-            // => this is the first image
-            baseWidth = width;
-        }
-
-        auto name = [&] {
-            if (useStatic)
-            {
-                auto staticName = file["static_name"].toString();
-                if (!staticName.isEmpty())
-                {
-                    return staticName;
-                }
-            }
-            return file["name"].toString();
-        }();
-
-        auto image =
-            Image::fromUrl({QString("https:%1/%2").arg(baseUrl, name)}, scale,
-                           {static_cast<int>(width), file["height"].toInt(16)});
-
-        sizes.at(nextSize) = image;
-        nextSize++;
-    }
-
-    if (nextSize < sizes.size())
-    {
-        // this should be really rare
-        // this means we didn't get all sizes of an emote
-        if (nextSize == 0)
-        {
-            qCDebug(chatterinoSeventv)
-                << "Got file list without any eligible files";
-            // When this emote is typed, chatterino will crash.
-            return ImageSet{};
-        }
-        for (; nextSize < sizes.size(); nextSize++)
-        {
-            sizes.at(nextSize) = Image::getEmpty();
-        }
-    }
-
-    // Typically, 7TV provides four versions (1x, 2x, 3x, and 4x). The 3x
-    // version has a scale factor of 1/3, which is a size other providers don't
-    // provide - they only provide the 4x version (0.25). To be in line with
-    // other providers, we prefer the 4x version but fall back to the 3x one if
-    // it doesn't exist.
-    auto largest = std::move(sizes[3]);
-    if (!largest || largest->isEmpty())
-    {
-        largest = std::move(sizes[2]);
-    }
-
-    return ImageSet{sizes[0], sizes[1], largest};
+    return makeImageSet(host["url"].toString(),
+                        readImageFiles(host["files"].toArray()), useStatic);
 }
 
 }  // namespace chatterino
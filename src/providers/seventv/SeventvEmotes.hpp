@@ -5,6 +5,7 @@
 #include "common/FlagsEnum.hpp"
 
 #include <pajlada/signals/scoped-connection.hpp>
+#include <QByteArray>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QString>
@@ -88,6 +89,29 @@ namespace seventv::detail {
 
 EmoteMap parseEmotes(const QJsonArray &emoteSetEmotes, bool isGlobal);
 
+struct EmoteSetData {
+    std::shared_ptr<EmoteMap> emotes;
+    QString id;
+    QString name;
+
+    // The following are only set if a user was read.
+    QString userID;
+    size_t twitchConnectionIndex = 0;
+};
+
+/**
+ * Reads an emote set (/v3/emote-sets/{id}) or a user with their active emote
+ * set (/v3/users/twitch/{id}).
+ *
+ * Unlike parseEmotes, this doesn't build a QJsonDocument first. The emotes
+ * are created while the JSON is read, so this is safe to call on a worker
+ * thread with the raw response.
+ *
+ * @return std::nullopt if @a json isn't valid JSON
+ */
+std::optional<EmoteSetData> readEmoteSet(const QByteArray &json,
+                                         bool isGlobal);
+
 }  // namespace seventv::detail
 
 class SeventvEmotes final
@@ -143,7 +167,11 @@ public:
         Atomic<std::shared_ptr<const EmoteMap>> &map,
         const seventv::eventapi::EmoteRemoveDispatch &dispatch);
 
-    /** Fetches an emote-set by its id */
+    /**
+     * Fetches an emote-set by its id
+     *
+     * The callbacks are called on a worker thread.
+     */
     static void getEmoteSet(
         const QString &emoteSetId,
         std::function<void(EmoteMap &&, QString)> successCallback,
@@ -0,0 +1,256 @@
+#include "providers/twitch/IrcIngestQueue.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <IrcMessage>
+#include <QThread>
+
+#include <algorithm>
+
+namespace {
+
+using chatterino::DebugCount;
+
+const auto QUEUE_COUNTER = DebugCount::counter("irc ingest queue");
+const auto BUILT_COUNTER = DebugCount::counter("irc ingest built");
+const auto DROPPED_COUNTER = DebugCount::counter("irc ingest dropped");
+
+// Building is CPU bound, but messages arrive in order and have to be finished
+// in order, so more threads rarely help.
+constexpr int MAX_BUILD_THREADS = 2;
+
+}  // namespace
+
+namespace chatterino {
+
+IrcIngestQueue::IrcIngestQueue(Prepare prepare, Handler handler,
+                               DropHandler onDropped)
+    : prepare_(std::move(prepare))
+    , handler_(std::move(handler))
+    , onDropped_(std::move(onDropped))
+{
+    this->pool_.setObjectName("IrcIngestQueue");
+    this->pool_.setMaxThreadCount(
+        std::clamp(QThread::idealThreadCount() / 2, 1, MAX_BUILD_THREADS));
+
+    this->drainTimer_.setSingleShot(true);
+    QObject::connect(&this->drainTimer_, &QTimer::timeout, [this] {
+        this->drain();
+    });
+}
+
+IrcIngestQueue::~IrcIngestQueue()
+{
+    // Builds reference this queue, so they have to be done before anything
+    // is destroyed. Results that are still posted to the context are dropped
+    // with it.
+    this->pool_.clear();
+    this->pool_.waitForDone();
+
+    QUEUE_COUNTER.decrease(static_cast<int64_t>(this->size_));
+}
+
+void IrcIngestQueue::push(Communi::IrcMessage *message)
+{
+    auto lane = message->parameters().value(0);
+
+    if (message->type() != Communi::IrcMessage::Private)
+    {
+        auto it = this->lanes_.find(lane);
+        if (it == this->lanes_.end())
+        {
+            this->handler_(message);
+            return;
+        }
+
+        // Communi deletes the message once the signal returns
+        std::shared_ptr<Communi::IrcMessage> copy(message->clone());
+        auto entry = std::make_shared<Entry>();
+        entry->finish = [this, copy] {
+            this->handler_(copy.get());
+        };
+        entry->ready = true;
+        it->second.push_back(std::move(entry));
+        this->size_++;
+        QUEUE_COUNTER.increase();
+        return;
+    }
+
+    if (this->pending_ >= MAX_PENDING)
+    {
+        this->drop(lane);
+        return;
+    }
+
+    auto build = this->prepare_(message);
+    if (!build)
+    {
+        return;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->build = std::move(build);
+    entry->isBuild = true;
+    this->lanes_[lane].push_back(entry);
+    this->size_++;
+    this->pending_++;
+    QUEUE_COUNTER.increase();
+
+    this->pool_.start([this, lane, entry]() mutable {
+        // Only this thread touches the build until it's posted back
+        auto finish = entry->build();
+        BUILT_COUNTER.increase();
+
+        QMetaObject::invokeMethod(
+            &this->context_,
+            [this, lane = std::move(lane), entry = std::move(entry),
+             finish = std::move(finish)]() mutable {
+                this->onBuilt(lane, entry, std::move(finish));
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+size_t IrcIngestQueue::size() const
+{
+    return this->size_;
+}
+
+void IrcIngestQueue::drop(const QString &lane)
+{
+    DROPPED_COUNTER.increase();
+
+    auto &entries = this->lanes_[lane];
+    if (!entries.empty() && entries.back()->dropped > 0)
+    {
+        entries.back()->dropped++;
+        return;
+    }
+
+    auto marker = std::make_shared<Entry>();
+    marker->ready = true;
+    marker->dropped = 1;
+    entries.push_back(std::move(marker));
+    this->size_++;
+    QUEUE_COUNTER.increase();
+
+    if (entries.size() == 1)
+    {
+        this->markReady(lane);
+    }
+}
+
+void IrcIngestQueue::onBuilt(const QString &lane, const EntryPtr &entry,
+                             Finish finish)
+{
+    // Destroy the build (and what it captured) on the GUI thread
+    entry->build = {};
+    entry->finish = std::move(finish);
+    entry->ready = true;
+
+    auto it = this->lanes_.find(lane);
+    if (it != this->lanes_.end() && it->second.front() == entry)
+    {
+        this->markReady(lane);
+    }
+}
+
+void IrcIngestQueue::markReady(const QString &lane)
+{
+    this->readyLanes_.push_back(lane);
+    this->scheduleDrain();
+}
+
+void IrcIngestQueue::drain()
+{
+    while (!this->readyLanes_.empty() && this->hasBudget())
+    {
+        auto lane = this->readyLanes_.front();
+
+        auto it = this->lanes_.find(lane);
+        if (it == this->lanes_.end() || !it->second.front()->ready)
+        {
+            this->readyLanes_.pop_front();
+            continue;
+        }
+
+        auto entry = std::move(it->second.front());
+        it->second.pop_front();
+        if (it->second.empty())
+        {
+            this->lanes_.erase(it);
+            this->readyLanes_.pop_front();
+        }
+        else if (!it->second.front()->ready)
+        {
+            // The lane is marked again once its next message is built
+            this->readyLanes_.pop_front();
+        }
+
+        this->finish(lane, *entry);
+    }
+
+    if (!this->readyLanes_.empty())
+    {
+        this->scheduleDrain();
+    }
+}
+
+void IrcIngestQueue::finish(const QString &lane, Entry &entry)
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    this->size_--;
+    QUEUE_COUNTER.decrease();
+
+    if (entry.isBuild)
+    {
+        this->pending_--;
+    }
+
+    if (entry.dropped > 0)
+    {
+        this->onDropped_(lane, entry.dropped);
+    }
+    else if (entry.finish)
+    {
+        entry.finish();
+    }
+
+    this->spent_ += std::chrono::nanoseconds(elapsed.nsecsElapsed());
+}
+
+bool IrcIngestQueue::hasBudget()
+{
+    if (!this->slice_.isValid() ||
+        std::chrono::milliseconds(this->slice_.elapsed()) >= SLICE)
+    {
+        this->slice_.start();
+        this->spent_ = {};
+    }
+
+    return this->spent_ < BUDGET;
+}
+
+void IrcIngestQueue::scheduleDrain()
+{
+    if (this->drainTimer_.isActive())
+    {
+        return;
+    }
+
+    if (this->hasBudget())
+    {
+        // Finish everything that's built by the time the event loop gets to
+        // the timer in one batch
+        this->drainTimer_.start(0);
+        return;
+    }
+
+    // Wait for the next slice, so the event loop gets the rest of this one
+    auto remaining = SLICE - std::chrono::milliseconds(this->slice_.elapsed());
+    this->drainTimer_.start(std::max(remaining, std::chrono::milliseconds{0}));
+}
+
+}  // namespace chatterino
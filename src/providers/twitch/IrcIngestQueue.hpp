@@ -0,0 +1,121 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace Communi {
+class IrcMessage;
+}  // namespace Communi
+
+namespace chatterino {
+
+/// Builds incoming IRC messages on worker threads.
+///
+/// PRIVMSGs are prepared on the GUI thread (see Prepare), built on a worker
+/// thread and the finished messages are added to their channel on the GUI
+/// thread in batches. Adding them is paced: the GUI thread doesn't spend more
+/// than BUDGET per SLICE on it, so input, scrolling and painting stay
+/// responsive during floods (e.g. raids).
+///
+/// The messages of a channel (its "lane") are always finished in the order
+/// they were pushed. All other messages (e.g. CLEARCHAT) are handled right
+/// away, unless messages of their channel are still being built - then they
+/// wait for them.
+///
+/// At most MAX_PENDING PRIVMSGs are in the queue. PRIVMSGs pushed while the
+/// queue is full are dropped. Consecutive dropped messages of a channel are
+/// reported once through the DropHandler, in place of the messages.
+class IrcIngestQueue
+{
+public:
+    /// Adds a built message on the GUI thread
+    using Finish = std::function<void()>;
+    /// Builds a message on a worker thread
+    using Build = std::function<Finish()>;
+
+    /// Prepares a PRIVMSG on the GUI thread. Returns an empty function if
+    /// there's nothing to build.
+    using Prepare = std::function<Build(Communi::IrcMessage *)>;
+    /// Handles all other messages on the GUI thread
+    using Handler = std::function<void(Communi::IrcMessage *)>;
+    /// Reports @a count dropped messages of @a lane on the GUI thread
+    using DropHandler = std::function<void(const QString &lane, size_t count)>;
+
+    static constexpr std::chrono::milliseconds SLICE{16};
+    static constexpr std::chrono::milliseconds BUDGET{8};
+    static constexpr size_t MAX_PENDING = 1000;
+
+    IrcIngestQueue(Prepare prepare, Handler handler, DropHandler onDropped);
+    ~IrcIngestQueue();
+
+    IrcIngestQueue(const IrcIngestQueue &) = delete;
+    IrcIngestQueue &operator=(const IrcIngestQueue &) = delete;
+    IrcIngestQueue(IrcIngestQueue &&) = delete;
+    IrcIngestQueue &operator=(IrcIngestQueue &&) = delete;
+
+    /// Builds or handles @a message.
+    ///
+    /// @a message is owned by the caller and only used during this call.
+    void push(Communi::IrcMessage *message);
+
+    /// Returns the number of messages that aren't finished yet
+    size_t size() const;
+
+private:
+    struct Entry {
+        /// Set until the message is built
+        Build build;
+        Finish finish;
+        /// Set for PRIVMSGs - they count towards MAX_PENDING
+        bool isBuild = false;
+        /// Set once the entry can be finished
+        bool ready = false;
+        /// Number of dropped messages this entry stands for
+        size_t dropped = 0;
+    };
+    using EntryPtr = std::shared_ptr<Entry>;
+
+    void drop(const QString &lane);
+    void onBuilt(const QString &lane, const EntryPtr &entry, Finish finish);
+    void markReady(const QString &lane);
+
+    /// Finishes ready messages until the budget of this slice is used up
+    void drain();
+    void finish(const QString &lane, Entry &entry);
+    /// Returns true if there's budget left in the current slice. Starts a new
+    /// slice if the current one is over.
+    bool hasBudget();
+    void scheduleDrain();
+
+    Prepare prepare_;
+    Handler handler_;
+    DropHandler onDropped_;
+
+    /// Unfinished messages by their channel
+    std::unordered_map<QString, std::deque<EntryPtr>> lanes_;
+    /// Lanes whose first message is ready to be finished
+    std::deque<QString> readyLanes_;
+    size_t size_ = 0;
+    /// Number of PRIVMSGs that are built or waiting to be finished
+    size_t pending_ = 0;
+
+    /// Receives the built messages on the GUI thread
+    QObject context_;
+    QThreadPool pool_;
+
+    QTimer drainTimer_;
+    QElapsedTimer slice_;
+    /// Time spent finishing messages in the current slice
+    std::chrono::nanoseconds spent_{0};
+};
+
+}  // namespace chatterino
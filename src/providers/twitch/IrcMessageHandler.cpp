@@ -32,6 +32,7 @@
 #include <QStringBuilder>
 
 #include <memory>
+#include <tuple>
 
 using namespace chatterino::literals;
 
@@ -185,6 +186,225 @@ struct ReplyContext {
     MessagePtr parent;
 };
 
+/// Updates the badges of the current user in @a channel from their own
+/// message
+void updateOwnBadges(Communi::IrcMessage *message, TwitchChannel &channel)
+{
+    auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
+    if (message->tag("user-id") == currentUser->getUserId())
+    {
+        auto badgesTag = message->tag("badges");
+        if (badgesTag.isValid())
+        {
+            auto parsedBadges = parseBadges(badgesTag.toString());
+            channel.setMod(parsedBadges.contains("moderator"));
+            channel.setVIP(parsedBadges.contains("vip"));
+            channel.setStaff(parsedBadges.contains("staff"));
+        }
+    }
+}
+
+/// A message prepared for building
+struct PendingMessage {
+    MessageParseArgs args;
+    QString content;
+    int messageOffset = 0;
+    IrcMessageContext context;
+    bool isAnnouncement = false;
+};
+
+/// The part of IrcMessageHandler::addMessage() before building. Runs on the
+/// GUI thread.
+std::optional<PendingMessage> prepareMessage(Communi::IrcMessage *message,
+                                             MessageSink &sink,
+                                             TwitchChannel *chan,
+                                             const QString &originalContent,
+                                             bool isSub, bool isAction)
+{
+    MessageParseArgs args;
+    if (isSub)
+    {
+        args.isSubscriptionMessage = true;
+        args.trimSubscriberUsername = true;
+    }
+
+    if (chan->isBroadcaster())
+    {
+        args.isStaffOrBroadcaster = true;
+    }
+    args.isAction = isAction;
+
+    const auto &tags = message->tags();
+    QString rewardId;
+    if (const auto it = tags.find("custom-reward-id"); it != tags.end())
+    {
+        rewardId = it.value().toString();
+    }
+    else if (const auto typeIt = tags.find("msg-id"); typeIt != tags.end())
+    {
+        // slight hack to treat bits power-ups as channel point redemptions
+        const auto msgId = typeIt.value().toString();
+        if (msgId == "animated-message" || msgId == "gigantified-emote-message")
+        {
+            rewardId = msgId;
+        }
+    }
+    if (!rewardId.isEmpty() &&
+        sink.sinkTraits().has(
+            MessageSinkTrait::RequiresKnownChannelPointReward) &&
+        !chan->isChannelPointRewardKnown(rewardId))
+    {
+        // Need to wait for pubsub reward notification
+        qCDebug(chatterinoTwitch) << "TwitchChannel reward added ADD "
+                                     "callback since reward is not known:"
+                                  << rewardId;
+        chan->addQueuedRedemption(rewardId, originalContent, message);
+    }
+    args.channelPointRewardId = rewardId;
+
+    QString content = originalContent;
+    int messageOffset = stripLeadingReplyMention(tags, content);
+
+    ReplyContext replyCtx;
+
+    if (const auto it = tags.find("reply-thread-parent-msg-id");
+        it != tags.end())
+    {
+        const QString replyID = it.value().toString();
+        auto threadIt = chan->threads().find(replyID);
+        std::shared_ptr<MessageThread> rootThread;
+        if (threadIt != chan->threads().end() && !threadIt->second.expired())
+        {
+            // Thread already exists (has a reply)
+            auto thread = threadIt->second.lock();
+            checkThreadSubscription(tags, message->nick(), thread);
+            replyCtx.thread = thread;
+            rootThread = thread;
+        }
+        else
+        {
+            // Thread does not yet exist, find root reply and create thread.
+            auto root = sink.findMessageByID(replyID);
+            if (root)
+            {
+                // Found root reply message
+                auto newThread = std::make_shared<MessageThread>(root);
+                checkThreadSubscription(tags, message->nick(), newThread);
+
+                replyCtx.thread = newThread;
+                rootThread = newThread;
+                // Store weak reference to thread in channel
+                chan->addReplyThread(newThread);
+            }
+        }
+
+        if (const auto parentIt = tags.find("reply-parent-msg-id");
+            parentIt != tags.end())
+        {
+            const QString parentID = parentIt.value().toString();
+            if (replyID == parentID)
+            {
+                if (rootThread)
+                {
+                    replyCtx.parent = rootThread->root();
+                }
+            }
+            else
+            {
+                auto parentThreadIt = chan->threads().find(parentID);
+                if (parentThreadIt != chan->threads().end())
+                {
+                    auto thread = parentThreadIt->second.lock();
+                    if (thread)
+                    {
+                        replyCtx.parent = thread->root();
+                    }
+                }
+                else
+                {
+                    auto parent = sink.findMessageByID(parentID);
+                    if (parent)
+                    {
+                        replyCtx.parent = parent;
+                    }
+                }
+            }
+        }
+    }
+
+    args.allowIgnore = !isSub;
+    auto context = MessageBuilder::prepareIrcMessage(
+        chan, message, args, content, replyCtx.thread, replyCtx.parent);
+    if (!context)
+    {
+        return std::nullopt;
+    }
+
+    return PendingMessage{
+        .args = std::move(args),
+        .content = std::move(content),
+        .messageOffset = messageOffset,
+        .context = std::move(*context),
+        .isAnnouncement = tags.value("msg-id") == "announcement",
+    };
+}
+
+/// The part of IrcMessageHandler::addMessage() after building. Adds the built
+/// message to @a sink.
+void finishMessage(const PendingMessage &pending, const MessagePtrMut &msg,
+                   const HighlightAlert &alert, MessageSink &sink,
+                   TwitchChannel *chan, ITwitchIrcServer &twitch, bool isSub,
+                   const QString &msgType)
+{
+    MessageBuilder::finishIrcMessage(pending.context, msg);
+
+    if (!msg)
+    {
+        return;
+    }
+
+    if (isSub)
+    {
+        if (msgType == "viewermilestone")
+        {
+            msg->flags.set(MessageFlag::WatchStreak);
+        }
+        else
+        {
+            msg->flags.set(MessageFlag::Subscription);
+        }
+
+        if (!pending.isAnnouncement)
+        {
+            // Announcements are currently tagged as subscriptions,
+            // but we want them to be able to show up in mentions
+            msg->flags.unset(MessageFlag::Highlighted);
+        }
+    }
+
+    sink.applySimilarityFilters(msg);
+
+    if (!msg->flags.has(MessageFlag::Similar) ||
+        (!getSettings()->hideSimilar &&
+         getSettings()->shownSimilarTriggerHighlights))
+    {
+        MessageBuilder::triggerHighlights(chan, alert);
+    }
+
+    const auto highlighted = msg->flags.has(MessageFlag::Highlighted);
+    const auto showInMentions = msg->flags.has(MessageFlag::ShowInMentions);
+
+    if (highlighted && showInMentions &&
+        sink.sinkTraits().has(MessageSinkTrait::AddMentionsToGlobalChannel))
+    {
+        twitch.getMentionsChannel()->addMessage(msg,
+                                                MessageContext::Original);
+    }
+
+    sink.addMessage(msg, MessageContext::Original);
+    chan->addRecentChatter(msg->displayName);
+}
+
 std::optional<ClearChatMessage> parseClearChatMessage(
     Communi::IrcMessage *message)
 {
@@ -383,22 +603,75 @@ void IrcMessageHandler::handlePrivMessage(Communi::IrcPrivateMessage *message,
     parsePrivMessageInto(message, *twitchChannel, twitchChannel);
 }
 
-void IrcMessageHandler::parsePrivMessageInto(
-    Communi::IrcPrivateMessage *message, MessageSink &sink,
-    TwitchChannel *channel)
+IrcIngestQueue::Build IrcMessageHandler::preparePrivMessage(
+    Communi::IrcPrivateMessage *message, ITwitchIrcServer &twitchServer)
 {
-    auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
-    if (message->tag("user-id") == currentUser->getUserId())
+    auto channel = std::dynamic_pointer_cast<TwitchChannel>(
+        channelOrEmptyByTarget(message->target(), twitchServer));
+    if (!channel)
     {
-        auto badgesTag = message->tag("badges");
-        if (badgesTag.isValid())
+        return {};
+    }
+
+    updateOwnBadges(message, *channel);
+
+    auto pending =
+        prepareMessage(message, *channel, channel.get(),
+                       unescapeZeroWidthJoiner(message->content()), false,
+                       message->isAction());
+    bool isHypeChat = message->tags().contains(u"pinned-chat-paid-amount"_s);
+    if (!pending && !isHypeChat)
+    {
+        return {};
+    }
+
+    // Communi deletes the message once the signal returns, so the worker
+    // parses its own copy
+    return [data = message->toData(), channel, pending = std::move(pending),
+            isHypeChat, &twitchServer]() -> IrcIngestQueue::Finish {
+        std::unique_ptr<Communi::IrcMessage> parsed(
+            Communi::IrcMessage::fromData(data, nullptr));
+        auto *privMsg =
+            dynamic_cast<Communi::IrcPrivateMessage *>(parsed.get());
+        if (!privMsg)
         {
-            auto parsedBadges = parseBadges(badgesTag.toString());
-            channel->setMod(parsedBadges.contains("moderator"));
-            channel->setVIP(parsedBadges.contains("vip"));
-            channel->setStaff(parsedBadges.contains("staff"));
+            return {};
+        }
+
+        MessagePtrMut built;
+        HighlightAlert alert;
+        if (pending)
+        {
+            std::tie(built, alert) = MessageBuilder::buildIrcMessage(
+                channel.get(), pending->context, privMsg, pending->args,
+                pending->content, pending->messageOffset);
+        }
+
+        MessagePtr hypeChat;
+        if (isHypeChat)
+        {
+            hypeChat = MessageBuilder::buildHypeChatMessage(privMsg);
         }
-    }
+
+        return [channel, pending, built, alert, hypeChat, &twitchServer] {
+            if (pending)
+            {
+                finishMessage(*pending, built, alert, *channel, channel.get(),
+                              twitchServer, false, {});
+            }
+            if (hypeChat)
+            {
+                channel->addMessage(hypeChat, MessageContext::Original);
+            }
+        };
+    };
+}
+
+void IrcMessageHandler::parsePrivMessageInto(
+    Communi::IrcPrivateMessage *message, MessageSink &sink,
+    TwitchChannel *channel)
+{
+    updateOwnBadges(message, *channel);
 
     IrcMessageHandler::addMessage(
         message, sink, channel, unescapeZeroWidthJoiner(message->content()),
@@ -1027,165 +1300,17 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
 {
     assert(chan);
 
-    MessageParseArgs args;
-    if (isSub)
-    {
-        args.isSubscriptionMessage = true;
-        args.trimSubscriberUsername = true;
-    }
-
-    if (chan->isBroadcaster())
+    auto pending =
+        prepareMessage(message, sink, chan, originalContent, isSub, isAction);
+    if (!pending)
     {
-        args.isStaffOrBroadcaster = true;
-    }
-    args.isAction = isAction;
-
-    const auto &tags = message->tags();
-    QString rewardId;
-    if (const auto it = tags.find("custom-reward-id"); it != tags.end())
-    {
-        rewardId = it.value().toString();
-    }
-    else if (const auto typeIt = tags.find("msg-id"); typeIt != tags.end())
-    {
-        // slight hack to treat bits power-ups as channel point redemptions
-        const auto msgId = typeIt.value().toString();
-        if (msgId == "animated-message" || msgId == "gigantified-emote-message")
-        {
-            rewardId = msgId;
-        }
-    }
-    if (!rewardId.isEmpty() &&
-        sink.sinkTraits().has(
-            MessageSinkTrait::RequiresKnownChannelPointReward) &&
-        !chan->isChannelPointRewardKnown(rewardId))
-    {
-        // Need to wait for pubsub reward notification
-        qCDebug(chatterinoTwitch) << "TwitchChannel reward added ADD "
-                                     "callback since reward is not known:"
-                                  << rewardId;
-        chan->addQueuedRedemption(rewardId, originalContent, message);
-    }
-    args.channelPointRewardId = rewardId;
-
-    QString content = originalContent;
-    int messageOffset = stripLeadingReplyMention(tags, content);
-
-    ReplyContext replyCtx;
-
-    if (const auto it = tags.find("reply-thread-parent-msg-id");
-        it != tags.end())
-    {
-        const QString replyID = it.value().toString();
-        auto threadIt = chan->threads().find(replyID);
-        std::shared_ptr<MessageThread> rootThread;
-        if (threadIt != chan->threads().end() && !threadIt->second.expired())
-        {
-            // Thread already exists (has a reply)
-            auto thread = threadIt->second.lock();
-            checkThreadSubscription(tags, message->nick(), thread);
-            replyCtx.thread = thread;
-            rootThread = thread;
-        }
-        else
-        {
-            // Thread does not yet exist, find root reply and create thread.
-            auto root = sink.findMessageByID(replyID);
-            if (root)
-            {
-                // Found root reply message
-                auto newThread = std::make_shared<MessageThread>(root);
-                checkThreadSubscription(tags, message->nick(), newThread);
-
-                replyCtx.thread = newThread;
-                rootThread = newThread;
-                // Store weak reference to thread in channel
-                chan->addReplyThread(newThread);
-            }
-        }
-
-        if (const auto parentIt = tags.find("reply-parent-msg-id");
-            parentIt != tags.end())
-        {
-            const QString parentID = parentIt.value().toString();
-            if (replyID == parentID)
-            {
-                if (rootThread)
-                {
-                    replyCtx.parent = rootThread->root();
-                }
-            }
-            else
-            {
-                auto parentThreadIt = chan->threads().find(parentID);
-                if (parentThreadIt != chan->threads().end())
-                {
-                    auto thread = parentThreadIt->second.lock();
-                    if (thread)
-                    {
-                        replyCtx.parent = thread->root();
-                    }
-                }
-                else
-                {
-                    auto parent = sink.findMessageByID(parentID);
-                    if (parent)
-                    {
-                        replyCtx.parent = parent;
-                    }
-                }
-            }
-        }
+        return;
     }
 
-    args.allowIgnore = !isSub;
-    auto [msg, alert] = MessageBuilder::makeIrcMessage(
-        chan, message, args, content, messageOffset, replyCtx.thread,
-        replyCtx.parent);
-
-    if (msg)
-    {
-        if (isSub)
-        {
-            if (msgType == "viewermilestone")
-            {
-                msg->flags.set(MessageFlag::WatchStreak);
-            }
-            else
-            {
-                msg->flags.set(MessageFlag::Subscription);
-            }
-
-            if (tags.value("msg-id") != "announcement")
-            {
-                // Announcements are currently tagged as subscriptions,
-                // but we want them to be able to show up in mentions
-                msg->flags.unset(MessageFlag::Highlighted);
-            }
-        }
-
-        sink.applySimilarityFilters(msg);
-
-        if (!msg->flags.has(MessageFlag::Similar) ||
-            (!getSettings()->hideSimilar &&
-             getSettings()->shownSimilarTriggerHighlights))
-        {
-            MessageBuilder::triggerHighlights(chan, alert);
-        }
-
-        const auto highlighted = msg->flags.has(MessageFlag::Highlighted);
-        const auto showInMentions = msg->flags.has(MessageFlag::ShowInMentions);
-
-        if (highlighted && showInMentions &&
-            sink.sinkTraits().has(MessageSinkTrait::AddMentionsToGlobalChannel))
-        {
-            twitch.getMentionsChannel()->addMessage(msg,
-                                                    MessageContext::Original);
-        }
-
-        sink.addMessage(msg, MessageContext::Original);
-        chan->addRecentChatter(msg->displayName);
-    }
+    auto [msg, alert] = MessageBuilder::buildIrcMessage(
+        chan, pending->context, message, pending->args, pending->content,
+        pending->messageOffset);
+    finishMessage(*pending, msg, alert, sink, chan, twitch, isSub, msgType);
 }
 
 }  // namespace chatterino
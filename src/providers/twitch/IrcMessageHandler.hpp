@@ -1,5 +1,7 @@
 #pragma once
 
+#include "providers/twitch/IrcIngestQueue.hpp"
+
 #include <IrcMessage>
 
 #include <optional>
@@ -37,6 +39,16 @@ public:
 
     void handlePrivMessage(Communi::IrcPrivateMessage *message,
                            ITwitchIrcServer &twitchServer);
+    /// Prepares building the PRIVMSG @a message on a worker thread.
+    ///
+    /// Everything that reads or changes the state of the channel beyond what
+    /// the builder can safely read happens here, on the GUI thread.
+    ///
+    /// @returns The build of the message for the IrcIngestQueue or an empty
+    ///          function if there's nothing to build (e.g. the channel isn't
+    ///          open or the message is ignored).
+    IrcIngestQueue::Build preparePrivMessage(
+        Communi::IrcPrivateMessage *message, ITwitchIrcServer &twitchServer);
     static void parsePrivMessageInto(Communi::IrcPrivateMessage *message,
                                      MessageSink &sink, TwitchChannel *channel);
 
@@ -0,0 +1,254 @@
+#include "providers/twitch/IrcTags.hpp"
+
+#include <IrcMessage>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+
+/// Sorted by name, so we can binary search it
+constexpr std::array KNOWN_TAGS{
+    std::pair{std::string_view{"badge-info"}, IrcTag::BadgeInfo},
+    std::pair{std::string_view{"badges"}, IrcTag::Badges},
+    std::pair{std::string_view{"bits"}, IrcTag::Bits},
+    std::pair{std::string_view{"color"}, IrcTag::Color},
+    std::pair{std::string_view{"display-name"}, IrcTag::DisplayName},
+    std::pair{std::string_view{"emotes"}, IrcTag::Emotes},
+    std::pair{std::string_view{"first-msg"}, IrcTag::FirstMsg},
+    std::pair{std::string_view{"historical"}, IrcTag::Historical},
+    std::pair{std::string_view{"id"}, IrcTag::Id},
+    std::pair{std::string_view{"msg-id"}, IrcTag::MsgId},
+    std::pair{std::string_view{"pinned-chat-paid-amount"},
+              IrcTag::PinnedChatPaidAmount},
+    std::pair{std::string_view{"reply-parent-display-name"},
+              IrcTag::ReplyParentDisplayName},
+    std::pair{std::string_view{"reply-parent-msg-body"},
+              IrcTag::ReplyParentMsgBody},
+    std::pair{std::string_view{"reply-parent-msg-id"},
+              IrcTag::ReplyParentMsgId},
+    std::pair{std::string_view{"reply-parent-user-id"},
+              IrcTag::ReplyParentUserId},
+    std::pair{std::string_view{"reply-parent-user-login"},
+              IrcTag::ReplyParentUserLogin},
+    std::pair{std::string_view{"reply-thread-parent-msg-id"},
+              IrcTag::ReplyThreadParentMsgId},
+    std::pair{std::string_view{"rm-deleted"}, IrcTag::RmDeleted},
+    std::pair{std::string_view{"rm-received-ts"}, IrcTag::RmReceivedTs},
+    std::pair{std::string_view{"room-id"}, IrcTag::RoomId},
+    std::pair{std::string_view{"source-room-id"}, IrcTag::SourceRoomId},
+    std::pair{std::string_view{"tmi-sent-ts"}, IrcTag::TmiSentTs},
+    std::pair{std::string_view{"user-id"}, IrcTag::UserId},
+    std::pair{std::string_view{"user-type"}, IrcTag::UserType},
+};
+
+static_assert(std::ranges::is_sorted(KNOWN_TAGS, {},
+                                     &decltype(KNOWN_TAGS)::value_type::first));
+static_assert(KNOWN_TAGS.size() ==
+              static_cast<size_t>(IrcTag::UserType) + 1);
+
+std::optional<IrcTag> knownTag(std::string_view key)
+{
+    auto it = std::ranges::lower_bound(
+        KNOWN_TAGS, key, {}, &decltype(KNOWN_TAGS)::value_type::first);
+    if (it == KNOWN_TAGS.end() || it->first != key)
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+QString fromUtf8(std::string_view str)
+{
+    return QString::fromUtf8(str.data(), static_cast<qsizetype>(str.size()));
+}
+
+/// Unescapes @a value like parseTagString does
+QString unescape(std::string_view value)
+{
+    if (value.find('\\') == std::string_view::npos)
+    {
+        return fromUtf8(value);
+    }
+
+    QByteArray out;
+    out.reserve(static_cast<qsizetype>(value.size()));
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        char c = value[i];
+        if (c != '\\' || i + 1 == value.size())
+        {
+            out.append(c);
+            continue;
+        }
+
+        i++;
+        switch (value[i])
+        {
+            case 'n':
+                out.append('\n');
+                break;
+            case 'r':
+                out.append('\r');
+                break;
+            case 's':
+                out.append(' ');
+                break;
+            case ':':
+                out.append(';');
+                break;
+            default:
+                out.append(value[i]);
+                break;
+        }
+    }
+
+    return QString::fromUtf8(out);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+IrcTags::IrcTags()
+{
+    this->known_.fill(-1);
+}
+
+IrcTags::IrcTags(QByteArray line)
+    : line_(std::move(line))
+{
+    this->known_.fill(-1);
+
+    std::string_view data(this->line_.constData(),
+                          static_cast<size_t>(this->line_.size()));
+    if (!data.starts_with('@'))
+    {
+        return;
+    }
+
+    auto tagsEnd = std::min(data.find(' '), data.size());
+    size_t pos = 1;
+    while (pos < tagsEnd)
+    {
+        auto tagEnd = std::min(data.find(';', pos), tagsEnd);
+        auto tag = data.substr(pos, tagEnd - pos);
+        auto eq = tag.find('=');
+
+        Entry entry;
+        entry.key = {
+            .begin = static_cast<int32_t>(pos),
+            .length = static_cast<int32_t>(std::min(eq, tag.size())),
+        };
+        if (eq != std::string_view::npos)
+        {
+            entry.value = {
+                .begin = static_cast<int32_t>(pos + eq + 1),
+                .length = static_cast<int32_t>(tag.size() - eq - 1),
+            };
+        }
+
+        if (entry.key.length > 0)
+        {
+            if (auto known = knownTag(this->view(entry.key)))
+            {
+                // Later tags override earlier ones (same as in Communi)
+                this->known_[static_cast<size_t>(*known)] =
+                    static_cast<int32_t>(this->entries_.size());
+            }
+            this->entries_.append(entry);
+        }
+
+        pos = tagEnd + 1;
+    }
+}
+
+IrcTags IrcTags::fromMessage(const Communi::IrcMessage *message)
+{
+    return IrcTags(message->toData());
+}
+
+bool IrcTags::contains(IrcTag tag) const
+{
+    return this->known_[static_cast<size_t>(tag)] >= 0;
+}
+
+bool IrcTags::contains(std::string_view key) const
+{
+    return this->find(key) != nullptr;
+}
+
+std::string_view IrcTags::raw(IrcTag tag) const
+{
+    auto idx = this->known_[static_cast<size_t>(tag)];
+    if (idx < 0)
+    {
+        return {};
+    }
+    return this->view(this->entries_[idx].value);
+}
+
+std::string_view IrcTags::raw(std::string_view key) const
+{
+    const auto *entry = this->find(key);
+    if (!entry)
+    {
+        return {};
+    }
+    return this->view(entry->value);
+}
+
+QString IrcTags::value(IrcTag tag) const
+{
+    return fromUtf8(this->raw(tag));
+}
+
+QString IrcTags::value(std::string_view key) const
+{
+    return fromUtf8(this->raw(key));
+}
+
+QString IrcTags::unescaped(IrcTag tag) const
+{
+    return unescape(this->raw(tag));
+}
+
+QString IrcTags::unescaped(std::string_view key) const
+{
+    return unescape(this->raw(key));
+}
+
+qsizetype IrcTags::size() const
+{
+    return this->entries_.size();
+}
+
+std::string_view IrcTags::view(Span span) const
+{
+    return {this->line_.constData() + span.begin,
+            static_cast<size_t>(span.length)};
+}
+
+const IrcTags::Entry *IrcTags::find(std::string_view key) const
+{
+    if (auto known = knownTag(key))
+    {
+        auto idx = this->known_[static_cast<size_t>(*known)];
+        return idx < 0 ? nullptr : &this->entries_[idx];
+    }
+
+    // Search from the back, so later tags override earlier ones
+    for (auto i = this->entries_.size() - 1; i >= 0; i--)
+    {
+        if (this->view(this->entries_[i].key) == key)
+        {
+            return &this->entries_[i];
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace chatterino
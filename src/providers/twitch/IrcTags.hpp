@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVarLengthArray>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace Communi {
+class IrcMessage;
+}  // namespace Communi
+
+namespace chatterino {
+
+/// Tags that are looked up for (almost) every message.
+///
+/// Their position is recorded while parsing, so looking them up doesn't
+/// involve any string comparisons.
+enum class IrcTag : uint8_t {
+    BadgeInfo,
+    Badges,
+    Bits,
+    Color,
+    DisplayName,
+    Emotes,
+    FirstMsg,
+    Historical,
+    Id,
+    MsgId,
+    PinnedChatPaidAmount,
+    ReplyParentDisplayName,
+    ReplyParentMsgBody,
+    ReplyParentMsgId,
+    ReplyParentUserId,
+    ReplyParentUserLogin,
+    ReplyThreadParentMsgId,
+    RmDeleted,
+    RmReceivedTs,
+    RoomId,
+    SourceRoomId,
+    TmiSentTs,
+    UserId,
+    UserType,
+};
+
+/// A flat view of the IRCv3 tags of a raw IRC line.
+///
+/// The tags are scanned once. Only the positions of keys and values are
+/// stored - the line itself is shared with the caller. Values are decoded
+/// when they're accessed.
+///
+/// Unlike Communi::IrcMessage::tags(), this doesn't build a map of
+/// QVariants for every message.
+class IrcTags
+{
+public:
+    IrcTags();
+    /// Parses the tags of @a line (e.g. `@a=b;c=d :nick!user@host PRIVMSG ...`)
+    explicit IrcTags(QByteArray line);
+
+    /// Parses the tags of the raw line @a message was parsed from
+    static IrcTags fromMessage(const Communi::IrcMessage *message);
+
+    bool contains(IrcTag tag) const;
+    bool contains(std::string_view key) const;
+
+    /// Returns the value of a tag as it was sent (i.e. still escaped).
+    ///
+    /// The view points into the line and is only valid as long as this object
+    /// exists. Returns an empty view if the tag doesn't exist.
+    std::string_view raw(IrcTag tag) const;
+    std::string_view raw(std::string_view key) const;
+
+    /// Returns the value of a tag as it was sent (i.e. still escaped).
+    ///
+    /// This is the same as `Communi::IrcMessage::tags().value(key).toString()`.
+    QString value(IrcTag tag) const;
+    QString value(std::string_view key) const;
+
+    /// Returns the unescaped value of a tag (e.g. `a\sb` becomes `a b`).
+    ///
+    /// This is the same as `parseTagString(value(tag))`.
+    QString unescaped(IrcTag tag) const;
+    QString unescaped(std::string_view key) const;
+
+    /// Returns the number of tags
+    qsizetype size() const;
+
+private:
+    struct Span {
+        int32_t begin = 0;
+        int32_t length = 0;
+    };
+
+    struct Entry {
+        Span key;
+        Span value;
+    };
+
+    static constexpr size_t TAG_COUNT =
+        static_cast<size_t>(IrcTag::UserType) + 1;
+
+    std::string_view view(Span span) const;
+    const Entry *find(std::string_view key) const;
+
+    QByteArray line_;
+    /// Twitch sends around 20 tags with a PRIVMSG
+    QVarLengthArray<Entry, 32> entries_;
+    /// Index into entries_ for every IrcTag or -1 if the tag doesn't exist
+    std::array<int32_t, TAG_COUNT> known_;
+};
+
+}  // namespace chatterino
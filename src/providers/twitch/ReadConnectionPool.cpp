@@ -0,0 +1,194 @@
+#include "providers/twitch/ReadConnectionPool.hpp"
+
+#include "common/QLogging.hpp"
+#include "providers/irc/IrcConnection2.hpp"
+
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <cassert>
+
+namespace chatterino {
+
+ReadConnectionPool::ReadConnectionPool(OnCreated onCreated)
+    : onCreated_(std::move(onCreated))
+{
+    this->addShard();
+}
+
+ReadConnectionPool::~ReadConnectionPool() = default;
+
+IrcConnection *ReadConnectionPool::primary() const
+{
+    return this->shards_.front()->connection.get();
+}
+
+IrcConnection *ReadConnectionPool::connectionFor(
+    const QString &channelName) const
+{
+    auto *shard = this->assignments_.value(channelName);
+    if (!shard)
+    {
+        return nullptr;
+    }
+    return shard->connection.get();
+}
+
+IrcConnection *ReadConnectionPool::assign(const QString &channelName)
+{
+    if (auto *connection = this->connectionFor(channelName))
+    {
+        return connection;
+    }
+
+    auto it = std::ranges::min_element(this->shards_, {}, [](const auto &s) {
+        return s->channels.size();
+    });
+    auto *shard = it->get();
+
+    if (shard->channels.size() >= CHANNELS_PER_CONNECTION &&
+        this->shards_.size() < MAX_CONNECTIONS)
+    {
+        shard = &this->addShard();
+    }
+
+    shard->channels.insert(channelName);
+    this->assignments_.insert(channelName, shard);
+    return shard->connection.get();
+}
+
+void ReadConnectionPool::unassign(const QString &channelName)
+{
+    auto *shard = this->assignments_.take(channelName);
+    if (!shard)
+    {
+        return;
+    }
+
+    shard->channels.remove(channelName);
+    if (shard->channels.isEmpty() && shard != this->shards_.front().get())
+    {
+        this->removeShard(shard);
+    }
+}
+
+QStringList ReadConnectionPool::channelsOf(
+    const IrcConnection *connection) const
+{
+    auto *shard = this->findShard(connection);
+    if (!shard)
+    {
+        return {};
+    }
+    return {shard->channels.begin(), shard->channels.end()};
+}
+
+bool ReadConnectionPool::contains(const IrcConnection *connection) const
+{
+    return this->findShard(connection) != nullptr;
+}
+
+IrcConnection *ReadConnectionPool::find(
+    const Communi::IrcConnection *connection) const
+{
+    for (const auto &shard : this->shards_)
+    {
+        if (shard->connection.get() == connection)
+        {
+            return shard->connection.get();
+        }
+    }
+    return nullptr;
+}
+
+void ReadConnectionPool::rebalance(const QStringList &channelNames)
+{
+    auto wanted = std::clamp<size_t>(
+        static_cast<size_t>(
+            (channelNames.size() + CHANNELS_PER_CONNECTION - 1) /
+            CHANNELS_PER_CONNECTION),
+        1, MAX_CONNECTIONS);
+
+    while (this->shards_.size() > wanted)
+    {
+        this->removeShard(this->shards_.back().get());
+    }
+    while (this->shards_.size() < wanted)
+    {
+        this->addShard();
+    }
+
+    this->assignments_.clear();
+    for (auto &shard : this->shards_)
+    {
+        shard->channels.clear();
+    }
+
+    for (qsizetype i = 0; i < channelNames.size(); i++)
+    {
+        auto *shard = this->shards_[static_cast<size_t>(i) % wanted].get();
+        shard->channels.insert(channelNames[i]);
+        this->assignments_.insert(channelNames[i], shard);
+    }
+
+    qCDebug(chatterinoIrc) << "Spread" << channelNames.size()
+                           << "channels over" << wanted << "read connections";
+}
+
+void ReadConnectionPool::forEachConnection(
+    const std::function<void(IrcConnection *)> &func)
+{
+    for (const auto &shard : this->shards_)
+    {
+        func(shard->connection.get());
+    }
+}
+
+size_t ReadConnectionPool::size() const
+{
+    return this->shards_.size();
+}
+
+ReadConnectionPool::Shard &ReadConnectionPool::addShard()
+{
+    auto &shard = *this->shards_.emplace_back(std::make_unique<Shard>());
+    shard.connection.reset(new IrcConnection);
+    shard.connection->moveToThread(QCoreApplication::instance()->thread());
+
+    if (this->onCreated_)
+    {
+        this->onCreated_(shard.connection.get(), shard.signalHolder);
+    }
+
+    return shard;
+}
+
+ReadConnectionPool::Shard *ReadConnectionPool::findShard(
+    const IrcConnection *connection) const
+{
+    for (const auto &shard : this->shards_)
+    {
+        if (shard->connection.get() == connection)
+        {
+            return shard.get();
+        }
+    }
+    return nullptr;
+}
+
+void ReadConnectionPool::removeShard(Shard *shard)
+{
+    assert(shard != this->shards_.front().get());
+
+    for (const auto &channelName : shard->channels)
+    {
+        this->assignments_.remove(channelName);
+    }
+
+    shard->connection->close();
+    std::erase_if(this->shards_, [&](const auto &s) {
+        return s.get() == shard;
+    });
+}
+
+}  // namespace chatterino
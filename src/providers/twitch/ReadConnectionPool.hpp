@@ -0,0 +1,114 @@
+#pragma once
+
+#include "common/Common.hpp"
+
+#include <pajlada/signals/signalholder.hpp>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Communi {
+class IrcConnection;
+}  // namespace Communi
+
+namespace chatterino {
+
+class IrcConnection;
+
+/// Spreads joined channels over multiple read connections.
+///
+/// Every channel is assigned to exactly one connection. New channels go to
+/// the connection with the fewest channels. Once all connections hold
+/// CHANNELS_PER_CONNECTION channels, another connection is created (up to
+/// MAX_CONNECTIONS). Connections other than the first one are removed once
+/// their last channel is removed.
+///
+/// Each connection reconnects on its own (see IrcConnection::smartReconnect),
+/// so a slow or dropped connection only affects the channels assigned to it.
+///
+/// The pool only manages the assignments and the lifetime of the
+/// connections. Creating a connection calls the `onCreated` callback, which
+/// is expected to connect to its signals and open it if needed. Connections
+/// made through the SignalHolder passed to it are released together with the
+/// connection.
+///
+/// Must only be used from the GUI thread.
+class ReadConnectionPool
+{
+public:
+    static constexpr qsizetype CHANNELS_PER_CONNECTION = 50;
+    static constexpr size_t MAX_CONNECTIONS = 10;
+
+    using OnCreated = std::function<void(IrcConnection *,
+                                         pajlada::Signals::SignalHolder &)>;
+
+    explicit ReadConnectionPool(OnCreated onCreated);
+    ~ReadConnectionPool();
+
+    ReadConnectionPool(const ReadConnectionPool &) = delete;
+    ReadConnectionPool &operator=(const ReadConnectionPool &) = delete;
+    ReadConnectionPool(ReadConnectionPool &&) = delete;
+    ReadConnectionPool &operator=(ReadConnectionPool &&) = delete;
+
+    /// Returns the first connection. It always exists.
+    IrcConnection *primary() const;
+
+    /// Returns the connection @a channelName is assigned to or nullptr
+    IrcConnection *connectionFor(const QString &channelName) const;
+
+    /// Assigns @a channelName to a connection
+    ///
+    /// @returns The connection the channel is assigned to
+    IrcConnection *assign(const QString &channelName);
+
+    /// Removes @a channelName from its connection. If the connection doesn't
+    /// have any channels left (and isn't the primary one), it's removed.
+    void unassign(const QString &channelName);
+
+    /// Returns the channels assigned to @a connection
+    QStringList channelsOf(const IrcConnection *connection) const;
+
+    /// Returns true if @a connection is part of this pool
+    bool contains(const IrcConnection *connection) const;
+
+    /// Returns @a connection if it's part of this pool or nullptr otherwise.
+    ///
+    /// @a connection isn't dereferenced, so it may point to a connection that
+    /// was already removed (e.g. the sender of a queued message).
+    IrcConnection *find(const Communi::IrcConnection *connection) const;
+
+    /// Reassigns @a channelNames evenly to as few connections as possible.
+    ///
+    /// Connections that aren't needed anymore are removed. This should only
+    /// be done while the connections are closed, as channels might move to
+    /// a different connection.
+    void rebalance(const QStringList &channelNames);
+
+    void forEachConnection(const std::function<void(IrcConnection *)> &func);
+
+    /// Returns the number of connections
+    size_t size() const;
+
+private:
+    struct Shard {
+        QObjectPtr<IrcConnection> connection;
+        QSet<QString> channels;
+        /// Connections to the signals of `connection`
+        pajlada::Signals::SignalHolder signalHolder;
+    };
+
+    Shard &addShard();
+    Shard *findShard(const IrcConnection *connection) const;
+    void removeShard(Shard *shard);
+
+    OnCreated onCreated_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    QHash<QString, Shard *> assignments_;
+};
+
+}  // namespace chatterino
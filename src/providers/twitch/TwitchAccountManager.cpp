@@ -218,12 +218,13 @@ TwitchAccountManager::TwitchAccountManager()
 
 std::shared_ptr<TwitchAccount> TwitchAccountManager::getCurrent()
 {
-    if (!this->currentUser_)
+    auto current = this->currentUser_.get();
+    if (!current)
     {
         return this->anonymousUser_;
     }
 
-    return this->currentUser_;
+    return current;
 }
 
 std::vector<QString> TwitchAccountManager::getUsernames() const
@@ -343,36 +344,37 @@ void TwitchAccountManager::load()
     this->currentUsername.connect([this](const QString &newUsername) {
         auto user = this->findUserByUsername(newUsername);
 
-        this->currentUserAboutToChange.invoke(this->currentUser_, user);
+        this->currentUserAboutToChange.invoke(this->currentUser_.get(), user);
 
         if (user)
         {
             qCDebug(chatterinoTwitch)
                 << "Twitch user updated to" << newUsername;
             getHelix()->update(user->getOAuthClient(), user->getOAuthToken());
-            this->currentUser_ = user;
+            this->currentUser_.set(user);
         }
         else
         {
             qCDebug(chatterinoTwitch) << "Twitch user updated to anonymous";
-            this->currentUser_ = this->anonymousUser_;
+            this->currentUser_.set(this->anonymousUser_);
         }
 
         this->currentUserChanged();
-        this->currentUser_->reloadEmotes();
+        this->currentUser_.get()->reloadEmotes();
     });
 }
 
 bool TwitchAccountManager::isLoggedIn() const
 {
-    if (!this->currentUser_)
+    auto current = this->currentUser_.get();
+    if (!current)
     {
         return false;
     }
 
     // Once `TwitchAccount` class has a way to check, we should also return
     // false if the credentials are incorrect
-    return !this->currentUser_->isAnon();
+    return !current->isAnon();
 }
 
 bool TwitchAccountManager::removeUser(TwitchAccount *account)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/Atomic.hpp"
 #include "common/ChatterinoSetting.hpp"
 #include "common/SignalVector.hpp"
 #include "util/Expected.hpp"
@@ -82,7 +83,8 @@ private:
     AddUserResponse addUser(const UserData &data);
     bool removeUser(TwitchAccount *account);
 
-    std::shared_ptr<TwitchAccount> currentUser_;
+    /// Read from the IRC message builders on worker threads
+    Atomic<std::shared_ptr<TwitchAccount>> currentUser_;
 
     std::shared_ptr<TwitchAccount> anonymousUser_;
     mutable std::mutex mutex_;
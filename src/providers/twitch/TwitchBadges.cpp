@@ -4,6 +4,7 @@
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteSnapshot.hpp"
 #include "messages/Image.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "util/DisplayBadge.hpp"
@@ -24,6 +25,8 @@ namespace {
 // From Twitch docs - expected size for a badge (1x)
 constexpr QSize BADGE_BASE_SIZE(18, 18);
 
+const QString SNAPSHOT_KEY = QStringLiteral("global.twitch-badges");
+
 }  // namespace
 
 namespace chatterino {
@@ -32,9 +35,16 @@ void TwitchBadges::loadTwitchBadges()
 {
     assert(this->loaded_ == false);
 
+    // Show the badges from the last session until they're loaded
+    if (auto snapshot = EmoteSnapshot::global().badgeSets(SNAPSHOT_KEY))
+    {
+        *this->badgeSets_.access() = std::move(*snapshot);
+    }
+
     getHelix()->getGlobalBadges(
         [this](auto globalBadges) {
             auto badgeSets = this->badgeSets_.access();
+            badgeSets->clear();
 
             for (const auto &badgeSet : globalBadges.badgeSets)
             {
@@ -59,6 +69,7 @@ void TwitchBadges::loadTwitchBadges()
                         std::make_shared<Emote>(emote);
                 }
             }
+            EmoteSnapshot::global().setBadgeSets(SNAPSHOT_KEY, *badgeSets);
 
             this->loaded();
         },
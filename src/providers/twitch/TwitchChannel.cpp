@@ -12,6 +12,7 @@
 #include "controllers/notifications/NotificationController.hpp"
 #include "controllers/twitch/LiveController.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteSnapshot.hpp"
 #include "messages/Image.hpp"
 #include "messages/Link.hpp"
 #include "messages/Message.hpp"
@@ -106,6 +107,33 @@ constexpr auto MAX_CHATTERS_TO_FETCH = 5000;
 // From Twitch docs - expected size for a badge (1x)
 constexpr QSize BASE_BADGE_SIZE(18, 18);
 
+EmoteSnapshot::BadgeSets makeBadgeSets(const HelixChannelBadges &channelBadges)
+{
+    EmoteSnapshot::BadgeSets badgeSets;
+    for (const auto &badgeSet : channelBadges.badgeSets)
+    {
+        const auto &setID = badgeSet.setID;
+        for (const auto &version : badgeSet.versions)
+        {
+            auto emote = Emote{
+                .name = EmoteName{},
+                .images =
+                    ImageSet{
+                        Image::fromUrl(version.imageURL1x, 1, BASE_BADGE_SIZE),
+                        Image::fromUrl(version.imageURL2x, .5,
+                                       BASE_BADGE_SIZE * 2),
+                        Image::fromUrl(version.imageURL4x, .25,
+                                       BASE_BADGE_SIZE * 4),
+                    },
+                .tooltip = Tooltip{version.title},
+                .homePage = version.clickURL,
+            };
+            badgeSets[setID][version.id] = std::make_shared<Emote>(emote);
+        }
+    }
+    return badgeSets;
+}
+
 }  // namespace
 
 TwitchChannel::TwitchChannel(const QString &name)
@@ -119,6 +147,7 @@ TwitchChannel::TwitchChannel(const QString &name)
     , bttvEmotes_(std::make_shared<EmoteMap>())
     , ffzEmotes_(std::make_shared<EmoteMap>())
     , seventvEmotes_(std::make_shared<EmoteMap>())
+    , mergedEmotes_(std::make_shared<const MergedEmoteMap>())
 {
     qCDebug(chatterinoTwitch) << "[TwitchChannel" << name << "] Opened";
 
@@ -355,25 +384,38 @@ void TwitchChannel::refreshBTTVChannelEmotes(bool manualRefresh)
     if (!Settings::instance().enableBTTVChannelEmotes)
     {
         this->bttvEmotes_.set(EMPTY_EMOTE_MAP);
+        this->updateMergedEmotes(MergedEmoteMap::Source::BttvChannel);
         return;
     }
 
-    bool cacheHit = readProviderEmotesCache(
-        this->roomId(), "betterttv",
-        [this, weak = weakOf<Channel>(this)](auto jsonDoc) {
-            if (auto shared = weak.lock())
-            {
-                auto emoteMap = bttv::detail::parseChannelEmotes(
-                    jsonDoc.object(), this->getLocalizedName());
-                this->setBttvEmotes(std::make_shared<const EmoteMap>(emoteMap));
-            }
-        });
+    QString snapshotKey = this->roomId() % ".betterttv";
+    bool cacheHit = false;
+    if (auto emotes = EmoteSnapshot::global().emotes(snapshotKey))
+    {
+        this->setBttvEmotes(std::move(emotes));
+        cacheHit = true;
+    }
+    else
+    {
+        cacheHit = readProviderEmotesCache(
+            this->roomId(), "betterttv",
+            [this, weak = weakOf<Channel>(this)](auto jsonDoc) {
+                if (auto shared = weak.lock())
+                {
+                    auto emoteMap = bttv::detail::parseChannelEmotes(
+                        jsonDoc.object(), this->getLocalizedName());
+                    this->setBttvEmotes(
+                        std::make_shared<const EmoteMap>(emoteMap));
+                }
+            });
+    }
 
     BttvEmotes::loadChannel(
         weakOf<Channel>(this), this->roomId(), this->getLocalizedName(),
-        [this, weak = weakOf<Channel>(this)](auto &&emoteMap) {
+        [this, weak = weakOf<Channel>(this), snapshotKey](auto &&emoteMap) {
             if (auto shared = weak.lock())
             {
+                EmoteSnapshot::global().setEmotes(snapshotKey, emoteMap);
                 this->setBttvEmotes(std::make_shared<const EmoteMap>(emoteMap));
             }
         },
@@ -385,20 +427,33 @@ void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
     if (!Settings::instance().enableFFZChannelEmotes)
     {
         this->ffzEmotes_.set(EMPTY_EMOTE_MAP);
+        this->updateMergedEmotes(MergedEmoteMap::Source::FfzChannel);
         return;
     }
 
-    bool cacheHit = readProviderEmotesCache(
-        this->roomId(), "frankerfacez", [this](const auto &jsonDoc) {
-            auto emoteMap = ffz::detail::parseChannelEmotes(jsonDoc.object());
-            this->setFfzEmotes(std::make_shared<const EmoteMap>(emoteMap));
-        });
+    QString snapshotKey = this->roomId() % ".frankerfacez";
+    bool cacheHit = false;
+    if (auto emotes = EmoteSnapshot::global().emotes(snapshotKey))
+    {
+        this->setFfzEmotes(std::move(emotes));
+        cacheHit = true;
+    }
+    else
+    {
+        cacheHit = readProviderEmotesCache(
+            this->roomId(), "frankerfacez", [this](const auto &jsonDoc) {
+                auto emoteMap =
+                    ffz::detail::parseChannelEmotes(jsonDoc.object());
+                this->setFfzEmotes(std::make_shared<const EmoteMap>(emoteMap));
+            });
+    }
 
     FfzEmotes::loadChannel(
         weakOf<Channel>(this), this->roomId(),
-        [this, weak = weakOf<Channel>(this)](auto &&emoteMap) {
+        [this, weak = weakOf<Channel>(this), snapshotKey](auto &&emoteMap) {
             if (auto shared = weak.lock())
             {
+                EmoteSnapshot::global().setEmotes(snapshotKey, emoteMap);
                 this->setFfzEmotes(std::make_shared<const EmoteMap>(emoteMap));
             }
         },
@@ -419,8 +474,7 @@ void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
         [this, weak = weakOf<Channel>(this)](auto &&channelBadges) {
             if (auto shared = weak.lock())
             {
-                this->tgFfzChannelBadges_.guard();
-                this->ffzChannelBadges_ =
+                *this->ffzChannelBadges_.access() =
                     std::forward<decltype(channelBadges)>(channelBadges);
             }
         },
@@ -432,24 +486,34 @@ void TwitchChannel::refreshSevenTVChannelEmotes(bool manualRefresh)
     if (!Settings::instance().enableSevenTVChannelEmotes)
     {
         this->seventvEmotes_.set(EMPTY_EMOTE_MAP);
+        this->updateMergedEmotes(MergedEmoteMap::Source::SeventvChannel);
         return;
     }
 
-    bool cacheHit = readProviderEmotesCache(
-        this->roomId(), "seventv", [this](auto jsonDoc) {
-            const auto json = jsonDoc.object();
-            const auto emoteSet = json["emote_set"].toObject();
-            const auto parsedEmotes = emoteSet["emotes"].toArray();
-            auto emoteMap = seventv::detail::parseEmotes(parsedEmotes, false);
-            this->setSeventvEmotes(std::make_shared<const EmoteMap>(emoteMap));
-        });
+    QString snapshotKey = this->roomId() % ".seventv";
+    bool cacheHit = false;
+    if (auto emotes = EmoteSnapshot::global().emotes(snapshotKey))
+    {
+        this->setSeventvEmotes(std::move(emotes));
+        cacheHit = true;
+    }
+    else if (auto cached =
+                 readProviderEmotesCacheData(this->roomId(), "seventv"))
+    {
+        cacheHit = true;
+        if (auto user = seventv::detail::readEmoteSet(*cached, false))
+        {
+            this->setSeventvEmotes(std::move(user->emotes));
+        }
+    }
 
     SeventvEmotes::loadChannelEmotes(
         weakOf<Channel>(this), this->roomId(),
-        [this, weak = weakOf<Channel>(this)](auto &&emoteMap,
-                                             auto channelInfo) {
+        [this, weak = weakOf<Channel>(this), snapshotKey](auto &&emoteMap,
+                                                          auto channelInfo) {
             if (auto shared = weak.lock())
             {
+                EmoteSnapshot::global().setEmotes(snapshotKey, emoteMap);
                 this->setSeventvEmotes(
                     std::make_shared<const EmoteMap>(emoteMap));
                 this->updateSeventvData(channelInfo.userID,
@@ -464,16 +528,72 @@ void TwitchChannel::refreshSevenTVChannelEmotes(bool manualRefresh)
 void TwitchChannel::setBttvEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
     this->bttvEmotes_.set(std::move(map));
+    this->updateMergedEmotes(MergedEmoteMap::Source::BttvChannel);
 }
 
 void TwitchChannel::setFfzEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
     this->ffzEmotes_.set(std::move(map));
+    this->updateMergedEmotes(MergedEmoteMap::Source::FfzChannel);
 }
 
 void TwitchChannel::setSeventvEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
     this->seventvEmotes_.set(std::move(map));
+    this->updateMergedEmotes(MergedEmoteMap::Source::SeventvChannel);
+}
+
+std::shared_ptr<const MergedEmoteMap> TwitchChannel::mergedEmotes() const
+{
+    auto merged = this->mergedEmotes_.get();
+    if (merged->builtForGlobalGeneration() ==
+        MergedEmoteMap::globalGeneration())
+    {
+        return merged;
+    }
+
+    // The global emotes changed since the map was built
+    std::lock_guard lock(this->mergedEmotesMutex_);
+
+    merged = this->mergedEmotes_.get();
+    auto generation = MergedEmoteMap::globalGeneration();
+    if (merged->builtForGlobalGeneration() != generation)
+    {
+        auto *app = getApp();
+        merged = merged->withGlobals(generation, app->getFfzEmotes()->emotes(),
+                                     app->getBttvEmotes()->emotes(),
+                                     app->getSeventvEmotes()->globalEmotes());
+        this->mergedEmotes_.set(merged);
+    }
+
+    return merged;
+}
+
+void TwitchChannel::updateMergedEmotes(MergedEmoteMap::Source source)
+{
+    using Source = MergedEmoteMap::Source;
+
+    std::lock_guard lock(this->mergedEmotesMutex_);
+
+    std::shared_ptr<const EmoteMap> emotes;
+    switch (source)
+    {
+        case Source::FfzChannel:
+            emotes = this->ffzEmotes_.get();
+            break;
+        case Source::BttvChannel:
+            emotes = this->bttvEmotes_.get();
+            break;
+        case Source::SeventvChannel:
+            emotes = this->seventvEmotes_.get();
+            break;
+        default:
+            assert(false && "Global emotes are updated in mergedEmotes()");
+            return;
+    }
+
+    this->mergedEmotes_.set(
+        this->mergedEmotes_.get()->withSource(source, std::move(emotes)));
 }
 
 void TwitchChannel::addQueuedRedemption(const QString &rewardId,
@@ -973,6 +1093,15 @@ void TwitchChannel::setRoomId(const QString &id)
         // This is intended for tests and benchmarks. See comment in constructor.
         if (!getApp()->isTest())
         {
+            // Restoring a big layout joins many channels at once. The ones
+            // in visible splits are loaded first. Selecting a tab raises the
+            // requests of its channels (see SplitNotebook::select).
+            auto visible =
+                getApp()->getWindows()->getVisibleChannelNames().contains(
+                    this->getName());
+            NetworkPriorityScope priority(
+                visible ? NetworkPriority::High : NetworkPriority::Low,
+                this->getName());
             this->roomIdChanged();
             this->loadRecentMessages();
         }
@@ -1107,6 +1236,7 @@ void TwitchChannel::addBttvEmote(
 {
     auto emote = BttvEmotes::addEmote(this->getDisplayName(), this->bttvEmotes_,
                                       message);
+    this->updateMergedEmotes(MergedEmoteMap::Source::BttvChannel);
 
     this->addOrReplaceLiveUpdatesAddRemove(true, "BTTV", QString() /*actor*/,
                                            emote->name.string);
@@ -1121,6 +1251,7 @@ void TwitchChannel::updateBttvEmote(
     {
         return;
     }
+    this->updateMergedEmotes(MergedEmoteMap::Source::BttvChannel);
 
     const auto [oldEmote, newEmote] = *updated;
     if (oldEmote->name == newEmote->name)
@@ -1142,6 +1273,7 @@ void TwitchChannel::removeBttvEmote(
     {
         return;
     }
+    this->updateMergedEmotes(MergedEmoteMap::Source::BttvChannel);
 
     this->addOrReplaceLiveUpdatesAddRemove(false, "BTTV", QString() /*actor*/,
                                            (*removed)->name.string);
@@ -1154,6 +1286,7 @@ void TwitchChannel::addSeventvEmote(
     {
         return;
     }
+    this->updateMergedEmotes(MergedEmoteMap::Source::SeventvChannel);
 
     this->addOrReplaceLiveUpdatesAddRemove(
         true, "7TV", dispatch.actorName, dispatch.emoteJson["name"].toString());
@@ -1166,6 +1299,7 @@ void TwitchChannel::updateSeventvEmote(
     {
         return;
     }
+    this->updateMergedEmotes(MergedEmoteMap::Source::SeventvChannel);
 
     auto builder =
         MessageBuilder(liveUpdatesUpdateEmoteMessage, "7TV", dispatch.actorName,
@@ -1181,6 +1315,7 @@ void TwitchChannel::removeSeventvEmote(
     {
         return;
     }
+    this->updateMergedEmotes(MergedEmoteMap::Source::SeventvChannel);
 
     this->addOrReplaceLiveUpdatesAddRemove(false, "7TV", dispatch.actorName,
                                            (*removed)->name.string);
@@ -1203,7 +1338,7 @@ void TwitchChannel::updateSeventvUser(
             postToThread([this, weak, dispatch, emotes, name]() {
                 if (auto shared = weak.lock())
                 {
-                    this->seventvEmotes_.set(
+                    this->setSeventvEmotes(
                         std::make_shared<EmoteMap>(emotes));
                     auto builder =
                         MessageBuilder(liveUpdatesUpdateEmoteSetMessage, "7TV",
@@ -1218,6 +1353,8 @@ void TwitchChannel::updateSeventvUser(
                 if (auto shared = weak.lock())
                 {
                     this->seventvEmotes_.set(EMPTY_EMOTE_MAP);
+                    this->updateMergedEmotes(
+                        MergedEmoteMap::Source::SeventvChannel);
                     this->addSystemMessage(
                         QString("Failed updating 7TV emote set (%1).")
                             .arg(reason));
@@ -1805,10 +1942,22 @@ void TwitchChannel::refreshBadges()
         return;
     }
 
+    // Show the badges from the last session until they're loaded
+    QString snapshotKey = this->roomId() % ".twitch-badges";
+    if (auto snapshot = EmoteSnapshot::global().badgeSets(snapshotKey))
+    {
+        auto badgeSets = this->badgeSets_.access();
+        for (auto &[setID, versions] : *snapshot)
+        {
+            (*badgeSets)[setID].insert(versions.begin(), versions.end());
+        }
+    }
+
     getHelix()->getChannelBadges(
         this->roomId(),
         // successCallback
-        [this, weak = weakOf<Channel>(this)](const auto &channelBadges) {
+        [this, weak = weakOf<Channel>(this),
+         snapshotKey](const auto &channelBadges) {
             auto shared = weak.lock();
             if (!shared)
             {
@@ -1816,7 +1965,19 @@ void TwitchChannel::refreshBadges()
                 return;
             }
 
-            this->addTwitchBadgeSets(channelBadges);
+            auto fresh = makeBadgeSets(channelBadges);
+            {
+                // Replaces the badges from the snapshot, so badges that were
+                // removed from the channel are dropped
+                auto badgeSets = this->badgeSets_.access();
+                badgeSets->clear();
+                for (const auto &[setID, versions] : fresh)
+                {
+                    (*badgeSets)[setID].insert(versions.begin(),
+                                               versions.end());
+                }
+            }
+            EmoteSnapshot::global().setBadgeSets(snapshotKey, fresh);
         },
         // failureCallback
         [this, weak = weakOf<Channel>(this)](auto error, auto message) {
@@ -1851,25 +2012,11 @@ void TwitchChannel::addTwitchBadgeSets(const HelixChannelBadges &channelBadges)
 {
     auto badgeSets = this->badgeSets_.access();
 
-    for (const auto &badgeSet : channelBadges.badgeSets)
+    for (auto &[setID, versions] : makeBadgeSets(channelBadges))
     {
-        const auto &setID = badgeSet.setID;
-        for (const auto &version : badgeSet.versions)
+        for (auto &[version, badge] : versions)
         {
-            auto emote = Emote{
-                .name = EmoteName{},
-                .images =
-                    ImageSet{
-                        Image::fromUrl(version.imageURL1x, 1, BASE_BADGE_SIZE),
-                        Image::fromUrl(version.imageURL2x, .5,
-                                       BASE_BADGE_SIZE * 2),
-                        Image::fromUrl(version.imageURL4x, .25,
-                                       BASE_BADGE_SIZE * 4),
-                    },
-                .tooltip = Tooltip{version.title},
-                .homePage = version.clickURL,
-            };
-            (*badgeSets)[setID][version.id] = std::make_shared<Emote>(emote);
+            (*badgeSets)[setID][version] = std::move(badge);
         }
     }
 }
@@ -2177,10 +2324,10 @@ std::optional<EmotePtr> TwitchChannel::twitchBadge(const QString &set,
 std::vector<FfzBadges::Badge> TwitchChannel::ffzChannelBadges(
     const QString &userID) const
 {
-    this->tgFfzChannelBadges_.guard();
+    auto channelBadges = this->ffzChannelBadges_.accessConst();
 
-    auto it = this->ffzChannelBadges_.find(userID);
-    if (it == this->ffzChannelBadges_.end())
+    auto it = channelBadges->find(userID);
+    if (it == channelBadges->end())
     {
         return {};
     }
@@ -2203,8 +2350,7 @@ std::vector<FfzBadges::Badge> TwitchChannel::ffzChannelBadges(
 
 void TwitchChannel::setFfzChannelBadges(FfzChannelBadgeMap map)
 {
-    this->tgFfzChannelBadges_.guard();
-    this->ffzChannelBadges_ = std::move(map);
+    *this->ffzChannelBadges_.access() = std::move(map);
 }
 
 std::optional<EmotePtr> TwitchChannel::ffzCustomModBadge() const
@@ -6,12 +6,12 @@
 #include "common/ChannelChatters.hpp"
 #include "common/Common.hpp"
 #include "common/UniqueAccess.hpp"
+#include "messages/MergedEmoteMap.hpp"
 #include "providers/ffz/FfzBadges.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/twitch/eventsub/SubscriptionHandle.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "util/QStringHash.hpp"
-#include "util/ThreadGuard.hpp"
 
 #include <boost/circular_buffer/space_optimized.hpp>
 #include <boost/signals2.hpp>
@@ -222,6 +222,10 @@ public:
     std::shared_ptr<const EmoteMap> ffzEmotes() const;
     std::shared_ptr<const EmoteMap> seventvEmotes() const;
 
+    /// Returns the FFZ, BTTV and 7TV emotes (channel and global) usable in
+    /// this channel merged into one map.
+    std::shared_ptr<const MergedEmoteMap> mergedEmotes() const;
+
     void refreshTwitchChannelEmotes(bool manualRefresh);
     void refreshBTTVChannelEmotes(bool manualRefresh);
     void refreshFFZChannelEmotes(bool manualRefresh);
@@ -466,10 +470,14 @@ protected:
     Atomic<std::optional<EmotePtr>> ffzCustomModBadge_;
     Atomic<std::optional<EmotePtr>> ffzCustomVipBadge_;
 
-    FfzChannelBadgeMap ffzChannelBadges_;
-    ThreadGuard tgFfzChannelBadges_;
+    UniqueAccess<FfzChannelBadgeMap> ffzChannelBadges_;
 
 private:
+    /// Must be called after the channel emotes of @a source changed
+    void updateMergedEmotes(MergedEmoteMap::Source source);
+    mutable std::mutex mergedEmotesMutex_;
+    mutable Atomic<std::shared_ptr<const MergedEmoteMap>> mergedEmotes_;
+
     // Badges
     UniqueAccess<std::map<QString, std::map<QString, EmotePtr>>>
         badgeSets_;  // "subscribers": { "0": ... "3": ... "6": ...
@@ -478,9 +486,10 @@ private:
     boost::circular_buffer_space_optimized<QueuedRedemption>
         waitingRedemptions_{MAX_QUEUED_REDEMPTIONS};
 
-    bool mod_ = false;
-    bool vip_ = false;
-    bool staff_ = false;
+    // Read from the IRC message builders on worker threads
+    std::atomic<bool> mod_ = false;
+    std::atomic<bool> vip_ = false;
+    std::atomic<bool> staff_ = false;
     UniqueAccess<QString> roomID_;
 
     // --
@@ -4,6 +4,7 @@
 #include "common/Aliases.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/emotes/EmoteController.hpp"
+#include "providers/twitch/IrcTags.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "util/IrcHelpers.hpp"
 
@@ -82,21 +83,11 @@ void appendTwitchEmoteOccurrences(const QString &emote,
     }
 }
 
-}  // namespace
-
-namespace chatterino {
-
-std::unordered_map<QString, QString> parseBadgeInfoTag(const QVariantMap &tags)
+std::unordered_map<QString, QString> parseBadgeInfoValue(const QString &value)
 {
     std::unordered_map<QString, QString> infoMap;
 
-    auto infoIt = tags.constFind("badge-info");
-    if (infoIt == tags.end())
-    {
-        return infoMap;
-    }
-
-    auto info = infoIt.value().toString().split(',', Qt::SkipEmptyParts);
+    auto info = value.split(',', Qt::SkipEmptyParts);
 
     for (const QString &badge : info)
     {
@@ -106,17 +97,11 @@ std::unordered_map<QString, QString> parseBadgeInfoTag(const QVariantMap &tags)
     return infoMap;
 }
 
-std::vector<Badge> parseBadgeTag(const QVariantMap &tags)
+std::vector<Badge> parseBadgeValue(const QString &value)
 {
     std::vector<Badge> b;
 
-    auto badgesIt = tags.constFind("badges");
-    if (badgesIt == tags.end())
-    {
-        return b;
-    }
-
-    auto badges = badgesIt.value().toString().split(',', Qt::SkipEmptyParts);
+    auto badges = value.split(',', Qt::SkipEmptyParts);
 
     for (const QString &badge : badges)
     {
@@ -132,21 +117,13 @@ std::vector<Badge> parseBadgeTag(const QVariantMap &tags)
     return b;
 }
 
-std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const QVariantMap &tags,
-                                                     const QString &content,
-                                                     int messageOffset)
+std::vector<TwitchEmoteOccurrence> parseEmotesValue(const QString &value,
+                                                    const QString &content,
+                                                    int messageOffset)
 {
-    // Twitch emotes
     std::vector<TwitchEmoteOccurrence> twitchEmotes;
 
-    auto emotesTag = tags.find("emotes");
-
-    if (emotesTag == tags.end())
-    {
-        return twitchEmotes;
-    }
-
-    QStringList emoteString = emotesTag.value().toString().split('/');
+    QStringList emoteString = value.split('/');
     std::vector<int> correctPositions;
     for (int i = 0; i < content.size(); ++i)
     {
@@ -164,4 +141,67 @@ std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const QVariantMap &tags,
     return twitchEmotes;
 }
 
+}  // namespace
+
+namespace chatterino {
+
+std::unordered_map<QString, QString> parseBadgeInfoTag(const QVariantMap &tags)
+{
+    auto infoIt = tags.constFind("badge-info");
+    if (infoIt == tags.end())
+    {
+        return {};
+    }
+
+    return parseBadgeInfoValue(infoIt.value().toString());
+}
+
+std::unordered_map<QString, QString> parseBadgeInfoTag(const IrcTags &tags)
+{
+    return parseBadgeInfoValue(tags.value(IrcTag::BadgeInfo));
+}
+
+std::vector<Badge> parseBadgeTag(const QVariantMap &tags)
+{
+    auto badgesIt = tags.constFind("badges");
+    if (badgesIt == tags.end())
+    {
+        return {};
+    }
+
+    return parseBadgeValue(badgesIt.value().toString());
+}
+
+std::vector<Badge> parseBadgeTag(const IrcTags &tags)
+{
+    return parseBadgeValue(tags.value(IrcTag::Badges));
+}
+
+std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const QVariantMap &tags,
+                                                     const QString &content,
+                                                     int messageOffset)
+{
+    auto emotesTag = tags.find("emotes");
+    if (emotesTag == tags.end())
+    {
+        return {};
+    }
+
+    return parseEmotesValue(emotesTag.value().toString(), content,
+                            messageOffset);
+}
+
+std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const IrcTags &tags,
+                                                     const QString &content,
+                                                     int messageOffset)
+{
+    if (!tags.contains(IrcTag::Emotes))
+    {
+        return {};
+    }
+
+    return parseEmotesValue(tags.value(IrcTag::Emotes), content,
+                            messageOffset);
+}
+
 }  // namespace chatterino
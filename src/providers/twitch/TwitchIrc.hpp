@@ -10,6 +10,8 @@
 
 namespace chatterino {
 
+class IrcTags;
+
 struct TwitchEmoteOccurrence {
     int start;
     int end;
@@ -34,6 +36,7 @@ struct TwitchEmoteOccurrence {
 /// @param tags The tags of the IRC message
 /// @returns A map of badge-names to their values
 std::unordered_map<QString, QString> parseBadgeInfoTag(const QVariantMap &tags);
+std::unordered_map<QString, QString> parseBadgeInfoTag(const IrcTags &tags);
 
 /// @brief Parses the `badges` tag of an IRC message
 ///
@@ -47,6 +50,7 @@ std::unordered_map<QString, QString> parseBadgeInfoTag(const QVariantMap &tags);
 /// @param tags The tags of the IRC message
 /// @returns A list of badges (name and version)
 std::vector<Badge> parseBadgeTag(const QVariantMap &tags);
+std::vector<Badge> parseBadgeTag(const IrcTags &tags);
 
 /// @brief Parses Twitch emotes in an IRC message
 ///
@@ -63,5 +67,8 @@ std::vector<Badge> parseBadgeTag(const QVariantMap &tags);
 std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const QVariantMap &tags,
                                                      const QString &content,
                                                      int messageOffset);
+std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(const IrcTags &tags,
+                                                     const QString &content,
+                                                     int messageOffset);
 
 }  // namespace chatterino
@@ -141,6 +141,29 @@ TwitchIrcServer::TwitchIrcServer()
     , liveChannel(new Channel("/live", Channel::Type::TwitchLive))
     , automodChannel(new Channel("/automod", Channel::Type::TwitchAutomod))
     , watchingChannel(Channel::getEmpty(), Channel::Type::TwitchWatching)
+    , readConnections_(
+          [this](IrcConnection *connection,
+                 pajlada::Signals::SignalHolder &connectionSignals) {
+              this->onReadConnectionCreated(connection, connectionSignals);
+          })
+    , readQueue_(
+          [this](Communi::IrcMessage *message) {
+              return IrcMessageHandler::instance().preparePrivMessage(
+                  static_cast<Communi::IrcPrivateMessage *>(message), *this);
+          },
+          [this](Communi::IrcMessage *message) {
+              this->readConnectionMessageReceived(message);
+          },
+          [this](const QString &channelName, size_t count) {
+              auto channel = this->getChannelOrEmpty(channelName);
+              if (!channel->isEmpty())
+              {
+                  channel->addSystemMessage(
+                      QStringLiteral("Skipped %1 messages because chat is "
+                                     "moving too fast.")
+                          .arg(count));
+              }
+          })
 {
     // Initialize the connections
     // XXX: don't create write connection if there is no separate write connection.
@@ -148,13 +171,17 @@ TwitchIrcServer::TwitchIrcServer()
     this->writeConnection_->moveToThread(
         QCoreApplication::instance()->thread());
 
-    // Apply a leaky bucket rate limiting to JOIN messages
+    // Apply a leaky bucket rate limiting to JOIN messages. The rate limit
+    // applies to the account, so all read connections share one bucket.
     auto actuallyJoin = [&](QString message) {
         if (!this->channels.contains(message))
         {
             return;
         }
-        this->readConnection_->sendRaw("JOIN #" + message);
+        if (auto *connection = this->readConnections_.connectionFor(message))
+        {
+            connection->sendRaw("JOIN #" + message);
+        }
     };
     this->joinBucket_.reset(new RatelimitBucket(
         JOIN_RATELIMIT_BUDGET, JOIN_RATELIMIT_COOLDOWN, actuallyJoin, this));
@@ -175,44 +202,51 @@ TwitchIrcServer::TwitchIrcServer()
             this->writeConnection_->smartReconnect();
         });
 
-    // Listen to read connection message signals
-    this->readConnection_.reset(new IrcConnection);
-    this->readConnection_->moveToThread(QCoreApplication::instance()->thread());
+}
 
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::messageReceived, this,
-                     [this](auto msg) {
-                         this->readConnectionMessageReceived(msg);
-                     });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::privateMessageReceived, this,
-                     [this](auto msg) {
-                         this->privateMessageReceived(msg);
+void TwitchIrcServer::onReadConnectionCreated(
+    IrcConnection *connection,
+    pajlada::Signals::SignalHolder &connectionSignals)
+{
+    // Listen to read connection message signals
+    QObject::connect(connection, &Communi::IrcConnection::messageReceived,
+                     this, [this](auto msg) {
+                         this->readQueue_.push(msg);
                      });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::connected, this, [this] {
-                         this->onReadConnected(this->readConnection_.get());
+    QObject::connect(connection, &Communi::IrcConnection::connected, this,
+                     [this, connection] {
+                         this->onReadConnected(connection);
                      });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::disconnected, this, [this] {
-                         this->onDisconnected();
+    QObject::connect(connection, &Communi::IrcConnection::disconnected, this,
+                     [this, connection] {
+                         this->onDisconnected(connection);
                      });
-    this->signalHolder.managedConnect(
-        this->readConnection_->connectionLost, [this](bool timeout) {
+    connectionSignals.managedConnect(
+        connection->connectionLost, [this, connection](bool timeout) {
             qCDebug(chatterinoIrc)
                 << "Read connection reconnect requested. Timeout:" << timeout;
             if (timeout)
             {
                 // Show additional message since this is going to interrupt a
                 // connection that is still "connected"
-                this->addGlobalSystemMessage(
-                    "Server connection timed out, reconnecting");
+                this->addSystemMessage(
+                    connection, "Server connection timed out, reconnecting");
             }
-            this->readConnection_->smartReconnect();
+            connection->smartReconnect();
         });
-    this->signalHolder.managedConnect(this->readConnection_->heartbeat, [this] {
-        this->markChannelsConnected();
-    });
+    connectionSignals.managedConnect(connection->heartbeat,
+                                     [this, connection] {
+                                         this->markChannelsConnected(
+                                             connection);
+                                     });
+
+    // Connections created for new channels while we're connected have to be
+    // opened right away
+    if (this->readConnectionsOpen_)
+    {
+        this->initializeConnection(connection, ConnectionType::Read);
+        connection->open();
+    }
 }
 
 void TwitchIrcServer::initialize()
@@ -302,8 +336,6 @@ void TwitchIrcServer::initializeConnection(IrcConnection *connection,
     connection->setHost(Env::get().twitchServerHost);
     connection->setPort(Env::get().twitchServerPort);
     connection->setSecure(Env::get().twitchServerSecure);
-
-    this->open(type);
 }
 
 std::shared_ptr<Channel> TwitchIrcServer::createChannel(
@@ -351,7 +383,8 @@ void TwitchIrcServer::readConnectionMessageReceived(
 {
     if (message->type() == Communi::IrcMessage::Type::Private)
     {
-        // We already have a handler for private messages
+        this->privateMessageReceived(
+            static_cast<Communi::IrcPrivateMessage *>(message));
         return;
     }
 
@@ -401,10 +434,26 @@ void TwitchIrcServer::readConnectionMessageReceived(
     }
     else if (command == "RECONNECT")
     {
-        this->addGlobalSystemMessage(
+        // The sender might have been removed from the pool while the message
+        // was queued, so it's only used if it's still part of the pool
+        auto *connection = this->readConnections_.find(message->connection());
+        if (!connection)
+        {
+            this->addGlobalSystemMessage(
+                "Twitch Servers requested us to reconnect, reconnecting");
+            this->markChannelsConnected();
+            this->connect();
+            return;
+        }
+
+        // Only the connection that received this has to reconnect
+        this->addSystemMessage(
+            connection,
             "Twitch Servers requested us to reconnect, reconnecting");
-        this->markChannelsConnected();
-        this->connect();
+        this->markChannelsConnected(connection);
+        connection->close();
+        this->initializeConnection(connection, ConnectionType::Read);
+        connection->open();
     }
 }
 
@@ -437,21 +486,7 @@ void TwitchIrcServer::writeConnectionMessageReceived(
 
 void TwitchIrcServer::onReadConnected(IrcConnection *connection)
 {
-    (void)connection;
-
-    std::vector<ChannelPtr> activeChannels;
-    {
-        std::lock_guard lock(this->channelMutex);
-
-        activeChannels.reserve(this->channels.size());
-        for (const auto &weak : this->channels)
-        {
-            if (auto channel = weak.lock())
-            {
-                activeChannels.push_back(channel);
-            }
-        }
-    }
+    auto activeChannels = this->channelsOf(connection);
 
     // put the visible channels first
     auto visible = getApp()->getWindows()->getVisibleChannelNames();
@@ -502,22 +537,14 @@ void TwitchIrcServer::onWriteConnected(IrcConnection *connection)
     (void)connection;
 }
 
-void TwitchIrcServer::onDisconnected()
+void TwitchIrcServer::onDisconnected(IrcConnection *connection)
 {
-    std::lock_guard<std::mutex> lock(this->channelMutex);
-
     MessageBuilder b(systemMessage, "disconnected");
     b->flags.set(MessageFlag::DisconnectedMessage);
     auto disconnectedMsg = b.release();
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values())
+    for (const auto &chan : this->channelsOf(connection))
     {
-        std::shared_ptr<Channel> chan = weak.lock();
-        if (!chan)
-        {
-            continue;
-        }
-
         chan->addMessage(disconnectedMsg, MessageContext::Original);
 
         if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
@@ -1050,12 +1077,42 @@ void TwitchIrcServer::markChannelsConnected()
     });
 }
 
+void TwitchIrcServer::markChannelsConnected(IrcConnection *connection)
+{
+    for (const auto &chan : this->channelsOf(connection))
+    {
+        if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
+        {
+            channel->markConnected();
+        }
+    }
+}
+
+std::vector<ChannelPtr> TwitchIrcServer::channelsOf(
+    IrcConnection *connection)
+{
+    auto channelNames = this->readConnections_.channelsOf(connection);
+
+    std::vector<ChannelPtr> result;
+    result.reserve(channelNames.size());
+
+    std::lock_guard lock(this->channelMutex);
+    for (const auto &channelName : channelNames)
+    {
+        if (auto channel = this->channels.value(channelName).lock())
+        {
+            result.emplace_back(std::move(channel));
+        }
+    }
+    return result;
+}
+
 void TwitchIrcServer::addFakeMessage(const QString &data)
 {
     assertInGuiThread();
 
     auto *fakeMessage = Communi::IrcMessage::fromData(
-        data.toUtf8(), this->readConnection_.get());
+        data.toUtf8(), this->readConnections_.primary());
 
     if (fakeMessage->command() == "PRIVMSG")
     {
@@ -1087,6 +1144,18 @@ void TwitchIrcServer::addGlobalSystemMessage(const QString &messageText)
     }
 }
 
+void TwitchIrcServer::addSystemMessage(IrcConnection *connection,
+                                       const QString &messageText)
+{
+    MessageBuilder b(systemMessage, messageText);
+    auto message = b.release();
+
+    for (const auto &chan : this->channelsOf(connection))
+    {
+        chan->addMessage(message, MessageContext::Original);
+    }
+}
+
 void TwitchIrcServer::forEachChannel(std::function<void(ChannelPtr)> func)
 {
     std::lock_guard<std::mutex> lock(this->channelMutex);
@@ -1109,17 +1178,40 @@ void TwitchIrcServer::connect()
 
     this->disconnect();
 
+    // Channels might have been parted since the last connect, so we might
+    // need fewer connections now
+    QStringList channelNames;
+    {
+        std::lock_guard lock(this->channelMutex);
+        for (const auto &channelName : this->channels.keys())
+        {
+            // HACK(mm2pl): This prevents custom invalid twitch channels used by plugins from being joined
+            if (!channelName.startsWith("/"))
+            {
+                channelNames.append(channelName);
+            }
+        }
+    }
+    this->readConnections_.rebalance(channelNames);
+
     this->initializeConnection(this->writeConnection_.get(),
                                ConnectionType::Write);
-    this->initializeConnection(this->readConnection_.get(),
-                               ConnectionType::Read);
+    this->readConnections_.forEachConnection([this](auto *connection) {
+        this->initializeConnection(connection, ConnectionType::Read);
+    });
+
+    this->open(ConnectionType::Write);
+    this->open(ConnectionType::Read);
 }
 
 void TwitchIrcServer::disconnect()
 {
     std::lock_guard<std::mutex> locker(this->connectionMutex_);
 
-    this->readConnection_->close();
+    this->readConnectionsOpen_ = false;
+    this->readConnections_.forEachConnection([](auto *connection) {
+        connection->close();
+    });
     this->writeConnection_->close();
 }
 
@@ -1164,27 +1256,28 @@ ChannelPtr TwitchIrcServer::getOrAddChannel(const QString &dirtyChannelName)
                                << "was destroyed";
         this->channels.remove(channelName);
 
-        if (this->readConnection_)
+        // HACK(mm2pl): This prevents custom invalid twitch channels used by plugins from being joined
+        if (!channelName.startsWith("/"))
         {
-            // HACK(mm2pl): This prevents custom invalid twitch channels used by plugins from being joined
-            if (!channelName.startsWith("/"))
+            if (auto *connection =
+                    this->readConnections_.connectionFor(channelName))
             {
-                this->readConnection_->sendRaw("PART #" + channelName);
+                connection->sendRaw("PART #" + channelName);
             }
+            this->readConnections_.unassign(channelName);
         }
     });
 
     // join IRC channel
+    // HACK(mm2pl): This prevents custom invalid twitch channels used by plugins from being joined
+    if (!channelName.startsWith("/"))
     {
         std::lock_guard<std::mutex> lock2(this->connectionMutex_);
 
-        if (this->readConnection_ && this->readConnection_->isConnected())
+        auto *connection = this->readConnections_.assign(channelName);
+        if (connection->isConnected())
         {
-            // HACK(mm2pl): This prevents custom invalid twitch channels used by plugins from being joined
-            if (!channelName.startsWith("/"))
-            {
-                this->joinBucket_->send(channelName);
-            }
+            this->joinBucket_->send(channelName);
         }
     }
 
@@ -1229,7 +1322,10 @@ void TwitchIrcServer::open(ConnectionType type)
     }
     if (type == ConnectionType::Read)
     {
-        this->readConnection_->open();
+        this->readConnectionsOpen_ = true;
+        this->readConnections_.forEachConnection([](auto *connection) {
+            connection->open();
+        });
     }
 }
 
@@ -4,6 +4,8 @@
 #include "common/Channel.hpp"
 #include "common/Common.hpp"
 #include "providers/irc/IrcConnection2.hpp"
+#include "providers/twitch/IrcIngestQueue.hpp"
+#include "providers/twitch/ReadConnectionPool.hpp"
 #include "util/RatelimitBucket.hpp"
 
 #include <IrcMessage>
@@ -15,6 +17,7 @@
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 namespace chatterino {
 
@@ -172,10 +175,20 @@ protected:
     void readConnectionMessageReceived(Communi::IrcMessage *message);
     void writeConnectionMessageReceived(Communi::IrcMessage *message);
 
+    void onReadConnectionCreated(
+        IrcConnection *connection,
+        pajlada::Signals::SignalHolder &connectionSignals);
     void onReadConnected(IrcConnection *connection);
     void onWriteConnected(IrcConnection *connection);
-    void onDisconnected();
+    void onDisconnected(IrcConnection *connection);
     void markChannelsConnected();
+    void markChannelsConnected(IrcConnection *connection);
+
+    /// Returns the channels that are joined through @a connection
+    std::vector<ChannelPtr> channelsOf(IrcConnection *connection);
+    /// Adds a system message to all channels joined through @a connection
+    void addSystemMessage(IrcConnection *connection,
+                          const QString &messageText);
 
     std::shared_ptr<Channel> getCustomChannel(const QString &channelname);
 
@@ -192,7 +205,6 @@ private:
     std::mutex channelMutex;
 
     QObjectPtr<IrcConnection> writeConnection_ = nullptr;
-    QObjectPtr<IrcConnection> readConnection_ = nullptr;
 
     // Our rate limiting bucket for the Twitch join rate limits
     // https://dev.twitch.tv/docs/irc/guide#rate-limits
@@ -210,6 +222,15 @@ private:
     std::queue<std::chrono::steady_clock::time_point> lastMessageMod_;
     std::chrono::steady_clock::time_point lastErrorTimeSpeed_;
     std::chrono::steady_clock::time_point lastErrorTimeAmount_;
+
+    /// True if the read connections were opened and not closed since
+    bool readConnectionsOpen_ = false;
+    /// Creating a connection accesses the members above, so this has to be
+    /// declared after them
+    ReadConnectionPool readConnections_;
+    /// Builds messages from the read connections. Declared after the
+    /// connections, so queued messages are deleted before them.
+    IrcIngestQueue readQueue_;
 };
 
 }  // namespace chatterino
@@ -6,6 +6,7 @@
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
+#include "providers/twitch/api/HelixBroker.hpp"
 #include "util/CancellationToken.hpp"
 #include "util/QMagicEnum.hpp"
 
@@ -29,6 +30,13 @@ using namespace literals;
 
 static IHelix *instance = nullptr;
 
+Helix::Helix()
+    : broker_(std::make_unique<HelixBroker>(*this))
+{
+}
+
+Helix::~Helix() = default;
+
 HelixChatters::HelixChatters(const QJsonObject &jsonObject)
     : total(jsonObject.value("total").toInt())
     , cursor(
@@ -45,6 +53,18 @@ HelixChatters::HelixChatters(const QJsonObject &jsonObject)
 void Helix::fetchUsers(QStringList userIds, QStringList userLogins,
                        ResultCallback<std::vector<HelixUser>> successCallback,
                        HelixFailureCallback failureCallback)
+{
+    this->fetchUsersWithStatus(std::move(userIds), std::move(userLogins),
+                               std::move(successCallback),
+                               [failureCallback](auto /*status*/) {
+                                   failureCallback();
+                               });
+}
+
+void Helix::fetchUsersWithStatus(
+    QStringList userIds, QStringList userLogins,
+    ResultCallback<std::vector<HelixUser>> successCallback,
+    StatusFailureCallback failureCallback)
 {
     QUrlQuery urlQuery;
 
@@ -66,7 +86,7 @@ void Helix::fetchUsers(QStringList userIds, QStringList userLogins,
 
             if (!data.isArray())
             {
-                failureCallback();
+                failureCallback(std::nullopt);
                 return;
             }
 
@@ -79,9 +99,8 @@ void Helix::fetchUsers(QStringList userIds, QStringList userLogins,
 
             successCallback(users);
         })
-        .onError([failureCallback](auto /*result*/) {
-            // TODO: make better xd
-            failureCallback();
+        .onError([failureCallback](const auto &result) {
+            failureCallback(result.status());
         })
         .execute();
 }
@@ -90,19 +109,15 @@ void Helix::getUserByName(QString userName,
                           ResultCallback<HelixUser> successCallback,
                           HelixFailureCallback failureCallback)
 {
-    QStringList userIds;
-    QStringList userLogins{std::move(userName)};
-
-    this->fetchUsers(
-        userIds, userLogins,
-        [successCallback,
-         failureCallback](const std::vector<HelixUser> &users) {
-            if (users.empty())
+    this->broker_->getUserByLogin(
+        userName,
+        [successCallback, failureCallback](const auto &user) {
+            if (!user)
             {
                 failureCallback();
                 return;
             }
-            successCallback(users[0]);
+            successCallback(*user);
         },
         failureCallback);
 }
@@ -111,18 +126,15 @@ void Helix::getUserById(QString userId,
                         ResultCallback<HelixUser> successCallback,
                         HelixFailureCallback failureCallback)
 {
-    QStringList userIds{std::move(userId)};
-    QStringList userLogins;
-
-    this->fetchUsers(
-        userIds, userLogins,
-        [successCallback, failureCallback](const auto &users) {
-            if (users.empty())
+    this->broker_->getUserById(
+        userId,
+        [successCallback, failureCallback](const auto &user) {
+            if (!user)
             {
                 failureCallback();
                 return;
             }
-            successCallback(users[0]);
+            successCallback(*user);
         },
         failureCallback);
 }
@@ -167,6 +179,20 @@ void Helix::fetchStreams(
     QStringList userIds, QStringList userLogins,
     ResultCallback<std::vector<HelixStream>> successCallback,
     HelixFailureCallback failureCallback, std::function<void()> finallyCallback)
+{
+    this->fetchStreamsWithStatus(std::move(userIds), std::move(userLogins),
+                                 std::move(successCallback),
+                                 [failureCallback](auto /*status*/) {
+                                     failureCallback();
+                                 },
+                                 std::move(finallyCallback));
+}
+
+void Helix::fetchStreamsWithStatus(
+    QStringList userIds, QStringList userLogins,
+    ResultCallback<std::vector<HelixStream>> successCallback,
+    StatusFailureCallback failureCallback,
+    std::function<void()> finallyCallback)
 {
     QUrlQuery urlQuery;
 
@@ -188,7 +214,7 @@ void Helix::fetchStreams(
 
             if (!data.isArray())
             {
-                failureCallback();
+                failureCallback(std::nullopt);
                 return;
             }
 
@@ -201,9 +227,8 @@ void Helix::fetchStreams(
 
             successCallback(streams);
         })
-        .onError([failureCallback](auto /*result*/) {
-            // TODO: make better xd
-            failureCallback();
+        .onError([failureCallback](const auto &result) {
+            failureCallback(result.status());
         })
         .finally(finallyCallback)
         .execute();
@@ -214,20 +239,22 @@ void Helix::getStreamById(QString userId,
                           HelixFailureCallback failureCallback,
                           std::function<void()> finallyCallback)
 {
-    QStringList userIds{std::move(userId)};
-    QStringList userLogins;
-
-    this->fetchStreams(
-        userIds, userLogins,
-        [successCallback](const auto &streams) {
-            if (streams.empty())
+    this->broker_->getStreamById(
+        userId,
+        [successCallback, finallyCallback](const auto &stream) {
+            successCallback(stream.has_value(), stream.value_or(HelixStream()));
+            if (finallyCallback)
             {
-                successCallback(false, HelixStream());
-                return;
+                finallyCallback();
             }
-            successCallback(true, streams[0]);
         },
-        failureCallback, finallyCallback);
+        [failureCallback, finallyCallback] {
+            failureCallback();
+            if (finallyCallback)
+            {
+                finallyCallback();
+            }
+        });
 }
 
 void Helix::getStreamByName(QString userName,
@@ -235,20 +262,22 @@ void Helix::getStreamByName(QString userName,
                             HelixFailureCallback failureCallback,
                             std::function<void()> finallyCallback)
 {
-    QStringList userIds;
-    QStringList userLogins{std::move(userName)};
-
-    this->fetchStreams(
-        userIds, userLogins,
-        [successCallback, failureCallback](const auto &streams) {
-            if (streams.empty())
+    this->broker_->getStreamByLogin(
+        userName,
+        [successCallback, finallyCallback](const auto &stream) {
+            successCallback(stream.has_value(), stream.value_or(HelixStream()));
+            if (finallyCallback)
             {
-                successCallback(false, HelixStream());
-                return;
+                finallyCallback();
             }
-            successCallback(true, streams[0]);
         },
-        failureCallback, finallyCallback);
+        [failureCallback, finallyCallback] {
+            failureCallback();
+            if (finallyCallback)
+            {
+                finallyCallback();
+            }
+        });
 }
 
 ///
@@ -437,6 +466,18 @@ void Helix::fetchChannels(
     QStringList userIDs,
     ResultCallback<std::vector<HelixChannel>> successCallback,
     HelixFailureCallback failureCallback)
+{
+    this->fetchChannelsWithStatus(std::move(userIDs),
+                                  std::move(successCallback),
+                                  [failureCallback](auto /*status*/) {
+                                      failureCallback();
+                                  });
+}
+
+void Helix::fetchChannelsWithStatus(
+    QStringList userIDs,
+    ResultCallback<std::vector<HelixChannel>> successCallback,
+    StatusFailureCallback failureCallback)
 {
     QUrlQuery urlQuery;
 
@@ -452,7 +493,7 @@ void Helix::fetchChannels(
 
             if (!data.isArray())
             {
-                failureCallback();
+                failureCallback(std::nullopt);
                 return;
             }
 
@@ -465,8 +506,8 @@ void Helix::fetchChannels(
 
             successCallback(channels);
         })
-        .onError([failureCallback](auto /*result*/) {
-            failureCallback();
+        .onError([failureCallback](const auto &result) {
+            failureCallback(result.status());
         })
         .execute();
 }
@@ -475,28 +516,17 @@ void Helix::getChannel(QString broadcasterId,
                        ResultCallback<HelixChannel> successCallback,
                        HelixFailureCallback failureCallback)
 {
-    QUrlQuery urlQuery;
-    urlQuery.addQueryItem("broadcaster_id", broadcasterId);
-
-    this->makeGet("channels", urlQuery)
-        .onSuccess([successCallback, failureCallback](auto result) {
-            auto root = result.parseJson();
-            auto data = root.value("data");
-
-            if (!data.isArray())
+    this->broker_->getChannel(
+        broadcasterId,
+        [successCallback, failureCallback](const auto &channel) {
+            if (!channel)
             {
                 failureCallback();
                 return;
             }
-
-            HelixChannel channel(data.toArray()[0].toObject());
-
-            successCallback(channel);
-        })
-        .onError([failureCallback](auto /*result*/) {
-            failureCallback();
-        })
-        .execute();
+            successCallback(*channel);
+        },
+        failureCallback);
 }
 
 void Helix::createStreamMarker(
@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <unordered_set>
 #include <vector>
@@ -29,6 +30,7 @@ template <typename... T>
 using ResultCallback = std::function<void(T...)>;
 
 class CancellationToken;
+class HelixBroker;
 
 struct HelixUser {
     QString id;
@@ -1312,6 +1314,14 @@ protected:
 class Helix final : public IHelix
 {
 public:
+    Helix();
+    ~Helix();
+
+    Helix(const Helix &) = delete;
+    Helix(Helix &&) = delete;
+    Helix &operator=(const Helix &) = delete;
+    Helix &operator=(Helix &&) = delete;
+
     // https://dev.twitch.tv/docs/api/reference#get-users
     void fetchUsers(QStringList userIds, QStringList userLogins,
                     ResultCallback<std::vector<HelixUser>> successCallback,
@@ -1718,6 +1728,28 @@ protected:
         FailureCallback<HelixGetModeratorsError, QString> failureCallback);
 
 private:
+    friend class HelixBroker;
+
+    /// Called with the HTTP status of the response, if one was received
+    using StatusFailureCallback = std::function<void(std::optional<int>)>;
+
+    // Like fetchUsers, fetchStreams and fetchChannels, but they pass the
+    // status to the failure callback, so HelixBroker can split rejected
+    // batches.
+    void fetchUsersWithStatus(
+        QStringList userIds, QStringList userLogins,
+        ResultCallback<std::vector<HelixUser>> successCallback,
+        StatusFailureCallback failureCallback);
+    void fetchStreamsWithStatus(
+        QStringList userIds, QStringList userLogins,
+        ResultCallback<std::vector<HelixStream>> successCallback,
+        StatusFailureCallback failureCallback,
+        std::function<void()> finallyCallback);
+    void fetchChannelsWithStatus(
+        QStringList userIDs,
+        ResultCallback<std::vector<HelixChannel>> successCallback,
+        StatusFailureCallback failureCallback);
+
     NetworkRequest makeRequest(const QString &url, const QUrlQuery &urlQuery,
                                NetworkRequestType type);
     NetworkRequest makeGet(const QString &url, const QUrlQuery &urlQuery);
@@ -1737,6 +1769,9 @@ private:
 
     QString clientId;
     QString oauthToken;
+
+    /// Batches getUserById, getStreamById, getChannel & co.
+    std::unique_ptr<HelixBroker> broker_;
 };
 
 // initializeHelix sets the helix instance to _instance
@@ -0,0 +1,178 @@
+#include "providers/twitch/api/HelixBroker.hpp"
+
+#include "util/PostToThread.hpp"
+
+#include <optional>
+
+namespace {
+
+using namespace chatterino;
+
+template <typename T>
+using Results = typename BatchedLookup<T>::Results;
+
+/// Reports a failed request to the lookup. Helix rejects the whole request
+/// with 400 if any ID or login is malformed.
+template <typename T, typename OnFailure>
+auto failureOf(OnFailure onFailure)
+{
+    using FetchError = typename BatchedLookup<T>::FetchError;
+    return [onFailure = std::move(onFailure)](std::optional<int> status) {
+        onFailure(status == 400 ? FetchError::Rejected : FetchError::Failed);
+    };
+}
+
+}  // namespace
+
+namespace chatterino {
+
+HelixBroker::HelixBroker(Helix &helix)
+    : usersByID_(
+          [this, &helix](const auto &ids, auto onSuccess, auto onFailure) {
+              helix.fetchUsersWithStatus(
+                  ids, {},
+                  [this, onSuccess](const auto &users) {
+                      this->storeUsers(users);
+                      Results<HelixUser> results;
+                      for (const auto &user : users)
+                      {
+                          results.emplace_back(user.id, user);
+                      }
+                      onSuccess(std::move(results));
+                  },
+                  failureOf<HelixUser>(onFailure));
+          },
+          WINDOW, USER_TTL)
+    , usersByLogin_(
+          [this, &helix](const auto &logins, auto onSuccess, auto onFailure) {
+              helix.fetchUsersWithStatus(
+                  {}, logins,
+                  [this, onSuccess](const auto &users) {
+                      this->storeUsers(users);
+                      Results<HelixUser> results;
+                      for (const auto &user : users)
+                      {
+                          results.emplace_back(user.login.toLower(), user);
+                      }
+                      onSuccess(std::move(results));
+                  },
+                  failureOf<HelixUser>(onFailure));
+          },
+          WINDOW, USER_TTL)
+    , streamsByID_(
+          [&helix](const auto &ids, auto onSuccess, auto onFailure) {
+              helix.fetchStreamsWithStatus(
+                  ids, {},
+                  [onSuccess](const auto &streams) {
+                      Results<HelixStream> results;
+                      for (const auto &stream : streams)
+                      {
+                          results.emplace_back(stream.userId, stream);
+                      }
+                      onSuccess(std::move(results));
+                  },
+                  failureOf<HelixStream>(onFailure), [] {});
+          },
+          WINDOW, STATUS_TTL)
+    , streamsByLogin_(
+          [&helix](const auto &logins, auto onSuccess, auto onFailure) {
+              helix.fetchStreamsWithStatus(
+                  {}, logins,
+                  [onSuccess](const auto &streams) {
+                      Results<HelixStream> results;
+                      for (const auto &stream : streams)
+                      {
+                          results.emplace_back(stream.userLogin.toLower(),
+                                               stream);
+                      }
+                      onSuccess(std::move(results));
+                  },
+                  failureOf<HelixStream>(onFailure), [] {});
+          },
+          WINDOW, STATUS_TTL)
+    , channels_(
+          [&helix](const auto &ids, auto onSuccess, auto onFailure) {
+              helix.fetchChannelsWithStatus(
+                  ids,
+                  [onSuccess](const auto &channels) {
+                      Results<HelixChannel> results;
+                      for (const auto &channel : channels)
+                      {
+                          results.emplace_back(channel.userId, channel);
+                      }
+                      onSuccess(std::move(results));
+                  },
+                  failureOf<HelixChannel>(onFailure));
+          },
+          WINDOW, STATUS_TTL)
+{
+}
+
+void HelixBroker::getUserById(const QString &userID,
+                              BatchedLookup<HelixUser>::Callback callback,
+                              HelixFailureCallback onFailure)
+{
+    runInGuiThread([this, userID, callback = std::move(callback),
+                    onFailure = std::move(onFailure)]() mutable {
+        this->usersByID_.get(userID, std::move(callback),
+                             std::move(onFailure));
+    });
+}
+
+void HelixBroker::getUserByLogin(const QString &login,
+                                 BatchedLookup<HelixUser>::Callback callback,
+                                 HelixFailureCallback onFailure)
+{
+    runInGuiThread([this, login = login.toLower(),
+                    callback = std::move(callback),
+                    onFailure = std::move(onFailure)]() mutable {
+        this->usersByLogin_.get(login, std::move(callback),
+                                std::move(onFailure));
+    });
+}
+
+void HelixBroker::getStreamById(const QString &userID,
+                                BatchedLookup<HelixStream>::Callback callback,
+                                HelixFailureCallback onFailure)
+{
+    runInGuiThread([this, userID, callback = std::move(callback),
+                    onFailure = std::move(onFailure)]() mutable {
+        this->streamsByID_.get(userID, std::move(callback),
+                               std::move(onFailure));
+    });
+}
+
+void HelixBroker::getStreamByLogin(
+    const QString &login, BatchedLookup<HelixStream>::Callback callback,
+    HelixFailureCallback onFailure)
+{
+    runInGuiThread([this, login = login.toLower(),
+                    callback = std::move(callback),
+                    onFailure = std::move(onFailure)]() mutable {
+        this->streamsByLogin_.get(login, std::move(callback),
+                                  std::move(onFailure));
+    });
+}
+
+void HelixBroker::getChannel(const QString &broadcasterID,
+                             BatchedLookup<HelixChannel>::Callback callback,
+                             HelixFailureCallback onFailure)
+{
+    runInGuiThread([this, broadcasterID, callback = std::move(callback),
+                    onFailure = std::move(onFailure)]() mutable {
+        this->channels_.get(broadcasterID, std::move(callback),
+                            std::move(onFailure));
+    });
+}
+
+void HelixBroker::storeUsers(const std::vector<HelixUser> &users)
+{
+    // Users found by their login can be found by their ID and vice versa
+    for (const auto &user : users)
+    {
+        this->usersByID_.store(user.id, user);
+        this->usersByLogin_.store(user.login.toLower(), user);
+    }
+}
+
+}  // namespace chatterino
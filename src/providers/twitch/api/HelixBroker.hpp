@@ -0,0 +1,58 @@
+#pragma once
+
+#include "providers/twitch/api/Helix.hpp"
+#include "util/BatchedLookup.hpp"
+
+#include <QString>
+
+#include <chrono>
+
+namespace chatterino {
+
+/// Batches the lookups of single users, streams and channels.
+///
+/// Lookups made within WINDOW of each other are sent as one request for up to
+/// 100 IDs (or logins). Results are cached - users for USER_TTL, streams and
+/// channel information for STATUS_TTL. If Helix rejects a batch because of a
+/// malformed key, the batch is split, so only lookups of that key fail.
+///
+/// Can be used from any thread, callbacks are called on the GUI thread.
+class HelixBroker
+{
+public:
+    static constexpr std::chrono::milliseconds WINDOW{50};
+    static constexpr std::chrono::minutes USER_TTL{10};
+    static constexpr std::chrono::seconds STATUS_TTL{10};
+
+    explicit HelixBroker(Helix &helix);
+
+    void getUserById(const QString &userID,
+                     BatchedLookup<HelixUser>::Callback callback,
+                     HelixFailureCallback onFailure);
+    void getUserByLogin(const QString &login,
+                        BatchedLookup<HelixUser>::Callback callback,
+                        HelixFailureCallback onFailure);
+
+    /// The callback gets std::nullopt if the user isn't live
+    void getStreamById(const QString &userID,
+                       BatchedLookup<HelixStream>::Callback callback,
+                       HelixFailureCallback onFailure);
+    void getStreamByLogin(const QString &login,
+                          BatchedLookup<HelixStream>::Callback callback,
+                          HelixFailureCallback onFailure);
+
+    void getChannel(const QString &broadcasterID,
+                    BatchedLookup<HelixChannel>::Callback callback,
+                    HelixFailureCallback onFailure);
+
+private:
+    void storeUsers(const std::vector<HelixUser> &users);
+
+    BatchedLookup<HelixUser> usersByID_;
+    BatchedLookup<HelixUser> usersByLogin_;
+    BatchedLookup<HelixStream> streamsByID_;
+    BatchedLookup<HelixStream> streamsByLogin_;
+    BatchedLookup<HelixChannel> channels_;
+};
+
+}  // namespace chatterino
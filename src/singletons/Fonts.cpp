@@ -4,6 +4,7 @@
 #include "debug/AssertInGuiThread.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/DebugCount.hpp"
 
 #include <QDebug>
 #include <QtGlobal>
@@ -12,6 +13,9 @@ namespace {
 
 using namespace chatterino;
 
+const auto WIDTH_HITS = DebugCount::counter("word width cache hits");
+const auto WIDTH_MISSES = DebugCount::counter("word width cache misses");
+
 int getUsernameBoldness()
 {
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -207,6 +211,57 @@ QFontMetricsF Fonts::getFontMetrics(FontStyle type, float scale)
     return this->getOrCreateFontData(type, scale).metrics;
 }
 
+qreal Fonts::getWordWidth(FontStyle type, float scale, const QString &text)
+{
+    auto &data = this->getOrCreateFontData(type, scale);
+
+    auto it = data.words.find(text);
+    if (it != data.words.end())
+    {
+        WIDTH_HITS.increase();
+        return it->second;
+    }
+
+    qreal width = 0;
+    auto old = data.oldWords.find(text);
+    if (old != data.oldWords.end())
+    {
+        WIDTH_HITS.increase();
+        width = old->second;
+    }
+    else
+    {
+        WIDTH_MISSES.increase();
+        width = data.metrics.horizontalAdvance(text);
+    }
+
+    if (data.words.size() >= MAX_CACHED_WORDS)
+    {
+        data.oldWords = std::move(data.words);
+        data.words.clear();
+    }
+    // Copy the text, so the cache doesn't keep the message it's from alive
+    data.words.emplace(QString(text.constData(), text.size()), width);
+    return width;
+}
+
+qreal Fonts::getCharWidth(FontStyle type, float scale, QChar c)
+{
+    auto &data = this->getOrCreateFontData(type, scale);
+
+    auto [it, inserted] = data.chars.try_emplace(c.unicode(), 0);
+    if (inserted)
+    {
+        WIDTH_MISSES.increase();
+        it->second = data.metrics.horizontalAdvance(c);
+    }
+    else
+    {
+        WIDTH_HITS.increase();
+    }
+    return it->second;
+}
+
 Fonts::FontData &Fonts::getOrCreateFontData(FontStyle type, float scale)
 {
     assertInGuiThread();
@@ -5,6 +5,7 @@
 #include <pajlada/signals/signal.hpp>
 #include <QFont>
 #include <QFontMetrics>
+#include <QString>
 
 #include <unordered_map>
 #include <vector>
@@ -49,6 +50,17 @@ public:
     QFont getFont(FontStyle type, float scale);
     QFontMetricsF getFontMetrics(FontStyle type, float scale);
 
+    /// Returns the horizontal advance of @a text.
+    ///
+    /// Chat is mostly made of the same words (names, emote codes, mentions),
+    /// so the widths are cached per font until the fonts change. Each font
+    /// keeps at most 2 * MAX_CACHED_WORDS recently used words.
+    qreal getWordWidth(FontStyle type, float scale, const QString &text);
+    /// Returns the horizontal advance of @a c. Cached like words.
+    qreal getCharWidth(FontStyle type, float scale, QChar c);
+
+    static constexpr size_t MAX_CACHED_WORDS = 8192;
+
     pajlada::Signals::NoArgSignal fontChanged;
 
 private:
@@ -61,6 +73,13 @@ private:
 
         const QFont font;
         const QFontMetricsF metrics;
+
+        /// Cached word widths. Once `words` is full, it replaces `oldWords`,
+        /// so words that are still in use are moved over when they're
+        /// measured again.
+        std::unordered_map<QString, qreal> words;
+        std::unordered_map<QString, qreal> oldWords;
+        std::unordered_map<char16_t, qreal> chars;
     };
 
     struct ChatFontData {
@@ -1,7 +1,11 @@
 #include "singletons/Logging.hpp"
 
+#include "Application.hpp"
 #include "messages/Message.hpp"
 #include "singletons/helper/LoggingChannel.hpp"
+#include "singletons/helper/LogIndexer.hpp"
+#include "singletons/helper/LogWriter.hpp"
+#include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 
 #include <QDir>
@@ -13,6 +17,7 @@
 namespace chatterino {
 
 Logging::Logging(Settings &settings)
+    : writer_(std::make_unique<LogWriter>())
 {
     // We can safely ignore this signal connection since settings are only-ever destroyed
     // on application exit
@@ -29,6 +34,26 @@ Logging::Logging(Settings &settings)
                 this->onlyLogListedChannels.insert(loggedChannel.channelName());
             }
         });
+
+    settings.enableLogIndex.connect(
+        [this](bool enabled) {
+            this->threadGuard.guard();
+
+            if (enabled == (this->indexer_ != nullptr))
+            {
+                return;
+            }
+            this->indexer_ = enabled ? std::make_shared<LogIndexer>() : nullptr;
+            // The writer keeps the old indexer alive until it's done with
+            // the current batch
+            this->writer_->setIndexer(this->indexer_);
+        },
+        this->signalHolder_);
+}
+
+Logging::~Logging()
+{
+    this->loggingChannels_.clear();
 }
 
 void Logging::addMessage(const QString &channelName, MessagePtr message,
@@ -57,7 +82,8 @@ void Logging::addMessage(const QString &channelName, MessagePtr message,
     auto platIt = this->loggingChannels_.find(platformName);
     if (platIt == this->loggingChannels_.end())
     {
-        auto *channel = new LoggingChannel(channelName, platformName);
+        auto *channel = new LoggingChannel(channelName, platformName,
+                                           *this->writer_);
         channel->addMessage(message, streamID);
         auto map = std::map<QString, std::unique_ptr<LoggingChannel>>();
         this->loggingChannels_[platformName] = std::move(map);
@@ -68,7 +94,8 @@ void Logging::addMessage(const QString &channelName, MessagePtr message,
     auto chanIt = platIt->second.find(channelName);
     if (chanIt == platIt->second.end())
     {
-        auto *channel = new LoggingChannel(channelName, platformName);
+        auto *channel = new LoggingChannel(channelName, platformName,
+                                           *this->writer_);
         channel->addMessage(message, streamID);
         platIt->second.emplace(channelName, channel);
     }
@@ -94,4 +121,27 @@ void Logging::closeChannel(const QString &channelName,
     platIt->second.erase(channelName);
 }
 
+std::vector<LogMatch> Logging::searchLogs(const QString &channelName,
+                                          const QString &platformName,
+                                          const LogQuery &query)
+{
+    this->threadGuard.guard();
+
+    if (!this->indexer_ || platformName.isEmpty())
+    {
+        return {};
+    }
+
+    QString baseDirectory = getSettings()->logPath;
+    if (baseDirectory.isEmpty())
+    {
+        baseDirectory = getApp()->getPaths().messageLogDirectory;
+    }
+
+    return this->indexer_->query(
+        baseDirectory + QDir::separator() +
+            LoggingChannel::subDirectoryFor(channelName, platformName),
+        query);
+}
+
 }  // namespace chatterino
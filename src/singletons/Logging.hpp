@@ -1,13 +1,16 @@
 #pragma once
 
+#include "singletons/helper/LogIndex.hpp"
 #include "util/QStringHash.hpp"
 #include "util/ThreadGuard.hpp"
 
+#include <pajlada/signals/signalholder.hpp>
 #include <QString>
 
 #include <map>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 namespace chatterino {
 
@@ -15,6 +18,8 @@ class Settings;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 class LoggingChannel;
+class LogWriter;
+class LogIndexer;
 
 class ILogging
 {
@@ -27,12 +32,20 @@ public:
 
     virtual void closeChannel(const QString &channelName,
                               const QString &platformName) = 0;
+
+    /// Searches the logs of a channel. Returns nothing if indexing logs is
+    /// disabled.
+    virtual std::vector<LogMatch> searchLogs(const QString &channelName,
+                                             const QString &platformName,
+                                             const LogQuery &query) = 0;
 };
 
 class Logging : public ILogging
 {
 public:
     Logging(Settings &settings);
+    /// Closes all log files and waits until all queued lines are written
+    ~Logging() override;
 
     void addMessage(const QString &channelName, MessagePtr message,
                     const QString &platformName,
@@ -41,9 +54,21 @@ public:
     void closeChannel(const QString &channelName,
                       const QString &platformName) override;
 
+    /// Blocks while the matching lines are read from the log files
+    std::vector<LogMatch> searchLogs(const QString &channelName,
+                                     const QString &platformName,
+                                     const LogQuery &query) override;
+
 private:
     using PlatformName = QString;
     using ChannelName = QString;
+
+    // Declared before the writer, so the writer can still report writes
+    // while it's stopping
+    std::shared_ptr<LogIndexer> indexer_;
+    // Declared before the channels, so it's still running while the
+    // channels write their closing lines
+    std::unique_ptr<LogWriter> writer_;
     std::map<PlatformName,
              std::map<ChannelName, std::unique_ptr<LoggingChannel>>>
         loggingChannels_;
@@ -51,6 +76,8 @@ private:
     // Keeps the value of the `loggedChannels` settings
     std::unordered_set<ChannelName> onlyLogListedChannels;
     ThreadGuard threadGuard;
+
+    pajlada::Signals::SignalHolder signalHolder_;
 };
 
 }  // namespace chatterino
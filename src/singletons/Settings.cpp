@@ -181,6 +181,21 @@ Settings::Settings(const Args &args, const QString &settingsDirectory)
     initializeSignalVector(this->signalHolder, this->loggedChannelsSetting,
                            this->loggedChannels);
 
+    auto &listener = this->messageBuildSettingsListener_;
+    listener.addSetting(this->colorizeNicknames);
+    listener.addSetting(this->usernameDisplayMode);
+    listener.addSetting(this->findAllUsernames);
+    listener.addSetting(this->useCustomFfzModeratorBadges);
+    listener.addSetting(this->useCustomFfzVipBadges);
+    listener.addSetting(this->enableZeroWidthEmotes);
+    listener.addSetting(this->stackBits);
+    listener.addSetting(this->highlightInlineWhispers);
+    listener.addSetting(this->timestampFormat);
+    listener.setCB([this] {
+        this->updateMessageBuildSettings();
+    });
+    this->updateMessageBuildSettings();
+
     instance_ = this;
 
 #ifdef USEWINSDK
@@ -198,6 +213,28 @@ Settings::~Settings()
     Settings::instance_ = this->prevInstance_;
 }
 
+std::shared_ptr<const MessageBuildSettings> Settings::messageBuildSettings()
+    const
+{
+    return this->messageBuildSettings_.get();
+}
+
+void Settings::updateMessageBuildSettings()
+{
+    this->messageBuildSettings_.set(
+        std::make_shared<const MessageBuildSettings>(MessageBuildSettings{
+            .colorizeNicknames = this->colorizeNicknames,
+            .usernameDisplayMode = this->usernameDisplayMode.getEnum(),
+            .findAllUsernames = this->findAllUsernames,
+            .useCustomFfzModeratorBadges = this->useCustomFfzModeratorBadges,
+            .useCustomFfzVipBadges = this->useCustomFfzVipBadges,
+            .enableZeroWidthEmotes = this->enableZeroWidthEmotes,
+            .stackBits = this->stackBits,
+            .highlightInlineWhispers = this->highlightInlineWhispers,
+            .timestampFormat = this->timestampFormat,
+        }));
+}
+
 void Settings::requestSave() const
 {
     if (this->disableSaving)
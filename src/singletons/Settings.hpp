@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/Atomic.hpp"
 #include "common/ChatterinoSetting.hpp"
 #include "common/enums/MessageOverflow.hpp"
 #include "common/LastMessageLineStyle.hpp"
@@ -26,6 +27,7 @@
 #include <pajlada/settings/settinglistener.hpp>
 #include <pajlada/signals/signalholder.hpp>
 
+#include <memory>
 #include <optional>
 #include <string_view>
 
@@ -112,6 +114,23 @@ constexpr std::optional<std::string_view> qmagicenumDisplayName(
     }
 }
 
+/// Settings read while building messages
+///
+/// Unlike the settings themselves, a snapshot can be read from any thread.
+/// @see Settings::messageBuildSettings()
+struct MessageBuildSettings {
+    bool colorizeNicknames = false;
+    UsernameDisplayMode usernameDisplayMode =
+        UsernameDisplayMode::UsernameAndLocalizedName;
+    bool findAllUsernames = false;
+    bool useCustomFfzModeratorBadges = false;
+    bool useCustomFfzVipBadges = false;
+    bool enableZeroWidthEmotes = false;
+    bool stackBits = false;
+    bool highlightInlineWhispers = false;
+    QString timestampFormat;
+};
+
 /// Settings which are available for reading and writing on the gui thread.
 // These settings are still accessed concurrently in the code but it is bad practice.
 class Settings
@@ -593,6 +612,7 @@ public:
         false,
     };
     QStringSetting logPath = {"/logging/path", ""};
+    BoolSetting enableLogIndex = {"/logging/index", false};
 
     QStringSetting pathHighlightSound = {"/highlighting/highlightSoundPath",
                                          ""};
@@ -689,6 +709,8 @@ public:
         ThumbnailPreviewMode::AlwaysShow,
     };
     QStringSetting cachePath = {"/cache/path", ""};
+    /// The maximum size of the HTTP cache in MB
+    IntSetting cacheMaxSize = {"/cache/maxSizeMB", 1024};
     BoolSetting attachExtensionToAnyProcess = {
         "/misc/attachExtensionToAnyProcess", false};
     BoolSetting askOnImageUpload = {"/misc/askOnImageUpload", true};
@@ -800,8 +822,16 @@ public:
     void mute(const QString &channelName);
     void unmute(const QString &channelName);
 
+    /// Returns a snapshot of the settings read while building messages.
+    /// Safe to call from any thread.
+    std::shared_ptr<const MessageBuildSettings> messageBuildSettings() const;
+
 private:
     void updateModerationActions();
+    void updateMessageBuildSettings();
+
+    Atomic<std::shared_ptr<const MessageBuildSettings>> messageBuildSettings_;
+    pajlada::SettingListener messageBuildSettingsListener_;
 
     std::unique_ptr<rapidjson::Document> snapshot_;
 
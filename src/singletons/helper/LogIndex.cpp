@@ -0,0 +1,1069 @@
+#include "singletons/helper/LogIndex.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace chatterino {
+
+namespace {
+
+const char SEGMENT_MAGIC[4] = {'C', 'L', 'I', 'X'};
+constexpr uint32_t SEGMENT_VERSION = 1;
+constexpr qint64 HEADER_SIZE = 20;
+constexpr qint64 FILE_ENTRY_SIZE = 8;
+constexpr qint64 TERM_ENTRY_SIZE = 16;
+constexpr qint64 POSTING_SIZE = 8;
+
+const QString STATE_HEADER = QStringLiteral("chatterino log index 1");
+
+/// Log files are read in chunks of this size
+constexpr qint64 READ_CHUNK_SIZE = 1024 * 1024;
+
+uint32_t readU32(const uchar *data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+void appendU32(QByteArray &out, uint32_t value)
+{
+    auto le = qToLittleEndian<quint32>(value);
+    out.append(reinterpret_cast<const char *>(&le), sizeof(le));
+}
+
+/// Returns the date of a daily log file (like "forsen-2024-01-31.log") or an
+/// invalid date for other files
+QDate dateOfLogFile(QStringView fileName)
+{
+    // "-yyyy-MM-dd.log"
+    constexpr qsizetype suffixLength = 15;
+    if (fileName.size() <= suffixLength || !fileName.endsWith(u".log") ||
+        fileName[fileName.size() - suffixLength] != u'-')
+    {
+        return {};
+    }
+
+    return QDate::fromString(
+        fileName.mid(fileName.size() - suffixLength + 1, 10).toString(),
+        Qt::ISODate);
+}
+
+bool isWordChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == u'_';
+}
+
+bool isLoginName(QStringView name)
+{
+    return !name.isEmpty() && std::ranges::all_of(name, [](QChar c) {
+        return (c >= u'a' && c <= u'z') || (c >= u'0' && c <= u'9') ||
+               c == u'_';
+    });
+}
+
+bool isAscii(QStringView text)
+{
+    return std::ranges::all_of(text, [](QChar c) {
+        return c.unicode() < 0x80;
+    });
+}
+
+void appendWords(QStringView text, std::vector<QByteArray> &terms)
+{
+    qsizetype start = -1;
+    auto endWord = [&](qsizetype end) {
+        auto word =
+            text.mid(start, std::min(end - start, LogIndex::MAX_TERM_LENGTH));
+        // Single characters would match almost every line
+        if (word.size() >= 2)
+        {
+            terms.push_back(word.toString().toCaseFolded().toUtf8());
+        }
+        start = -1;
+    };
+
+    for (qsizetype i = 0; i < text.size(); i++)
+    {
+        if (isWordChar(text[i]))
+        {
+            if (start < 0)
+            {
+                start = i;
+            }
+        }
+        else if (start >= 0)
+        {
+            endWord(i);
+        }
+    }
+    if (start >= 0)
+    {
+        endWord(text.size());
+    }
+}
+
+void deduplicate(std::vector<QByteArray> &terms)
+{
+    std::ranges::sort(terms);
+    auto duplicates = std::ranges::unique(terms);
+    terms.erase(duplicates.begin(), duplicates.end());
+}
+
+QByteArray loginTerm(QStringView loginName)
+{
+    return '@' + loginName.toUtf8();
+}
+
+std::vector<QByteArray> queryTerms(const LogQuery &query)
+{
+    std::vector<QByteArray> terms;
+    appendWords(query.text, terms);
+
+    auto loginName = query.loginName.trimmed().toLower();
+    if (loginName.startsWith(u'@'))
+    {
+        loginName.remove(0, 1);
+    }
+    if (!loginName.isEmpty())
+    {
+        terms.push_back(loginTerm(loginName));
+    }
+
+    deduplicate(terms);
+    return terms;
+}
+
+}  // namespace
+
+/// A memory-mapped segment file
+///
+/// Layout (all numbers are little endian uint32):
+///
+///     magic ("CLIX"), version, fileCount, termCount, postingCount
+///     fileCount x (nameOffset, nameLength)
+///     termCount x (termOffset, termLength, firstPosting, postingCount)
+///     postingCount x (file, lineOffset)
+///     names and terms (UTF-8)
+///
+/// Terms are sorted, so they can be binary searched. Name and term offsets
+/// are relative to the start of the names and terms.
+struct LogIndex::Segment {
+    uint32_t id = 0;
+    /// Closed once mapped, it only owns the mapping
+    QFile file;
+    const uchar *data = nullptr;
+    qint64 size = 0;
+
+    uint32_t termCount = 0;
+    uint32_t postingCount = 0;
+    qint64 termTable = 0;
+    qint64 postings = 0;
+    qint64 strings = 0;
+
+    /// Segment-local file index -> LogIndex file ID
+    std::vector<uint32_t> files;
+
+    QByteArrayView string(const uchar *entry) const
+    {
+        return {
+            reinterpret_cast<const char *>(this->data + this->strings +
+                                           readU32(entry)),
+            static_cast<qsizetype>(readU32(entry + 4)),
+        };
+    }
+
+    const uchar *termEntry(uint32_t i) const
+    {
+        return this->data + this->termTable + (i * TERM_ENTRY_SIZE);
+    }
+
+    QByteArrayView term(uint32_t i) const
+    {
+        return this->string(this->termEntry(i));
+    }
+
+    /// Returns the first posting and the number of postings of term @a i
+    std::pair<uint32_t, uint32_t> postingsOf(uint32_t i) const
+    {
+        const auto *entry = this->termEntry(i);
+        return {readU32(entry + 8), readU32(entry + 12)};
+    }
+
+    /// Returns the first posting and the number of postings of @a term
+    std::pair<uint32_t, uint32_t> find(QByteArrayView term) const
+    {
+        std::string_view needle(term.data(), term.size());
+        uint32_t lo = 0;
+        uint32_t hi = this->termCount;
+        while (lo < hi)
+        {
+            auto mid = lo + ((hi - lo) / 2);
+            auto candidate = this->term(mid);
+            auto cmp = std::string_view(candidate.data(), candidate.size())
+                           .compare(needle);
+            if (cmp == 0)
+            {
+                return this->postingsOf(mid);
+            }
+            if (cmp < 0)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        return {0, 0};
+    }
+
+    Posting posting(uint32_t i) const
+    {
+        const auto *entry = this->data + this->postings + (i * POSTING_SIZE);
+        return {
+            .file = this->files[readU32(entry)],
+            .offset = readU32(entry + 4),
+        };
+    }
+};
+
+LogIndex::LogIndex(QString directory)
+    : directory_(std::move(directory))
+    , indexDirectory_(this->directory_ + "/.index")
+{
+    std::lock_guard lock(this->mutex_);
+    this->load();
+}
+
+LogIndex::~LogIndex()
+{
+    this->flush();
+}
+
+const QString &LogIndex::directory() const
+{
+    return this->directory_;
+}
+
+void LogIndex::append(const QString &fileName, qint64 offset,
+                      QByteArrayView data)
+{
+    if (!isIndexedFile(fileName))
+    {
+        return;
+    }
+
+    std::lock_guard lock(this->mutex_);
+    auto id = this->fileId(fileName);
+
+    // Lines written while the index wasn't running
+    while (this->files_[id].indexedBytes < offset &&
+           this->indexFile(id, offset, READ_CHUNK_SIZE))
+    {
+    }
+
+    auto indexedBytes = this->files_[id].indexedBytes;
+    if (offset < indexedBytes)
+    {
+        // (some of) the lines were already read from the file
+        auto skip = indexedBytes - offset;
+        if (skip >= data.size())
+        {
+            return;
+        }
+        data = data.sliced(skip);
+        offset = indexedBytes;
+    }
+
+    this->indexLines(id, offset, data);
+    if (this->pendingPostings_ >= MAX_PENDING_POSTINGS)
+    {
+        this->flushLocked();
+    }
+}
+
+void LogIndex::catchUp(const std::function<bool()> &shouldStop)
+{
+    auto entries = QDir(this->directory_)
+                       .entryInfoList({"*.log"}, QDir::Files, QDir::Name);
+    for (const auto &entry : entries)
+    {
+        auto fileName = entry.fileName();
+        if (!isIndexedFile(fileName))
+        {
+            continue;
+        }
+
+        while (true)
+        {
+            if (shouldStop && shouldStop())
+            {
+                return;
+            }
+
+            // Locked per chunk, so queries don't have to wait for all files
+            std::lock_guard lock(this->mutex_);
+            if (!this->indexFile(this->fileId(fileName), -1, READ_CHUNK_SIZE))
+            {
+                break;
+            }
+            if (this->pendingPostings_ >= MAX_PENDING_POSTINGS)
+            {
+                this->flushLocked();
+            }
+        }
+    }
+}
+
+void LogIndex::flush()
+{
+    std::lock_guard lock(this->mutex_);
+    this->flushLocked();
+}
+
+std::vector<LogMatch> LogIndex::query(const LogQuery &query) const
+{
+    auto terms = queryTerms(query);
+    if (terms.empty() || query.limit == 0)
+    {
+        return {};
+    }
+
+    std::vector<LogMatch> matches;
+    {
+        std::lock_guard lock(this->mutex_);
+
+        std::vector<bool> allowed(this->files_.size());
+        for (size_t i = 0; i < this->files_.size(); i++)
+        {
+            const auto &date = this->files_[i].date;
+            allowed[i] = (!query.from.isValid() || date >= query.from) &&
+                         (!query.to.isValid() || date <= query.to);
+        }
+
+        // Start with the rarest term, so the intersection stays small
+        auto postingCount = [&](const QByteArray &term) {
+            size_t count = 0;
+            for (const auto &segment : this->segments_)
+            {
+                count += segment->find(term).second;
+            }
+            auto it = this->pending_.find(term);
+            if (it != this->pending_.end())
+            {
+                count += it->second.size();
+            }
+            return count;
+        };
+        std::ranges::sort(terms, {}, postingCount);
+
+        // (file << 32) | offset
+        std::vector<uint64_t> keys;
+        bool isFirstTerm = true;
+        for (const auto &term : terms)
+        {
+            std::vector<uint64_t> termKeys;
+            auto add = [&](Posting posting) {
+                if (allowed[posting.file])
+                {
+                    termKeys.push_back(
+                        (static_cast<uint64_t>(posting.file) << 32) |
+                        posting.offset);
+                }
+            };
+
+            for (const auto &segment : this->segments_)
+            {
+                auto [first, count] = segment->find(term);
+                for (uint32_t i = first; i < first + count; i++)
+                {
+                    add(segment->posting(i));
+                }
+            }
+            auto it = this->pending_.find(term);
+            if (it != this->pending_.end())
+            {
+                for (auto posting : it->second)
+                {
+                    add(posting);
+                }
+            }
+
+            std::ranges::sort(termKeys);
+            if (isFirstTerm)
+            {
+                auto duplicates = std::ranges::unique(termKeys);
+                termKeys.erase(duplicates.begin(), duplicates.end());
+                keys = std::move(termKeys);
+                isFirstTerm = false;
+            }
+            else
+            {
+                std::vector<uint64_t> intersection;
+                std::ranges::set_intersection(
+                    keys, termKeys, std::back_inserter(intersection));
+                keys = std::move(intersection);
+            }
+
+            if (keys.empty())
+            {
+                return {};
+            }
+        }
+
+        // newest first
+        std::ranges::sort(keys, [&](uint64_t a, uint64_t b) {
+            const auto &dateA = this->files_[a >> 32].date;
+            const auto &dateB = this->files_[b >> 32].date;
+            if (dateA != dateB)
+            {
+                return dateA > dateB;
+            }
+            return a > b;
+        });
+        if (keys.size() > query.limit)
+        {
+            keys.resize(query.limit);
+        }
+
+        matches.reserve(keys.size());
+        for (auto key : keys)
+        {
+            const auto &file = this->files_[key >> 32];
+            matches.push_back({
+                .date = file.date,
+                .fileName = file.name,
+                .offset = static_cast<uint32_t>(key),
+            });
+        }
+    }
+
+    // The lines are read without holding the lock
+    std::vector<LogMatch> results;
+    results.reserve(matches.size());
+    QFile file;
+    for (auto &match : matches)
+    {
+        if (file.fileName() != this->directory_ + '/' + match.fileName)
+        {
+            file.close();
+            file.setFileName(this->directory_ + '/' + match.fileName);
+            if (!file.open(QIODevice::ReadOnly))
+            {
+                qCWarning(chatterinoHelper)
+                    << "Failed to open" << file.fileName()
+                    << file.errorString();
+            }
+        }
+        if (!file.isOpen() || !file.seek(match.offset))
+        {
+            continue;
+        }
+
+        auto line = file.readLine();
+        while (line.endsWith('\n') || line.endsWith('\r'))
+        {
+            line.chop(1);
+        }
+        match.line = QString::fromUtf8(line);
+        results.push_back(std::move(match));
+    }
+
+    return results;
+}
+
+std::vector<size_t> LogIndex::segmentsToMerge(const std::vector<qint64> &sizes)
+{
+    // Merging MERGE_FACTOR segments of up to this size stays below
+    // MAX_SEGMENT_SIZE
+    constexpr qint64 maxMergeableSize =
+        MAX_SEGMENT_SIZE / static_cast<qint64>(MERGE_FACTOR);
+
+    auto tierOf = [](qint64 size) {
+        size_t tier = 0;
+        for (auto limit = MIN_MERGE_SIZE; size >= limit;
+             limit *= static_cast<qint64>(MERGE_FACTOR))
+        {
+            tier++;
+        }
+        return tier;
+    };
+
+    std::map<size_t, std::vector<size_t>> tiers;
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        if (sizes[i] > maxMergeableSize)
+        {
+            continue;
+        }
+
+        tiers[tierOf(sizes[i])].push_back(i);
+    }
+
+    for (auto &[tier, indices] : tiers)
+    {
+        if (indices.size() >= MERGE_FACTOR)
+        {
+            indices.resize(MERGE_FACTOR);
+            return indices;
+        }
+    }
+    return {};
+}
+
+bool LogIndex::isIndexedFile(const QString &fileName)
+{
+    return dateOfLogFile(fileName).isValid();
+}
+
+std::vector<QByteArray> LogIndex::termsOf(QByteArrayView line)
+{
+    auto decoded = QString::fromUtf8(line);
+    QStringView text = QStringView(decoded).trimmed();
+
+    // "# Start logging at ..." and "# Stop logging at ..."
+    if (text.startsWith(u"# "))
+    {
+        return {};
+    }
+    // Lines in mention and automod logs start with the channel
+    if (text.startsWith(u'#'))
+    {
+        auto space = text.indexOf(u' ');
+        text = space < 0 ? QStringView() : text.mid(space + 1);
+    }
+    // timestamp
+    if (text.startsWith(u'['))
+    {
+        auto end = text.indexOf(u']');
+        if (end >= 0)
+        {
+            text = text.mid(end + 1).trimmed();
+        }
+    }
+
+    std::vector<QByteArray> terms;
+
+    // "login: text" or "localizedName login: text"
+    auto colon = text.indexOf(u": ");
+    if (colon > 0)
+    {
+        auto author = text.left(colon);
+        auto space = author.lastIndexOf(u' ');
+        auto login = author.mid(space + 1);
+        auto name = space < 0 ? QStringView() : author.left(space);
+        if (isLoginName(login) &&
+            (name.isEmpty() || (!name.contains(u' ') && !isAscii(name))))
+        {
+            terms.push_back(loginTerm(login));
+        }
+    }
+
+    appendWords(text, terms);
+    deduplicate(terms);
+    return terms;
+}
+
+void LogIndex::load()
+{
+    QFile stateFile(this->statePath());
+    if (!stateFile.open(QIODevice::ReadOnly))
+    {
+        this->reset();
+        return;
+    }
+
+    auto lines = QString::fromUtf8(stateFile.readAll()).split('\n');
+    if (lines.isEmpty() || lines.front() != STATE_HEADER)
+    {
+        qCWarning(chatterinoHelper)
+            << "Unknown log index in" << this->directory_ << "- rebuilding";
+        this->reset();
+        return;
+    }
+
+    std::vector<uint32_t> segmentIds;
+    for (const auto &line : lines)
+    {
+        auto parts = line.split('\t');
+        if (parts.size() == 2 && parts[0] == "next")
+        {
+            this->nextSegmentId_ = parts[1].toUInt();
+        }
+        else if (parts.size() == 2 && parts[0] == "segment")
+        {
+            segmentIds.push_back(parts[1].toUInt());
+        }
+        else if (parts.size() == 3 && parts[0] == "file")
+        {
+            auto id = this->fileId(parts[1]);
+            this->files_[id].indexedBytes = parts[2].toLongLong();
+        }
+    }
+
+    for (auto id : segmentIds)
+    {
+        auto segment = this->openSegment(id);
+        if (!segment)
+        {
+            qCWarning(chatterinoHelper) << "Broken log index segment in"
+                                        << this->directory_ << "- rebuilding";
+            this->reset();
+            return;
+        }
+        this->nextSegmentId_ = std::max(this->nextSegmentId_, id + 1);
+        this->segments_.emplace_back(std::move(segment));
+    }
+
+    // Segments written after the state was last saved
+    for (const auto &entry : QDir(this->indexDirectory_)
+                                 .entryInfoList({"*.seg"}, QDir::Files))
+    {
+        auto id = entry.baseName().toUInt();
+        if (std::ranges::find(segmentIds, id) == segmentIds.end())
+        {
+            QFile::remove(entry.absoluteFilePath());
+        }
+    }
+}
+
+void LogIndex::reset()
+{
+    this->segments_.clear();
+    this->files_.clear();
+    this->fileIds_.clear();
+    this->pending_.clear();
+    this->pendingPostings_ = 0;
+    this->obsoleteSegments_.clear();
+    this->nextSegmentId_ = 0;
+
+    for (const auto &entry : QDir(this->indexDirectory_)
+                                 .entryInfoList({"*.seg"}, QDir::Files))
+    {
+        QFile::remove(entry.absoluteFilePath());
+    }
+    QFile::remove(this->statePath());
+}
+
+void LogIndex::saveState()
+{
+    QByteArray state;
+    state.append(STATE_HEADER.toUtf8()).append('\n');
+    state.append("next\t" + QByteArray::number(this->nextSegmentId_) + '\n');
+    for (const auto &segment : this->segments_)
+    {
+        state.append("segment\t" + QByteArray::number(segment->id) + '\n');
+    }
+    for (const auto &file : this->files_)
+    {
+        state.append("file\t" + file.name.toUtf8() + '\t' +
+                     QByteArray::number(file.indexedBytes) + '\n');
+    }
+
+    QSaveFile stateFile(this->statePath());
+    if (!stateFile.open(QIODevice::WriteOnly) ||
+        stateFile.write(state) != state.size() || !stateFile.commit())
+    {
+        qCWarning(chatterinoHelper) << "Failed to save log index state"
+                                    << stateFile.errorString();
+        return;
+    }
+    this->stateDirty_ = false;
+
+    for (auto id : this->obsoleteSegments_)
+    {
+        QFile::remove(this->segmentPath(id));
+    }
+    this->obsoleteSegments_.clear();
+}
+
+void LogIndex::flushLocked()
+{
+    if (!this->pending_.empty())
+    {
+        QDir().mkpath(this->indexDirectory_);
+
+        auto id = this->nextSegmentId_++;
+        std::unique_ptr<Segment> segment;
+        if (this->writeSegment(id, this->pending_))
+        {
+            segment = this->openSegment(id);
+        }
+
+        if (segment)
+        {
+            this->segments_.emplace_back(std::move(segment));
+        }
+        else
+        {
+            // Keeping them would retry writing them for every line
+            qCWarning(chatterinoHelper)
+                << "Failed to write log index segment - dropping"
+                << this->pendingPostings_ << "postings";
+        }
+        this->pending_.clear();
+        this->pendingPostings_ = 0;
+        this->stateDirty_ = true;
+    }
+
+    if (this->segments_.size() >= MERGE_FACTOR)
+    {
+        this->merge();
+    }
+
+    if (this->stateDirty_)
+    {
+        this->saveState();
+    }
+}
+
+void LogIndex::merge()
+{
+    while (true)
+    {
+        std::vector<qint64> sizes;
+        sizes.reserve(this->segments_.size());
+        for (const auto &segment : this->segments_)
+        {
+            sizes.push_back(segment->size);
+        }
+
+        auto indices = segmentsToMerge(sizes);
+        if (indices.empty() || !this->mergeSegments(indices))
+        {
+            return;
+        }
+    }
+}
+
+bool LogIndex::mergeSegments(const std::vector<size_t> &indices)
+{
+    TermMap merged;
+    for (auto index : indices)
+    {
+        const auto &segment = *this->segments_[index];
+        for (uint32_t term = 0; term < segment.termCount; term++)
+        {
+            auto &postings = merged[segment.term(term).toByteArray()];
+            auto [firstPosting, postingCount] = segment.postingsOf(term);
+            for (uint32_t i = firstPosting; i < firstPosting + postingCount;
+                 i++)
+            {
+                postings.push_back(segment.posting(i));
+            }
+        }
+    }
+
+    auto id = this->nextSegmentId_++;
+    if (!this->writeSegment(id, merged))
+    {
+        return false;
+    }
+    auto segment = this->openSegment(id);
+    if (!segment)
+    {
+        return false;
+    }
+
+    // Indices are ascending, erase from the back so they stay valid
+    for (auto it = indices.rbegin(); it != indices.rend(); it++)
+    {
+        auto erased = this->segments_.begin() + static_cast<ptrdiff_t>(*it);
+        this->obsoleteSegments_.push_back((*erased)->id);
+        this->segments_.erase(erased);
+    }
+    this->segments_.emplace_back(std::move(segment));
+    this->stateDirty_ = true;
+    return true;
+}
+
+uint32_t LogIndex::fileId(const QString &fileName)
+{
+    auto it = this->fileIds_.find(fileName);
+    if (it != this->fileIds_.end())
+    {
+        return it->second;
+    }
+
+    auto id = static_cast<uint32_t>(this->files_.size());
+    this->files_.push_back({
+        .name = fileName,
+        .date = dateOfLogFile(fileName),
+    });
+    this->fileIds_.emplace(fileName, id);
+    return id;
+}
+
+bool LogIndex::indexFile(uint32_t file, qint64 end, qint64 maxBytes)
+{
+    auto &logFile = this->files_[file];
+    QFile input(this->directory_ + '/' + logFile.name);
+    if (!input.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    auto size = input.size();
+    if (size < logFile.indexedBytes)
+    {
+        qCWarning(chatterinoHelper)
+            << input.fileName() << "is smaller than its indexed part";
+        return false;
+    }
+
+    auto limit = end < 0 ? size : std::min(end, size);
+    if (limit <= logFile.indexedBytes || !input.seek(logFile.indexedBytes))
+    {
+        return false;
+    }
+
+    auto data = input.read(std::min(limit - logFile.indexedBytes, maxBytes));
+    if (data.isEmpty())
+    {
+        return false;
+    }
+
+    auto lastNewline = data.lastIndexOf('\n');
+    if (lastNewline < 0)
+    {
+        if (data.size() < maxBytes)
+        {
+            // The last line isn't complete yet
+            return false;
+        }
+        // A line longer than a whole chunk isn't indexed
+        logFile.indexedBytes += data.size();
+        this->stateDirty_ = true;
+        return true;
+    }
+
+    data.truncate(lastNewline + 1);
+    this->indexLines(file, logFile.indexedBytes, data);
+    return true;
+}
+
+void LogIndex::indexLines(uint32_t file, qint64 offset, QByteArrayView data)
+{
+    qsizetype start = 0;
+    while (start < data.size())
+    {
+        auto end = data.indexOf('\n', start);
+        if (end < 0)
+        {
+            end = data.size();
+        }
+
+        auto lineOffset = offset + start;
+        if (lineOffset > std::numeric_limits<uint32_t>::max())
+        {
+            break;
+        }
+
+        for (auto &term : termsOf(data.sliced(start, end - start)))
+        {
+            this->pending_[std::move(term)].push_back({
+                .file = file,
+                .offset = static_cast<uint32_t>(lineOffset),
+            });
+            this->pendingPostings_++;
+        }
+
+        start = end + 1;
+    }
+
+    auto &logFile = this->files_[file];
+    logFile.indexedBytes = std::max(logFile.indexedBytes, offset + data.size());
+    this->stateDirty_ = true;
+}
+
+std::unique_ptr<LogIndex::Segment> LogIndex::openSegment(uint32_t id)
+{
+    auto segment = std::make_unique<Segment>();
+    segment->id = id;
+    segment->file.setFileName(this->segmentPath(id));
+    if (!segment->file.open(QIODevice::ReadOnly))
+    {
+        return nullptr;
+    }
+
+    segment->size = segment->file.size();
+    if (segment->size < HEADER_SIZE)
+    {
+        return nullptr;
+    }
+    segment->data = segment->file.map(0, segment->size);
+    if (!segment->data)
+    {
+        return nullptr;
+    }
+    // The mapping stays valid until the QFile is destroyed, there's no need
+    // to keep a file descriptor per segment
+    segment->file.close();
+
+    const auto *data = segment->data;
+    if (std::memcmp(data, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0 ||
+        readU32(data + 4) != SEGMENT_VERSION)
+    {
+        return nullptr;
+    }
+
+    auto fileCount = readU32(data + 8);
+    segment->termCount = readU32(data + 12);
+    segment->postingCount = readU32(data + 16);
+    segment->termTable = HEADER_SIZE + (fileCount * FILE_ENTRY_SIZE);
+    segment->postings =
+        segment->termTable + (segment->termCount * TERM_ENTRY_SIZE);
+    segment->strings =
+        segment->postings + (segment->postingCount * POSTING_SIZE);
+    if (segment->strings > segment->size)
+    {
+        return nullptr;
+    }
+
+    auto stringsSize = segment->size - segment->strings;
+    auto isValidString = [&](const uchar *entry) {
+        return static_cast<qint64>(readU32(entry)) + readU32(entry + 4) <=
+               stringsSize;
+    };
+
+    for (uint32_t i = 0; i < fileCount; i++)
+    {
+        const auto *entry = data + HEADER_SIZE + (i * FILE_ENTRY_SIZE);
+        if (!isValidString(entry))
+        {
+            return nullptr;
+        }
+        auto name = segment->string(entry);
+        segment->files.push_back(
+            this->fileId(QString::fromUtf8(name.data(), name.size())));
+    }
+
+    for (uint32_t i = 0; i < segment->termCount; i++)
+    {
+        auto [first, count] = segment->postingsOf(i);
+        if (!isValidString(segment->termEntry(i)) ||
+            static_cast<uint64_t>(first) + count > segment->postingCount)
+        {
+            return nullptr;
+        }
+    }
+
+    for (uint32_t i = 0; i < segment->postingCount; i++)
+    {
+        if (readU32(data + segment->postings + (i * POSTING_SIZE)) >=
+            fileCount)
+        {
+            return nullptr;
+        }
+    }
+
+    return segment;
+}
+
+bool LogIndex::writeSegment(uint32_t id, const TermMap &terms) const
+{
+    // LogIndex file ID -> segment-local index
+    std::vector<uint32_t> files;
+    size_t postingCount = 0;
+    for (const auto &[term, postings] : terms)
+    {
+        for (auto posting : postings)
+        {
+            files.push_back(posting.file);
+        }
+        postingCount += postings.size();
+    }
+    std::ranges::sort(files);
+    auto duplicates = std::ranges::unique(files);
+    files.erase(duplicates.begin(), duplicates.end());
+
+    auto localFile = [&](uint32_t file) {
+        return static_cast<uint32_t>(std::ranges::lower_bound(files, file) -
+                                     files.begin());
+    };
+
+    QByteArray fileTable;
+    QByteArray termTable;
+    QByteArray postingTable;
+    QByteArray strings;
+
+    for (auto file : files)
+    {
+        auto name = this->files_[file].name.toUtf8();
+        appendU32(fileTable, static_cast<uint32_t>(strings.size()));
+        appendU32(fileTable, static_cast<uint32_t>(name.size()));
+        strings.append(name);
+    }
+
+    uint32_t firstPosting = 0;
+    for (const auto &[term, postings] : terms)
+    {
+        appendU32(termTable, static_cast<uint32_t>(strings.size()));
+        appendU32(termTable, static_cast<uint32_t>(term.size()));
+        appendU32(termTable, firstPosting);
+        appendU32(termTable, static_cast<uint32_t>(postings.size()));
+        strings.append(term);
+
+        for (auto posting : postings)
+        {
+            appendU32(postingTable, localFile(posting.file));
+            appendU32(postingTable, posting.offset);
+        }
+        firstPosting += static_cast<uint32_t>(postings.size());
+    }
+
+    auto totalSize = HEADER_SIZE + fileTable.size() + termTable.size() +
+                     postingTable.size() + strings.size();
+    if (totalSize > std::numeric_limits<uint32_t>::max())
+    {
+        qCWarning(chatterinoHelper) << "Log index segment is too big";
+        return false;
+    }
+
+    QByteArray header(SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    appendU32(header, SEGMENT_VERSION);
+    appendU32(header, static_cast<uint32_t>(files.size()));
+    appendU32(header, static_cast<uint32_t>(terms.size()));
+    appendU32(header, static_cast<uint32_t>(postingCount));
+
+    QSaveFile output(this->segmentPath(id));
+    if (!output.open(QIODevice::WriteOnly))
+    {
+        qCWarning(chatterinoHelper) << "Failed to open log index segment"
+                                    << output.errorString();
+        return false;
+    }
+    for (const auto *part :
+         {&header, &fileTable, &termTable, &postingTable, &strings})
+    {
+        output.write(*part);
+    }
+    if (!output.commit())
+    {
+        qCWarning(chatterinoHelper) << "Failed to write log index segment"
+                                    << output.errorString();
+        return false;
+    }
+    return true;
+}
+
+QString LogIndex::segmentPath(uint32_t id) const
+{
+    return this->indexDirectory_ + '/' + QString::number(id) + ".seg";
+}
+
+QString LogIndex::statePath() const
+{
+    return this->indexDirectory_ + "/state";
+}
+
+}  // namespace chatterino
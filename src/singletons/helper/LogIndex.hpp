@@ -0,0 +1,175 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDate>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct LogQuery {
+    /// Words that all have to be in a line (case-insensitive)
+    QString text;
+    /// If set, only lines sent by this user are returned
+    QString loginName;
+    /// If valid, only lines logged on or after this date are returned
+    QDate from;
+    /// If valid, only lines logged on or before this date are returned
+    QDate to;
+    /// Maximum number of lines to return
+    size_t limit = 1000;
+};
+
+struct LogMatch {
+    /// Date of the log file the line is from
+    QDate date;
+    QString fileName;
+    /// Byte offset of the line in the log file
+    uint32_t offset = 0;
+    /// The line without its line break
+    QString line;
+};
+
+/// A persistent inverted index over the daily log files in one directory.
+///
+/// Lines are indexed by their (case-folded) words and the login name of
+/// their sender. The date of a line is the date of its log file. Stream log
+/// files only duplicate lines from the daily files, so they aren't indexed.
+///
+/// The index is stored in the `.index` directory next to the log files. It
+/// consists of immutable segments, which are memory-mapped, and a state file
+/// listing the segments and how much of each log file is indexed. New lines
+/// are kept in memory until flush() writes them to a new segment. Segments of
+/// a similar size are merged once there are MERGE_FACTOR of them (see
+/// segmentsToMerge()), so every line is only rewritten a logarithmic number
+/// of times.
+///
+/// All functions are thread-safe.
+class LogIndex
+{
+public:
+    /// Number of segments of a similar size that are merged into one
+    static constexpr size_t MERGE_FACTOR = 4;
+    /// Segments smaller than this are all considered to be of a similar size
+    static constexpr qint64 MIN_MERGE_SIZE = 1024 * 1024;
+    /// Merged segments don't get bigger than this. It's well below the 4 GiB
+    /// limit of the segment format.
+    static constexpr qint64 MAX_SEGMENT_SIZE = 256 * 1024 * 1024;
+    /// Pending postings that trigger a flush
+    static constexpr size_t MAX_PENDING_POSTINGS = 256 * 1024;
+    /// Longer words are truncated
+    static constexpr qsizetype MAX_TERM_LENGTH = 64;
+
+    /// Opens the index of @a directory. If there's no index (or it's
+    /// broken), an empty one is created.
+    explicit LogIndex(QString directory);
+    ~LogIndex();
+
+    LogIndex(const LogIndex &) = delete;
+    LogIndex &operator=(const LogIndex &) = delete;
+    LogIndex(LogIndex &&) = delete;
+    LogIndex &operator=(LogIndex &&) = delete;
+
+    const QString &directory() const;
+
+    /// Indexes @a data, which was appended to @a fileName at @a offset.
+    ///
+    /// Anything that was appended to the file before and isn't indexed yet
+    /// is read from the file first.
+    void append(const QString &fileName, qint64 offset, QByteArrayView data);
+
+    /// Indexes everything that was appended to the log files in the
+    /// directory since they were last indexed.
+    ///
+    /// @param shouldStop Checked regularly to stop early. Can be empty.
+    void catchUp(const std::function<bool()> &shouldStop = {});
+
+    /// Writes pending lines to a new segment
+    void flush();
+
+    /// Finds all lines matching @a query, from newest to oldest
+    std::vector<LogMatch> query(const LogQuery &query) const;
+
+    /// Returns true if @a fileName is a daily log file
+    static bool isIndexedFile(const QString &fileName);
+
+    /// Returns the terms @a line is indexed with
+    static std::vector<QByteArray> termsOf(QByteArrayView line);
+
+    /// Returns the indices of the segments to merge next, given the sizes of
+    /// all segments from oldest to newest. Returns an empty list if nothing
+    /// should be merged.
+    ///
+    /// Segments are grouped into tiers by size, each tier MERGE_FACTOR times
+    /// bigger than the previous one. The oldest MERGE_FACTOR segments of the
+    /// smallest full tier are merged. Segments bigger than MAX_SEGMENT_SIZE /
+    /// MERGE_FACTOR aren't merged anymore.
+    static std::vector<size_t> segmentsToMerge(
+        const std::vector<qint64> &sizes);
+
+private:
+    struct Segment;
+
+    struct Posting {
+        uint32_t file;
+        uint32_t offset;
+    };
+
+    struct LogFile {
+        QString name;
+        QDate date;
+        qint64 indexedBytes = 0;
+    };
+
+    using TermMap = std::map<QByteArray, std::vector<Posting>>;
+
+    void load();
+    void reset();
+    void saveState();
+    void flushLocked();
+    /// Merges segments until segmentsToMerge() doesn't return any
+    void merge();
+    /// Merges the segments at @a indices into one
+    ///
+    /// @returns false if the merged segment couldn't be written
+    bool mergeSegments(const std::vector<size_t> &indices);
+
+    uint32_t fileId(const QString &fileName);
+    /// Reads and indexes the complete lines in [indexedBytes, @a end) of a
+    /// file. A negative @a end reads to the end of the file.
+    ///
+    /// @returns false if nothing could be read
+    bool indexFile(uint32_t file, qint64 end, qint64 maxBytes);
+    void indexLines(uint32_t file, qint64 offset, QByteArrayView data);
+
+    std::unique_ptr<Segment> openSegment(uint32_t id);
+    bool writeSegment(uint32_t id, const TermMap &terms) const;
+    QString segmentPath(uint32_t id) const;
+    QString statePath() const;
+
+    const QString directory_;
+    const QString indexDirectory_;
+
+    mutable std::mutex mutex_;
+    std::vector<LogFile> files_;
+    std::unordered_map<QString, uint32_t> fileIds_;
+    std::vector<std::unique_ptr<Segment>> segments_;
+    uint32_t nextSegmentId_ = 0;
+    /// Segments that were merged, deleted once the state is saved
+    std::vector<uint32_t> obsoleteSegments_;
+
+    TermMap pending_;
+    size_t pendingPostings_ = 0;
+    /// Set if the state changed since it was saved
+    bool stateDirty_ = false;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,138 @@
+#include "singletons/helper/LogIndexer.hpp"
+
+#include "common/QLogging.hpp"
+#include "util/RenameThread.hpp"
+
+#include <QDir>
+#include <QFileInfo>
+
+namespace chatterino {
+
+LogIndexer::LogIndexer()
+{
+    this->thread_ = std::make_unique<std::thread>([this] {
+        this->run();
+    });
+    renameThread(*this->thread_, "LogIndexer");
+}
+
+LogIndexer::~LogIndexer()
+{
+    {
+        std::lock_guard lock(this->mutex_);
+        this->stopping_ = true;
+    }
+    this->wake_.notify_one();
+    this->thread_->join();
+}
+
+void LogIndexer::appended(const QString &path, qint64 offset, QByteArray data)
+{
+    QFileInfo info(path);
+    if (!LogIndex::isIndexedFile(info.fileName()))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(this->mutex_);
+        this->queue_.push_back({
+            .index = this->indexFor(info.absolutePath()),
+            .fileName = info.fileName(),
+            .offset = offset,
+            .data = std::move(data),
+        });
+    }
+    this->wake_.notify_one();
+}
+
+std::vector<LogMatch> LogIndexer::query(const QString &directory,
+                                        const LogQuery &query)
+{
+    std::shared_ptr<LogIndex> index;
+    {
+        std::lock_guard lock(this->mutex_);
+        index = this->indexFor(directory);
+    }
+    this->wake_.notify_one();
+
+    return index->query(query);
+}
+
+std::shared_ptr<LogIndex> LogIndexer::indexFor(const QString &directory)
+{
+    auto key = QDir::cleanPath(directory);
+    auto it = this->indices_.find(key);
+    if (it != this->indices_.end())
+    {
+        return it->second;
+    }
+
+    auto index = std::make_shared<LogIndex>(key);
+    this->indices_.emplace(key, index);
+    // Lines written while indexing was disabled
+    this->queue_.push_back({
+        .index = index,
+        .catchUp = true,
+    });
+    return index;
+}
+
+void LogIndexer::run()
+{
+    auto nextFlush = std::chrono::steady_clock::now() + FLUSH_INTERVAL;
+    std::vector<Job> jobs;
+    while (true)
+    {
+        bool stopping = false;
+        {
+            std::unique_lock lock(this->mutex_);
+            this->wake_.wait_until(lock, nextFlush, [this] {
+                return this->stopping_ || !this->queue_.empty();
+            });
+            jobs.swap(this->queue_);
+            stopping = this->stopping_ && jobs.empty();
+        }
+
+        for (auto &job : jobs)
+        {
+            if (!job.catchUp)
+            {
+                job.index->append(job.fileName, job.offset, job.data);
+            }
+            else if (!this->stopping_)
+            {
+                qCDebug(chatterinoHelper)
+                    << "Indexing logs in" << job.index->directory();
+                job.index->catchUp([this] {
+                    return this->stopping_.load();
+                });
+            }
+        }
+        jobs.clear();
+
+        if (stopping || std::chrono::steady_clock::now() >= nextFlush)
+        {
+            std::vector<std::shared_ptr<LogIndex>> indices;
+            {
+                std::lock_guard lock(this->mutex_);
+                for (const auto &[directory, index] : this->indices_)
+                {
+                    indices.push_back(index);
+                }
+            }
+            for (const auto &index : indices)
+            {
+                index->flush();
+            }
+            nextFlush = std::chrono::steady_clock::now() + FLUSH_INTERVAL;
+        }
+
+        if (stopping)
+        {
+            break;
+        }
+    }
+}
+
+}  // namespace chatterino
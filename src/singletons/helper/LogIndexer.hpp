@@ -0,0 +1,76 @@
+#pragma once
+
+#include "singletons/helper/LogIndex.hpp"
+
+#include <QByteArray>
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+/// Keeps the LogIndex of every log directory up to date on a dedicated
+/// thread.
+///
+/// The LogWriter reports every write to the indexer. The first time a
+/// directory is seen, everything that's not indexed yet is read from its log
+/// files. Indices are written to disk every FLUSH_INTERVAL and when the
+/// indexer is destroyed.
+class LogIndexer
+{
+public:
+    static constexpr std::chrono::seconds FLUSH_INTERVAL{30};
+
+    LogIndexer();
+    /// Indexes everything that's queued (except catch-ups) and stops the
+    /// thread
+    ~LogIndexer();
+
+    LogIndexer(const LogIndexer &) = delete;
+    LogIndexer &operator=(const LogIndexer &) = delete;
+    LogIndexer(LogIndexer &&) = delete;
+    LogIndexer &operator=(LogIndexer &&) = delete;
+
+    /// Queues @a data, which was written to the file at @a path at
+    /// @a offset, for indexing
+    void appended(const QString &path, qint64 offset, QByteArray data);
+
+    /// Searches the logs in @a directory.
+    ///
+    /// Blocks while the matching lines are read. Lines that weren't indexed
+    /// yet aren't found.
+    std::vector<LogMatch> query(const QString &directory,
+                                const LogQuery &query);
+
+private:
+    struct Job {
+        std::shared_ptr<LogIndex> index;
+        QString fileName;
+        qint64 offset = 0;
+        QByteArray data;
+        /// If set, the index catches up with its files instead
+        bool catchUp = false;
+    };
+
+    /// Returns the index of @a directory, opening it if necessary. Must be
+    /// called with the mutex locked.
+    std::shared_ptr<LogIndex> indexFor(const QString &directory);
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<Job> queue_;
+    std::unordered_map<QString, std::shared_ptr<LogIndex>> indices_;
+    std::atomic<bool> stopping_ = false;
+
+    std::unique_ptr<std::thread> thread_;
+};
+
+}  // namespace chatterino
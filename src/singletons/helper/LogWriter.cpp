@@ -0,0 +1,249 @@
+#include "singletons/helper/LogWriter.hpp"
+
+#include "common/QLogging.hpp"
+#include "singletons/helper/LogIndexer.hpp"
+#include "util/DebugCount.hpp"
+#include "util/RenameThread.hpp"
+
+#include <QDir>
+#include <QFileInfo>
+
+namespace {
+
+using chatterino::DebugCount;
+
+const auto BACKLOG_COUNTER = DebugCount::counter("log writer backlog");
+const auto BYTES_COUNTER =
+    DebugCount::counter("log bytes written", DebugCount::Flag::DataSize);
+
+}  // namespace
+
+namespace chatterino {
+
+LogWriter::LogWriter()
+{
+    this->thread_ = std::make_unique<std::thread>([this] {
+        this->run();
+    });
+    renameThread(*this->thread_, "LogWriter");
+}
+
+LogWriter::~LogWriter()
+{
+    {
+        std::lock_guard lock(this->mutex_);
+        this->stopping_ = true;
+    }
+    this->wakeWriter_.notify_one();
+    this->thread_->join();
+}
+
+void LogWriter::write(const QString &path, QByteArray data)
+{
+    this->enqueue({
+        .path = path,
+        .data = std::move(data),
+    });
+}
+
+void LogWriter::close(const QString &path)
+{
+    this->enqueue({
+        .path = path,
+        .close = true,
+    });
+}
+
+void LogWriter::flush()
+{
+    std::unique_lock lock(this->mutex_);
+    auto target = this->queuedSeq_;
+    this->flushRequested_ = true;
+    this->wakeWriter_.notify_one();
+    this->batchWritten_.wait(lock, [&] {
+        return this->writtenSeq_ >= target;
+    });
+}
+
+void LogWriter::setIndexer(std::shared_ptr<LogIndexer> indexer)
+{
+    std::lock_guard lock(this->mutex_);
+    this->indexer_ = std::move(indexer);
+}
+
+size_t LogWriter::backlog() const
+{
+    return this->backlog_.load(std::memory_order_relaxed);
+}
+
+uint64_t LogWriter::bytesWritten() const
+{
+    return this->bytesWritten_.load(std::memory_order_relaxed);
+}
+
+void LogWriter::enqueue(Command command)
+{
+    bool wake = false;
+    {
+        std::lock_guard lock(this->mutex_);
+        this->queuedBytes_ += command.data.size();
+        this->queuedSeq_++;
+        this->queue_.emplace_back(std::move(command));
+        // Counted while holding the lock, so the writer can't take the
+        // command out of the backlog before it was added
+        this->backlog_.fetch_add(1, std::memory_order_relaxed);
+        BACKLOG_COUNTER.increase();
+        // Waking the writer for every line would defeat the batching
+        wake = this->queuedBytes_ >= FLUSH_SIZE;
+    }
+
+    if (wake)
+    {
+        this->wakeWriter_.notify_one();
+    }
+}
+
+void LogWriter::run()
+{
+    std::vector<Command> batch;
+    while (true)
+    {
+        std::shared_ptr<LogIndexer> indexer;
+        uint64_t batchSeq = 0;
+        bool stopping = false;
+        {
+            std::unique_lock lock(this->mutex_);
+            this->wakeWriter_.wait_for(lock, FLUSH_INTERVAL, [this] {
+                return this->stopping_ || this->flushRequested_ ||
+                       this->queuedBytes_ >= FLUSH_SIZE;
+            });
+            batch.swap(this->queue_);
+            this->queuedBytes_ = 0;
+            this->flushRequested_ = false;
+            batchSeq = this->queuedSeq_;
+            indexer = this->indexer_;
+            stopping = this->stopping_ && batch.empty();
+        }
+
+        this->execute(batch, indexer.get());
+        this->backlog_.fetch_sub(batch.size(), std::memory_order_relaxed);
+        BACKLOG_COUNTER.decrease(static_cast<int64_t>(batch.size()));
+        batch.clear();
+
+        {
+            std::lock_guard lock(this->mutex_);
+            this->writtenSeq_ = batchSeq;
+        }
+        this->batchWritten_.notify_all();
+
+        if (stopping)
+        {
+            break;
+        }
+    }
+
+    for (auto &[path, openFile] : this->files_)
+    {
+        openFile->file.close();
+    }
+    this->files_.clear();
+}
+
+void LogWriter::execute(std::vector<Command> &batch, LogIndexer *indexer)
+{
+    std::vector<Written> written;
+    for (auto &command : batch)
+    {
+        if (command.close)
+        {
+            auto it = this->files_.find(command.path);
+            if (it != this->files_.end())
+            {
+                it->second->file.close();
+                this->files_.erase(it);
+            }
+            continue;
+        }
+
+        auto &openFile = this->openFile(command.path);
+        if (!openFile.file.isOpen())
+        {
+            continue;
+        }
+
+        auto offset = openFile.file.pos();
+        auto size = openFile.file.write(command.data);
+        if (size > 0)
+        {
+            openFile.dirty = true;
+            this->bytesWritten_.fetch_add(static_cast<uint64_t>(size),
+                                          std::memory_order_relaxed);
+            BYTES_COUNTER.increase(size);
+        }
+        if (indexer && size == command.data.size())
+        {
+            // Consecutive lines are reported as one write
+            if (!written.empty() && written.back().path == command.path &&
+                written.back().offset + written.back().data.size() == offset)
+            {
+                written.back().data.append(command.data);
+            }
+            else
+            {
+                written.push_back({
+                    .path = command.path,
+                    .offset = offset,
+                    .data = std::move(command.data),
+                });
+            }
+        }
+    }
+
+    for (auto &[path, openFile] : this->files_)
+    {
+        if (openFile->dirty)
+        {
+            openFile->file.flush();
+            openFile->dirty = false;
+        }
+    }
+
+    // The lines have to be on disk before they're indexed, because
+    // queries read them from the files
+    for (auto &write : written)
+    {
+        indexer->appended(write.path, write.offset, std::move(write.data));
+    }
+}
+
+LogWriter::OpenFile &LogWriter::openFile(const QString &path)
+{
+    auto it = this->files_.find(path);
+    if (it != this->files_.end())
+    {
+        return *it->second;
+    }
+
+    // Files that failed to open stay in the map (closed), so we don't retry
+    // for every line.
+    auto &openFile = *this->files_.emplace(path, std::make_unique<OpenFile>())
+                          .first->second;
+
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+    {
+        qCDebug(chatterinoHelper) << "Unable to create logging path";
+        return openFile;
+    }
+
+    qCDebug(chatterinoHelper) << "Logging to" << path;
+    openFile.file.setFileName(path);
+    if (!openFile.file.open(QIODevice::Append))
+    {
+        qCDebug(chatterinoHelper)
+            << "Failed to open file" << openFile.file.errorString();
+    }
+
+    return openFile;
+}
+
+}  // namespace chatterino
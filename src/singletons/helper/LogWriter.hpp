@@ -0,0 +1,112 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+class LogIndexer;
+
+/// Writes chat logs on a dedicated thread.
+///
+/// Lines are queued from the GUI thread and written in batches. A batch is
+/// written when FLUSH_INTERVAL has passed or when FLUSH_SIZE bytes are
+/// queued. Every file that was written to in a batch is flushed once.
+///
+/// Files are opened (and their directory is created) on the first write and
+/// stay open until they're closed. Commands for the same file are executed
+/// in the order they were queued.
+///
+/// If an indexer is set, it's told about every write once the file is
+/// flushed.
+class LogWriter
+{
+public:
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{1000};
+    static constexpr qsizetype FLUSH_SIZE = 64 * 1024;
+
+    LogWriter();
+    /// Writes everything that's queued and stops the thread
+    ~LogWriter();
+
+    LogWriter(const LogWriter &) = delete;
+    LogWriter &operator=(const LogWriter &) = delete;
+    LogWriter(LogWriter &&) = delete;
+    LogWriter &operator=(LogWriter &&) = delete;
+
+    /// Appends @a data to the file at @a path
+    void write(const QString &path, QByteArray data);
+    /// Closes the file at @a path once the writes queued before are done
+    void close(const QString &path);
+
+    /// Blocks until everything queued before this call is written
+    void flush();
+
+    /// Sets the indexer that's told about writes in batches written after
+    /// this call. Pass nullptr to stop indexing.
+    void setIndexer(std::shared_ptr<LogIndexer> indexer);
+
+    /// Returns the number of queued commands that weren't executed yet
+    size_t backlog() const;
+    /// Returns the number of bytes written to log files
+    uint64_t bytesWritten() const;
+
+private:
+    struct Command {
+        QString path;
+        QByteArray data;
+        bool close = false;
+    };
+
+    /// A write that's reported to the indexer
+    struct Written {
+        QString path;
+        qint64 offset = 0;
+        QByteArray data;
+    };
+
+    struct OpenFile {
+        QFile file;
+        /// True if the file was written to since it was last flushed
+        bool dirty = false;
+    };
+
+    void enqueue(Command command);
+    void run();
+    void execute(std::vector<Command> &batch, LogIndexer *indexer);
+    OpenFile &openFile(const QString &path);
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeWriter_;
+    std::condition_variable batchWritten_;
+    std::vector<Command> queue_;
+    qsizetype queuedBytes_ = 0;
+    /// Number of commands queued so far
+    uint64_t queuedSeq_ = 0;
+    /// Number of commands executed so far
+    uint64_t writtenSeq_ = 0;
+    bool flushRequested_ = false;
+    bool stopping_ = false;
+    std::shared_ptr<LogIndexer> indexer_;
+
+    std::atomic<size_t> backlog_ = 0;
+    std::atomic<uint64_t> bytesWritten_ = 0;
+
+    // Only accessed from the writer thread
+    std::unordered_map<QString, std::unique_ptr<OpenFile>> files_;
+
+    std::unique_ptr<std::thread> thread_;
+};
+
+}  // namespace chatterino
@@ -1,9 +1,9 @@
 #include "singletons/helper/LoggingChannel.hpp"
 
 #include "Application.hpp"
-#include "common/QLogging.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageThread.hpp"
+#include "singletons/helper/LogWriter.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 
@@ -14,15 +14,6 @@ namespace {
 
 const QByteArray ENDLINE("\n");
 
-void appendLine(QFile &fileHandle, const QString &line)
-{
-    assert(fileHandle.isOpen());
-    assert(fileHandle.isWritable());
-
-    fileHandle.write(line.toUtf8());
-    fileHandle.flush();
-}
-
 QString generateOpeningString(
     const QDateTime &now = QDateTime::currentDateTime())
 {
@@ -56,49 +47,63 @@ QString generateDateString(const QDateTime &now)
 
 namespace chatterino {
 
-LoggingChannel::LoggingChannel(QString _channelName, QString _platform)
+LoggingChannel::LoggingChannel(QString _channelName, QString _platform,
+                               LogWriter &writer)
     : channelName(std::move(_channelName))
     , platform(std::move(_platform))
+    , subDirectory(subDirectoryFor(this->channelName, this->platform))
+    , writer(writer)
 {
-    if (this->channelName.startsWith("/whispers"))
+    getSettings()->logPath.connect([this](const QString &logPath, auto) {
+        this->baseDirectory = logPath.isEmpty()
+                                  ? getApp()->getPaths().messageLogDirectory
+                                  : logPath;
+        this->openLogFile();
+    });
+}
+
+LoggingChannel::~LoggingChannel()
+{
+    if (!this->filePath.isEmpty())
+    {
+        this->writer.write(this->filePath, generateClosingString().toUtf8());
+        this->writer.close(this->filePath);
+    }
+    if (!this->currentStreamFilePath.isEmpty())
     {
-        this->subDirectory = "Whispers";
+        this->writer.close(this->currentStreamFilePath);
+    }
+}
+
+QString LoggingChannel::subDirectoryFor(const QString &channelName,
+                                        const QString &platform)
+{
+    QString subDirectory;
+    if (channelName.startsWith("/whispers"))
+    {
+        subDirectory = "Whispers";
     }
     else if (channelName.startsWith("/mentions"))
     {
-        this->subDirectory = "Mentions";
+        subDirectory = "Mentions";
     }
     else if (channelName.startsWith("/live"))
     {
-        this->subDirectory = "Live";
+        subDirectory = "Live";
     }
     else if (channelName.startsWith("/automod"))
     {
-        this->subDirectory = "AutoMod";
+        subDirectory = "AutoMod";
     }
     else
     {
-        this->subDirectory =
+        subDirectory =
             QStringLiteral("Channels") + QDir::separator() + channelName;
     }
 
     // enforce capitalized platform names
-    this->subDirectory = platform[0].toUpper() + platform.mid(1).toLower() +
-                         QDir::separator() + this->subDirectory;
-
-    getSettings()->logPath.connect([this](const QString &logPath, auto) {
-        this->baseDirectory = logPath.isEmpty()
-                                  ? getApp()->getPaths().messageLogDirectory
-                                  : logPath;
-        this->openLogFile();
-    });
-}
-
-LoggingChannel::~LoggingChannel()
-{
-    appendLine(this->fileHandle, generateClosingString());
-    this->fileHandle.close();
-    this->currentStreamFileHandle.close();
+    return platform[0].toUpper() + platform.mid(1).toLower() +
+           QDir::separator() + subDirectory;
 }
 
 void LoggingChannel::openLogFile()
@@ -106,10 +111,9 @@ void LoggingChannel::openLogFile()
     QDateTime now = QDateTime::currentDateTime();
     this->dateString = generateDateString(now);
 
-    if (this->fileHandle.isOpen())
+    if (!this->filePath.isEmpty())
     {
-        this->fileHandle.flush();
-        this->fileHandle.close();
+        this->writer.close(this->filePath);
     }
 
     QString baseFileName = this->channelName + "-" + this->dateString + ".log";
@@ -117,25 +121,9 @@ void LoggingChannel::openLogFile()
     QString directory =
         this->baseDirectory + QDir::separator() + this->subDirectory;
 
-    if (!QDir().mkpath(directory))
-    {
-        qCDebug(chatterinoHelper) << "Unable to create logging path";
-        return;
-    }
-
-    // Open file handle to log file of current date
-    QString fileName = directory + QDir::separator() + baseFileName;
-    qCDebug(chatterinoHelper) << "Logging to" << fileName;
-    this->fileHandle.setFileName(fileName);
-
-    if (!this->fileHandle.open(QIODevice::Append))
-    {
-        qCDebug(chatterinoHelper)
-            << "Failed to open file" << this->fileHandle.errorString();
-        return;
-    }
-
-    appendLine(this->fileHandle, generateOpeningString(now));
+    // The writer creates the directory and opens the file of the current date
+    this->filePath = directory + QDir::separator() + baseFileName;
+    this->writer.write(this->filePath, generateOpeningString(now).toUtf8());
 }
 
 void LoggingChannel::openStreamLogFile(const QString &streamID)
@@ -143,10 +131,9 @@ void LoggingChannel::openStreamLogFile(const QString &streamID)
     QDateTime now = QDateTime::currentDateTime();
     this->currentStreamID = streamID;
 
-    if (this->currentStreamFileHandle.isOpen())
+    if (!this->currentStreamFilePath.isEmpty())
     {
-        this->currentStreamFileHandle.flush();
-        this->currentStreamFileHandle.close();
+        this->writer.close(this->currentStreamFilePath);
     }
 
     QString baseFileName = this->channelName + "-" + streamID + ".log";
@@ -154,24 +141,9 @@ void LoggingChannel::openStreamLogFile(const QString &streamID)
     QString directory =
         this->baseDirectory + QDir::separator() + this->subDirectory;
 
-    if (!QDir().mkpath(directory))
-    {
-        qCDebug(chatterinoHelper) << "Unable to create logging path";
-        return;
-    }
-
-    QString fileName = directory + QDir::separator() + baseFileName;
-    qCDebug(chatterinoHelper) << "Logging stream to" << fileName;
-    this->currentStreamFileHandle.setFileName(fileName);
-
-    if (!this->currentStreamFileHandle.open(QIODevice::Append))
-    {
-        qCDebug(chatterinoHelper)
-            << "Failed to open file"
-            << this->currentStreamFileHandle.errorString();
-        return;
-    }
-    appendLine(this->currentStreamFileHandle, generateOpeningString(now));
+    this->currentStreamFilePath = directory + QDir::separator() + baseFileName;
+    this->writer.write(this->currentStreamFilePath,
+                       generateOpeningString(now).toUtf8());
 }
 
 void LoggingChannel::addMessage(const MessagePtr &message,
@@ -254,7 +226,8 @@ void LoggingChannel::addMessage(const MessagePtr &message,
     str.append(messageText);
     str.append(ENDLINE);
 
-    appendLine(this->fileHandle, str);
+    auto line = str.toUtf8();
+    this->writer.write(this->filePath, line);
 
     if (!streamID.isEmpty() && getSettings()->separatelyStoreStreamLogs)
     {
@@ -263,7 +236,7 @@ void LoggingChannel::addMessage(const MessagePtr &message,
             this->openStreamLogFile(streamID);
         }
 
-        appendLine(this->currentStreamFileHandle, str);
+        this->writer.write(this->currentStreamFilePath, std::move(line));
     }
 }
 
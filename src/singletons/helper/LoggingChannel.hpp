@@ -1,6 +1,5 @@
 #pragma once
 
-#include <QFile>
 #include <QString>
 
 #include <memory>
@@ -8,12 +7,14 @@
 namespace chatterino {
 
 class Logging;
+class LogWriter;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 
 class LoggingChannel
 {
-    explicit LoggingChannel(QString _channelName, QString _platform);
+    explicit LoggingChannel(QString _channelName, QString _platform,
+                            LogWriter &writer);
 
 public:
     ~LoggingChannel();
@@ -26,6 +27,11 @@ public:
 
     void addMessage(const MessagePtr &message, const QString &streamID);
 
+    /// Returns the directory the logs of @a channelName are stored in,
+    /// relative to the log directory
+    static QString subDirectoryFor(const QString &channelName,
+                                   const QString &platform);
+
 private:
     void openLogFile();
     void openStreamLogFile(const QString &streamID);
@@ -35,8 +41,12 @@ private:
     QString baseDirectory;
     QString subDirectory;
 
-    QFile fileHandle;
-    QFile currentStreamFileHandle;
+    /// Writes to the log files on another thread
+    LogWriter &writer;
+    /// Path to the log file of the current date
+    QString filePath;
+    /// Path to the log file of the current stream
+    QString currentStreamFilePath;
     QString currentStreamID;
 
     QString dateString;
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// Coalesces lookups of single keys into requests for many keys.
+///
+/// Keys that are looked up within `window` of each other are requested
+/// together, in batches of at most BATCH_SIZE keys. While a key is queued or
+/// requested, further lookups of it wait for that request. Results - and
+/// keys that weren't found - are cached for `ttl`. Failed requests aren't
+/// cached.
+///
+/// If a request for multiple keys is rejected (e.g. because one of the keys
+/// is malformed), it's split in half and both halves are requested again
+/// until the rejected keys are found. Other keys in the batch still succeed.
+///
+/// Responses that arrive after the lookup is destroyed are ignored.
+///
+/// Only used from the GUI thread.
+template <typename T>
+class BatchedLookup
+{
+public:
+    /// Helix accepts at most 100 IDs or logins per request
+    static constexpr qsizetype BATCH_SIZE = 100;
+
+    /// Called with std::nullopt if the key wasn't found
+    using Callback = std::function<void(const std::optional<T> &)>;
+    using FailureCallback = std::function<void()>;
+    using Results = std::vector<std::pair<QString, T>>;
+
+    enum class FetchError : uint8_t {
+        /// The request failed, e.g. because of a network error
+        Failed,
+        /// The request was rejected because of its keys (HTTP 400)
+        Rejected,
+    };
+
+    /// Requests @a keys. Either @a onSuccess is called with the values that
+    /// were found (and their key) or @a onFailure is called.
+    using Fetch =
+        std::function<void(const QStringList &keys,
+                           std::function<void(Results)> onSuccess,
+                           std::function<void(FetchError)> onFailure)>;
+
+    BatchedLookup(Fetch fetch, std::chrono::milliseconds window,
+                  std::chrono::milliseconds ttl)
+        : fetch_(std::move(fetch))
+        , ttl_(ttl)
+    {
+        this->timer_.setSingleShot(true);
+        this->timer_.setInterval(window);
+        QObject::connect(&this->timer_, &QTimer::timeout, [this] {
+            this->flush();
+        });
+    }
+
+    /// Calls @a callback with the value of @a key or @a onFailure if it
+    /// couldn't be requested.
+    ///
+    /// Cached values are passed right away.
+    void get(const QString &key, Callback callback,
+             FailureCallback onFailure = {})
+    {
+        auto cached = this->cache_.find(key);
+        if (cached != this->cache_.end())
+        {
+            if (Clock::now() < cached->second.expiresAt)
+            {
+                callback(cached->second.value);
+                return;
+            }
+            this->cache_.erase(cached);
+        }
+
+        auto [waiting, inserted] = this->waiting_.try_emplace(key);
+        waiting->second.push_back({
+            .callback = std::move(callback),
+            .onFailure = std::move(onFailure),
+        });
+        if (!inserted)
+        {
+            // Already queued or requested
+            return;
+        }
+
+        this->queued_.append(key);
+        if (this->queued_.size() >= BATCH_SIZE)
+        {
+            this->flush();
+        }
+        else if (!this->timer_.isActive())
+        {
+            this->timer_.start();
+        }
+    }
+
+    /// Caches @a value for @a key, e.g. because it was part of another
+    /// response
+    void store(const QString &key, T value)
+    {
+        this->cache_.insert_or_assign(
+            key, Cached{
+                     .value = std::move(value),
+                     .expiresAt = Clock::now() + this->ttl_,
+                 });
+    }
+
+    /// Requests all queued keys right away
+    void flush()
+    {
+        this->timer_.stop();
+        this->pruneCache();
+
+        while (!this->queued_.isEmpty())
+        {
+            auto keys = this->queued_.first(
+                std::min(this->queued_.size(), BATCH_SIZE));
+            this->queued_.remove(0, keys.size());
+            this->request(keys);
+        }
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Cached {
+        /// std::nullopt if the key wasn't found
+        std::optional<T> value;
+        Clock::time_point expiresAt;
+    };
+
+    struct Waiting {
+        Callback callback;
+        FailureCallback onFailure;
+    };
+
+    void request(const QStringList &keys)
+    {
+        this->fetch_(
+            keys,
+            [this, lifetime = std::weak_ptr(this->lifetime_),
+             keys](Results results) {
+                if (!lifetime.expired())
+                {
+                    this->resolve(keys, std::move(results));
+                }
+            },
+            [this, lifetime = std::weak_ptr(this->lifetime_),
+             keys](FetchError error) {
+                if (lifetime.expired())
+                {
+                    return;
+                }
+                if (error == FetchError::Rejected && keys.size() > 1)
+                {
+                    // Find the keys that were rejected
+                    auto half = keys.size() / 2;
+                    this->request(keys.first(half));
+                    this->request(keys.sliced(half));
+                    return;
+                }
+                this->fail(keys);
+            });
+    }
+
+    void resolve(const QStringList &keys, Results results)
+    {
+        for (auto &[key, value] : results)
+        {
+            this->store(key, std::move(value));
+        }
+
+        auto expiresAt = Clock::now() + this->ttl_;
+        for (const auto &key : keys)
+        {
+            // Keys that weren't part of the results don't exist
+            auto cached =
+                this->cache_
+                    .try_emplace(key, Cached{.value = std::nullopt,
+                                             .expiresAt = expiresAt})
+                    .first;
+
+            // The cache entry might be replaced by a callback
+            auto value = cached->second.value;
+            for (const auto &waiting : this->takeWaiting(key))
+            {
+                waiting.callback(value);
+            }
+        }
+    }
+
+    void fail(const QStringList &keys)
+    {
+        for (const auto &key : keys)
+        {
+            for (const auto &waiting : this->takeWaiting(key))
+            {
+                if (waiting.onFailure)
+                {
+                    waiting.onFailure();
+                }
+            }
+        }
+    }
+
+    std::vector<Waiting> takeWaiting(const QString &key)
+    {
+        auto it = this->waiting_.find(key);
+        if (it == this->waiting_.end())
+        {
+            return {};
+        }
+        // Callbacks might look up the same key again
+        auto waiting = std::move(it->second);
+        this->waiting_.erase(it);
+        return waiting;
+    }
+
+    void pruneCache()
+    {
+        auto now = Clock::now();
+        std::erase_if(this->cache_, [&](const auto &it) {
+            return it.second.expiresAt <= now;
+        });
+    }
+
+    Fetch fetch_;
+    std::chrono::milliseconds ttl_;
+
+    std::unordered_map<QString, Cached> cache_;
+    /// Callbacks of keys that are queued or requested
+    std::unordered_map<QString, std::vector<Waiting>> waiting_;
+    QStringList queued_;
+    QTimer timer_;
+
+    std::shared_ptr<bool> lifetime_ = std::make_shared<bool>();
+};
+
+}  // namespace chatterino
@@ -0,0 +1,75 @@
+#include "util/BumpArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace chatterino {
+
+void *BumpArena::allocate(size_t size, size_t alignment)
+{
+    while (this->current_ < this->blocks_.size())
+    {
+        auto &block = this->blocks_[this->current_];
+        auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        auto start = (base + this->offset_ + alignment - 1) & ~(alignment - 1);
+        auto offset = static_cast<size_t>(start - base);
+        if (offset <= block.size && size <= block.size - offset)
+        {
+            this->used_ += offset + size - this->offset_;
+            this->offset_ = offset + size;
+            return block.data.get() + offset;
+        }
+
+        // Blocks from a previous pass are reused before allocating new ones
+        this->current_++;
+        this->offset_ = 0;
+    }
+
+    auto lastSize = this->blocks_.empty() ? INITIAL_BLOCK_SIZE / 2
+                                          : this->blocks_.back().size;
+    this->pushBlock(std::max(lastSize * 2, size + alignment));
+    return this->allocate(size, alignment);
+}
+
+void BumpArena::reset()
+{
+    if (this->blocks_.size() > 1)
+    {
+        // Round up, the padding might differ in a new block
+        auto size = std::max((this->used_ + 63) & ~size_t{63},
+                             this->blocks_.front().size);
+        this->blocks_.clear();
+        this->pushBlock(size);
+    }
+
+    this->current_ = 0;
+    this->offset_ = 0;
+    this->used_ = 0;
+}
+
+size_t BumpArena::capacity() const
+{
+    size_t capacity = 0;
+    for (const auto &block : this->blocks_)
+    {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+size_t BumpArena::blockCount() const
+{
+    return this->blocks_.size();
+}
+
+void BumpArena::pushBlock(size_t size)
+{
+    this->blocks_.push_back({
+        .data = std::unique_ptr<std::byte[]>(new std::byte[size]),
+        .size = size,
+    });
+    this->current_ = this->blocks_.size() - 1;
+    this->offset_ = 0;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// A monotonic arena that hands out memory by bumping a pointer.
+///
+/// Memory is only given back with reset(), after which it's reused for the
+/// next allocations. If a pass needed more than one block, the blocks are
+/// merged into one on reset(), so repeated passes of a similar size end up
+/// in a single, contiguous block.
+///
+/// The arena doesn't run destructors - objects created with create() have to
+/// be destroyed by their owner before calling reset().
+class BumpArena
+{
+public:
+    static constexpr size_t INITIAL_BLOCK_SIZE = 1024;
+
+    BumpArena() = default;
+    ~BumpArena() = default;
+
+    BumpArena(const BumpArena &) = delete;
+    BumpArena &operator=(const BumpArena &) = delete;
+    BumpArena(BumpArena &&) = default;
+    BumpArena &operator=(BumpArena &&) = default;
+
+    /// Returns @a size bytes aligned to @a alignment
+    void *allocate(size_t size, size_t alignment);
+
+    template <typename T, typename... Args>
+    T *create(Args &&...args)
+    {
+        void *memory = this->allocate(sizeof(T), alignof(T));
+        return new (memory) T(std::forward<Args>(args)...);
+    }
+
+    /// Makes all memory available again
+    void reset();
+
+    /// The number of bytes held by this arena
+    size_t capacity() const;
+
+    /// The number of blocks allocated from the heap
+    size_t blockCount() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    void pushBlock(size_t size);
+
+    std::vector<Block> blocks_;
+    /// The block we're currently allocating from
+    size_t current_ = 0;
+    /// The offset into the current block
+    size_t offset_ = 0;
+    /// The bytes allocated since the last reset (including padding)
+    size_t used_ = 0;
+};
+
+}  // namespace chatterino
@@ -1,105 +1,149 @@
 #include "util/DebugCount.hpp"
 
-#include "common/UniqueAccess.hpp"
-
 #include <QLocale>
 #include <QStringBuilder>
 
 #include <map>
+#include <memory>
+#include <mutex>
 
 namespace {
 
 using namespace chatterino;
+using namespace chatterino::debugcount::detail;
 
 struct Count {
-    int64_t value = 0;
+    std::unique_ptr<Storage> storage = std::make_unique<Storage>();
     DebugCount::Flags flags = DebugCount::Flag::None;
 };
 
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-UniqueAccess<std::map<QString, Count>> COUNTS;
+/// The registered counters. Counters are never removed, so pointers to their
+/// storage stay valid.
+struct Registry {
+    std::mutex mutex;
+    std::map<QString, Count> counts;
 
-}  // namespace
+    /// Returns the counter @a name, registering it if necessary.
+    /// The mutex must be locked.
+    Count &get(const QString &name)
+    {
+        auto it = this->counts.find(name);
+        if (it == this->counts.end())
+        {
+            it = this->counts.emplace(name, Count{}).first;
+        }
+        return it->second;
+    }
+};
 
-namespace chatterino {
+Registry &registry()
+{
+    // Intentionally leaked - counters might be updated while static
+    // destructors run.
+    static auto *registry = new Registry;
+    return *registry;
+}
 
-void DebugCount::configure(const QString &name, Flags flags)
+Storage *storage(const QString &name)
 {
-    auto counts = COUNTS.access();
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
+    return reg.get(name).storage.get();
+}
 
-    auto it = counts->find(name);
-    if (it == counts->end())
+void setStorage(Storage &storage, int64_t value)
+{
+    storage.shards[0].value.store(value, std::memory_order_relaxed);
+    for (size_t i = 1; i < SHARD_COUNT; i++)
     {
-        counts->emplace(name, Count{.flags = flags});
+        storage.shards[i].value.store(0, std::memory_order_relaxed);
     }
-    else
+}
+
+}  // namespace
+
+namespace chatterino {
+
+namespace debugcount::detail {
+
+int64_t Storage::sum() const
+{
+    int64_t total = 0;
+    for (const auto &shard : this->shards)
     {
-        it->second.flags = flags;
+        total += shard.value.load(std::memory_order_relaxed);
     }
+    return total;
 }
 
-void DebugCount::set(const QString &name, const int64_t &amount)
+}  // namespace debugcount::detail
+
+void DebugCount::Counter::set(int64_t value) const
 {
-    auto counts = COUNTS.access();
+    setStorage(*this->storage_, value);
+}
 
-    auto it = counts->find(name);
-    if (it == counts->end())
-    {
-        counts->emplace(name, Count{amount});
-    }
-    else
-    {
-        it->second.value = amount;
-    }
+int64_t DebugCount::Counter::value() const
+{
+    return this->storage_->sum();
 }
 
-void DebugCount::increase(const QString &name, const int64_t &amount)
+DebugCount::Counter DebugCount::counter(const QString &name, Flags flags)
 {
-    auto counts = COUNTS.access();
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
 
-    auto it = counts->find(name);
-    if (it == counts->end())
+    auto &count = reg.get(name);
+    if (!flags.isEmpty())
     {
-        counts->emplace(name, Count{amount});
-    }
-    else
-    {
-        it->second.value += amount;
+        count.flags = flags;
     }
+    return Counter(count.storage.get());
 }
 
-void DebugCount::decrease(const QString &name, const int64_t &amount)
+void DebugCount::configure(const QString &name, Flags flags)
 {
-    auto counts = COUNTS.access();
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
 
-    auto it = counts->find(name);
-    if (it == counts->end())
-    {
-        counts->emplace(name, Count{-amount});
-    }
-    else
-    {
-        it->second.value -= amount;
-    }
+    reg.get(name).flags = flags;
+}
+
+void DebugCount::set(const QString &name, const int64_t &amount)
+{
+    setStorage(*storage(name), amount);
+}
+
+void DebugCount::increase(const QString &name, const int64_t &amount)
+{
+    Counter(storage(name)).increase(amount);
+}
+
+void DebugCount::decrease(const QString &name, const int64_t &amount)
+{
+    Counter(storage(name)).decrease(amount);
 }
 
 QString DebugCount::getDebugText()
 {
     static const QLocale locale(QLocale::English);
 
-    auto counts = COUNTS.access();
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
 
     QString text;
-    for (const auto &[key, count] : *counts)
+    for (const auto &[key, count] : reg.counts)
     {
+        auto value = count.storage->sum();
+
         QString formatted;
         if (count.flags.has(Flag::DataSize))
         {
-            formatted = locale.formattedDataSize(count.value);
+            formatted = locale.formattedDataSize(value);
         }
         else
         {
-            formatted = locale.toString(static_cast<qlonglong>(count.value));
+            formatted = locale.toString(static_cast<qlonglong>(value));
         }
 
         text += key % ": " % formatted % '\n';
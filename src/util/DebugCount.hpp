@@ -4,8 +4,40 @@
 
 #include <QString>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 namespace chatterino {
 
+namespace debugcount::detail {
+
+/// Number of shards each counter is split into. Threads are assigned to
+/// shards round-robin, so threads rarely write to the same cache line.
+constexpr size_t SHARD_COUNT = 8;
+
+struct alignas(64) Shard {
+    std::atomic<int64_t> value = 0;
+};
+
+struct Storage {
+    std::array<Shard, SHARD_COUNT> shards;
+
+    int64_t sum() const;
+};
+
+/// Returns the shard of the current thread
+inline size_t currentShard()
+{
+    static std::atomic<size_t> nextShard = 0;
+    thread_local const size_t shard =
+        nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return shard;
+}
+
+}  // namespace debugcount::detail
+
 class DebugCount
 {
 public:
@@ -16,8 +48,55 @@ public:
     };
     using Flags = FlagsEnum<Flag>;
 
+    /// A handle to a registered counter.
+    ///
+    /// Updating a counter through its handle doesn't lock and doesn't look up
+    /// the name. Handles are cheap to copy and stay valid forever.
+    class Counter
+    {
+    public:
+        void increase(int64_t amount = 1) const
+        {
+            this->storage_->shards[debugcount::detail::currentShard()]
+                .value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        void decrease(int64_t amount = 1) const
+        {
+            this->increase(-amount);
+        }
+
+        /// Sets the counter to @a value.
+        ///
+        /// Updates from other threads that happen at the same time might get
+        /// lost, so this should only be used for counters that are only set.
+        void set(int64_t value) const;
+
+        int64_t value() const;
+
+    private:
+        explicit Counter(debugcount::detail::Storage *storage)
+            : storage_(storage)
+        {
+        }
+
+        debugcount::detail::Storage *storage_;
+
+        friend DebugCount;
+    };
+
+    /// Registers the counter @a name (if it's not registered yet) and returns
+    /// a handle to it.
+    ///
+    /// This is meant to be called once per counter, e.g. for a `static` or a
+    /// global variable.
+    static Counter counter(const QString &name, Flags flags = Flag::None);
+
     static void configure(const QString &name, Flags flags);
 
+    // The following functions look up the counter by its name on every call.
+    // Prefer using a Counter on hot paths.
+
     static void set(const QString &name, const int64_t &amount);
 
     static void increase(const QString &name, const int64_t &amount);
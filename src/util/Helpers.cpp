@@ -416,33 +416,43 @@ void writeProviderEmotesCache(const QString &id, const QString &provider,
     });
 }
 
-bool readProviderEmotesCache(const QString &id, const QString &provider,
-                             const std::function<void(QJsonDocument)> &callback)
+std::optional<QByteArray> readProviderEmotesCacheData(const QString &id,
+                                                     const QString &provider)
 {
     QString cacheKey = id % "." % provider;
     QFile responseCache(getApp()->getPaths().cacheFilePath(cacheKey));
 
-    if (responseCache.open(QIODevice::ReadOnly))
+    if (!responseCache.open(QIODevice::ReadOnly))
     {
-        QJsonParseError parseError;
-        auto doc = QJsonDocument::fromJson(qUncompress(responseCache.readAll()),
-                                           &parseError);
+        return std::nullopt;
+    }
 
-        if (parseError.error != QJsonParseError::NoError)
-        {
-            qCWarning(chatterinoCache)
-                << "Emote cache " << id << "." << provider
-                << " parsing failed: " << parseError.errorString();
-        }
+    qCDebug(chatterinoCache) << "Loaded emote cache: " << id << "." << provider;
+    return qUncompress(responseCache.readAll());
+}
 
-        qCDebug(chatterinoCache)
-            << "Loaded emote cache: " << id << "." << provider;
-        callback(doc);
-        return true;
+bool readProviderEmotesCache(const QString &id, const QString &provider,
+                             const std::function<void(QJsonDocument)> &callback)
+{
+    auto data = readProviderEmotesCacheData(id, provider);
+    if (!data)
+    {
+        // If the API call fails, we need to know if loading cached emotes was successful
+        return false;
+    }
+
+    QJsonParseError parseError;
+    auto doc = QJsonDocument::fromJson(*data, &parseError);
+
+    if (parseError.error != QJsonParseError::NoError)
+    {
+        qCWarning(chatterinoCache)
+            << "Emote cache " << id << "." << provider
+            << " parsing failed: " << parseError.errorString();
     }
 
-    // If the API call fails, we need to know if loading cached emotes was successful
-    return false;
+    callback(doc);
+    return true;
 }
 
 std::pair<QStringView, QStringView> splitOnce(QStringView haystack,
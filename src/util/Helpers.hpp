@@ -226,6 +226,12 @@ bool readProviderEmotesCache(
     const QString &id, const QString &provider,
     const std::function<void(QJsonDocument)> &callback);
 
+/// Reads the cached response of @a provider for @a id without parsing it.
+///
+/// @returns The (uncompressed) response or std::nullopt if nothing is cached
+std::optional<QByteArray> readProviderEmotesCacheData(const QString &id,
+                                                     const QString &provider);
+
 /// Splits `haystack` by `needle`. If `needle` doesn't occur in `haystack`,
 /// `{haystack, {}}` is returned.
 std::pair<QStringView, QStringView> splitOnce(QStringView haystack,
@@ -0,0 +1,605 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// A hash map that shares its structure with its copies.
+///
+/// The entries are stored in a hash array mapped trie (CHAMP layout). Copying
+/// a map only copies a pointer to the root. Inserting or erasing an entry
+/// copies the nodes on the path to it - at most one node per 5 bits of the
+/// hash - if they're shared with another map. Nodes that are only owned by
+/// this map are modified in place, so building a map entry by entry doesn't
+/// copy anything.
+///
+/// The interface mirrors std::unordered_map, but entries can't be modified
+/// through iterators. A map that's shared between threads must not be
+/// modified; copy it and publish the copy instead. Copying is cheap and
+/// doesn't affect readers of the original.
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class PersistentHashMap
+{
+    struct Node;
+    using NodePtr = std::shared_ptr<Node>;
+
+    static constexpr unsigned BITS = 5;
+    static constexpr size_t HASH_BITS = sizeof(size_t) * CHAR_BIT;
+    /// Nodes at this depth store all their entries in a list - their keys
+    /// have the same hash
+    static constexpr size_t MAX_DEPTH = (HASH_BITS + BITS - 1) / BITS;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PersistentHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        const_iterator() = default;
+
+        reference operator*() const
+        {
+            const auto &frame = this->stack_[this->depth_ - 1];
+            return frame.node->entries[frame.entry];
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        const_iterator &operator++()
+        {
+            this->stack_[this->depth_ - 1].entry++;
+            this->settle();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const const_iterator &other) const
+        {
+            if (this->depth_ != other.depth_)
+            {
+                return false;
+            }
+            if (this->depth_ == 0)
+            {
+                return true;
+            }
+            const auto &a = this->stack_[this->depth_ - 1];
+            const auto &b = other.stack_[other.depth_ - 1];
+            return a.node == b.node && a.entry == b.entry;
+        }
+
+    private:
+        friend class PersistentHashMap;
+
+        /// Entries of a node are visited before its children
+        struct Frame {
+            const Node *node = nullptr;
+            uint32_t entry = 0;
+            uint32_t child = 0;
+        };
+
+        explicit const_iterator(const Node *root)
+        {
+            if (root != nullptr)
+            {
+                this->push(root, 0, 0);
+                this->settle();
+            }
+        }
+
+        void push(const Node *node, uint32_t entry, uint32_t child)
+        {
+            assert(this->depth_ < this->stack_.size());
+            this->stack_[this->depth_++] = {node, entry, child};
+        }
+
+        /// Moves to the next entry, starting at the current position
+        void settle()
+        {
+            while (this->depth_ > 0)
+            {
+                auto &frame = this->stack_[this->depth_ - 1];
+                if (frame.entry < frame.node->entries.size())
+                {
+                    return;
+                }
+                if (frame.child < frame.node->children.size())
+                {
+                    const auto *child = frame.node->children[frame.child].get();
+                    frame.child++;
+                    this->push(child, 0, 0);
+                    continue;
+                }
+                this->depth_--;
+            }
+        }
+
+        std::array<Frame, MAX_DEPTH + 1> stack_{};
+        size_t depth_ = 0;
+    };
+    using iterator = const_iterator;
+
+    PersistentHashMap() = default;
+
+    PersistentHashMap(std::initializer_list<value_type> entries)
+    {
+        for (const auto &entry : entries)
+        {
+            this->insert(entry);
+        }
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this->root_.get());
+    }
+
+    const_iterator end() const
+    {
+        return {};
+    }
+
+    const_iterator cbegin() const
+    {
+        return this->begin();
+    }
+
+    const_iterator cend() const
+    {
+        return this->end();
+    }
+
+    size_t size() const
+    {
+        return this->size_;
+    }
+
+    bool empty() const
+    {
+        return this->size_ == 0;
+    }
+
+    void clear()
+    {
+        this->root_.reset();
+        this->size_ = 0;
+    }
+
+    /// Does nothing, this exists for compatibility with std::unordered_map
+    void reserve(size_t /* count */)
+    {
+    }
+
+    const_iterator find(const K &key) const
+    {
+        const_iterator it;
+        const auto *node = this->root_.get();
+        auto hash = hashOf(key);
+        for (size_t depth = 0; node != nullptr; depth++)
+        {
+            if (depth == MAX_DEPTH)
+            {
+                for (uint32_t i = 0; i < node->entries.size(); i++)
+                {
+                    if (KeyEqual{}(node->entries[i].first, key))
+                    {
+                        it.push(node, i, 0);
+                        return it;
+                    }
+                }
+                return {};
+            }
+
+            auto bit = bitOf(hash, depth);
+            if ((node->dataMap & bit) != 0)
+            {
+                auto index = indexOf(node->dataMap, bit);
+                if (!KeyEqual{}(node->entries[index].first, key))
+                {
+                    return {};
+                }
+                it.push(node, index, 0);
+                return it;
+            }
+            if ((node->nodeMap & bit) == 0)
+            {
+                return {};
+            }
+
+            // Continue with the next child once the found subtree is done
+            auto index = indexOf(node->nodeMap, bit);
+            it.push(node, static_cast<uint32_t>(node->entries.size()),
+                    index + 1);
+            node = node->children[index].get();
+        }
+        return {};
+    }
+
+    bool contains(const K &key) const
+    {
+        return this->find(key) != this->end();
+    }
+
+    size_t count(const K &key) const
+    {
+        return this->contains(key) ? 1 : 0;
+    }
+
+    const V &at(const K &key) const
+    {
+        auto it = this->find(key);
+        if (it == this->end())
+        {
+            throw std::out_of_range("PersistentHashMap::at");
+        }
+        return it->second;
+    }
+
+    V &operator[](const K &key)
+    {
+        return this->findOrInsert(key, [] {
+                       return V{};
+                   })
+            .first->second;
+    }
+
+    std::pair<const_iterator, bool> insert(const value_type &value)
+    {
+        auto inserted = this->findOrInsert(value.first, [&] {
+                                return value.second;
+                            }).second;
+        return {this->find(value.first), inserted};
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> emplace(Args &&...args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        auto inserted = this->findOrInsert(value.first, [&] {
+                                return std::move(value.second);
+                            }).second;
+        return {this->find(value.first), inserted};
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> try_emplace(const K &key, Args &&...args)
+    {
+        auto inserted = this->findOrInsert(key, [&] {
+                                return V(std::forward<Args>(args)...);
+                            }).second;
+        return {this->find(key), inserted};
+    }
+
+    template <typename M>
+    std::pair<const_iterator, bool> insert_or_assign(const K &key, M &&value)
+    {
+        bool assigned = false;
+        auto [entry, inserted] = this->findOrInsert(key, [&] {
+            assigned = true;
+            return V(std::forward<M>(value));
+        });
+        if (!assigned)
+        {
+            entry->second = std::forward<M>(value);
+        }
+        return {this->find(key), inserted};
+    }
+
+    size_t erase(const K &key)
+    {
+        // Check first, so we don't copy nodes for nothing
+        if (!this->contains(key))
+        {
+            return 0;
+        }
+
+        eraseFrom(this->root_, key, hashOf(key), 0);
+        this->size_--;
+        if (this->root_->entries.empty() && this->root_->children.empty())
+        {
+            this->root_.reset();
+        }
+        return 1;
+    }
+
+    /// Returns an iterator to the entry after @a it
+    const_iterator erase(const_iterator it)
+    {
+        K key = it->first;
+        ++it;
+        if (it == this->end())
+        {
+            this->erase(key);
+            return this->end();
+        }
+
+        K next = it->first;
+        this->erase(key);
+        return this->find(next);
+    }
+
+    /// Calls @a fn with every key that's only in one of the maps or has a
+    /// different value in them. A key might be passed more than once.
+    ///
+    /// Subtrees shared by both maps are skipped, so comparing a map to a
+    /// modified copy of itself only looks at the modified paths.
+    template <typename F>
+    void forEachDifference(const PersistentHashMap &other, F &&fn) const
+    {
+        diff(this->root_.get(), other.root_.get(), 0, fn);
+    }
+
+private:
+    struct Node {
+        /// Slots holding an entry
+        uint32_t dataMap = 0;
+        /// Slots holding a child
+        uint32_t nodeMap = 0;
+        /// Ordered by slot
+        std::vector<value_type> entries;
+        /// Ordered by slot
+        std::vector<NodePtr> children;
+    };
+
+    static size_t hashOf(const K &key)
+    {
+        return static_cast<size_t>(Hash{}(key));
+    }
+
+    static uint32_t bitOf(size_t hash, size_t depth)
+    {
+        return uint32_t{1} << ((hash >> (depth * BITS)) & ((1U << BITS) - 1));
+    }
+
+    /// The index of @a bit in the entries or children ordered by @a map
+    static uint32_t indexOf(uint32_t map, uint32_t bit)
+    {
+        return static_cast<uint32_t>(std::popcount(map & (bit - 1)));
+    }
+
+    /// Makes sure @a node is only owned by this map, copying it if needed
+    static Node &own(NodePtr &node)
+    {
+        if (!node)
+        {
+            node = std::make_shared<Node>();
+        }
+        else if (node.use_count() > 1)
+        {
+            node = std::make_shared<Node>(*node);
+        }
+        else
+        {
+            // use_count() is a relaxed load. Copies on other threads might
+            // have released the node just now - their reads of it have to
+            // happen before it's modified here.
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *node;
+    }
+
+    /// Returns the entry of @a key and true if it was created with
+    /// @a makeValue. All nodes on the path to the entry are owned by this map
+    /// afterwards.
+    template <typename MakeValue>
+    std::pair<value_type *, bool> findOrInsert(const K &key,
+                                               MakeValue &&makeValue)
+    {
+        auto hash = hashOf(key);
+        auto *slot = &this->root_;
+        for (size_t depth = 0;; depth++)
+        {
+            auto &node = own(*slot);
+            if (depth == MAX_DEPTH)
+            {
+                for (auto &entry : node.entries)
+                {
+                    if (KeyEqual{}(entry.first, key))
+                    {
+                        return {&entry, false};
+                    }
+                }
+                node.entries.emplace_back(key, makeValue());
+                this->size_++;
+                return {&node.entries.back(), true};
+            }
+
+            auto bit = bitOf(hash, depth);
+            if ((node.nodeMap & bit) != 0)
+            {
+                slot = &node.children[indexOf(node.nodeMap, bit)];
+                continue;
+            }
+
+            auto index = indexOf(node.dataMap, bit);
+            if ((node.dataMap & bit) == 0)
+            {
+                auto it = node.entries.emplace(
+                    node.entries.begin() + index, key, makeValue());
+                node.dataMap |= bit;
+                this->size_++;
+                return {&*it, true};
+            }
+            if (KeyEqual{}(node.entries[index].first, key))
+            {
+                return {&node.entries[index], false};
+            }
+
+            // The slot is taken by another key - move it down into a new
+            // child and continue there
+            auto child = std::make_shared<Node>();
+            if (depth + 1 < MAX_DEPTH)
+            {
+                child->dataMap =
+                    bitOf(hashOf(node.entries[index].first), depth + 1);
+            }
+            child->entries.push_back(std::move(node.entries[index]));
+            node.entries.erase(node.entries.begin() + index);
+            node.dataMap &= ~bit;
+
+            node.nodeMap |= bit;
+            slot = &*node.children.insert(
+                node.children.begin() + indexOf(node.nodeMap, bit),
+                std::move(child));
+        }
+    }
+
+    template <typename F>
+    static void forEachKey(const Node *node, F &fn)
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+        for (const auto &entry : node->entries)
+        {
+            fn(entry.first);
+        }
+        for (const auto &child : node->children)
+        {
+            forEachKey(child.get(), fn);
+        }
+    }
+
+    template <typename F>
+    static void diff(const Node *a, const Node *b, size_t depth, F &fn)
+    {
+        if (a == b)
+        {
+            return;
+        }
+        if (a == nullptr || b == nullptr || depth == MAX_DEPTH)
+        {
+            forEachKey(a, fn);
+            forEachKey(b, fn);
+            return;
+        }
+
+        auto slots = a->dataMap | a->nodeMap | b->dataMap | b->nodeMap;
+        while (slots != 0)
+        {
+            auto bit = slots & (~slots + 1);
+            slots &= ~bit;
+
+            const value_type *entryA = nullptr;
+            const value_type *entryB = nullptr;
+            const Node *childA = nullptr;
+            const Node *childB = nullptr;
+            if ((a->dataMap & bit) != 0)
+            {
+                entryA = &a->entries[indexOf(a->dataMap, bit)];
+            }
+            else if ((a->nodeMap & bit) != 0)
+            {
+                childA = a->children[indexOf(a->nodeMap, bit)].get();
+            }
+            if ((b->dataMap & bit) != 0)
+            {
+                entryB = &b->entries[indexOf(b->dataMap, bit)];
+            }
+            else if ((b->nodeMap & bit) != 0)
+            {
+                childB = b->children[indexOf(b->nodeMap, bit)].get();
+            }
+
+            if (entryA != nullptr && entryB != nullptr &&
+                KeyEqual{}(entryA->first, entryB->first) &&
+                entryA->second == entryB->second)
+            {
+                continue;
+            }
+            if (entryA != nullptr)
+            {
+                fn(entryA->first);
+            }
+            if (entryB != nullptr)
+            {
+                fn(entryB->first);
+            }
+            diff(childA, childB, depth + 1, fn);
+        }
+    }
+
+    /// Erases @a key, which must exist below @a slot
+    static void eraseFrom(NodePtr &slot, const K &key, size_t hash,
+                          size_t depth)
+    {
+        auto &node = own(slot);
+        if (depth == MAX_DEPTH)
+        {
+            std::erase_if(node.entries, [&](const auto &entry) {
+                return KeyEqual{}(entry.first, key);
+            });
+            return;
+        }
+
+        auto bit = bitOf(hash, depth);
+        if ((node.dataMap & bit) != 0)
+        {
+            node.entries.erase(node.entries.begin() +
+                               indexOf(node.dataMap, bit));
+            node.dataMap &= ~bit;
+            return;
+        }
+
+        auto childIndex = indexOf(node.nodeMap, bit);
+        auto &child = node.children[childIndex];
+        eraseFrom(child, key, hash, depth + 1);
+        if (!child->children.empty() || child->entries.size() > 1)
+        {
+            return;
+        }
+
+        // Keep the trie compact - a child with at most one entry is
+        // replaced by that entry
+        if (!child->entries.empty())
+        {
+            node.entries.insert(
+                node.entries.begin() + indexOf(node.dataMap, bit),
+                std::move(child->entries.front()));
+            node.dataMap |= bit;
+        }
+        node.children.erase(node.children.begin() + childIndex);
+        node.nodeMap &= ~bit;
+    }
+
+    NodePtr root_;
+    size_t size_ = 0;
+};
+
+}  // namespace chatterino
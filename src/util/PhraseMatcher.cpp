@@ -0,0 +1,223 @@
+#include "util/PhraseMatcher.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+namespace {
+
+/// Calls @a fn with the UTF-16 code units of @a text after simple case
+/// folding
+template <typename Fn>
+void forEachFolded(QStringView text, Fn &&fn)
+{
+    for (qsizetype i = 0; i < text.size(); i++)
+    {
+        char32_t codepoint = text[i].unicode();
+        if (QChar::isHighSurrogate(codepoint) && i + 1 < text.size() &&
+            text[i + 1].isLowSurrogate())
+        {
+            codepoint = QChar::surrogateToUcs4(text[i], text[i + 1]);
+            i++;
+        }
+
+        codepoint = QChar::toCaseFolded(codepoint);
+        if (QChar::requiresSurrogates(codepoint))
+        {
+            fn(static_cast<char16_t>(QChar::highSurrogate(codepoint)));
+            fn(static_cast<char16_t>(QChar::lowSurrogate(codepoint)));
+        }
+        else
+        {
+            fn(static_cast<char16_t>(codepoint));
+        }
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void PhraseMatcher::addLiteral(QStringView literal)
+{
+    assert(this->nodes_.empty() && "Phrases must be added before build()");
+
+    if (literal.isEmpty())
+    {
+        this->addUnindexed();
+        return;
+    }
+
+    uint32_t node = 0;
+    forEachFolded(literal, [&](char16_t c) {
+        auto it = this->trie_[node].find(c);
+        if (it != this->trie_[node].end())
+        {
+            node = it->second;
+            return;
+        }
+
+        auto next = static_cast<uint32_t>(this->trie_.size());
+        this->trie_[node].emplace(c, next);
+        this->trie_.emplace_back();
+        this->trieEnds_.emplace_back();
+        node = next;
+    });
+
+    this->trieEnds_[node].push_back(static_cast<uint32_t>(this->phraseCount_));
+    this->phraseCount_++;
+}
+
+void PhraseMatcher::addUnindexed()
+{
+    assert(this->nodes_.empty() && "Phrases must be added before build()");
+
+    this->unindexed_.push_back(this->phraseCount_);
+    this->phraseCount_++;
+}
+
+void PhraseMatcher::build()
+{
+    // Flatten the trie
+    this->nodes_.resize(this->trie_.size());
+    for (size_t i = 0; i < this->trie_.size(); i++)
+    {
+        auto &node = this->nodes_[i];
+
+        node.edgesBegin = static_cast<uint32_t>(this->edges_.size());
+        // std::map is sorted by character already
+        this->edges_.insert(this->edges_.end(), this->trie_[i].begin(),
+                            this->trie_[i].end());
+        node.edgesEnd = static_cast<uint32_t>(this->edges_.size());
+
+        node.phrasesBegin = static_cast<uint32_t>(this->phrases_.size());
+        this->phrases_.insert(this->phrases_.end(), this->trieEnds_[i].begin(),
+                              this->trieEnds_[i].end());
+        node.phrasesEnd = static_cast<uint32_t>(this->phrases_.size());
+    }
+    this->trie_.clear();
+    this->trie_.shrink_to_fit();
+    this->trieEnds_.clear();
+    this->trieEnds_.shrink_to_fit();
+
+    // Compute the failure and dictionary links in breadth-first order, so
+    // the links of shorter suffixes are known first
+    std::queue<uint32_t> queue;
+    queue.push(0);
+    while (!queue.empty())
+    {
+        auto parent = queue.front();
+        queue.pop();
+
+        for (auto e = this->nodes_[parent].edgesBegin;
+             e < this->nodes_[parent].edgesEnd; e++)
+        {
+            auto [c, child] = this->edges_[e];
+            queue.push(child);
+
+            uint32_t fail = 0;
+            if (parent != 0)
+            {
+                auto candidate = this->nodes_[parent].fail;
+                while (true)
+                {
+                    auto next = this->findEdge(candidate, c);
+                    if (next != NONE)
+                    {
+                        fail = next;
+                        break;
+                    }
+                    if (candidate == 0)
+                    {
+                        break;
+                    }
+                    candidate = this->nodes_[candidate].fail;
+                }
+            }
+
+            const auto &failNode = this->nodes_[fail];
+            auto &node = this->nodes_[child];
+            node.fail = fail;
+            node.dictionary = failNode.phrasesBegin != failNode.phrasesEnd
+                                  ? fail
+                                  : failNode.dictionary;
+        }
+    }
+}
+
+size_t PhraseMatcher::size() const
+{
+    return this->phraseCount_;
+}
+
+std::vector<size_t> PhraseMatcher::candidates(QStringView text) const
+{
+    assert((!this->nodes_.empty() || this->phraseCount_ == 0) &&
+           "build() must be called before searching");
+
+    std::vector<size_t> found = this->unindexed_;
+    if (this->nodes_.size() <= 1)
+    {
+        return found;
+    }
+
+    std::vector<bool> seen(this->phraseCount_);
+    uint32_t state = 0;
+    forEachFolded(text, [&](char16_t c) {
+        state = this->step(state, c);
+
+        const auto &current = this->nodes_[state];
+        auto match = current.phrasesBegin != current.phrasesEnd
+                         ? state
+                         : current.dictionary;
+        for (; match != NONE; match = this->nodes_[match].dictionary)
+        {
+            const auto &node = this->nodes_[match];
+            for (auto p = node.phrasesBegin; p < node.phrasesEnd; p++)
+            {
+                auto phrase = this->phrases_[p];
+                if (!seen[phrase])
+                {
+                    seen[phrase] = true;
+                    found.push_back(phrase);
+                }
+            }
+        }
+    });
+
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+uint32_t PhraseMatcher::findEdge(uint32_t node, char16_t c) const
+{
+    auto begin = this->edges_.begin() + this->nodes_[node].edgesBegin;
+    auto end = this->edges_.begin() + this->nodes_[node].edgesEnd;
+    auto it = std::lower_bound(begin, end, c, [](const auto &edge, char16_t c) {
+        return edge.first < c;
+    });
+    if (it != end && it->first == c)
+    {
+        return it->second;
+    }
+    return NONE;
+}
+
+uint32_t PhraseMatcher::step(uint32_t node, char16_t c) const
+{
+    while (true)
+    {
+        auto next = this->findEdge(node, c);
+        if (next != NONE)
+        {
+            return next;
+        }
+        if (node == 0)
+        {
+            return 0;
+        }
+        node = this->nodes_[node].fail;
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// Finds the phrases of a list whose literal text occurs in a message, in a
+/// single pass over the message (Aho-Corasick).
+///
+/// The search is case-insensitive (using simple case folding) and doesn't
+/// look at word boundaries, so it finds a superset of the phrases that match.
+/// Callers verify the returned candidates with the phrase's exact matching
+/// rules. Phrases without a literal (e.g. regular expressions) are always
+/// candidates.
+///
+/// Phrases are indexed in the order they're added. After all phrases are
+/// added, build() has to be called before searching.
+class PhraseMatcher
+{
+public:
+    /// Adds a phrase that's a candidate if @a literal occurs in the text.
+    /// An empty literal makes the phrase a candidate for all texts.
+    void addLiteral(QStringView literal);
+    /// Adds a phrase that's a candidate for all texts
+    void addUnindexed();
+
+    /// Builds the search automaton from the added phrases
+    void build();
+
+    /// Returns the number of added phrases
+    size_t size() const;
+
+    /// Returns the (sorted) indices of the candidate phrases for @a text
+    std::vector<size_t> candidates(QStringView text) const;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        /// Range in `edges_`, sorted by character
+        uint32_t edgesBegin = 0;
+        uint32_t edgesEnd = 0;
+        /// The node of the longest proper suffix of this node's text
+        uint32_t fail = 0;
+        /// The nearest node in the failure chain that ends a literal
+        uint32_t dictionary = NONE;
+        /// Range in `phrases_` of the phrases whose literal ends here
+        uint32_t phrasesBegin = 0;
+        uint32_t phrasesEnd = 0;
+    };
+
+    uint32_t findEdge(uint32_t node, char16_t c) const;
+    uint32_t step(uint32_t node, char16_t c) const;
+
+    size_t phraseCount_ = 0;
+    std::vector<size_t> unindexed_;
+
+    // Used while adding phrases
+    std::vector<std::map<char16_t, uint32_t>> trie_{1};
+    std::vector<std::vector<uint32_t>> trieEnds_{1};
+
+    // Built automaton
+    std::vector<Node> nodes_;
+    std::vector<std::pair<char16_t, uint32_t>> edges_;
+    std::vector<uint32_t> phrases_;
+};
+
+}  // namespace chatterino
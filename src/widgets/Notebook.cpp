@@ -2,6 +2,8 @@
 
 #include "Application.hpp"
 #include "common/Args.hpp"
+#include "common/Channel.hpp"
+#include "common/network/NetworkRequest.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/hotkeys/HotkeyCategory.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
@@ -1614,6 +1616,16 @@ void SplitNotebook::select(QWidget *page, bool focusPage)
     }
 
     this->Notebook::select(page, focusPage);
+
+    // Channels of the new page might still be loading in the background
+    if (auto *selectedPage = this->getSelectedPage())
+    {
+        for (auto *split : selectedPage->getSplits())
+        {
+            raiseNetworkPriority(split->getChannel()->getName(),
+                                 NetworkPriority::High);
+        }
+    }
 }
 
 void SplitNotebook::forEachSplit(const std::function<void(Split *)> &cb)
@@ -55,6 +55,7 @@
 #include <QDebug>
 #include <QDesktopServices>
 #include <QEasingCurve>
+#include <QElapsedTimer>
 #include <QGestureEvent>
 #include <QGraphicsBlurEffect>
 #include <QJsonDocument>
@@ -69,6 +70,7 @@
 #include <cmath>
 #include <functional>
 #include <memory>
+#include <utility>
 
 namespace {
 
@@ -78,6 +80,11 @@ using namespace chatterino;
 
 constexpr int SCROLLBAR_PADDING = 8;
 
+/// Time a view may spend laying out off-screen messages per event loop
+/// iteration
+constexpr std::chrono::nanoseconds DEFERRED_LAYOUT_BUDGET =
+    std::chrono::milliseconds(2);
+
 void addEmoteContextMenuItems(QMenu *menu, const Emote &emote, QStringView kind)
 {
     auto *openAction = menu->addAction("&Open");
@@ -348,6 +355,12 @@ ChannelView::ChannelView(InternalCtor /*tag*/, QWidget *parent, Split *split,
         this->scrollUpdateRequested();
     });
 
+    this->deferredLayoutTimer_.setInterval(0);
+    QObject::connect(&this->deferredLayoutTimer_, &QTimer::timeout, this,
+                     [this] {
+                         this->deferredLayoutStep();
+                     });
+
     this->grabGesture(Qt::PanGesture);
 
     // TODO: Figure out if we need this, and if so, why
@@ -691,12 +704,38 @@ void ChannelView::performLayout(bool causedByScrollbar, bool causedByShow)
                                   !this->scrollBar_->isAtBottom());
 }
 
+MessageLayoutContext ChannelView::layoutContext() const
+{
+    return {
+        .messageColors = this->messageColors_,
+        .flags = this->getFlags(),
+        .width = this->getLayoutWidth(),
+        .scale = this->scale(),
+        .imageScale =
+            this->scale() * static_cast<float>(this->devicePixelRatio()),
+    };
+}
+
+bool ChannelView::layoutMessage(const MessageLayoutContext &ctx,
+                                const std::vector<MessageLayoutPtr> &messages,
+                                size_t index, bool shouldInvalidateBuffer)
+{
+    const auto &message = messages[index];
+    bool changed = message->layout(ctx, shouldInvalidateBuffer);
+
+    auto &heights = this->heightIndex();
+    if (index < heights.size())
+    {
+        heights.setHeight(index, message->getHeight());
+    }
+    return changed;
+}
+
 void ChannelView::layoutVisibleMessages(
     const std::vector<MessageLayoutPtr> &messages)
 {
     const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
-    const auto layoutWidth = this->getLayoutWidth();
-    const auto flags = this->getFlags();
+    const auto ctx = this->layoutContext();
     auto redrawRequired = false;
 
     if (messages.size() > start)
@@ -704,22 +743,15 @@ void ChannelView::layoutVisibleMessages(
         auto y = -(messages[start]->getHeight() *
                    (fmod(this->scrollBar_->getRelativeCurrentValue(), 1)));
 
-        for (auto i = start; i < messages.size() && y <= this->height(); i++)
+        // Only the viewport is laid out right away, the messages around it
+        // are laid out later by deferredLayoutStep()
+        const auto bottom = this->height();
+        for (auto i = start; i < messages.size() && y <= bottom; i++)
         {
-            const auto &message = messages[i];
-
-            redrawRequired |= message->layout(
-                {
-                    .messageColors = this->messageColors_,
-                    .flags = flags,
-                    .width = layoutWidth,
-                    .scale = this->scale(),
-                    .imageScale = this->scale() *
-                                  static_cast<float>(this->devicePixelRatio()),
-                },
-                this->bufferInvalidationQueued_);
+            redrawRequired |= this->layoutMessage(
+                ctx, messages, i, this->bufferInvalidationQueued_);
 
-            y += message->getHeight();
+            y += messages[i]->getHeight();
         }
         this->bufferInvalidationQueued_ = false;
     }
@@ -728,6 +760,79 @@ void ChannelView::layoutVisibleMessages(
     {
         this->queueUpdate();
     }
+
+    this->queueDeferredLayout();
+}
+
+void ChannelView::queueDeferredLayout()
+{
+    // Let a running pass finish first, otherwise a continuous resize would
+    // keep it from getting past the messages next to the viewport
+    this->deferredLayout_.progress.invalidate();
+    if (!this->deferredLayoutTimer_.isActive())
+    {
+        this->deferredLayoutTimer_.start();
+    }
+}
+
+void ChannelView::deferredLayoutStep()
+{
+    if (!this->isVisible())
+    {
+        this->deferredLayoutTimer_.stop();
+        return;
+    }
+
+    auto &state = this->deferredLayout_;
+    if (state.generation != this->messagesGeneration_ && !this->paused())
+    {
+        state.messages = this->getMessagesSnapshot();
+        state.generation = this->messagesGeneration_;
+    }
+
+    const auto &messages = state.messages;
+    const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
+    const auto ctx = this->layoutContext();
+    // The height index only matches our messages if the view didn't take a
+    // newer snapshot in the meantime
+    const auto updateHeights = state.generation == this->snapshotGeneration_;
+    auto layout = [&](size_t index) {
+        if (updateHeights)
+        {
+            this->layoutMessage(ctx, messages, index, false);
+        }
+        else
+        {
+            messages[index]->layout(ctx, false);
+        }
+        return messages[index]->getHeight();
+    };
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    while (std::chrono::nanoseconds(elapsed.nsecsElapsed()) <
+           DEFERRED_LAYOUT_BUDGET)
+    {
+        auto step =
+            state.progress.next(start, messages.size(), this->height());
+        if (!step)
+        {
+            this->deferredLayoutTimer_.stop();
+            return;
+        }
+
+        int belowHeight = 0;
+        int aboveHeight = 0;
+        if (step->below)
+        {
+            belowHeight = layout(*step->below);
+        }
+        if (step->above)
+        {
+            aboveHeight = layout(*step->above);
+        }
+        state.progress.advance(belowHeight, aboveHeight);
+    }
 }
 
 void ChannelView::updateScrollbar(const std::vector<MessageLayoutPtr> &messages,
@@ -741,8 +846,7 @@ void ChannelView::updateScrollbar(const std::vector<MessageLayoutPtr> &messages,
 
     /// Layout the messages at the bottom
     qreal h = this->height() - 8;
-    auto flags = this->getFlags();
-    auto layoutWidth = this->getLayoutWidth();
+    const auto ctx = this->layoutContext();
     auto showScrollbar = false;
 
     // convert i to int since it checks >= 0
@@ -750,16 +854,7 @@ void ChannelView::updateScrollbar(const std::vector<MessageLayoutPtr> &messages,
     {
         auto *message = messages[i].get();
 
-        message->layout(
-            {
-                .messageColors = this->messageColors_,
-                .flags = flags,
-                .width = layoutWidth,
-                .scale = this->scale(),
-                .imageScale = this->scale() *
-                              static_cast<float>(this->devicePixelRatio()),
-            },
-            false);
+        this->layoutMessage(ctx, messages, size_t(i), false);
 
         h -= message->getHeight();
 
@@ -798,6 +893,8 @@ void ChannelView::clearMessages()
 {
     // Clear all stored messages in this chat widget
     this->messages_.clear();
+    this->messagesGeneration_++;
+    this->pendingHeightChanges_.invalidated = true;
     this->scrollBar_->clearHighlights();
     this->scrollBar_->resetBounds();
     this->scrollBar_->setMaximum(0);
@@ -901,11 +998,154 @@ std::vector<MessageLayoutPtr> &ChannelView::getMessagesSnapshot()
     if (!this->paused() /*|| this->scrollBar_->isVisible()*/)
     {
         this->snapshot_ = this->messages_.getSnapshot();
+        this->snapshotGeneration_ = this->messagesGeneration_;
+
+        auto &changes = this->snapshotHeightChanges_;
+        changes.appended += this->pendingHeightChanges_.appended;
+        changes.trimmed += this->pendingHeightChanges_.trimmed;
+        changes.invalidated |= this->pendingHeightChanges_.invalidated;
+        this->pendingHeightChanges_ = {};
     }
 
     return this->snapshot_;
 }
 
+MessageHeightIndex &ChannelView::heightIndex()
+{
+    auto &index = this->heightIndex_;
+    if (this->heightIndexGeneration_ == this->snapshotGeneration_ &&
+        index.size() == this->snapshot_.size())
+    {
+        return index;
+    }
+
+    // Usually messages were only added at the end and trimmed at the start
+    auto changes = std::exchange(this->snapshotHeightChanges_, {});
+    if (this->heightIndexGeneration_ && !changes.invalidated &&
+        changes.trimmed <= index.size() &&
+        index.size() - changes.trimmed + changes.appended ==
+            this->snapshot_.size())
+    {
+        index.popFront(changes.trimmed);
+
+        auto estimate =
+            index.empty()
+                ? int(20 * this->scale())
+                : int(index.totalHeight() / int64_t(index.size()));
+        for (auto i = this->snapshot_.size() - changes.appended;
+             i < this->snapshot_.size(); i++)
+        {
+            auto height = this->snapshot_[i]->getHeight();
+            index.pushBack(height > 0 ? height : estimate);
+        }
+        this->heightIndexGeneration_ = this->snapshotGeneration_;
+
+        return index;
+    }
+
+    // Messages that weren't laid out yet get the average height of the
+    // others
+    int64_t knownHeight = 0;
+    size_t knownCount = 0;
+    for (const auto &message : this->snapshot_)
+    {
+        if (message->getHeight() > 0)
+        {
+            knownHeight += message->getHeight();
+            knownCount++;
+        }
+    }
+    auto estimate = knownCount > 0 ? int(knownHeight / int64_t(knownCount))
+                                   : int(20 * this->scale());
+
+    std::vector<int> heights;
+    heights.reserve(this->snapshot_.size());
+    for (const auto &message : this->snapshot_)
+    {
+        auto height = message->getHeight();
+        heights.push_back(height > 0 ? height : estimate);
+    }
+    this->heightIndex_.assign(std::move(heights));
+    this->heightIndexGeneration_ = this->snapshotGeneration_;
+
+    return this->heightIndex_;
+}
+
+qreal ChannelView::scrollPositionToPixels(qreal position)
+{
+    auto &heights = this->heightIndex();
+    if (heights.empty() || position <= 0)
+    {
+        return 0;
+    }
+
+    auto index = size_t(position);
+    if (index >= heights.size())
+    {
+        return qreal(heights.totalHeight());
+    }
+    return qreal(heights.offsetOf(index)) +
+           (position - qreal(index)) * heights.height(index);
+}
+
+qreal ChannelView::pixelsToScrollPosition(qreal pixels)
+{
+    auto &heights = this->heightIndex();
+    if (heights.empty() || pixels <= 0)
+    {
+        return 0;
+    }
+
+    auto index = heights.indexAt(int64_t(pixels));
+    if (index >= heights.size())
+    {
+        return qreal(heights.size());
+    }
+    return qreal(index) + ((pixels - qreal(heights.offsetOf(index))) /
+                           std::max(1, heights.height(index)));
+}
+
+qreal ChannelView::offsetScrollPosition(qreal position, qreal pixels)
+{
+    const auto &messages = this->getMessagesSnapshot();
+    if (messages.empty())
+    {
+        return 0;
+    }
+
+    const auto ctx = this->layoutContext();
+    auto target = position;
+
+    // The heights of messages that weren't laid out yet are estimates, so
+    // lay out the messages we scroll over and compute the target again. This
+    // usually settles after the first pass.
+    std::optional<std::pair<size_t, size_t>> laidOut;
+    for (int pass = 0; pass < 3; pass++)
+    {
+        target = this->pixelsToScrollPosition(
+            this->scrollPositionToPixels(position) + pixels);
+
+        auto first = size_t(std::min(position, target));
+        auto last = std::min(size_t(std::max(position, target)),
+                             messages.size() - 1);
+        if (laidOut && first >= laidOut->first && last <= laidOut->second)
+        {
+            break;
+        }
+
+        for (auto i = first; i <= last; i++)
+        {
+            this->layoutMessage(ctx, messages, i, false);
+        }
+        laidOut = {
+            std::min(first, laidOut ? laidOut->first : first),
+            std::max(last, laidOut ? laidOut->second : last),
+        };
+    }
+
+    return target;
+}
+
 ChannelPtr ChannelView::channel() const
 {
     assert(this->channel_ != nullptr);
@@ -1040,6 +1280,8 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
         }
     }
 
+    this->messagesGeneration_++;
+    this->pendingHeightChanges_.invalidated = true;
     this->scrollBar_->setMaximum(
         static_cast<qreal>(std::min(nMessagesAdded, this->messages_.limit())));
 
@@ -1186,8 +1428,11 @@ void ChannelView::messageAppended(MessagePtr &message,
         this->scrollBar_->offsetMaximum(1);
     }
 
+    this->messagesGeneration_++;
+    this->pendingHeightChanges_.appended++;
     if (this->messages_.pushBack(messageRef))
     {
+        this->pendingHeightChanges_.trimmed++;
         if (this->paused())
         {
             this->pauseScrollMinimumOffset_++;
@@ -1255,6 +1500,8 @@ void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
 
     /// Add the messages at the start
     auto addedMessages = this->messages_.pushFront(messageRefs);
+    this->messagesGeneration_++;
+    this->pendingHeightChanges_.invalidated = true;
     if (!addedMessages.empty())
     {
         if (this->scrollBar_->isAtBottom())
@@ -1306,6 +1553,8 @@ void ChannelView::messageReplaced(size_t hint, const MessagePtr &prev,
                                        replacement->getScrollBarHighlight());
 
     this->messages_.replaceItem(index, newItem);
+    this->messagesGeneration_++;
+    this->pendingHeightChanges_.invalidated = true;
     this->queueLayout();
 }
 
@@ -1314,6 +1563,8 @@ void ChannelView::messagesUpdated()
     auto snapshot = this->channel_->getMessageSnapshot();
 
     this->messages_.clear();
+    this->messagesGeneration_++;
+    this->pendingHeightChanges_.invalidated = true;
     this->scrollBar_->clearHighlights();
     this->scrollBar_->resetBounds();
     this->scrollBar_->setMaximum(qreal(snapshot.size()));
@@ -1765,100 +2016,18 @@ void ChannelView::wheelEvent(QWheelEvent *event)
     {
         float mouseMultiplier = getSettings()->mouseScrollMultiplier;
 
-        // This ensures snapshot won't be indexed out of bounds when scrolling really fast
-        qreal desired = std::max<qreal>(0, this->scrollBar_->getDesiredValue());
         qreal delta = event->angleDelta().y() * qreal(1.5) * mouseMultiplier;
 
         auto &snapshot = this->getMessagesSnapshot();
-        int snapshotLength = int(snapshot.size());
-        int i = std::min<int>(int(desired - this->scrollBar_->getMinimum()),
-                              snapshotLength - 1);
-
-        if (delta > 0)
-        {
-            qreal scrollFactor = fmod(desired, 1);
-            qreal currentScrollLeft = std::max<qreal>(
-                0.01, int(scrollFactor * snapshot[i]->getHeight()));
-
-            for (; i >= 0; i--)
-            {
-                if (delta < currentScrollLeft)
-                {
-                    desired -= scrollFactor * (delta / currentScrollLeft);
-                    break;
-                }
-                else
-                {
-                    delta -= currentScrollLeft;
-                    desired -= scrollFactor;
-                }
+        auto minimum = this->scrollBar_->getMinimum();
 
-                if (i == 0)
-                {
-                    desired = 0;
-                }
-                else
-                {
-                    snapshot[i - 1]->layout(
-                        {
-                            .messageColors = this->messageColors_,
-                            .flags = this->getFlags(),
-                            .width = this->getLayoutWidth(),
-                            .scale = this->scale(),
-                            .imageScale =
-                                this->scale() *
-                                static_cast<float>(this->devicePixelRatio()),
-                        },
-                        false);
-                    scrollFactor = 1;
-                    currentScrollLeft = snapshot[i - 1]->getHeight();
-                }
-            }
-        }
-        else
-        {
-            delta = -delta;
-            qreal scrollFactor = 1 - fmod(desired, 1);
-            qreal currentScrollLeft = std::max<qreal>(
-                0.01, int(scrollFactor * snapshot[i]->getHeight()));
+        // This ensures snapshot won't be indexed out of bounds when scrolling really fast
+        auto position =
+            std::clamp<qreal>(this->scrollBar_->getDesiredValue() - minimum, 0,
+                              qreal(snapshot.size()));
 
-            for (; i < snapshotLength; i++)
-            {
-                if (delta < currentScrollLeft)
-                {
-                    desired +=
-                        scrollFactor * (qreal(delta) / currentScrollLeft);
-                    break;
-                }
-                else
-                {
-                    delta -= currentScrollLeft;
-                    desired += scrollFactor;
-                }
-
-                if (i == snapshotLength - 1)
-                {
-                    desired = snapshot.size();
-                }
-                else
-                {
-                    snapshot[i + 1]->layout(
-                        {
-                            .messageColors = this->messageColors_,
-                            .flags = this->getFlags(),
-                            .width = this->getLayoutWidth(),
-                            .scale = this->scale(),
-                            .imageScale =
-                                this->scale() *
-                                static_cast<float>(this->devicePixelRatio()),
-                        },
-                        false);
-
-                    scrollFactor = 1;
-                    currentScrollLeft = snapshot[i + 1]->getHeight();
-                }
-            }
-        }
+        // Scrolling up (positive delta) moves towards the first message
+        qreal desired = minimum + this->offsetScrollPosition(position, -delta);
 
         this->scrollBar_->setDesiredValue(desired, true);
     }
@@ -2958,6 +3127,10 @@ void ChannelView::mouseDoubleClickEvent(QMouseEvent *event)
 
 void ChannelView::hideEvent(QHideEvent * /*event*/)
 {
+    this->deferredLayoutTimer_.stop();
+    this->deferredLayout_.messages.clear();
+    this->deferredLayout_.generation.reset();
+
     for (const auto &layout : this->messagesOnScreen_)
     {
         layout->deleteBuffer();
@@ -3181,25 +3354,21 @@ bool ChannelView::tryGetMessageAt(QPointF p,
         return false;
     }
 
-    qreal y = -(messagesSnapshot[start]->getHeight() *
-                (fmod(this->scrollBar_->getRelativeCurrentValue(), 1)));
-
-    for (size_t i = start; i < messagesSnapshot.size(); ++i)
+    // Offset of the point from the top of the first message
+    auto &heights = this->heightIndex();
+    auto y = this->scrollPositionToPixels(
+                 this->scrollBar_->getRelativeCurrentValue()) +
+             p.y();
+    auto i = heights.indexAt(int64_t(std::floor(y)));
+    if (i < start || i >= messagesSnapshot.size())
     {
-        auto message = messagesSnapshot[i];
-
-        if (p.y() < y + message->getHeight())
-        {
-            relativePos = QPointF(p.x(), p.y() - y);
-            _message = message;
-            index = i;
-            return true;
-        }
-
-        y += message->getHeight();
+        return false;
     }
 
-    return false;
+    relativePos = QPointF(p.x(), y - qreal(heights.offsetOf(i)));
+    _message = messagesSnapshot[i];
+    index = int(i);
+    return true;
 }
 
 int ChannelView::getLayoutWidth() const
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "common/FlagsEnum.hpp"
+#include "messages/layouts/IdleLayout.hpp"
+#include "messages/layouts/MessageHeightIndex.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/MessageFlag.hpp"
@@ -285,10 +287,32 @@ private:
 
     void performLayout(bool causedByScrollbar = false,
                        bool causedByShow = false);
+    MessageLayoutContext layoutContext() const;
+    /// Lays out `messages[index]` and updates its height in the height index
+    bool layoutMessage(const MessageLayoutContext &ctx,
+                       const std::vector<MessageLayoutPtr> &messages,
+                       size_t index, bool shouldInvalidateBuffer);
     void layoutVisibleMessages(const std::vector<MessageLayoutPtr> &messages);
+    /// Lays out the messages around the viewport later, while the event loop
+    /// is idle
+    void queueDeferredLayout();
+    /// Lays out off-screen messages on the GUI thread until the time budget
+    /// of one event loop iteration is used up
+    void deferredLayoutStep();
     void updateScrollbar(const std::vector<MessageLayoutPtr> &messages,
                          bool causedByScrollbar, bool causedByShow);
 
+    /// Returns the height index of the messages snapshot, rebuilding it if
+    /// the messages changed since it was built.
+    MessageHeightIndex &heightIndex();
+    /// Converts a scroll position (relative to the scrollbar's minimum) to an
+    /// offset in pixels from the top of the first message
+    qreal scrollPositionToPixels(qreal position);
+    qreal pixelsToScrollPosition(qreal pixels);
+    /// Returns the scroll position that's @a pixels below @a position. The
+    /// messages in between are laid out to get their exact height.
+    qreal offsetScrollPosition(qreal position, qreal pixels);
+
     void drawMessages(QPainter &painter, const QRect &area);
     void setSelection(const SelectionItem &start, const SelectionItem &end);
     void setSelection(const Selection &newSelection);
@@ -354,6 +378,44 @@ private:
     ThreadGuard snapshotGuard_;
     std::vector<MessageLayoutPtr> snapshot_;
 
+    /// Prefix sums of the heights of the messages in `snapshot_`. Messages
+    /// that weren't laid out yet use an estimated height.
+    MessageHeightIndex heightIndex_;
+    /// Incremented every time `messages_` changes
+    size_t messagesGeneration_ = 0;
+    /// The value of `messagesGeneration_` when `snapshot_` was taken
+    size_t snapshotGeneration_ = 0;
+    /// The value of `snapshotGeneration_` when `heightIndex_` was updated
+    std::optional<size_t> heightIndexGeneration_;
+    /// Changes to `messages_` that weren't applied to `heightIndex_` yet
+    struct HeightIndexChanges {
+        /// Messages added at the end
+        size_t appended = 0;
+        /// Messages removed from the start
+        size_t trimmed = 0;
+        /// Set if the index has to be rebuilt (e.g. messages were added at
+        /// the start or replaced)
+        bool invalidated = false;
+    };
+    /// Changes since `snapshot_` was taken
+    HeightIndexChanges pendingHeightChanges_;
+    /// Changes up to the time `snapshot_` was taken
+    HeightIndexChanges snapshotHeightChanges_;
+
+    /// Defers laying out off-screen messages to small steps on the GUI
+    /// thread, so resizing or changing the scale only has to wait for the
+    /// visible messages. Messages that weren't laid out again are laid out
+    /// once they become visible.
+    QTimer deferredLayoutTimer_;
+    struct {
+        IdleLayout progress;
+        /// The messages that are laid out. Only taken again once the
+        /// messages of this view changed.
+        std::vector<MessageLayoutPtr> messages;
+        /// The value of `messagesGeneration_` when `messages` was taken
+        std::optional<size_t> generation;
+    } deferredLayout_;
+
     /// @brief The backing (internal) channel
     ///
     /// This is a "virtual" channel where all filtered messages from
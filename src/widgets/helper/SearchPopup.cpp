@@ -23,44 +23,25 @@
 #include <QLineEdit>
 #include <QPushButton>
 
+#include <algorithm>
+
 namespace chatterino {
 
-ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const std::vector<MessagePtr> &snapshot)
+MessageSearch::Matcher SearchPopup::makeMatcher(const QString &text)
 {
-    ChannelPtr channel(new Channel(channelName, Channel::Type::None));
-
     // Parse predicates from tags in "text"
-    auto predicates = parsePredicates(text);
-
-    // Check for every message whether it fulfills all predicates that have
-    // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
-    {
-        MessagePtr message = snapshot[i];
-
-        bool accept = true;
-        for (const auto &pred : predicates)
-        {
-            // Discard the message as soon as one predicate fails
-            if (!pred->appliesTo(*message))
-            {
-                accept = false;
-                break;
-            }
-        }
-
-        // If all predicates match, add the message to the channel
-        if (accept)
-        {
-            auto overrideFlags = std::optional<MessageFlags>(message->flags);
-            overrideFlags->set(MessageFlag::DoNotLog);
-
-            channel->addMessage(message, MessageContext::Repost, overrideFlags);
-        }
-    }
-
-    return channel;
+    auto predicates =
+        std::make_shared<std::vector<std::unique_ptr<MessagePredicate>>>(
+            parsePredicates(text));
+
+    // Check whether the message fulfills all predicates that have been
+    // registered
+    return [predicates](const Message &message, MessageFlags flags) {
+        // Discard the message as soon as one predicate fails
+        return std::ranges::all_of(*predicates, [&](const auto &pred) {
+            return pred->appliesTo(message, flags);
+        });
+    };
 }
 
 SearchPopup::SearchPopup(QWidget *parent, Split *split)
@@ -224,13 +205,33 @@ void SearchPopup::themeChangedEvent()
 
 void SearchPopup::search()
 {
-    if (this->snapshot_.size() == 0)
+    if (!this->snapshot_ || this->snapshot_->empty())
     {
-        this->snapshot_ = this->buildSnapshot();
+        this->snapshot_ = std::make_shared<const std::vector<MessagePtr>>(
+            this->buildSnapshot());
     }
 
-    this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_));
+    ChannelPtr channel(new Channel(this->channelName_, Channel::Type::None));
+    this->channelView_->setChannel(channel);
+
+    // Matching happens on worker threads, results are added in batches as
+    // they come in. Starting a new search cancels the previous one.
+    this->searchToken_ = MessageSearch::start(
+        this->snapshot_,
+        [text = this->searchInput_->text()] {
+            return makeMatcher(text);
+        },
+        [channel](const std::vector<MessagePtr> &batch) {
+            for (const auto &message : batch)
+            {
+                auto overrideFlags =
+                    std::optional<MessageFlags>(message->flags);
+                overrideFlags->set(MessageFlag::DoNotLog);
+
+                channel->addMessage(message, MessageContext::Repost,
+                                    overrideFlags);
+            }
+        });
 }
 
 std::vector<MessagePtr> SearchPopup::buildSnapshot()
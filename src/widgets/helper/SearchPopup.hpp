@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ForwardDecl.hpp"
+#include "messages/search/MessageSearch.hpp"
+#include "util/CancellationToken.hpp"
 #include "widgets/BasePopup.hpp"
 
 #include <memory>
@@ -40,19 +42,15 @@ private:
     std::vector<MessagePtr> buildSnapshot();
 
     /**
-     * @brief Only retains those message from a list of messages that satisfy a
-     *        search query.
+     * @brief Creates a matcher that only accepts messages satisfying a search
+     *        query.
      *
-     * @param text          the search query -- will be parsed for MessagePredicates
-     * @param channelName   name of the channel to be returned
-     * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
+     * Every call parses the query again, so the returned matchers don't
+     * share any state and can be used from different threads.
      *
-     * @return a ChannelPtr with "channelName" and the filtered messages from
-     *         "snapshot"
+     * @param text the search query -- will be parsed for MessagePredicates
      */
-    static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const std::vector<MessagePtr> &snapshot);
+    static MessageSearch::Matcher makeMatcher(const QString &text);
 
     /**
      * @brief Checks the input for tags and registers their corresponding
@@ -64,7 +62,9 @@ private:
     static std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
         const QString &input);
 
-    std::vector<MessagePtr> snapshot_;
+    std::shared_ptr<const std::vector<MessagePtr>> snapshot_;
+    /// Cancels the running search
+    ScopedCancellationToken searchToken_;
     QLineEdit *searchInput_{};
     ChannelView *channelView_{};
     QString channelName_{};
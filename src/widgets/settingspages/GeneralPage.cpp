@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "common/Literals.hpp"  // IWYU pragma: keep
+#include "common/network/NetworkCache.hpp"
 #include "common/Version.hpp"
 #include "controllers/hotkeys/HotkeyCategory.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
@@ -972,11 +973,12 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                 "take longer to load next time Chatterino is started.",
                 QMessageBox::Yes | QMessageBox::No);
 
-            if (reply == QMessageBox::Yes)
+            auto cache = NetworkCache::global();
+            if (reply == QMessageBox::Yes && cache)
             {
-                auto cacheDir = QDir(getApp()->getPaths().cacheDirectory());
-                cacheDir.removeRecursively();
-                cacheDir.mkdir(getApp()->getPaths().cacheDirectory());
+                NetworkCache::run([cache] {
+                    cache->clear();
+                });
             }
         }));
         box->addStretch(1);
@@ -984,6 +986,16 @@ void GeneralPage::initLayout(GeneralPageView &layout)
         layout.addLayout(box);
     }
 
+    SettingWidget::intInput("Maximum cache size (MB)", s.cacheMaxSize,
+                            {
+                                .min = 64,
+                                .max = 64 * 1024,
+                                .singleStep = 64,
+                            })
+        ->setTooltip("When the cache grows larger than this, the files that "
+                     "weren't used for the longest time are removed.")
+        ->addTo(layout);
+
     layout.addTitle("Advanced");
 
     layout.addSubtitle("Chat title");
@@ -185,6 +185,15 @@ ModerationPage::ModerationPage()
             ->conditionallyEnabledBy(getSettings()->enableLogging)
             ->addToLayout(logs->layout());
 
+        SettingWidget::checkbox("Index logs for searching",
+                                getSettings()->enableLogIndex)
+            ->setTooltip(
+                "Keep a search index next to the log files, so old messages "
+                "can be searched quickly.\nThe index is built in the "
+                "background and takes up some additional disk space.")
+            ->conditionallyEnabledBy(getSettings()->enableLogging)
+            ->addToLayout(logs->layout());
+
         QCheckBox *onlyLogListedChannels =
             this->createCheckBox("Only log channels listed below",
                                  getSettings()->onlyLogListedChannels);
@@ -0,0 +1,239 @@
+#include "util/BatchedLookup.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Lookup = BatchedLookup<int>;
+
+/// Records the requests of a lookup, so they can be answered later
+struct FakeFetch {
+    struct Request {
+        QStringList keys;
+        std::function<void(Lookup::Results)> onSuccess;
+        std::function<void(Lookup::FetchError)> onFailure;
+    };
+
+    Lookup::Fetch fetch()
+    {
+        return [this](const auto &keys, auto onSuccess, auto onFailure) {
+            this->requests.push_back({
+                .keys = keys,
+                .onSuccess = std::move(onSuccess),
+                .onFailure = std::move(onFailure),
+            });
+        };
+    }
+
+    std::vector<Request> requests;
+};
+
+/// Collects the results for one key
+struct Result {
+    Lookup::Callback callback()
+    {
+        return [this](const auto &value) {
+            this->values.push_back(value);
+        };
+    }
+
+    Lookup::FailureCallback onFailure()
+    {
+        return [this] {
+            this->failures++;
+        };
+    }
+
+    std::vector<std::optional<int>> values;
+    int failures = 0;
+};
+
+}  // namespace
+
+TEST(BatchedLookup, Coalesce)
+{
+    FakeFetch fake;
+    Lookup lookup(fake.fetch(), 50ms, 1h);
+
+    Result first;
+    Result second;
+    Result missing;
+    lookup.get("1", first.callback());
+    lookup.get("2", missing.callback());
+    lookup.get("1", second.callback());
+    ASSERT_TRUE(fake.requests.empty());
+
+    lookup.flush();
+    ASSERT_EQ(fake.requests.size(), 1U);
+    ASSERT_EQ(fake.requests[0].keys, (QStringList{"1", "2"}));
+
+    fake.requests[0].onSuccess({{"1", 42}});
+    ASSERT_EQ(first.values, (std::vector<std::optional<int>>{42}));
+    ASSERT_EQ(second.values, (std::vector<std::optional<int>>{42}));
+    ASSERT_EQ(missing.values, (std::vector<std::optional<int>>{std::nullopt}));
+
+    // both are cached now
+    Result cached;
+    lookup.get("1", cached.callback());
+    lookup.get("2", cached.callback());
+    ASSERT_EQ(cached.values,
+              (std::vector<std::optional<int>>{42, std::nullopt}));
+
+    lookup.flush();
+    ASSERT_EQ(fake.requests.size(), 1U);
+}
+
+TEST(BatchedLookup, Batches)
+{
+    FakeFetch fake;
+    Lookup lookup(fake.fetch(), 50ms, 1h);
+
+    Result result;
+    for (int i = 0; i < 250; i++)
+    {
+        lookup.get(QString::number(i), result.callback());
+    }
+    // full batches are sent right away
+    ASSERT_EQ(fake.requests.size(), 2U);
+
+    lookup.flush();
+    ASSERT_EQ(fake.requests.size(), 3U);
+    ASSERT_EQ(fake.requests[0].keys.size(), Lookup::BATCH_SIZE);
+    ASSERT_EQ(fake.requests[1].keys.size(), Lookup::BATCH_SIZE);
+    ASSERT_EQ(fake.requests[2].keys.size(), 50);
+    ASSERT_EQ(fake.requests[2].keys.back(), "249");
+
+    for (auto &request : fake.requests)
+    {
+        Lookup::Results results;
+        for (const auto &key : request.keys)
+        {
+            results.emplace_back(key, key.toInt());
+        }
+        request.onSuccess(std::move(results));
+    }
+    ASSERT_EQ(result.values.size(), 250U);
+    ASSERT_EQ(result.values[249], 249);
+}
+
+TEST(BatchedLookup, Failure)
+{
+    FakeFetch fake;
+    Lookup lookup(fake.fetch(), 50ms, 1h);
+
+    Result result;
+    lookup.get("1", result.callback(), result.onFailure());
+    lookup.get("1", result.callback());
+    lookup.flush();
+    fake.requests[0].onFailure(Lookup::FetchError::Failed);
+    ASSERT_EQ(result.failures, 1);
+    ASSERT_TRUE(result.values.empty());
+
+    // failures aren't cached
+    lookup.get("1", result.callback(), result.onFailure());
+    lookup.flush();
+    ASSERT_EQ(fake.requests.size(), 2U);
+    fake.requests[1].onSuccess({{"1", 1}});
+    ASSERT_EQ(result.values, (std::vector<std::optional<int>>{1}));
+}
+
+TEST(BatchedLookup, Expiry)
+{
+    FakeFetch fake;
+    Lookup lookup(fake.fetch(), 50ms, 0ms);
+
+    Result result;
+    lookup.get("1", result.callback());
+    lookup.flush();
+    fake.requests[0].onSuccess({{"1", 1}});
+
+    lookup.get("1", result.callback());
+    lookup.flush();
+    ASSERT_EQ(fake.requests.size(), 2U);
+    fake.requests[1].onSuccess({{"1", 2}});
+    ASSERT_EQ(result.values, (std::vector<std::optional<int>>{1, 2}));
+}
+
+TEST(BatchedLookup, Store)
+{
+    FakeFetch fake;
+    Lookup lookup(fake.fetch(), 50ms, 1h);
+
+    lookup.store("1", 1);
+    Result result;
+    lookup.get("1", result.callback());
+    ASSERT_EQ(result.values, (std::vector<std::optional<int>>{1}));
+
+    // values for keys that weren't requested are cached as well
+    lookup.get("2", result.callback());
+    lookup.flush();
+    fake.requests[0].onSuccess({{"2", 2}, {"3", 3}});
+    lookup.get("3", result.callback());
+    ASSERT_EQ(result.values, (std::vector<std::optional<int>>{1, 2, 3}));
+    ASSERT_EQ(fake.requests.size(), 1U);
+}
+
+TEST(BatchedLookup, Destroyed)
+{
+    FakeFetch fake;
+    Result result;
+    {
+        Lookup lookup(fake.fetch(), 50ms, 1h);
+        lookup.get("1", result.callback(), result.onFailure());
+        lookup.flush();
+    }
+
+    fake.requests[0].onSuccess({{"1", 1}});
+    fake.requests[0].onFailure(Lookup::FetchError::Failed);
+    ASSERT_TRUE(result.values.empty());
+    ASSERT_EQ(result.failures, 0);
+}
+
+TEST(BatchedLookup, Rejected)
+{
+    FakeFetch fake;
+    Lookup lookup(fake.fetch(), 50ms, 1h);
+
+    Result good;
+    Result bad;
+    for (const auto *key : {"1", "2", "3"})
+    {
+        lookup.get(key, good.callback(), good.onFailure());
+    }
+    lookup.get("bad", bad.callback(), bad.onFailure());
+    lookup.flush();
+    ASSERT_EQ(fake.requests.size(), 1U);
+
+    // the batch is split until the rejected key is found
+    fake.requests[0].onFailure(Lookup::FetchError::Rejected);
+    ASSERT_EQ(fake.requests.size(), 3U);
+    ASSERT_EQ(fake.requests[1].keys, (QStringList{"1", "2"}));
+    ASSERT_EQ(fake.requests[2].keys, (QStringList{"3", "bad"}));
+
+    fake.requests[1].onSuccess({{"1", 1}, {"2", 2}});
+    fake.requests[2].onFailure(Lookup::FetchError::Rejected);
+    ASSERT_EQ(fake.requests.size(), 5U);
+    ASSERT_EQ(fake.requests[3].keys, (QStringList{"3"}));
+    ASSERT_EQ(fake.requests[4].keys, (QStringList{"bad"}));
+
+    fake.requests[3].onSuccess({{"3", 3}});
+    fake.requests[4].onFailure(Lookup::FetchError::Rejected);
+    ASSERT_EQ(fake.requests.size(), 5U);
+
+    ASSERT_EQ(good.values, (std::vector<std::optional<int>>{1, 2, 3}));
+    ASSERT_EQ(good.failures, 0);
+    ASSERT_TRUE(bad.values.empty());
+    ASSERT_EQ(bad.failures, 1);
+
+    // other failures aren't split
+    Result failed;
+    lookup.get("4", failed.callback(), failed.onFailure());
+    lookup.get("5", failed.callback(), failed.onFailure());
+    lookup.flush();
+    fake.requests[5].onFailure(Lookup::FetchError::Failed);
+    ASSERT_EQ(fake.requests.size(), 6U);
+    ASSERT_EQ(failed.failures, 2);
+}
@@ -0,0 +1,48 @@
+#include "util/BumpArena.hpp"
+
+#include "Test.hpp"
+
+#include <cstdint>
+
+using namespace chatterino;
+
+TEST(BumpArena, Alignment)
+{
+    BumpArena arena;
+    for (size_t alignment : {1, 2, 4, 8, 16, 32})
+    {
+        auto *ptr = arena.allocate(3, alignment);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0U);
+    }
+
+    auto *big = arena.allocate(BumpArena::INITIAL_BLOCK_SIZE * 3, 8);
+    ASSERT_NE(big, nullptr);
+    ASSERT_EQ(arena.blockCount(), 2U);
+}
+
+TEST(BumpArena, Reuse)
+{
+    BumpArena arena;
+    auto *first = arena.create<int>(1);
+    ASSERT_EQ(*first, 1);
+    arena.reset();
+    auto *second = arena.create<int>(2);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(arena.blockCount(), 1U);
+
+    // blocks of a pass are merged into one on reset
+    for (size_t i = 0; i < BumpArena::INITIAL_BLOCK_SIZE; i++)
+    {
+        arena.create<int64_t>(static_cast<int64_t>(i));
+    }
+    ASSERT_GT(arena.blockCount(), 1U);
+    arena.reset();
+    ASSERT_EQ(arena.blockCount(), 1U);
+    ASSERT_GE(arena.capacity(), BumpArena::INITIAL_BLOCK_SIZE * 8);
+
+    for (size_t i = 0; i < BumpArena::INITIAL_BLOCK_SIZE; i++)
+    {
+        arena.create<int64_t>(static_cast<int64_t>(i));
+    }
+    ASSERT_EQ(arena.blockCount(), 1U);
+}
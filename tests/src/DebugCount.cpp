@@ -0,0 +1,73 @@
+#include "util/DebugCount.hpp"
+
+#include "Test.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(DebugCount, Counter)
+{
+    auto counter = DebugCount::counter("test counter");
+    EXPECT_EQ(counter.value(), 0);
+
+    counter.increase();
+    counter.increase(5);
+    counter.decrease(2);
+    EXPECT_EQ(counter.value(), 4);
+
+    // registering the same name returns the same counter
+    EXPECT_EQ(DebugCount::counter("test counter").value(), 4);
+
+    counter.set(42);
+    EXPECT_EQ(counter.value(), 42);
+}
+
+TEST(DebugCount, StringAPI)
+{
+    auto counter = DebugCount::counter("test string api");
+
+    DebugCount::increase("test string api");
+    DebugCount::increase("test string api", 9);
+    counter.increase();
+    DebugCount::decrease("test string api", 3);
+    EXPECT_EQ(counter.value(), 8);
+
+    DebugCount::set("test string api", -1);
+    EXPECT_EQ(counter.value(), -1);
+}
+
+TEST(DebugCount, Threads)
+{
+    auto counter = DebugCount::counter("test threads");
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 16; i++)
+    {
+        threads.emplace_back([counter] {
+            for (int j = 0; j < 10000; j++)
+            {
+                counter.increase();
+            }
+            counter.decrease(5000);
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.value(), 16 * 5000);
+}
+
+TEST(DebugCount, DebugText)
+{
+    DebugCount::counter("test text bytes", DebugCount::Flag::DataSize)
+        .set(2048);
+    DebugCount::counter("test text count").set(1234);
+
+    auto text = DebugCount::getDebugText();
+    EXPECT_TRUE(text.contains("test text bytes: 2.00 KiB\n")) << text;
+    EXPECT_TRUE(text.contains("test text count: 1,234\n")) << text;
+}
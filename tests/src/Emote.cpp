@@ -0,0 +1,100 @@
+#include "messages/Emote.hpp"
+
+#include "messages/EmoteSnapshot.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+Emote makeEmote(const QString &name, const QString &tooltip)
+{
+    return {
+        .name = {name},
+        .tooltip = {tooltip},
+        .homePage = {"https://7tv.app/emotes/01F6MQ33FG000FFJ97ZB8MWV52"},
+        .id = {"01F6MQ33FG000FFJ97ZB8MWV52"},
+    };
+}
+
+}  // namespace
+
+TEST(Emote, Intern)
+{
+    EmoteId id{"01F6MQ33FG000FFJ97ZB8MWV52"};
+    auto first =
+        internEmote(EmoteProvider::Seventv, id, makeEmote("Clap", "Clap"));
+    auto second =
+        internEmote(EmoteProvider::Seventv, id, makeEmote("Clap", "Clap"));
+    ASSERT_EQ(first, second);
+
+    // providers and aliases get their own emote
+    auto bttv = internEmote(EmoteProvider::Bttv, id, makeEmote("Clap", "Clap"));
+    ASSERT_NE(first, bttv);
+    auto alias =
+        internEmote(EmoteProvider::Seventv, id, makeEmote("Clap2", "Clap"));
+    ASSERT_NE(first, alias);
+
+    // a changed emote replaces the old one
+    auto changed =
+        internEmote(EmoteProvider::Seventv, id, makeEmote("Clap", "Clap!"));
+    ASSERT_NE(first, changed);
+    ASSERT_EQ(changed->tooltip.string, "Clap!");
+    ASSERT_EQ(first->tooltip.string, "Clap");
+    auto again =
+        internEmote(EmoteProvider::Seventv, id, makeEmote("Clap", "Clap!"));
+    ASSERT_EQ(changed, again);
+}
+
+TEST(Emote, InternedKey)
+{
+    EmoteId id{"01F6MQ33FG000FFJ97ZB8MWV52"};
+    auto interned =
+        internEmote(EmoteProvider::Seventv, id, makeEmote("Clap", "Clap"));
+    auto key = internedKeyOf(interned);
+    ASSERT_TRUE(key.has_value());
+    ASSERT_EQ(key->provider, EmoteProvider::Seventv);
+    ASSERT_EQ(key->id, id);
+
+    auto plain = std::make_shared<const Emote>(makeEmote("Clap", "Clap"));
+    ASSERT_FALSE(internedKeyOf(plain).has_value());
+}
+
+TEST(Emote, InternSnapshotRoundTrip)
+{
+    mock::BaseApplication mockApplication;
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("emote-snapshot");
+
+    EmoteId id{"01F6MQ33FG000FFJ97ZB8MWV52"};
+    auto interned =
+        internEmote(EmoteProvider::Bttv, id, makeEmote("Clap", "Clap"));
+    auto plain = std::make_shared<const Emote>(makeEmote("Plain", "Plain"));
+
+    EmoteMap emotes;
+    emotes[interned->name] = interned;
+    emotes[plain->name] = plain;
+    {
+        EmoteSnapshot snapshot(path);
+        snapshot.setEmotes("11148817.betterttv", emotes);
+        snapshot.save();
+    }
+
+    EmoteSnapshot snapshot(path);
+    auto restored = snapshot.emotes("11148817.betterttv");
+    ASSERT_NE(restored, nullptr);
+    ASSERT_EQ(restored->size(), 2U);
+
+    // interned emotes resolve to the live instance
+    ASSERT_EQ(restored->at(interned->name), interned);
+
+    // other emotes are restored as separate instances
+    const auto &restoredPlain = restored->at(plain->name);
+    ASSERT_NE(restoredPlain, plain);
+    ASSERT_EQ(*restoredPlain, *plain);
+    ASSERT_FALSE(internedKeyOf(restoredPlain).has_value());
+}
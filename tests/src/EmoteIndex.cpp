@@ -0,0 +1,120 @@
+#include "controllers/completion/sources/EmoteIndex.hpp"
+
+#include "messages/Emote.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+using namespace chatterino::completion;
+
+namespace {
+
+std::vector<EmoteItem> makeItems(std::initializer_list<QString> names)
+{
+    std::vector<EmoteItem> items;
+    for (const auto &name : names)
+    {
+        items.push_back({.searchName = name, .tabCompletionName = name});
+    }
+    return items;
+}
+
+QStringList collect(const EmoteIndex &index, const QString &query)
+{
+    std::vector<EmoteItem> out;
+    index.collect(query.toCaseFolded(), out);
+
+    QStringList names;
+    for (const auto &item : out)
+    {
+        names.append(item.searchName);
+    }
+    return names;
+}
+
+void addEmote(EmoteMap &map, const QString &name)
+{
+    EmoteName eName{.string{name}};
+    map.insert({eName, std::make_shared<const Emote>(Emote{.name{eName}})});
+}
+
+}  // namespace
+
+TEST(EmoteIndex, Contains)
+{
+    EmoteIndex index(makeItems({
+        "pajaW",
+        "PAJAW",
+        "FeelsGoodMan",
+        "FeelsBadMan",
+        "Clap",
+        "Clap2",
+        ":tf:",
+        "manManMAN",
+    }));
+
+    ASSERT_EQ(index.items().size(), 8);
+
+    // items stay in their original order
+    ASSERT_EQ(collect(index, "paja"), (QStringList{"pajaW", "PAJAW"}));
+    ASSERT_EQ(collect(index, "JAw"), (QStringList{"pajaW", "PAJAW"}));
+    ASSERT_EQ(collect(index, "man"),
+              (QStringList{"FeelsGoodMan", "FeelsBadMan", "manManMAN"}));
+    ASSERT_EQ(collect(index, "clap"), (QStringList{"Clap", "Clap2"}));
+    ASSERT_EQ(collect(index, "2"), (QStringList{"Clap2"}));
+    ASSERT_EQ(collect(index, ":"), (QStringList{":tf:"}));
+    ASSERT_EQ(collect(index, "tf:"), (QStringList{":tf:"}));
+    ASSERT_EQ(collect(index, "FeelsGoodMan"), (QStringList{"FeelsGoodMan"}));
+
+    ASSERT_TRUE(collect(index, "FeelsGoodMann").isEmpty());
+    ASSERT_TRUE(collect(index, "forsen").isEmpty());
+    ASSERT_TRUE(collect(index, "~").isEmpty());
+}
+
+TEST(EmoteIndex, EmptyQuery)
+{
+    EmoteIndex index(makeItems({"b", "a", "c"}));
+    ASSERT_EQ(collect(index, ""), (QStringList{"b", "a", "c"}));
+
+    EmoteIndex empty({});
+    ASSERT_TRUE(collect(empty, "").isEmpty());
+    ASSERT_TRUE(collect(empty, "a").isEmpty());
+}
+
+TEST(EmoteIndex, Appends)
+{
+    EmoteIndex first(makeItems({"Clap", "Kappa"}));
+    EmoteIndex second(makeItems({"Clap2", "Keepo"}));
+
+    std::vector<EmoteItem> out;
+    first.collect(u"clap", out);
+    second.collect(u"clap", out);
+
+    ASSERT_EQ(out.size(), 2);
+    ASSERT_EQ(out[0].searchName, "Clap");
+    ASSERT_EQ(out[1].searchName, "Clap2");
+}
+
+TEST(EmoteIndex, CachedPerMap)
+{
+    auto map = std::make_shared<EmoteMap>();
+    addEmote(*map, "Kappa");
+    addEmote(*map, "Keepo");
+    std::shared_ptr<const EmoteMap> constMap = map;
+
+    auto index = EmoteIndex::forEmotes(constMap, "Channel 7TV");
+    ASSERT_EQ(index->items().size(), 2);
+    ASSERT_EQ(index->items()[0].providerName, "Channel 7TV");
+
+    // same snapshot, same index
+    ASSERT_EQ(EmoteIndex::forEmotes(constMap, "Channel 7TV"), index);
+    // different provider name
+    ASSERT_NE(EmoteIndex::forEmotes(constMap, "Global 7TV"), index);
+
+    // the emotes were replaced
+    auto newMap = std::make_shared<EmoteMap>(*map);
+    addEmote(*newMap, "Kappa123");
+    std::shared_ptr<const EmoteMap> constNewMap = newMap;
+    auto newIndex = EmoteIndex::forEmotes(constNewMap, "Channel 7TV");
+    ASSERT_NE(newIndex, index);
+    ASSERT_EQ(newIndex->items().size(), 3);
+}
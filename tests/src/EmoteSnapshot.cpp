@@ -0,0 +1,168 @@
+#include "messages/EmoteSnapshot.hpp"
+
+#include "messages/Image.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+EmotePtr makeEmote(const QString &name)
+{
+    return std::make_shared<const Emote>(Emote{
+        .name = {name},
+        .images =
+            ImageSet{
+                Image::fromUrl({"https://example.com/" % name % "/1x"}, 1,
+                               {28, 28}),
+                Image::fromUrl({"https://example.com/" % name % "/2x"}, 0.5,
+                               {56, 56}),
+            },
+        .tooltip = {name % "<br>Channel Emote"},
+        .homePage = {"https://example.com/" % name},
+        .zeroWidth = name.endsWith("W"),
+        .id = {name % "-id"},
+        .author = {"forsen"},
+        .baseName = name.startsWith("my")
+                        ? std::optional<EmoteName>({name.mid(2)})
+                        : std::nullopt,
+    });
+}
+
+EmoteMap makeEmotes()
+{
+    EmoteMap emotes;
+    for (const auto *name : {"Kappa", "myKappa", "SoSnowyW"})
+    {
+        auto emote = makeEmote(name);
+        emotes[emote->name] = emote;
+    }
+    return emotes;
+}
+
+class EmoteSnapshotTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(this->dir.isValid());
+        this->path = this->dir.filePath("emote-snapshot");
+    }
+
+    mock::BaseApplication mockApplication;
+    QTemporaryDir dir;
+    QString path;
+};
+
+}  // namespace
+
+TEST_F(EmoteSnapshotTest, RoundTrip)
+{
+    auto emotes = makeEmotes();
+    EmoteSnapshot::BadgeSets badges{
+        {"subscriber", {{"0", makeEmote("sub0")}, {"3", makeEmote("sub3")}}},
+        {"bits", {{"100", makeEmote("bits100")}}},
+    };
+
+    {
+        EmoteSnapshot snapshot(this->path);
+        ASSERT_EQ(snapshot.emotes("11148817.betterttv"), nullptr);
+        snapshot.setEmotes("11148817.betterttv", emotes);
+        snapshot.setEmotes("11148817.seventv", {});
+        snapshot.setBadgeSets("global.twitch-badges", badges);
+        snapshot.setBadgeSets("22484632.twitch-badges", {});
+        snapshot.save();
+    }
+
+    EmoteSnapshot snapshot(this->path);
+    auto loaded = snapshot.emotes("11148817.betterttv");
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->size(), emotes.size());
+    for (const auto &[name, emote] : emotes)
+    {
+        auto it = loaded->find(name);
+        ASSERT_NE(it, loaded->end());
+        ASSERT_EQ(*it->second, *emote);
+        ASSERT_EQ(it->second->id, emote->id);
+        ASSERT_EQ(it->second->author, emote->author);
+        ASSERT_EQ(it->second->zeroWidth, emote->zeroWidth);
+        ASSERT_EQ(it->second->baseName, emote->baseName);
+        ASSERT_EQ(it->second->images.getImage1()->expectedSize(),
+                  emote->images.getImage1()->expectedSize());
+    }
+
+    loaded = snapshot.emotes("11148817.seventv");
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_TRUE(loaded->empty());
+
+    auto loadedBadges = snapshot.badgeSets("global.twitch-badges");
+    ASSERT_TRUE(loadedBadges.has_value());
+    ASSERT_EQ(loadedBadges->size(), 2U);
+    ASSERT_EQ(loadedBadges->at("subscriber").size(), 2U);
+    ASSERT_EQ(*loadedBadges->at("bits").at("100"), *makeEmote("bits100"));
+    ASSERT_FALSE(snapshot.badgeSets("11148817.twitch-badges").has_value());
+
+    // empty entries are valid
+    loadedBadges = snapshot.badgeSets("22484632.twitch-badges");
+    ASSERT_TRUE(loadedBadges.has_value());
+    ASSERT_TRUE(loadedBadges->empty());
+
+    // entries that weren't read are kept when saving again
+    snapshot.setEmotes("22484632.frankerfacez", emotes);
+    snapshot.save();
+    snapshot.waitForSave();
+    EmoteSnapshot again(this->path);
+    ASSERT_NE(again.emotes("11148817.betterttv"), nullptr);
+    ASSERT_NE(again.emotes("22484632.frankerfacez"), nullptr);
+}
+
+TEST_F(EmoteSnapshotTest, Corrupted)
+{
+    {
+        EmoteSnapshot snapshot(this->path);
+        snapshot.setEmotes("11148817.betterttv", makeEmotes());
+        snapshot.save();
+    }
+
+    // flip the last byte, which belongs to the data of the entry
+    QFile file(this->path);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    auto data = file.readAll();
+    data.back() = static_cast<char>(data.back() ^ 0xff);
+    file.seek(0);
+    file.write(data);
+    file.close();
+
+    EmoteSnapshot snapshot(this->path);
+    ASSERT_EQ(snapshot.emotes("11148817.betterttv"), nullptr);
+
+    // garbage is ignored
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("CESN garbage");
+    file.close();
+    EmoteSnapshot garbage(this->path);
+    ASSERT_EQ(garbage.emotes("11148817.betterttv"), nullptr);
+}
+
+TEST_F(EmoteSnapshotTest, OtherVersion)
+{
+    {
+        EmoteSnapshot snapshot(this->path);
+        snapshot.setEmotes("11148817.betterttv", makeEmotes());
+        snapshot.save();
+    }
+
+    // the version follows the magic
+    QFile file(this->path);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.seek(4));
+    file.write(QByteArray(4, '\x7f'));
+    file.close();
+
+    EmoteSnapshot snapshot(this->path);
+    ASSERT_EQ(snapshot.emotes("11148817.betterttv"), nullptr);
+}
@@ -1,6 +1,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/filters/lang/expressions/UnaryOperation.hpp"
 #include "controllers/filters/lang/Filter.hpp"
+#include "controllers/filters/lang/MessageContext.hpp"
 #include "controllers/filters/lang/Types.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -297,6 +298,85 @@ TEST_F(FiltersF, TypingContextChecks)
     delete privmsg;
 }
 
+TEST_F(FiltersF, CompiledEvaluation)
+{
+    MockChannel channel("pajlada");
+
+    QByteArray message =
+        R"(@badge-info=subscriber/80;badges=broadcaster/1,subscriber/3072,partner/1;color=#CC44FF;display-name=pajlada;emote-only=1;emotes=25:0-4;first-msg=0;flags=;id=90ef1e46-8baa-4bf2-9c54-272f39d6fa11;mod=0;returning-chatter=0;room-id=11148817;subscriber=1;tmi-sent-ts=1662206235860;turbo=0;user-id=11148817;user-type= :pajlada!pajlada@pajlada.tmi.twitch.tv PRIVMSG #pajlada :Kappa)";
+
+    auto *privmsg = dynamic_cast<Communi::IrcPrivateMessage *>(
+        Communi::IrcPrivateMessage::fromData(message, nullptr));
+    ASSERT_NE(privmsg, nullptr);
+
+    auto [msg, alert] = MessageBuilder::makeIrcMessage(
+        &channel, privmsg, MessageParseArgs{}, privmsg->content(), 0);
+    ASSERT_NE(msg.get(), nullptr);
+    delete privmsg;
+
+    struct TestCase {
+        QString input;
+        QVariant output;
+    };
+
+    // clang-format off
+    std::vector<TestCase> tests{
+        {R".(author.name == "PAJLADA").", QVariant(true)},
+        {R".(author.name != "forsen").", QVariant(true)},
+        {R".(author.badges contains "Broadcaster").", QVariant(true)},
+        {R".(author.badges startswith "broadcaster").", QVariant(true)},
+        {R".(author.badges endswith "partner").", QVariant(true)},
+        {R".(author.subbed && author.sub_length >= 80).", QVariant(true)},
+        {R".(author.sub_length - 1).", QVariant(79)},
+        {R".(author.user_id == 11148817).", QVariant(true)},
+        {R".(author.color == "#cc44ff").", QVariant(true)},
+        {R".(!author.no_color).", QVariant(true)},
+        {R".(!flags.action && !flags.reply).", QVariant(true)},
+        {R".(flags.highlighted || flags.automod).", QVariant(false)},
+        {R".(channel.name == "pajlada" && !channel.live).", QVariant(true)},
+        {R".(message.content contains "kappa").", QVariant(true)},
+        {R".(message.content startswith "kap").", QVariant(true)},
+        {R".(message.content endswith "PPA").", QVariant(true)},
+        {R".(message.length * 2 > 9).", QVariant(true)},
+        {R".(message.content + message.length).", QVariant("Kappa5")},
+        {R".(message.content + flags.action).", QVariant("Kappafalse")},
+        {R".(message.content match r"^Kap+a$").", QVariant(true)},
+        {R".(message.content match r"^kappa$").", QVariant(false)},
+        {R".(message.content match ri"^kappa$").", QVariant(true)},
+        {R".(message.content match {r"(K)(a)", 2}).", QVariant("a")},
+        {R".({"forsen", author.name} contains "PAJLADA").", QVariant(true)},
+        {R".({1, author.name} contains "PAJLADA").", QVariant(false)},
+        {R".(reward.cost < 0 && reward.title == "").", QVariant(true)},
+        {R".(5 == "5" && "abc" + 123 == "ABC123").", QVariant(true)},
+    };
+    // clang-format on
+
+    auto contextMap = buildContextMap(msg, &channel);
+    for (const auto &[input, expected] : tests)
+    {
+        auto filterResult = Filter::fromString(input);
+        ASSERT_TRUE(std::holds_alternative<Filter>(filterResult))
+            << "Filter::fromString( " << input << " ) is invalid";
+        const auto &filter = std::get<Filter>(filterResult);
+
+        MessageContext context(msg, &channel);
+        auto compiled = filter.execute(context);
+        auto interpreted = filter.execute(contextMap);
+
+        EXPECT_EQ(compiled, expected)
+            << "Compiled filter{ " << input << " } evaluated to "
+            << compiled.toString() << " instead of " << expected.toString();
+        EXPECT_EQ(compiled, interpreted)
+            << "Compiled filter{ " << input << " } evaluated to "
+            << compiled.toString() << " but the expression tree evaluated to "
+            << interpreted.toString();
+        if (filter.returnType() == Type::Bool)
+        {
+            EXPECT_EQ(filter.matches(context), expected.toBool()) << input;
+        }
+    }
+}
+
 TEST_F(FiltersF, ExpressionDebug)
 {
     struct TestCase {
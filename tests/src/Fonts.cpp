@@ -0,0 +1,135 @@
+#include "singletons/Fonts.hpp"
+
+#include "mocks/BaseApplication.hpp"
+#include "singletons/Settings.hpp"
+#include "Test.hpp"
+#include "util/DebugCount.hpp"
+
+using namespace chatterino;
+
+namespace {
+
+constexpr auto STYLE = FontStyle::ChatMedium;
+constexpr float SCALE = 1.F;
+
+const auto WIDTH_HITS = DebugCount::counter("word width cache hits");
+const auto WIDTH_MISSES = DebugCount::counter("word width cache misses");
+
+/// Counts the cache hits and misses since it was created
+class CacheStats
+{
+public:
+    int64_t hits() const
+    {
+        return WIDTH_HITS.value() - this->hits_;
+    }
+    int64_t misses() const
+    {
+        return WIDTH_MISSES.value() - this->misses_;
+    }
+
+private:
+    int64_t hits_ = WIDTH_HITS.value();
+    int64_t misses_ = WIDTH_MISSES.value();
+};
+
+/// Measures @a count distinct words starting with @a prefix
+void measureWords(Fonts &fonts, const QString &prefix, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        fonts.getWordWidth(STYLE, SCALE, prefix + QString::number(i));
+    }
+}
+
+class FontsTest : public ::testing::Test
+{
+protected:
+    mock::BaseApplication app;
+};
+
+}  // namespace
+
+TEST_F(FontsTest, WordWidth)
+{
+    auto &fonts = this->app.fonts;
+    CacheStats stats;
+
+    auto width = fonts.getWordWidth(STYLE, SCALE, "forsen");
+    ASSERT_EQ(width,
+              fonts.getFontMetrics(STYLE, SCALE).horizontalAdvance("forsen"));
+    ASSERT_EQ(stats.misses(), 1);
+    ASSERT_EQ(stats.hits(), 0);
+
+    ASSERT_EQ(fonts.getWordWidth(STYLE, SCALE, "forsen"), width);
+    ASSERT_EQ(stats.misses(), 1);
+    ASSERT_EQ(stats.hits(), 1);
+
+    // Other fonts have their own cache
+    fonts.getWordWidth(FontStyle::ChatMediumBold, SCALE, "forsen");
+    fonts.getWordWidth(STYLE, 2.F, "forsen");
+    ASSERT_EQ(stats.misses(), 3);
+}
+
+TEST_F(FontsTest, CharWidth)
+{
+    auto &fonts = this->app.fonts;
+    CacheStats stats;
+
+    auto width = fonts.getCharWidth(STYLE, SCALE, u'a');
+    ASSERT_EQ(width,
+              fonts.getFontMetrics(STYLE, SCALE).horizontalAdvance(u'a'));
+    ASSERT_EQ(fonts.getCharWidth(STYLE, SCALE, u'a'), width);
+    ASSERT_EQ(stats.misses(), 1);
+    ASSERT_EQ(stats.hits(), 1);
+}
+
+TEST_F(FontsTest, WordWidthGenerations)
+{
+    auto &fonts = this->app.fonts;
+    constexpr auto max = Fonts::MAX_CACHED_WORDS;
+
+    // Fills the current generation
+    measureWords(fonts, "a", max);
+    // Makes the "a" words the old generation
+    fonts.getWordWidth(STYLE, SCALE, "b");
+
+    {
+        CacheStats stats;
+        // Still cached, moved to the current generation
+        fonts.getWordWidth(STYLE, SCALE, "a0");
+        ASSERT_EQ(stats.hits(), 1);
+        ASSERT_EQ(stats.misses(), 0);
+    }
+
+    // "b" and "a0" are in the current generation, fill it up and start a
+    // new one
+    measureWords(fonts, "c", max - 2);
+    fonts.getWordWidth(STYLE, SCALE, "d");
+
+    CacheStats stats;
+    // Used since the last generation started, so it's still cached
+    fonts.getWordWidth(STYLE, SCALE, "a0");
+    ASSERT_EQ(stats.hits(), 1);
+    // Not used for two generations
+    fonts.getWordWidth(STYLE, SCALE, "a1");
+    ASSERT_EQ(stats.misses(), 1);
+}
+
+TEST_F(FontsTest, FontChangeDropsCache)
+{
+    auto &fonts = this->app.fonts;
+    fonts.getWordWidth(STYLE, SCALE, "forsen");
+    fonts.getCharWidth(STYLE, SCALE, u'a');
+
+    this->app.settings.chatFontSize =
+        this->app.settings.chatFontSize.getValue() + 4;
+
+    CacheStats stats;
+    auto width = fonts.getWordWidth(STYLE, SCALE, "forsen");
+    fonts.getCharWidth(STYLE, SCALE, u'a');
+    ASSERT_EQ(stats.misses(), 2);
+    ASSERT_EQ(stats.hits(), 0);
+    ASSERT_EQ(width,
+              fonts.getFontMetrics(STYLE, SCALE).horizontalAdvance("forsen"));
+}
@@ -0,0 +1,122 @@
+#include "messages/layouts/IdleLayout.hpp"
+
+#include "Test.hpp"
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+/// Runs @a layout to completion with messages of @a height and returns the
+/// order in which the messages were laid out
+std::vector<size_t> runToEnd(IdleLayout &layout, size_t start, size_t count,
+                             int64_t pageHeight, int height)
+{
+    std::vector<size_t> order;
+    while (auto step = layout.next(start, count, pageHeight))
+    {
+        int below = 0;
+        int above = 0;
+        if (step->below)
+        {
+            order.push_back(*step->below);
+            below = height;
+        }
+        if (step->above)
+        {
+            order.push_back(*step->above);
+            above = height;
+        }
+        layout.advance(below, above);
+    }
+    return order;
+}
+
+}  // namespace
+
+TEST(IdleLayout, Empty)
+{
+    IdleLayout layout;
+    EXPECT_FALSE(layout.next(0, 0, 100).has_value());
+}
+
+TEST(IdleLayout, AlternatesAroundViewport)
+{
+    IdleLayout layout;
+    auto order = runToEnd(layout, 3, 6, 1000, 10);
+
+    // below: 3, 4, 5 - above: 2, 1, 0
+    std::vector<size_t> expected{3, 4, 2, 5, 1, 0};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(IdleLayout, StopsAfterPages)
+{
+    IdleLayout layout;
+    // 10 messages per page
+    auto order = runToEnd(layout, 500, 1000, 100, 10);
+
+    size_t below = 0;
+    size_t above = 0;
+    for (auto index : order)
+    {
+        if (index >= 500)
+        {
+            below++;
+        }
+        else
+        {
+            above++;
+        }
+    }
+    EXPECT_EQ(below, size_t(10 * (IdleLayout::PAGES + 1)));
+    EXPECT_EQ(above, size_t(10 * IdleLayout::PAGES));
+}
+
+TEST(IdleLayout, Reset)
+{
+    IdleLayout layout;
+    runToEnd(layout, 0, 5, 1000, 10);
+    EXPECT_FALSE(layout.next(0, 5, 1000).has_value());
+
+    // More messages arrived, but the progress is kept
+    auto step = layout.next(0, 6, 1000);
+    ASSERT_TRUE(step.has_value());
+    EXPECT_EQ(step->below, 5U);
+    EXPECT_FALSE(step->above.has_value());
+
+    layout.reset();
+    step = layout.next(2, 5, 1000);
+    ASSERT_TRUE(step.has_value());
+    EXPECT_EQ(step->below, 2U);
+    EXPECT_FALSE(step->above.has_value());
+}
+
+TEST(IdleLayout, ZeroHeightViewport)
+{
+    IdleLayout layout;
+    // The viewport is treated as one pixel high, so one message on each
+    // side covers it
+    auto order = runToEnd(layout, 2, 10, 0, 10);
+    std::vector<size_t> expected{2, 1};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(IdleLayout, InvalidateFinishesPassFirst)
+{
+    IdleLayout layout;
+    auto step = layout.next(0, 3, 1000);
+    ASSERT_TRUE(step.has_value());
+    EXPECT_EQ(step->below, 0U);
+    layout.advance(10, 0);
+
+    // The running pass isn't started over...
+    layout.invalidate();
+    auto order = runToEnd(layout, 0, 3, 1000, 10);
+
+    // ...but a second one follows it
+    std::vector<size_t> expected{1, 2, 0, 1, 2};
+    EXPECT_EQ(order, expected);
+    EXPECT_FALSE(layout.next(0, 3, 1000).has_value());
+}
@@ -0,0 +1,225 @@
+#include "providers/twitch/IrcIngestQueue.hpp"
+
+#include "Test.hpp"
+
+#include <IrcMessage>
+#include <QCoreApplication>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace chatterino;
+
+namespace {
+
+/// Pushes the IRC line @a line to @a queue
+void pushLine(IrcIngestQueue &queue, const QString &line)
+{
+    std::unique_ptr<Communi::IrcMessage> message(
+        Communi::IrcMessage::fromData(line.toUtf8(), nullptr));
+    queue.push(message.get());
+}
+
+/// Pushes a PRIVMSG with @a text in @a channel to @a queue
+void push(IrcIngestQueue &queue, const QString &text,
+          const QString &channel = "#pajlada")
+{
+    pushLine(queue, QStringLiteral("PRIVMSG %1 :%2").arg(channel, text));
+}
+
+/// Runs the event loop until @a queue is empty
+void drain(IrcIngestQueue &queue)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (queue.size() > 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        QCoreApplication::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+struct Recorder {
+    /// Finished messages and handled commands in the order they were added
+    std::vector<QString> handled;
+    std::vector<std::pair<QString, size_t>> dropped;
+
+    std::mutex buildThreadsMutex;
+    std::vector<std::thread::id> buildThreads;
+
+    /// Builds wait for this before they return
+    std::shared_future<void> gate;
+
+    IrcIngestQueue makeQueue()
+    {
+        return {
+            [this](Communi::IrcMessage *message) -> IrcIngestQueue::Build {
+                auto text = message->parameters().value(1);
+                if (text == "ignored")
+                {
+                    return {};
+                }
+                return [this, text] {
+                    {
+                        std::lock_guard lock(this->buildThreadsMutex);
+                        this->buildThreads.push_back(
+                            std::this_thread::get_id());
+                    }
+                    if (this->gate.valid())
+                    {
+                        this->gate.wait();
+                    }
+                    if (text == "slow")
+                    {
+                        std::this_thread::sleep_for(
+                            std::chrono::milliseconds(50));
+                    }
+                    return [this, text] {
+                        this->handled.push_back(text);
+                    };
+                };
+            },
+            [this](Communi::IrcMessage *message) {
+                this->handled.push_back(message->command() + ' ' +
+                                        message->parameters().value(0));
+            },
+            [this](const QString &lane, size_t count) {
+                this->dropped.emplace_back(lane, count);
+            },
+        };
+    }
+};
+
+}  // namespace
+
+TEST(IrcIngestQueue, BuildsOnWorkers)
+{
+    Recorder recorder;
+    auto queue = recorder.makeQueue();
+
+    push(queue, "a");
+    push(queue, "b");
+    push(queue, "c");
+
+    // Finished messages are only added from the event loop
+    ASSERT_EQ(queue.size(), 3U);
+    ASSERT_TRUE(recorder.handled.empty());
+
+    drain(queue);
+
+    ASSERT_EQ(queue.size(), 0U);
+    ASSERT_EQ(recorder.handled, (std::vector<QString>{"a", "b", "c"}));
+    ASSERT_EQ(recorder.buildThreads.size(), 3U);
+    for (auto id : recorder.buildThreads)
+    {
+        ASSERT_NE(id, std::this_thread::get_id());
+    }
+}
+
+TEST(IrcIngestQueue, SkipsEmptyBuilds)
+{
+    Recorder recorder;
+    auto queue = recorder.makeQueue();
+
+    push(queue, "ignored");
+    ASSERT_EQ(queue.size(), 0U);
+
+    drain(queue);
+    ASSERT_TRUE(recorder.handled.empty());
+    ASSERT_TRUE(recorder.buildThreads.empty());
+}
+
+TEST(IrcIngestQueue, KeepsOrderPerLane)
+{
+    Recorder recorder;
+    auto queue = recorder.makeQueue();
+
+    push(queue, "slow", "#a");
+    push(queue, "a1", "#a");
+    push(queue, "b1", "#b");
+    push(queue, "a2", "#a");
+
+    drain(queue);
+
+    ASSERT_EQ(recorder.handled.size(), 4U);
+    std::vector<QString> laneA;
+    for (const auto &text : recorder.handled)
+    {
+        if (text != "b1")
+        {
+            laneA.push_back(text);
+        }
+    }
+    ASSERT_EQ(laneA, (std::vector<QString>{"slow", "a1", "a2"}));
+}
+
+TEST(IrcIngestQueue, OtherMessagesWaitForTheirLane)
+{
+    Recorder recorder;
+    auto queue = recorder.makeQueue();
+
+    push(queue, "slow", "#a");
+    pushLine(queue, "CLEARCHAT #a");
+    pushLine(queue, "CLEARCHAT #b");
+
+    // #b has nothing in flight, so its message is handled right away
+    ASSERT_EQ(recorder.handled, (std::vector<QString>{"CLEARCHAT #b"}));
+    ASSERT_EQ(queue.size(), 2U);
+
+    drain(queue);
+
+    ASSERT_EQ(recorder.handled,
+              (std::vector<QString>{"CLEARCHAT #b", "slow", "CLEARCHAT #a"}));
+}
+
+TEST(IrcIngestQueue, DropsWhenFull)
+{
+    Recorder recorder;
+    std::promise<void> open;
+    recorder.gate = open.get_future().share();
+    auto queue = recorder.makeQueue();
+
+    for (size_t i = 0; i < IrcIngestQueue::MAX_PENDING + 5; i++)
+    {
+        push(queue, QString::number(i));
+    }
+    push(queue, "other", "#other");
+
+    // The dropped messages of a channel are coalesced into one entry
+    ASSERT_EQ(queue.size(), IrcIngestQueue::MAX_PENDING + 2);
+
+    open.set_value();
+    drain(queue);
+
+    ASSERT_EQ(queue.size(), 0U);
+    ASSERT_EQ(recorder.handled.size(), IrcIngestQueue::MAX_PENDING);
+    ASSERT_EQ(recorder.handled.front(), "0");
+    ASSERT_EQ(recorder.handled.back(),
+              QString::number(IrcIngestQueue::MAX_PENDING - 1));
+    // #other had nothing in flight, so its drop was reported first
+    ASSERT_EQ(recorder.dropped,
+              (std::vector<std::pair<QString, size_t>>{{"#other", 1},
+                                                       {"#pajlada", 5}}));
+
+    // There's room again
+    push(queue, "after");
+    drain(queue);
+    ASSERT_EQ(recorder.handled.back(), "after");
+}
+
+TEST(IrcIngestQueue, DestroyWithPendingMessages)
+{
+    Recorder recorder;
+    {
+        auto queue = recorder.makeQueue();
+        push(queue, "slow");
+        push(queue, "a");
+        ASSERT_EQ(queue.size(), 2U);
+    }
+
+    // Pending messages are dropped with the queue
+    QCoreApplication::processEvents();
+    ASSERT_TRUE(recorder.handled.empty());
+}
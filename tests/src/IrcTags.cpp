@@ -0,0 +1,137 @@
+#include "providers/twitch/IrcTags.hpp"
+
+#include "Test.hpp"
+#include "util/IrcHelpers.hpp"
+
+#include <IrcMessage>
+
+using namespace chatterino;
+
+namespace {
+
+const QByteArray PRIVMSG =
+    "@badge-info=subscriber/22;badges=broadcaster/1,subscriber/18;"
+    "color=#FF0000;display-name=nerixyz;emotes=;first-msg=0;flags=;"
+    "id=5e5f526a-5d60-4d81-800b-3b81b8a34c2c;mod=0;room-id=11148817;"
+    "reply-parent-msg-body=a\\sb\\:c\\\\sd;subscriber=1;"
+    "tmi-sent-ts=1726690593888;turbo=0;user-id=129546453;user-type= "
+    ":nerixyz!nerixyz@nerixyz.tmi.twitch.tv PRIVMSG #pajlada :a=b;c";
+
+}  // namespace
+
+TEST(IrcTags, KnownTags)
+{
+    IrcTags tags(PRIVMSG);
+
+    ASSERT_EQ(tags.size(), 16);
+
+    ASSERT_TRUE(tags.contains(IrcTag::BadgeInfo));
+    ASSERT_EQ(tags.value(IrcTag::BadgeInfo), "subscriber/22");
+    ASSERT_EQ(tags.value(IrcTag::Badges), "broadcaster/1,subscriber/18");
+    ASSERT_EQ(tags.value(IrcTag::Color), "#FF0000");
+    ASSERT_EQ(tags.value(IrcTag::Id), "5e5f526a-5d60-4d81-800b-3b81b8a34c2c");
+    ASSERT_EQ(tags.value(IrcTag::RoomId), "11148817");
+    ASSERT_EQ(tags.raw(IrcTag::UserId), "129546453");
+    ASSERT_EQ(tags.raw(IrcTag::FirstMsg), "0");
+
+    // empty values
+    ASSERT_TRUE(tags.contains(IrcTag::Emotes));
+    ASSERT_EQ(tags.value(IrcTag::Emotes), "");
+    ASSERT_TRUE(tags.contains(IrcTag::UserType));
+    ASSERT_EQ(tags.value(IrcTag::UserType), "");
+
+    ASSERT_FALSE(tags.contains(IrcTag::Bits));
+    ASSERT_EQ(tags.value(IrcTag::Bits), "");
+    ASSERT_FALSE(tags.contains(IrcTag::ReplyParentMsgId));
+}
+
+TEST(IrcTags, OtherTags)
+{
+    IrcTags tags(PRIVMSG);
+
+    ASSERT_TRUE(tags.contains("mod"));
+    ASSERT_EQ(tags.value("turbo"), "0");
+    ASSERT_EQ(tags.value("subscriber"), "1");
+    ASSERT_EQ(tags.value("color"), "#FF0000");
+    ASSERT_TRUE(tags.contains("flags"));
+
+    ASSERT_FALSE(tags.contains("vip"));
+    ASSERT_FALSE(tags.contains("PRIVMSG"));
+    ASSERT_FALSE(tags.contains("c"));
+}
+
+TEST(IrcTags, Escapes)
+{
+    IrcTags tags(PRIVMSG);
+
+    ASSERT_EQ(tags.value(IrcTag::ReplyParentMsgBody), "a\\sb\\:c\\\\sd");
+    ASSERT_EQ(tags.unescaped(IrcTag::ReplyParentMsgBody), "a b;c\\sd");
+
+    for (const auto *value : {
+             "",
+             "foo",
+             "\\",
+             "a\\",
+             "\\\\",
+             "\\n\\r\\s\\:",
+             "\\q\\\\\\s",
+             "ä\\sö\\sü",
+         })
+    {
+        IrcTags escaped("@key=" + QByteArray(value) + " :a PRIVMSG #b :c");
+        ASSERT_EQ(escaped.unescaped("key"),
+                  parseTagString(QString::fromUtf8(value)))
+            << value;
+    }
+}
+
+TEST(IrcTags, Malformed)
+{
+    for (const auto *line : {
+             "",
+             "@",
+             "@ :a PRIVMSG #b :c",
+             ":a PRIVMSG #b :c",
+             "PING :tmi.twitch.tv",
+             "@;;; :a PRIVMSG #b :c",
+         })
+    {
+        IrcTags tags(line);
+        ASSERT_EQ(tags.size(), 0) << line;
+        ASSERT_FALSE(tags.contains(IrcTag::Id)) << line;
+    }
+
+    IrcTags noValue("@id;room-id=;=foo;user-id=1");
+    ASSERT_EQ(noValue.size(), 3);
+    ASSERT_TRUE(noValue.contains(IrcTag::Id));
+    ASSERT_EQ(noValue.value(IrcTag::Id), "");
+    ASSERT_TRUE(noValue.contains(IrcTag::RoomId));
+    ASSERT_EQ(noValue.value(IrcTag::UserId), "1");
+}
+
+TEST(IrcTags, LastTagWins)
+{
+    IrcTags tags("@id=1;foo=a;id=2;foo=b :a PRIVMSG #b :c");
+
+    ASSERT_EQ(tags.value(IrcTag::Id), "2");
+    ASSERT_EQ(tags.value("id"), "2");
+    ASSERT_EQ(tags.value("foo"), "b");
+}
+
+TEST(IrcTags, MatchesCommuni)
+{
+    auto *message = Communi::IrcMessage::fromData(PRIVMSG, nullptr);
+    auto communiTags = message->tags();
+    auto tags = IrcTags::fromMessage(message);
+
+    ASSERT_EQ(tags.size(), communiTags.size());
+    for (auto it = communiTags.begin(); it != communiTags.end(); it++)
+    {
+        auto key = it.key().toUtf8();
+        ASSERT_EQ(tags.value(std::string_view(key.data(), key.size())),
+                  it.value().toString())
+            << it.key();
+    }
+
+    delete message;
+}
@@ -0,0 +1,237 @@
+#include "singletons/helper/LogIndex.hpp"
+
+#include "Test.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+/// Appends @a lines to a log file and returns the offset they were written at
+qint64 writeLines(const QString &path, const QByteArray &lines)
+{
+    QFile file(path);
+    EXPECT_TRUE(file.open(QIODevice::Append));
+    auto offset = file.size();
+    file.write(lines);
+    return offset;
+}
+
+std::vector<QString> linesOf(const std::vector<LogMatch> &matches)
+{
+    std::vector<QString> lines;
+    for (const auto &match : matches)
+    {
+        lines.push_back(match.line);
+    }
+    return lines;
+}
+
+LogQuery text(const QString &text)
+{
+    return {.text = text};
+}
+
+}  // namespace
+
+TEST(LogIndex, Terms)
+{
+    using Terms = std::vector<QByteArray>;
+
+    ASSERT_EQ(LogIndex::termsOf("[12:34:56] forsen: Hello World hello"),
+              (Terms{"@forsen", "forsen", "hello", "world"}));
+    ASSERT_EQ(LogIndex::termsOf("forsen: a b cd"),
+              (Terms{"@forsen", "cd", "forsen"}));
+    ASSERT_EQ(
+        LogIndex::termsOf(
+            "[12:34] \xe6\xb5\x8b\xe8\xaf\x95 forsen_1: \xc3\x84\xc3\xa4h"),
+        (Terms{"@forsen_1", "forsen_1", "\xc3\xa4\xc3\xa4h",
+               "\xe6\xb5\x8b\xe8\xaf\x95"}));
+    ASSERT_EQ(LogIndex::termsOf("#pajlada [12:34] forsen: hi"),
+              (Terms{"@forsen", "forsen", "hi"}));
+
+    // system messages
+    ASSERT_EQ(LogIndex::termsOf("# Start logging at 2024-01-01 00:00:00 UTC"),
+              Terms{});
+    ASSERT_EQ(LogIndex::termsOf("[12:34] forsen has been timed out: ok"),
+              (Terms{"been", "forsen", "has", "ok", "out", "timed"}));
+}
+
+TEST(LogIndex, Query)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    writeLines(dir.filePath("forsen-2024-01-01.log"),
+               "# Start logging at 2024-01-01 00:00:00 UTC\n"
+               "[00:00:01] pajlada: hello forsen\n"
+               "[00:00:02] forsen: Hello there\n");
+    writeLines(dir.filePath("forsen-2024-01-02.log"),
+               "[00:00:01] forsen: hello again\n"
+               "[00:00:02] pajlada: bye\n");
+    // stream logs aren't indexed
+    writeLines(dir.filePath("forsen-123456.log"), "forsen: hello stream\n");
+
+    LogIndex index(dir.path());
+    index.catchUp();
+
+    ASSERT_EQ(linesOf(index.query(text("HELLO"))),
+              (std::vector<QString>{
+                  "[00:00:01] forsen: hello again",
+                  "[00:00:02] forsen: Hello there",
+                  "[00:00:01] pajlada: hello forsen",
+              }));
+    ASSERT_EQ(linesOf(index.query(text("hello forsen"))).size(), 3U);
+    ASSERT_EQ(linesOf(index.query({.loginName = "pajlada"})),
+              (std::vector<QString>{
+                  "[00:00:02] pajlada: bye",
+                  "[00:00:01] pajlada: hello forsen",
+              }));
+    ASSERT_EQ(linesOf(index.query({.text = "hello", .loginName = "forsen"}))
+                  .size(),
+              2U);
+    ASSERT_EQ(linesOf(index.query({
+                  .text = "hello",
+                  .from = QDate(2024, 1, 1),
+                  .to = QDate(2024, 1, 1),
+              })),
+              (std::vector<QString>{
+                  "[00:00:02] forsen: Hello there",
+                  "[00:00:01] pajlada: hello forsen",
+              }));
+    ASSERT_EQ(index.query({.text = "hello", .limit = 1}).size(), 1U);
+    ASSERT_TRUE(index.query(text("stream")).empty());
+    ASSERT_TRUE(index.query(text("hello nothing")).empty());
+    ASSERT_TRUE(index.query(text("")).empty());
+
+    auto matches = index.query(text("bye"));
+    ASSERT_EQ(matches.size(), 1U);
+    ASSERT_EQ(matches[0].date, QDate(2024, 1, 2));
+    ASSERT_EQ(matches[0].fileName, "forsen-2024-01-02.log");
+    ASSERT_EQ(matches[0].offset, 31U);
+}
+
+TEST(LogIndex, Append)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-01.log");
+
+    LogIndex index(dir.path());
+    index.catchUp();
+
+    QByteArray first = "forsen: first\n";
+    index.append("forsen-2024-01-01.log", writeLines(path, first), first);
+    ASSERT_EQ(index.query(text("first")).size(), 1U);
+
+    // not reported to the index
+    writeLines(path, "forsen: second\n");
+    QByteArray third = "forsen: third\n";
+    index.append("forsen-2024-01-01.log", writeLines(path, third), third);
+    ASSERT_EQ(index.query(text("second")).size(), 1U);
+    ASSERT_EQ(index.query(text("third")).size(), 1U);
+
+    // already indexed
+    index.append("forsen-2024-01-01.log", 0, first);
+    index.catchUp();
+    ASSERT_EQ(index.query({.loginName = "forsen"}).size(), 3U);
+}
+
+TEST(LogIndex, Persistent)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-01.log");
+    writeLines(path, "forsen: one\n");
+
+    {
+        LogIndex index(dir.path());
+        index.catchUp();
+        // unflushed lines are flushed when the index is destroyed
+    }
+
+    writeLines(path, "forsen: two\n");
+    {
+        LogIndex index(dir.path());
+        ASSERT_EQ(index.query(text("one")).size(), 1U);
+        ASSERT_TRUE(index.query(text("two")).empty());
+
+        index.catchUp();
+        ASSERT_EQ(index.query(text("one")).size(), 1U);
+        ASSERT_EQ(index.query(text("two")).size(), 1U);
+    }
+
+    // broken indices are rebuilt
+    QFile state(QDir(dir.path()).filePath(".index/state"));
+    ASSERT_TRUE(state.open(QIODevice::WriteOnly));
+    state.write("something else\n");
+    state.close();
+    {
+        LogIndex index(dir.path());
+        ASSERT_TRUE(index.query(text("one")).empty());
+
+        index.catchUp();
+        ASSERT_EQ(index.query({.loginName = "forsen"}).size(), 2U);
+    }
+}
+
+TEST(LogIndex, Merge)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-01.log");
+
+    constexpr size_t count = (LogIndex::MERGE_FACTOR * 6) + 1;
+    {
+        LogIndex index(dir.path());
+        for (size_t i = 0; i < count; i++)
+        {
+            auto line = "forsen: message " + QByteArray::number(i) + '\n';
+            index.append("forsen-2024-01-01.log", writeLines(path, line),
+                         line);
+            index.flush();
+        }
+        ASSERT_EQ(index.query(text("message")).size(), count);
+        ASSERT_EQ(index.query(text("message 17")).size(), 1U);
+    }
+
+    auto segments = QDir(QDir(dir.path()).filePath(".index"))
+                        .entryList({"*.seg"}, QDir::Files);
+    // All segments are small, so they're in the same tier
+    ASSERT_LT(static_cast<size_t>(segments.size()), LogIndex::MERGE_FACTOR);
+
+    LogIndex index(dir.path());
+    ASSERT_EQ(index.query(text("message")).size(), count);
+}
+
+TEST(LogIndex, SegmentsToMerge)
+{
+    constexpr auto small = LogIndex::MIN_MERGE_SIZE / 2;
+    constexpr auto medium = LogIndex::MIN_MERGE_SIZE * 2;
+    constexpr auto full = LogIndex::MAX_SEGMENT_SIZE;
+
+    ASSERT_TRUE(LogIndex::segmentsToMerge({}).empty());
+    ASSERT_TRUE(
+        LogIndex::segmentsToMerge({small, small, small, medium}).empty());
+
+    // The oldest segments of a tier are merged, wherever they are
+    ASSERT_EQ(LogIndex::segmentsToMerge(
+                  {medium, small, medium, small, small, small, small}),
+              (std::vector<size_t>{1, 3, 4, 5}));
+
+    // The smallest tier goes first
+    ASSERT_EQ(LogIndex::segmentsToMerge({medium, medium, medium, medium, small,
+                                         small, small, small}),
+              (std::vector<size_t>{4, 5, 6, 7}));
+    ASSERT_EQ(LogIndex::segmentsToMerge(
+                  {medium, medium, medium, medium, small, small}),
+              (std::vector<size_t>{0, 1, 2, 3}));
+
+    // Big segments aren't merged anymore
+    ASSERT_TRUE(LogIndex::segmentsToMerge({full, full, full, full}).empty());
+    ASSERT_TRUE(LogIndex::segmentsToMerge(
+                    std::vector<qint64>(10, LogIndex::MAX_SEGMENT_SIZE / 3))
+                    .empty());
+}
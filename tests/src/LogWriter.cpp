@@ -0,0 +1,130 @@
+#include "singletons/helper/LogWriter.hpp"
+
+#include "Test.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+    return file.readAll();
+}
+
+}  // namespace
+
+TEST(LogWriter, WritesInOrder)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto first = dir.filePath("first.log");
+    auto second = dir.filePath("second.log");
+
+    LogWriter writer;
+    for (int i = 0; i < 100; i++)
+    {
+        writer.write(first, QByteArray::number(i) + '\n');
+        writer.write(second, QByteArray::number(99 - i) + '\n');
+    }
+    writer.flush();
+
+    QByteArray expectedFirst;
+    QByteArray expectedSecond;
+    for (int i = 0; i < 100; i++)
+    {
+        expectedFirst += QByteArray::number(i) + '\n';
+        expectedSecond += QByteArray::number(99 - i) + '\n';
+    }
+    ASSERT_EQ(readFile(first), expectedFirst);
+    ASSERT_EQ(readFile(second), expectedSecond);
+    ASSERT_EQ(writer.backlog(), 0U);
+    ASSERT_EQ(writer.bytesWritten(),
+              uint64_t(expectedFirst.size() + expectedSecond.size()));
+}
+
+TEST(LogWriter, CreatesDirectories)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("a/b/c.log");
+
+    LogWriter writer;
+    writer.write(path, "line\n");
+    writer.flush();
+
+    ASSERT_EQ(readFile(path), "line\n");
+}
+
+TEST(LogWriter, CloseKeepsOrder)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("channel.log");
+
+    LogWriter writer;
+    writer.write(path, "before\n");
+    writer.close(path);
+    // The file is opened again and appended to
+    writer.write(path, "after\n");
+    writer.flush();
+    ASSERT_EQ(readFile(path), "before\nafter\n");
+
+    // Another file can be written to while the first one is closed
+    writer.close(path);
+    writer.write(dir.filePath("other.log"), "other\n");
+    writer.flush();
+    ASSERT_EQ(readFile(path), "before\nafter\n");
+    ASSERT_EQ(readFile(dir.filePath("other.log")), "other\n");
+}
+
+TEST(LogWriter, DrainsOnDestruction)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("channel.log");
+
+    QByteArray expected;
+    {
+        LogWriter writer;
+        for (int i = 0; i < 1000; i++)
+        {
+            auto line = QByteArray::number(i) + '\n';
+            writer.write(path, line);
+            expected += line;
+        }
+        // no flush
+    }
+
+    ASSERT_EQ(readFile(path), expected);
+}
+
+TEST(LogWriter, LargeBacklog)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("channel.log");
+
+    // Several batches worth of data, written while the writer is busy
+    QByteArray line(1023, 'a');
+    line += '\n';
+    auto count = (LogWriter::FLUSH_SIZE / line.size()) * 4;
+
+    LogWriter writer;
+    for (qsizetype i = 0; i < count; i++)
+    {
+        writer.write(path, line);
+    }
+    writer.flush();
+
+    ASSERT_EQ(writer.backlog(), 0U);
+    ASSERT_EQ(QFile(path).size(), count * line.size());
+}
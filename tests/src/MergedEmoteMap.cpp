@@ -0,0 +1,129 @@
+#include "messages/MergedEmoteMap.hpp"
+
+#include "messages/Emote.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+
+namespace {
+
+using Source = MergedEmoteMap::Source;
+
+EmotePtr makeEmote(const QString &name, const QString &id)
+{
+    return std::make_shared<const Emote>(Emote{
+        .name = {name},
+        .images = {},
+        .tooltip = {},
+        .homePage = {},
+        .zeroWidth = false,
+        .id = {id},
+        .author = {},
+        .baseName = {},
+    });
+}
+
+std::shared_ptr<const EmoteMap> makeMap(
+    std::initializer_list<std::pair<QString, QString>> emotes)
+{
+    EmoteMap map;
+    for (const auto &[name, id] : emotes)
+    {
+        map.emplace(EmoteName{name}, makeEmote(name, id));
+    }
+    return std::make_shared<const EmoteMap>(std::move(map));
+}
+
+QString findId(const MergedEmoteMap &map, const QString &name)
+{
+    auto emote = map.find({name});
+    if (!emote)
+    {
+        return {};
+    }
+    return emote->id.string;
+}
+
+}  // namespace
+
+TEST(MergedEmoteMap, Priority)
+{
+    MergedEmoteMap map({
+        makeMap({{"Kappa", "ffz-channel"}}),
+        makeMap({{"Kappa", "bttv-channel"}, {"PogU", "bttv-channel"}}),
+        makeMap({{"PogU", "7tv-channel"}, {"LUL", "7tv-channel"}}),
+        makeMap({{"LUL", "ffz-global"}, {"monkaS", "ffz-global"}}),
+        makeMap({{"monkaS", "bttv-global"}, {"Clap", "bttv-global"}}),
+        makeMap({{"Clap", "7tv-global"}, {"EZ", "7tv-global"}}),
+    });
+
+    EXPECT_EQ(map.size(), 6U);
+    EXPECT_EQ(findId(map, "Kappa"), "ffz-channel");
+    EXPECT_EQ(findId(map, "PogU"), "bttv-channel");
+    EXPECT_EQ(findId(map, "LUL"), "7tv-channel");
+    EXPECT_EQ(findId(map, "monkaS"), "ffz-global");
+    EXPECT_EQ(findId(map, "Clap"), "bttv-global");
+    EXPECT_EQ(findId(map, "EZ"), "7tv-global");
+    EXPECT_EQ(map.find({"forsen"}), nullptr);
+    EXPECT_EQ(map.find({""}), nullptr);
+}
+
+TEST(MergedEmoteMap, WithSource)
+{
+    auto map = std::make_shared<const MergedEmoteMap>();
+    EXPECT_EQ(map->size(), 0U);
+    EXPECT_TRUE(map->definitelyMissing(u"Kappa"));
+
+    map = map->withSource(Source::SeventvGlobal,
+                          makeMap({{"Kappa", "7tv-global"}}));
+    EXPECT_EQ(findId(*map, "Kappa"), "7tv-global");
+    EXPECT_FALSE(map->definitelyMissing(u"Kappa"));
+
+    auto before = map;
+    map = map->withSource(Source::BttvChannel,
+                          makeMap({{"Kappa", "bttv-channel"}}));
+    EXPECT_EQ(findId(*map, "Kappa"), "bttv-channel");
+    // the previous map is unchanged
+    EXPECT_EQ(findId(*before, "Kappa"), "7tv-global");
+
+    // removing the channel emote falls back to the global one
+    map = map->withSource(Source::BttvChannel, makeMap({}));
+    EXPECT_EQ(findId(*map, "Kappa"), "7tv-global");
+
+    map = map->withSource(Source::SeventvGlobal, nullptr);
+    EXPECT_EQ(map->find({"Kappa"}), nullptr);
+    EXPECT_EQ(map->size(), 0U);
+    // The filter keeps the bit of a removed name until the globals change
+    EXPECT_FALSE(map->definitelyMissing(u"Kappa"));
+
+    map = map->withGlobals(1, nullptr, nullptr,
+                           makeMap({{"EZ", "7tv-global"}}));
+    EXPECT_TRUE(map->definitelyMissing(u"Kappa"));
+    EXPECT_FALSE(map->definitelyMissing(u"EZ"));
+}
+
+TEST(MergedEmoteMap, WithGlobals)
+{
+    auto map = std::make_shared<const MergedEmoteMap>();
+    map = map->withSource(Source::FfzChannel,
+                          makeMap({{"Kappa", "ffz-channel"}}));
+
+    map = map->withGlobals(42, makeMap({{"Kappa", "ffz-global"}}),
+                           makeMap({{"LUL", "bttv-global"}}),
+                           makeMap({{"EZ", "7tv-global"}}));
+    EXPECT_EQ(map->builtForGlobalGeneration(), 42U);
+    EXPECT_EQ(findId(*map, "Kappa"), "ffz-channel");
+    EXPECT_EQ(findId(*map, "LUL"), "bttv-global");
+    EXPECT_EQ(findId(*map, "EZ"), "7tv-global");
+}
+
+TEST(MergedEmoteMap, GlobalGeneration)
+{
+    auto before = MergedEmoteMap::globalGeneration();
+    MergedEmoteMap::globalsChanged();
+    EXPECT_EQ(MergedEmoteMap::globalGeneration(), before + 1);
+
+    MergedEmoteMap map;
+    EXPECT_NE(map.builtForGlobalGeneration(),
+              MergedEmoteMap::globalGeneration());
+}
@@ -0,0 +1,147 @@
+#include "messages/layouts/MessageHeightIndex.hpp"
+
+#include "Test.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+using namespace chatterino;
+
+TEST(MessageHeightIndex, Empty)
+{
+    MessageHeightIndex index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.totalHeight(), 0);
+    EXPECT_EQ(index.indexAt(0), 0U);
+    EXPECT_EQ(index.indexAt(100), 0U);
+}
+
+TEST(MessageHeightIndex, Offsets)
+{
+    MessageHeightIndex index;
+    index.assign({10, 20, 30, 40, 50});
+
+    EXPECT_EQ(index.size(), 5U);
+    EXPECT_EQ(index.offsetOf(0), 0);
+    EXPECT_EQ(index.offsetOf(1), 10);
+    EXPECT_EQ(index.offsetOf(3), 60);
+    EXPECT_EQ(index.offsetOf(5), 150);
+    EXPECT_EQ(index.totalHeight(), 150);
+
+    EXPECT_EQ(index.indexAt(-5), 0U);
+    EXPECT_EQ(index.indexAt(0), 0U);
+    EXPECT_EQ(index.indexAt(9), 0U);
+    EXPECT_EQ(index.indexAt(10), 1U);
+    EXPECT_EQ(index.indexAt(59), 2U);
+    EXPECT_EQ(index.indexAt(60), 3U);
+    EXPECT_EQ(index.indexAt(149), 4U);
+    EXPECT_EQ(index.indexAt(150), 5U);
+    EXPECT_EQ(index.indexAt(1000), 5U);
+}
+
+TEST(MessageHeightIndex, SetHeight)
+{
+    MessageHeightIndex index;
+    index.assign({10, 20, 30});
+
+    index.setHeight(1, 5);
+    EXPECT_EQ(index.height(1), 5);
+    EXPECT_EQ(index.offsetOf(2), 15);
+    EXPECT_EQ(index.totalHeight(), 45);
+    EXPECT_EQ(index.indexAt(14), 1U);
+    EXPECT_EQ(index.indexAt(15), 2U);
+
+    // zero height messages are skipped
+    index.setHeight(1, 0);
+    EXPECT_EQ(index.indexAt(10), 2U);
+    EXPECT_EQ(index.indexAt(9), 0U);
+}
+
+TEST(MessageHeightIndex, MatchesLinearScan)
+{
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> heightDist(0, 200);
+
+    for (size_t n : {1, 2, 7, 64, 100, 1000})
+    {
+        std::vector<int> heights(n);
+        for (auto &h : heights)
+        {
+            h = heightDist(rng);
+        }
+
+        MessageHeightIndex index;
+        index.assign(heights);
+
+        for (int round = 0; round < 20; round++)
+        {
+            std::uniform_int_distribution<size_t> indexDist(0, n - 1);
+            auto i = indexDist(rng);
+            heights[i] = heightDist(rng);
+            index.setHeight(i, heights[i]);
+
+            int64_t offset = 0;
+            for (size_t j = 0; j < n; j++)
+            {
+                ASSERT_EQ(index.offsetOf(j), offset);
+                if (heights[j] > 0)
+                {
+                    ASSERT_EQ(index.indexAt(offset), j);
+                    ASSERT_EQ(index.indexAt(offset + heights[j] - 1), j);
+                }
+                offset += heights[j];
+            }
+            ASSERT_EQ(index.totalHeight(), offset);
+            ASSERT_EQ(index.indexAt(offset), n);
+        }
+    }
+}
+
+TEST(MessageHeightIndex, PushBackPopFront)
+{
+    std::mt19937 rng(4321);
+    std::uniform_int_distribution<int> heightDist(0, 200);
+    std::uniform_int_distribution<size_t> countDist(0, 3);
+
+    // Like a LimitedQueue: messages are added at the end and trimmed at the
+    // start
+    std::deque<int> heights;
+    MessageHeightIndex index;
+    for (int round = 0; round < 500; round++)
+    {
+        for (auto n = countDist(rng) + 1; n > 0; n--)
+        {
+            heights.push_back(heightDist(rng));
+            index.pushBack(heights.back());
+        }
+        auto trim = std::min(countDist(rng), heights.size());
+        heights.erase(heights.begin(), heights.begin() + ptrdiff_t(trim));
+        index.popFront(trim);
+
+        if (!heights.empty())
+        {
+            std::uniform_int_distribution<size_t> indexDist(
+                0, heights.size() - 1);
+            auto i = indexDist(rng);
+            heights[i] = heightDist(rng);
+            index.setHeight(i, heights[i]);
+        }
+
+        ASSERT_EQ(index.size(), heights.size());
+        int64_t offset = 0;
+        for (size_t j = 0; j < heights.size(); j++)
+        {
+            ASSERT_EQ(index.height(j), heights[j]);
+            ASSERT_EQ(index.offsetOf(j), offset);
+            if (heights[j] > 0)
+            {
+                ASSERT_EQ(index.indexAt(offset), j);
+                ASSERT_EQ(index.indexAt(offset + heights[j] - 1), j);
+            }
+            offset += heights[j];
+        }
+        ASSERT_EQ(index.totalHeight(), offset);
+        ASSERT_EQ(index.indexAt(offset), heights.size());
+    }
+}
@@ -0,0 +1,257 @@
+#include "messages/MessageIdIndex.hpp"
+
+#include "common/Channel.hpp"
+#include "messages/Message.hpp"
+#include "singletons/Settings.hpp"
+#include "Test.hpp"
+
+#include <QDateTime>
+
+using namespace chatterino;
+
+namespace {
+
+MessagePtr makeMessage(const QString &id, qint64 receivedAt = 0)
+{
+    auto msg = std::make_shared<Message>();
+    msg->id = id;
+    msg->serverReceivedTime = QDateTime::fromSecsSinceEpoch(receivedAt);
+    return msg;
+}
+
+/// A channel with a limit of @a limit messages
+class ScopedChannel
+{
+public:
+    explicit ScopedChannel(int limit)
+        : prevLimit(getSettings()->scrollbackSplitLimit.getValue())
+    {
+        getSettings()->scrollbackSplitLimit = limit;
+        this->channel =
+            std::make_shared<Channel>("test", Channel::Type::None);
+    }
+
+    ~ScopedChannel()
+    {
+        this->channel.reset();
+        getSettings()->scrollbackSplitLimit = this->prevLimit;
+    }
+
+    ScopedChannel(const ScopedChannel &) = delete;
+    ScopedChannel &operator=(const ScopedChannel &) = delete;
+
+    Channel *operator->() const
+    {
+        return this->channel.get();
+    }
+
+private:
+    int prevLimit;
+    std::shared_ptr<Channel> channel;
+};
+
+}  // namespace
+
+TEST(MessageIdIndex, Basic)
+{
+    MessageIdIndex index;
+    auto a = makeMessage("a");
+    auto b = makeMessage("b");
+    auto system = makeMessage("");
+
+    index.addNewest(a);
+    index.addNewest(b);
+    index.addNewest(system);
+
+    ASSERT_EQ(index.size(), 2U);
+    ASSERT_EQ(index.find(u"a"), a);
+    ASSERT_EQ(index.find(u"b"), b);
+    ASSERT_EQ(index.find(u"c"), nullptr);
+    ASSERT_EQ(index.find(u""), nullptr);
+
+    index.remove(a);
+    ASSERT_EQ(index.find(u"a"), nullptr);
+    ASSERT_EQ(index.size(), 1U);
+
+    index.clear();
+    ASSERT_EQ(index.find(u"b"), nullptr);
+    ASSERT_EQ(index.size(), 0U);
+}
+
+TEST(MessageIdIndex, Duplicates)
+{
+    MessageIdIndex index;
+    auto older = makeMessage("a");
+    auto newer = makeMessage("a");
+
+    index.addNewest(older);
+    index.addNewest(newer);
+    ASSERT_EQ(index.find(u"a"), newer);
+
+    // the older message doesn't hide the newer one
+    index.addOlder(older);
+    ASSERT_EQ(index.find(u"a"), newer);
+
+    // removing the older message keeps the newer one
+    index.remove(older);
+    ASSERT_EQ(index.find(u"a"), newer);
+
+    auto replacement = makeMessage("a");
+    index.replace(older, replacement);
+    ASSERT_EQ(index.find(u"a"), newer);
+    index.replace(newer, replacement);
+    ASSERT_EQ(index.find(u"a"), replacement);
+
+    index.rebuild({older, newer});
+    ASSERT_EQ(index.find(u"a"), newer);
+}
+
+TEST(MessageIdIndex, ChannelEviction)
+{
+    ScopedChannel channel(3);
+
+    auto a = makeMessage("a");
+    auto b = makeMessage("b");
+    auto c = makeMessage("c");
+    auto d = makeMessage("d");
+
+    channel->addMessage(a, MessageContext::Original);
+    channel->addMessage(b, MessageContext::Original);
+    channel->addMessage(c, MessageContext::Original);
+    ASSERT_EQ(channel->findMessageByID(u"a"), a);
+
+    channel->addMessage(d, MessageContext::Original);
+    ASSERT_EQ(channel->findMessageByID(u"a"), nullptr);
+    ASSERT_EQ(channel->findMessageByID(u"b"), b);
+    ASSERT_EQ(channel->findMessageByID(u"d"), d);
+
+    channel->clearMessages();
+    ASSERT_EQ(channel->findMessageByID(u"d"), nullptr);
+}
+
+TEST(MessageIdIndex, ChannelReplace)
+{
+    ScopedChannel channel(10);
+
+    auto a = makeMessage("a");
+    auto b = makeMessage("b");
+    channel->addMessage(a, MessageContext::Original);
+    channel->addMessage(b, MessageContext::Original);
+
+    auto a2 = makeMessage("a");
+    channel->replaceMessage(a, a2);
+    ASSERT_EQ(channel->findMessageByID(u"a"), a2);
+
+    auto b2 = makeMessage("b");
+    channel->replaceMessage(1, b2);
+    ASSERT_EQ(channel->findMessageByID(u"b"), b2);
+
+    auto b3 = makeMessage("b");
+    channel->replaceMessage(0, b2, b3);
+    ASSERT_EQ(channel->findMessageByID(u"b"), b3);
+
+    // a replacement with a different ID
+    auto c = makeMessage("c");
+    channel->replaceMessage(a2, c);
+    ASSERT_EQ(channel->findMessageByID(u"a"), nullptr);
+    ASSERT_EQ(channel->findMessageByID(u"c"), c);
+    ASSERT_EQ(channel->findMessageByID(u"b"), b3);
+}
+
+TEST(MessageIdIndex, ChannelReplaceRevealsOlder)
+{
+    ScopedChannel channel(10);
+
+    auto older = makeMessage("a");
+    auto newer = makeMessage("a");
+    channel->addMessage(older, MessageContext::Original);
+    channel->addMessage(newer, MessageContext::Original);
+    ASSERT_EQ(channel->findMessageByID(u"a"), newer);
+
+    channel->replaceMessage(newer, makeMessage("b"));
+    ASSERT_EQ(channel->findMessageByID(u"a"), older);
+}
+
+TEST(MessageIdIndex, ChannelAddAtStart)
+{
+    ScopedChannel channel(4);
+
+    auto live = makeMessage("live");
+    channel->addMessage(live, MessageContext::Original);
+
+    auto a = makeMessage("a");
+    auto b = makeMessage("b");
+    auto c = makeMessage("c");
+    auto d = makeMessage("d");
+    // only three messages fit
+    channel->addMessagesAtStart({a, b, c, d});
+
+    ASSERT_EQ(channel->findMessageByID(u"a"), nullptr);
+    ASSERT_EQ(channel->findMessageByID(u"b"), b);
+    ASSERT_EQ(channel->findMessageByID(u"d"), d);
+    ASSERT_EQ(channel->findMessageByID(u"live"), live);
+
+    // older duplicates don't hide newer messages
+    auto liveOld = makeMessage("live");
+    ScopedChannel other(4);
+    other->addMessage(live, MessageContext::Original);
+    other->addMessagesAtStart({liveOld});
+    ASSERT_EQ(other->findMessageByID(u"live"), live);
+}
+
+TEST(MessageIdIndex, ChannelFillIn)
+{
+    ScopedChannel channel(10);
+
+    auto a = makeMessage("a", 10);
+    auto c = makeMessage("c", 30);
+    channel->addMessage(a, MessageContext::Original);
+    channel->addMessage(c, MessageContext::Original);
+
+    auto b = makeMessage("b", 20);
+    auto d = makeMessage("d", 40);
+    auto aDuplicate = makeMessage("a", 10);
+    channel->fillInMissingMessages({aDuplicate, b, d});
+
+    ASSERT_EQ(channel->findMessageByID(u"a"), a);
+    ASSERT_EQ(channel->findMessageByID(u"b"), b);
+    ASSERT_EQ(channel->findMessageByID(u"c"), c);
+    ASSERT_EQ(channel->findMessageByID(u"d"), d);
+
+    ScopedChannel empty(10);
+    empty->fillInMissingMessages({a, b});
+    ASSERT_EQ(empty->findMessageByID(u"a"), a);
+    ASSERT_EQ(empty->findMessageByID(u"b"), b);
+}
+
+TEST(MessageIdIndex, ChannelFillInFull)
+{
+    ScopedChannel channel(3);
+
+    auto a = makeMessage("a", 10);
+    auto c = makeMessage("c", 30);
+    auto e = makeMessage("e", 50);
+    channel->addMessage(a, MessageContext::Original);
+    channel->addMessage(c, MessageContext::Original);
+    channel->addMessage(e, MessageContext::Original);
+
+    // b evicts a, f evicts b
+    auto b = makeMessage("b", 20);
+    auto f = makeMessage("f", 60);
+    channel->fillInMissingMessages({b, f});
+
+    ASSERT_EQ(channel->getMessageSnapshot(),
+              (std::vector<MessagePtr>{c, e, f}));
+    ASSERT_EQ(channel->findMessageByID(u"a"), nullptr);
+    ASSERT_EQ(channel->findMessageByID(u"b"), nullptr);
+    ASSERT_EQ(channel->findMessageByID(u"c"), c);
+    ASSERT_EQ(channel->findMessageByID(u"e"), e);
+    ASSERT_EQ(channel->findMessageByID(u"f"), f);
+
+    // a message older than everything doesn't fit
+    auto z = makeMessage("z", 5);
+    channel->fillInMissingMessages({z});
+    ASSERT_EQ(channel->getMessageSnapshot(),
+              (std::vector<MessagePtr>{c, e, f}));
+    ASSERT_EQ(channel->findMessageByID(u"z"), nullptr);
+}
@@ -0,0 +1,253 @@
+#include "messages/search/MessageSearch.hpp"
+
+#include "messages/Message.hpp"
+#include "messages/search/RegexPredicate.hpp"
+#include "messages/search/SubstringPredicate.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QRegularExpression>
+
+using namespace chatterino;
+
+namespace {
+
+std::shared_ptr<const std::vector<MessagePtr>> makeSnapshot(size_t count)
+{
+    std::vector<MessagePtr> messages;
+    for (size_t i = 0; i < count; i++)
+    {
+        auto message = std::make_shared<Message>();
+        message->messageText = QString::number(i);
+        message->searchText = message->messageText;
+        messages.emplace_back(std::move(message));
+    }
+    return std::make_shared<const std::vector<MessagePtr>>(
+        std::move(messages));
+}
+
+MessagePtr makeMessage(const QString &text)
+{
+    auto message = std::make_shared<Message>();
+    message->messageText = text;
+    message->searchText = text;
+    return message;
+}
+
+MessageSearch::Matcher matchEven()
+{
+    return [](const Message &message, MessageFlags /*flags*/) {
+        return message.messageText.toInt() % 2 == 0;
+    };
+}
+
+void processEventsUntil(const std::function<bool()> &done)
+{
+    QDeadlineTimer deadline(5000);
+    while (!done() && !deadline.hasExpired())
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+}
+
+}  // namespace
+
+TEST(MessageSearch, BatchesInOrder)
+{
+    constexpr size_t count = (MessageSearch::CHUNK_SIZE * 10) + 3;
+    auto snapshot = makeSnapshot(count);
+
+    std::vector<MessagePtr> results;
+    size_t batches = 0;
+    bool finished = false;
+    auto token = MessageSearch::start(
+        snapshot, matchEven,
+        [&](const auto &batch) {
+            ASSERT_FALSE(finished);
+            batches++;
+            results.insert(results.end(), batch.begin(), batch.end());
+        },
+        [&] {
+            finished = true;
+        });
+
+    processEventsUntil([&] {
+        return finished;
+    });
+    ASSERT_TRUE(finished);
+    ASSERT_EQ(batches, 11U);
+    ASSERT_EQ(results.size(), (count + 1) / 2);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        ASSERT_EQ(results[i], (*snapshot)[i * 2]);
+    }
+}
+
+TEST(MessageSearch, UsesFlagsFromStart)
+{
+    auto snapshot = makeSnapshot(MessageSearch::CHUNK_SIZE * 2);
+
+    std::vector<MessagePtr> results;
+    bool finished = false;
+    MessageSearch::start(
+        snapshot,
+        [] {
+            return [](const Message & /*message*/, MessageFlags flags) {
+                return !flags.has(MessageFlag::Disabled);
+            };
+        },
+        [&](const auto &batch) {
+            results.insert(results.end(), batch.begin(), batch.end());
+        },
+        [&] {
+            finished = true;
+        });
+
+    // Disabling messages after the search started doesn't affect it
+    for (const auto &message : *snapshot)
+    {
+        message->flags.set(MessageFlag::Disabled);
+    }
+
+    processEventsUntil([&] {
+        return finished;
+    });
+    ASSERT_TRUE(finished);
+    ASSERT_EQ(results.size(), snapshot->size());
+}
+
+TEST(MessageSearch, Empty)
+{
+    bool finished = false;
+    MessageSearch::start(
+        makeSnapshot(0), matchEven,
+        [](const auto & /*batch*/) {
+            FAIL();
+        },
+        [&] {
+            finished = true;
+        });
+    ASSERT_TRUE(finished);
+
+    // chunks without matches aren't delivered
+    finished = false;
+    MessageSearch::start(
+        makeSnapshot(MessageSearch::CHUNK_SIZE * 3),
+        [] {
+            return [](const Message & /*message*/, MessageFlags /*flags*/) {
+                return false;
+            };
+        },
+        [](const auto & /*batch*/) {
+            FAIL();
+        },
+        [&] {
+            finished = true;
+        });
+    processEventsUntil([&] {
+        return finished;
+    });
+    ASSERT_TRUE(finished);
+}
+
+TEST(MessageSearch, Cancel)
+{
+    bool called = false;
+    auto token = MessageSearch::start(
+        makeSnapshot(MessageSearch::CHUNK_SIZE * 20), matchEven,
+        [&](const auto & /*batch*/) {
+            called = true;
+        },
+        [&] {
+            called = true;
+        });
+    token.cancel();
+
+    // give the cancelled search a chance to deliver its results
+    bool finished = false;
+    MessageSearch::start(
+        makeSnapshot(1), matchEven, nullptr, [&] {
+            finished = true;
+        });
+    processEventsUntil([&] {
+        return finished;
+    });
+    ASSERT_TRUE(finished);
+    ASSERT_FALSE(called);
+}
+
+TEST(MessageSearch, RegexLiteral)
+{
+    const std::vector<QString> texts{
+        "",
+        "kappa",
+        "Kappa 123",
+        "KAPPA123",
+        "kapa",
+        "forsen kappa keepo",
+        "a.b",
+        "axb",
+        "pog pogchamp POGGERS",
+        "xxx{2}",
+        "1 + 1 = 2",
+        "ä ö ü Kappa",
+        "\\d",
+    };
+    const std::vector<QString> patterns{
+        "kappa",
+        "Kappa 123",
+        "kap+a",
+        "kapp?a",
+        "kappa*",
+        "ka(pp)?a",
+        "ka(pp)+a",
+        "(kappa|keepo)",
+        "^kappa$",
+        "a\\.b",
+        "a.b",
+        "\\bpog\\b",
+        "pog\\w+",
+        "x{2}",
+        "xx{0}",
+        "[kp]appa",
+        "[^a]appa",
+        "\\x4bappa",
+        "\\x{4b}appa",
+        "\\p{L}appa",
+        "1 \\+ 1",
+        "(?i)KAPPA",
+        "ka\\Qpp\\Ea",
+        "\\Qkapp\\E{0}a",
+        "\\d",
+        "\\\\d",
+        "",
+    };
+
+    for (const auto &pattern : patterns)
+    {
+        QRegularExpression regex(pattern,
+                                 QRegularExpression::CaseInsensitiveOption);
+        RegexPredicate predicate(pattern, false);
+        for (const auto &text : texts)
+        {
+            auto message = makeMessage(text);
+            ASSERT_EQ(predicate.appliesTo(*message, message->flags),
+                      regex.match(text).hasMatch())
+                << pattern << text;
+        }
+    }
+}
+
+TEST(MessageSearch, Substring)
+{
+    SubstringPredicate predicate("KaPpA");
+    auto applies = [&](const QString &text) {
+        auto message = makeMessage(text);
+        return predicate.appliesTo(*message, message->flags);
+    };
+    ASSERT_TRUE(applies("kappa"));
+    ASSERT_TRUE(applies("foo KAPPA bar"));
+    ASSERT_FALSE(applies("kapp"));
+    ASSERT_FALSE(applies(""));
+}
@@ -0,0 +1,151 @@
+#include "messages/MessageSimilarity.hpp"
+
+#include "messages/Message.hpp"
+#include "Test.hpp"
+
+#include <QTime>
+
+using namespace chatterino;
+using namespace chatterino::similarity::detail;
+
+namespace {
+
+MessagePtr makeMessage(const QString &login, const QString &text,
+                       QTime parseTime)
+{
+    auto msg = std::make_shared<Message>();
+    msg->loginName = login;
+    msg->messageText = text;
+    msg->parseTime = parseTime;
+    return msg;
+}
+
+}  // namespace
+
+TEST(MessageSimilarity, RelativeSimilarity)
+{
+    EXPECT_FLOAT_EQ(relativeSimilarity(u"", u""), 0.F);
+    EXPECT_FLOAT_EQ(relativeSimilarity(u"abc", u""), 0.F);
+    EXPECT_FLOAT_EQ(relativeSimilarity(u"abc", u"xyz"), 0.F);
+    EXPECT_FLOAT_EQ(relativeSimilarity(u"abc", u"abc"), 1.F);
+    EXPECT_FLOAT_EQ(relativeSimilarity(u"abcd", u"xabc"), 0.75F);
+    EXPECT_FLOAT_EQ(relativeSimilarity(u"xabc", u"abcd"), 0.75F);
+    EXPECT_FLOAT_EQ(relativeSimilarity(u"ab", u"abab"), 0.5F);
+    EXPECT_FLOAT_EQ(relativeSimilarity(u"forsen LUL", u"forsen LUL!"),
+                    10.F / 11.F);
+}
+
+TEST(MessageSimilarity, ExceedsSimilarity)
+{
+    auto exceeds = [](QStringView a, QStringView b, float threshold) {
+        return exceedsSimilarity(a, bigramSignature(a), b, bigramSignature(b),
+                                 threshold);
+    };
+
+    EXPECT_TRUE(exceeds(u"forsen LUL", u"forsen LUL!", 0.9F));
+    EXPECT_FALSE(exceeds(u"forsen LUL", u"forsen LUL!", 0.95F));
+    // rejected by the length
+    EXPECT_FALSE(exceeds(u"forsen", u"forsen LUL", 0.9F));
+    // no common characters
+    EXPECT_FALSE(exceeds(u"abcdef", u"ghijkl", 0.5F));
+    // a single common character is enough for short strings
+    EXPECT_TRUE(exceeds(u"a", u"a", 0.5F));
+    EXPECT_FALSE(exceeds(u"", u"", 0.F));
+
+    // must agree with relativeSimilarity
+    const QStringView strings[] = {
+        u"foo",          u"foobar", u"barfoo", u"LUL LUL LUL",
+        u"LUL LUL LUL!", u"a",      u"ab",     u"Kappa 123",
+    };
+    for (auto a : strings)
+    {
+        for (auto b : strings)
+        {
+            for (float threshold : {0.F, 0.25F, 0.5F, 0.75F, 0.9F})
+            {
+                EXPECT_EQ(exceeds(a, b, threshold),
+                          relativeSimilarity(a, b) > threshold)
+                    << a.toString() << b.toString() << threshold;
+            }
+        }
+    }
+}
+
+TEST(MessageSimilarity, IndexSameUser)
+{
+    auto now = QTime::currentTime();
+    SimilarityIndex index;
+    SimilarityOptions options{
+        .maxMessages = 3,
+        .maxDelay = 5,
+        .bySameUser = true,
+        .threshold = 0.9F,
+    };
+
+    index.add(makeMessage("a", "forsen LUL", now), 3);
+    index.add(makeMessage("b", "something else", now), 3);
+
+    EXPECT_TRUE(
+        index.isSimilar(*makeMessage("a", "forsen LUL!", now), options, now));
+    EXPECT_FALSE(
+        index.isSimilar(*makeMessage("b", "forsen LUL!", now), options, now));
+    EXPECT_FALSE(
+        index.isSimilar(*makeMessage("c", "forsen LUL!", now), options, now));
+
+    // push the message of "a" out of the last 3 messages
+    index.add(makeMessage("b", "something else 2", now), 3);
+    index.add(makeMessage("c", "something else 3", now), 3);
+    EXPECT_EQ(index.size(), 3U);
+    EXPECT_FALSE(
+        index.isSimilar(*makeMessage("a", "forsen LUL!", now), options, now));
+}
+
+TEST(MessageSimilarity, IndexMaxMessages)
+{
+    auto now = QTime::currentTime();
+    SimilarityIndex index;
+    SimilarityOptions options{
+        .maxMessages = 2,
+        .maxDelay = 5,
+        .bySameUser = false,
+        .threshold = 0.9F,
+    };
+
+    index.add(makeMessage("a", "forsen LUL", now), 5);
+    index.add(makeMessage("b", "something else", now), 5);
+    EXPECT_TRUE(
+        index.isSimilar(*makeMessage("c", "forsen LUL!", now), options, now));
+
+    index.add(makeMessage("b", "something else 2", now), 5);
+    EXPECT_FALSE(
+        index.isSimilar(*makeMessage("c", "forsen LUL!", now), options, now));
+
+    options.maxMessages = 3;
+    EXPECT_TRUE(
+        index.isSimilar(*makeMessage("c", "forsen LUL!", now), options, now));
+}
+
+TEST(MessageSimilarity, IndexMaxDelay)
+{
+    auto now = QTime::currentTime();
+    SimilarityIndex index;
+    SimilarityOptions options{
+        .maxMessages = 3,
+        .maxDelay = 5,
+        .bySameUser = true,
+        .threshold = 0.9F,
+    };
+
+    index.add(makeMessage("a", "forsen LUL", now.addSecs(-10)), 3);
+    EXPECT_FALSE(
+        index.isSimilar(*makeMessage("a", "forsen LUL!", now), options, now));
+
+    options.maxDelay = 15;
+    EXPECT_TRUE(
+        index.isSimilar(*makeMessage("a", "forsen LUL!", now), options, now));
+
+    index.clear();
+    EXPECT_EQ(index.size(), 0U);
+    EXPECT_FALSE(
+        index.isSimilar(*makeMessage("a", "forsen LUL!", now), options, now));
+}
@@ -0,0 +1,206 @@
+#include "common/network/NetworkCache.hpp"
+
+#include "Test.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+constexpr int64_t NOW = 1'700'000'000'000;  // 2023-11-14T22:13:20Z
+
+QString key(char c)
+{
+    return QString(64, QChar(c));
+}
+
+NetworkCache::Policy freshPolicy()
+{
+    return {
+        .store = true,
+        .expiresAt = QDateTime::currentMSecsSinceEpoch() + 60'000,
+        .etag = {},
+        .lastModified = {},
+    };
+}
+
+}  // namespace
+
+TEST(NetworkCache, PolicyMaxAge)
+{
+    auto policy = NetworkCache::Policy::fromHeaders("public, max-age=3600",
+                                                    {}, "\"abc\"", {}, NOW);
+    EXPECT_TRUE(policy.store);
+    EXPECT_EQ(policy.expiresAt, NOW + 3'600'000);
+    EXPECT_EQ(policy.etag, "\"abc\"");
+
+    // max-age takes precedence over Expires
+    policy = NetworkCache::Policy::fromHeaders(
+        "max-age=10", "Thu, 01 Jan 1970 00:00:00 GMT", {}, {}, NOW);
+    EXPECT_EQ(policy.expiresAt, NOW + 10'000);
+}
+
+TEST(NetworkCache, PolicyNoCache)
+{
+    auto policy = NetworkCache::Policy::fromHeaders("no-cache, max-age=3600",
+                                                    {}, {}, {}, NOW);
+    EXPECT_TRUE(policy.store);
+    EXPECT_EQ(policy.expiresAt, NOW);
+
+    policy = NetworkCache::Policy::fromHeaders("No-Store", {}, {}, {}, NOW);
+    EXPECT_FALSE(policy.store);
+}
+
+TEST(NetworkCache, PolicyExpires)
+{
+    auto policy = NetworkCache::Policy::fromHeaders(
+        {}, "Wed, 15 Nov 2023 22:13:20 GMT", {}, {}, NOW);
+    EXPECT_EQ(policy.expiresAt, NOW + 24 * 3'600'000);
+
+    // invalid dates are in the past
+    policy = NetworkCache::Policy::fromHeaders({}, "0", {}, {}, NOW);
+    EXPECT_EQ(policy.expiresAt, NOW);
+}
+
+TEST(NetworkCache, PolicyHeuristic)
+{
+    // 10 days since the last modification -> fresh for one day
+    auto policy = NetworkCache::Policy::fromHeaders(
+        {}, {}, {}, "Sat, 04 Nov 2023 22:13:20 GMT", NOW);
+    EXPECT_EQ(policy.expiresAt, NOW + 24 * 3'600'000);
+    EXPECT_EQ(policy.lastModified, "Sat, 04 Nov 2023 22:13:20 GMT");
+
+    // no information at all
+    policy = NetworkCache::Policy::fromHeaders({}, {}, {}, {}, NOW);
+    EXPECT_EQ(policy.expiresAt, NOW + 14 * 24 * 3'600'000);
+}
+
+TEST(NetworkCache, ReadWrite)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    NetworkCache cache(dir.path(), 1024);
+    EXPECT_EQ(cache.read(key('a')), std::nullopt);
+
+    cache.write(key('a'), "foo", freshPolicy());
+    auto lookup = cache.read(key('a'));
+    ASSERT_TRUE(lookup.has_value());
+    EXPECT_EQ(lookup->data, "foo");
+    EXPECT_TRUE(lookup->fresh);
+
+    auto stale = freshPolicy();
+    stale.expiresAt = 0;
+    stale.etag = "\"v1\"";
+    cache.write(key('b'), "bar", stale);
+    lookup = cache.read(key('b'));
+    ASSERT_TRUE(lookup.has_value());
+    EXPECT_FALSE(lookup->fresh);
+    EXPECT_TRUE(lookup->canRevalidate());
+
+    cache.refresh(key('b'), freshPolicy());
+    lookup = cache.read(key('b'));
+    ASSERT_TRUE(lookup.has_value());
+    EXPECT_TRUE(lookup->fresh);
+    EXPECT_EQ(lookup->etag, "\"v1\"");
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.entries, 2);
+    EXPECT_EQ(stats.bytes, 6);
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.revalidated, 1);
+
+    // a missing file is a miss
+    QFile::remove(dir.filePath(key('a')));
+    EXPECT_EQ(cache.read(key('a')), std::nullopt);
+    EXPECT_EQ(cache.stats().entries, 1);
+}
+
+TEST(NetworkCache, Eviction)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    NetworkCache cache(dir.path(), 10);
+    cache.write(key('a'), "aaaa", freshPolicy());
+    cache.write(key('b'), "bbbb", freshPolicy());
+    // 'a' is now the most recently used entry
+    ASSERT_TRUE(cache.read(key('a')).has_value());
+
+    cache.write(key('c'), "cccc", freshPolicy());
+    EXPECT_TRUE(cache.read(key('a')).has_value());
+    EXPECT_EQ(cache.read(key('b')), std::nullopt);
+    EXPECT_TRUE(cache.read(key('c')).has_value());
+    EXPECT_FALSE(QFile::exists(dir.filePath(key('b'))));
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.entries, 2);
+    EXPECT_EQ(stats.bytes, 8);
+    EXPECT_EQ(stats.evictions, 1);
+
+    cache.setMaxBytes(4);
+    cache.write(key('d'), "dddd", freshPolicy());
+    EXPECT_EQ(cache.stats().entries, 1);
+    EXPECT_TRUE(cache.read(key('d')).has_value());
+}
+
+TEST(NetworkCache, Persistence)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    auto policy = freshPolicy();
+    policy.etag = "\"v1\"";
+    {
+        NetworkCache cache(dir.path(), 1024);
+        cache.write(key('a'), "foo", policy);
+        cache.write(key('b'), "bar", freshPolicy());
+        cache.save();
+    }
+
+    NetworkCache cache(dir.path(), 1024);
+    auto lookup = cache.read(key('a'));
+    ASSERT_TRUE(lookup.has_value());
+    EXPECT_EQ(lookup->data, "foo");
+    EXPECT_TRUE(lookup->fresh);
+    EXPECT_EQ(lookup->etag, "\"v1\"");
+    EXPECT_EQ(cache.stats().entries, 2);
+}
+
+TEST(NetworkCache, LegacyFiles)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    // files from before the index existed
+    for (auto c : {'a', 'b'})
+    {
+        QFile file(dir.filePath(key(c)));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("legacy");
+    }
+    QFile other(dir.filePath("not-a-cache-file"));
+    ASSERT_TRUE(other.open(QIODevice::WriteOnly));
+    other.write("other");
+    other.close();
+
+    NetworkCache cache(dir.path(), 1024);
+    auto lookup = cache.read(key('a'));
+    ASSERT_TRUE(lookup.has_value());
+    EXPECT_EQ(lookup->data, "legacy");
+    EXPECT_TRUE(lookup->fresh);
+    EXPECT_EQ(cache.stats().entries, 2);
+    EXPECT_EQ(cache.stats().bytes, 12);
+
+    cache.clear();
+    EXPECT_EQ(cache.stats().entries, 0);
+    EXPECT_FALSE(QFile::exists(dir.filePath(key('a'))));
+    EXPECT_TRUE(QDir(dir.path()).exists());
+    // Files of others in the same directory are kept
+    EXPECT_TRUE(QFile::exists(dir.filePath("not-a-cache-file")));
+}
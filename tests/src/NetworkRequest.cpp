@@ -277,3 +277,80 @@ TEST(NetworkRequest, BatchedTimeouts)
     }
 #endif
 }
+
+TEST(NetworkRequest, IdenticalRequestsShareResult)
+{
+    static const auto numRequests = 4;
+
+    struct RequestState {
+        RequestWaiter waiter;
+        std::optional<int> status;
+    };
+
+    std::vector<std::shared_ptr<RequestState>> states;
+    for (auto i = 0; i < numRequests; ++i)
+    {
+        auto state = std::make_shared<RequestState>();
+
+        NetworkRequest(getDelayURL(1))
+            .priority(i % 2 == 0 ? NetworkPriority::High
+                                 : NetworkPriority::Low)
+            .onSuccess([=](const NetworkResult &result) {
+                state->status = result.status();
+            })
+            .finally([=] {
+                state->waiter.requestDone();
+            })
+            .execute();
+
+        states.emplace_back(state);
+    }
+
+    for (const auto &state : states)
+    {
+        state->waiter.waitForRequest();
+        EXPECT_EQ(state->status, 200);
+    }
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+}
+
+TEST(NetworkRequest, RaisedRequestsFinish)
+{
+    static const auto numRequests = 8;
+
+    struct RequestState {
+        RequestWaiter waiter;
+        std::optional<int> status;
+    };
+
+    std::vector<std::shared_ptr<RequestState>> states;
+    {
+        NetworkPriorityScope scope(NetworkPriority::Low, "raised");
+        for (auto i = 0; i < numRequests; ++i)
+        {
+            auto state = std::make_shared<RequestState>();
+
+            // Distinct URLs, so the requests aren't shared
+            NetworkRequest(getStatusURL(200 + i))
+                .onSuccess([=](const NetworkResult &result) {
+                    state->status = result.status();
+                })
+                .finally([=] {
+                    state->waiter.requestDone();
+                })
+                .execute();
+
+            states.emplace_back(state);
+        }
+    }
+    raiseNetworkPriority("raised", NetworkPriority::High);
+    // Groups that don't exist are ignored
+    raiseNetworkPriority("missing", NetworkPriority::High);
+
+    for (auto i = 0; i < numRequests; ++i)
+    {
+        states[i]->waiter.waitForRequest();
+        EXPECT_EQ(states[i]->status, 200 + i);
+    }
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+}
@@ -0,0 +1,153 @@
+#include "util/PersistentHashMap.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+
+#include <set>
+#include <unordered_map>
+
+using namespace chatterino;
+
+namespace {
+
+/// Maps all keys to a few hashes, so keys end up in the collision nodes
+struct BadHash {
+    size_t operator()(int key) const
+    {
+        return static_cast<size_t>(key % 3);
+    }
+};
+
+template <typename Map>
+void expectEqual(const Map &map, const std::unordered_map<int, int> &expected)
+{
+    ASSERT_EQ(map.size(), expected.size());
+    size_t count = 0;
+    for (const auto &[key, value] : map)
+    {
+        ASSERT_EQ(expected.at(key), value);
+        count++;
+    }
+    ASSERT_EQ(count, expected.size());
+}
+
+template <typename Map>
+void fillAndErase()
+{
+    Map map;
+    std::unordered_map<int, int> expected;
+    for (int i = 0; i < 2000; i++)
+    {
+        map[i * 7] = i;
+        expected[i * 7] = i;
+    }
+    expectEqual(map, expected);
+
+    for (int i = 0; i < 2000; i += 3)
+    {
+        ASSERT_EQ(map.erase(i * 7), 1U);
+        expected.erase(i * 7);
+    }
+    ASSERT_EQ(map.erase(1), 0U);
+    expectEqual(map, expected);
+
+    for (int i = 0; i < 2000; i++)
+    {
+        ASSERT_EQ(map.contains(i * 7), i % 3 != 0);
+    }
+
+    for (const auto &[key, value] : expected)
+    {
+        map.erase(key);
+    }
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.begin(), map.end());
+}
+
+}  // namespace
+
+TEST(PersistentHashMap, Basic)
+{
+    PersistentHashMap<QString, int> map{{"forsen", 1}, {"nymn", 2}};
+    ASSERT_EQ(map.size(), 2U);
+    ASSERT_EQ(map.at("forsen"), 1);
+
+    auto [it, inserted] = map.emplace("pajlada", 3);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(it->first, "pajlada");
+    std::tie(it, inserted) = map.try_emplace("pajlada", 4);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(it->second, 3);
+    map.insert_or_assign("pajlada", 5);
+    ASSERT_EQ(map.at("pajlada"), 5);
+
+    map.erase(map.find("nymn"));
+    ASSERT_FALSE(map.contains("nymn"));
+    ASSERT_EQ(map.find("nymn"), map.end());
+    ASSERT_EQ(map.size(), 2U);
+}
+
+TEST(PersistentHashMap, Erase)
+{
+    fillAndErase<PersistentHashMap<int, int>>();
+}
+
+TEST(PersistentHashMap, Collisions)
+{
+    fillAndErase<PersistentHashMap<int, int, BadHash>>();
+}
+
+TEST(PersistentHashMap, Sharing)
+{
+    PersistentHashMap<int, int> map;
+    std::unordered_map<int, int> expected;
+    for (int i = 0; i < 1000; i++)
+    {
+        map[i] = i;
+        expected[i] = i;
+    }
+
+    auto copy = map;
+    copy[1] = 42;
+    copy[1000] = 1000;
+    copy.erase(2);
+
+    // the original isn't affected
+    expectEqual(map, expected);
+
+    expected[1] = 42;
+    expected[1000] = 1000;
+    expected.erase(2);
+    expectEqual(copy, expected);
+}
+
+TEST(PersistentHashMap, Difference)
+{
+    PersistentHashMap<int, int> map;
+    for (int i = 0; i < 1000; i++)
+    {
+        map[i] = i;
+    }
+
+    auto copy = map;
+    copy[1] = 42;
+    copy[1000] = 1000;
+    copy.erase(2);
+
+    std::set<int> keys;
+    size_t calls = 0;
+    map.forEachDifference(copy, [&](int key) {
+        keys.insert(key);
+        calls++;
+    });
+    ASSERT_EQ(keys, (std::set<int>{1, 2, 1000}));
+    // shared nodes are skipped
+    ASSERT_LT(calls, 50U);
+
+    keys.clear();
+    map.forEachDifference(map, [&](int key) {
+        keys.insert(key);
+    });
+    ASSERT_TRUE(keys.empty());
+}
@@ -0,0 +1,122 @@
+#include "util/PhraseMatcher.hpp"
+
+#include "common/Literals.hpp"
+#include "Test.hpp"
+
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+PhraseMatcher makeMatcher(const std::vector<QString> &patterns)
+{
+    PhraseMatcher matcher;
+    for (const auto &pattern : patterns)
+    {
+        matcher.addLiteral(pattern);
+    }
+    matcher.build();
+    return matcher;
+}
+
+}  // namespace
+
+TEST(PhraseMatcher, Empty)
+{
+    PhraseMatcher matcher;
+    matcher.build();
+
+    ASSERT_EQ(matcher.size(), 0U);
+    ASSERT_TRUE(matcher.candidates(u"forsen").empty());
+}
+
+TEST(PhraseMatcher, Literals)
+{
+    auto matcher = makeMatcher({"forsen", "xd", "pajlada", "sen"});
+    ASSERT_EQ(matcher.size(), 4U);
+
+    struct TestCase {
+        QString input;
+        std::vector<size_t> expected;
+    };
+
+    std::vector<TestCase> tests{
+        {"", {}},
+        {"nothing here", {}},
+        {"forsen", {0, 3}},
+        {"forse", {}},
+        {"xd forsen", {0, 1, 3}},
+        {"xdxdxd", {1}},
+        {"pajlada forsenxd", {0, 1, 2, 3}},
+        {"sen", {3}},
+        {"pajlad", {}},
+    };
+
+    for (const auto &[input, expected] : tests)
+    {
+        EXPECT_EQ(matcher.candidates(input), expected) << input;
+    }
+}
+
+TEST(PhraseMatcher, Overlapping)
+{
+    // "he", "she", "his", "hers" - the classic example
+    auto matcher = makeMatcher({"he", "she", "his", "hers"});
+
+    EXPECT_EQ(matcher.candidates(u"ushers"), (std::vector<size_t>{0, 1, 3}));
+    EXPECT_EQ(matcher.candidates(u"ahishe"),
+              (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(matcher.candidates(u"hhhhis"), (std::vector<size_t>{2}));
+}
+
+TEST(PhraseMatcher, Duplicates)
+{
+    auto matcher = makeMatcher({"forsen", "FORSEN", "forsen"});
+
+    EXPECT_EQ(matcher.candidates(u"forsen"),
+              (std::vector<size_t>{0, 1, 2}));
+    EXPECT_TRUE(matcher.candidates(u"nymn").empty());
+}
+
+TEST(PhraseMatcher, CaseInsensitive)
+{
+    auto matcher = makeMatcher({"Forsen", u"ÄÖÜ"_s, u"σ"_s});
+
+    EXPECT_EQ(matcher.candidates(u"FORSEN"), (std::vector<size_t>{0}));
+    EXPECT_EQ(matcher.candidates(u"fOrSeN"), (std::vector<size_t>{0}));
+    EXPECT_EQ(matcher.candidates(u"äöü"), (std::vector<size_t>{1}));
+    // final sigma and capital sigma fold to the same character
+    EXPECT_EQ(matcher.candidates(u"ς"), (std::vector<size_t>{2}));
+    EXPECT_EQ(matcher.candidates(u"Σ"), (std::vector<size_t>{2}));
+}
+
+TEST(PhraseMatcher, SurrogatePairs)
+{
+    // U+10400 DESERET CAPITAL LETTER LONG I folds to U+10428
+    auto matcher = makeMatcher({u"a\U00010400b"_s, u"😂"_s});
+
+    EXPECT_EQ(matcher.candidates(u"xa\U00010428bx"),
+              (std::vector<size_t>{0}));
+    EXPECT_EQ(matcher.candidates(u"xa\U00010400bx"),
+              (std::vector<size_t>{0}));
+    EXPECT_EQ(matcher.candidates(u"😂😂"), (std::vector<size_t>{1}));
+    EXPECT_TRUE(matcher.candidates(u"😀").empty());
+}
+
+TEST(PhraseMatcher, Unindexed)
+{
+    PhraseMatcher matcher;
+    matcher.addLiteral(u"forsen");
+    matcher.addUnindexed();
+    matcher.addLiteral(u"");
+    matcher.addLiteral(u"xd");
+    matcher.build();
+
+    ASSERT_EQ(matcher.size(), 4U);
+    EXPECT_EQ(matcher.candidates(u""), (std::vector<size_t>{1, 2}));
+    EXPECT_EQ(matcher.candidates(u"xd"), (std::vector<size_t>{1, 2, 3}));
+    EXPECT_EQ(matcher.candidates(u"xd forsen"),
+              (std::vector<size_t>{0, 1, 2, 3}));
+}
@@ -0,0 +1,203 @@
+#include "providers/twitch/ReadConnectionPool.hpp"
+
+#include "providers/irc/IrcConnection2.hpp"
+#include "Test.hpp"
+
+#include <pajlada/signals/signal.hpp>
+#include <QCoreApplication>
+
+using namespace chatterino;
+
+namespace {
+
+QString channelName(qsizetype i)
+{
+    return QStringLiteral("channel%1").arg(i);
+}
+
+}  // namespace
+
+class ReadConnectionPoolTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        // Connections are deleted with deleteLater
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+};
+
+TEST_F(ReadConnectionPoolTest, Primary)
+{
+    std::vector<IrcConnection *> created;
+    ReadConnectionPool pool([&](auto *connection, auto & /*signals*/) {
+        created.push_back(connection);
+    });
+
+    ASSERT_EQ(pool.size(), 1U);
+    ASSERT_EQ(created.size(), 1U);
+    ASSERT_EQ(pool.primary(), created[0]);
+    ASSERT_TRUE(pool.contains(pool.primary()));
+    ASSERT_EQ(pool.find(pool.primary()), pool.primary());
+    ASSERT_EQ(pool.connectionFor("forsen"), nullptr);
+    ASSERT_TRUE(pool.channelsOf(pool.primary()).isEmpty());
+}
+
+TEST_F(ReadConnectionPoolTest, AssignSpillsOver)
+{
+    size_t created = 0;
+    ReadConnectionPool pool([&](auto * /*connection*/, auto & /*signals*/) {
+        created++;
+    });
+
+    for (qsizetype i = 0; i < ReadConnectionPool::CHANNELS_PER_CONNECTION;
+         i++)
+    {
+        ASSERT_EQ(pool.assign(channelName(i)), pool.primary());
+    }
+    ASSERT_EQ(pool.size(), 1U);
+
+    // assigning twice doesn't move the channel
+    ASSERT_EQ(pool.assign(channelName(0)), pool.primary());
+
+    auto *second =
+        pool.assign(channelName(ReadConnectionPool::CHANNELS_PER_CONNECTION));
+    ASSERT_NE(second, pool.primary());
+    ASSERT_EQ(pool.size(), 2U);
+    ASSERT_EQ(created, 2U);
+    ASSERT_EQ(pool.channelsOf(second),
+              QStringList{
+                  channelName(ReadConnectionPool::CHANNELS_PER_CONNECTION)});
+
+    // new channels go to the connection with the fewest channels
+    ASSERT_EQ(pool.assign("forsen"), second);
+    ASSERT_EQ(created, 2U);
+}
+
+TEST_F(ReadConnectionPoolTest, UnassignRemovesEmpty)
+{
+    ReadConnectionPool pool({});
+
+    for (qsizetype i = 0; i <= ReadConnectionPool::CHANNELS_PER_CONNECTION;
+         i++)
+    {
+        pool.assign(channelName(i));
+    }
+    ASSERT_EQ(pool.size(), 2U);
+
+    auto last = channelName(ReadConnectionPool::CHANNELS_PER_CONNECTION);
+    auto *second = pool.connectionFor(last);
+    pool.unassign(last);
+    ASSERT_EQ(pool.size(), 1U);
+    ASSERT_FALSE(pool.contains(second));
+    ASSERT_EQ(pool.find(second), nullptr);
+    ASSERT_EQ(pool.connectionFor(last), nullptr);
+
+    // the primary connection stays
+    for (qsizetype i = 0; i < ReadConnectionPool::CHANNELS_PER_CONNECTION;
+         i++)
+    {
+        pool.unassign(channelName(i));
+    }
+    ASSERT_EQ(pool.size(), 1U);
+    ASSERT_TRUE(pool.channelsOf(pool.primary()).isEmpty());
+
+    // unknown channels are ignored
+    pool.unassign("forsen");
+}
+
+TEST_F(ReadConnectionPoolTest, Rebalance)
+{
+    ReadConnectionPool pool({});
+
+    QStringList channels;
+    for (qsizetype i = 0; i < 3 * ReadConnectionPool::CHANNELS_PER_CONNECTION;
+         i++)
+    {
+        channels.append(channelName(i));
+        pool.assign(channelName(i));
+    }
+    ASSERT_EQ(pool.size(), 3U);
+
+    // keep channels from the second and third connection only
+    QStringList remaining;
+    for (const auto &channel : channels)
+    {
+        if (pool.connectionFor(channel) != pool.primary())
+        {
+            remaining.append(channel);
+        }
+    }
+    remaining = remaining.mid(0, ReadConnectionPool::CHANNELS_PER_CONNECTION +
+                                     1);
+
+    pool.rebalance(remaining);
+    ASSERT_EQ(pool.size(), 2U);
+    for (const auto &channel : remaining)
+    {
+        ASSERT_NE(pool.connectionFor(channel), nullptr);
+    }
+    ASSERT_EQ(pool.connectionFor(channels[0]), nullptr);
+
+    qsizetype total = 0;
+    pool.forEachConnection([&](auto *connection) {
+        auto count = pool.channelsOf(connection).size();
+        ASSERT_GE(count, ReadConnectionPool::CHANNELS_PER_CONNECTION / 2);
+        total += count;
+    });
+    ASSERT_EQ(total, remaining.size());
+
+    pool.rebalance({});
+    ASSERT_EQ(pool.size(), 1U);
+    ASSERT_TRUE(pool.channelsOf(pool.primary()).isEmpty());
+}
+
+TEST_F(ReadConnectionPoolTest, MaxConnections)
+{
+    ReadConnectionPool pool({});
+
+    auto total = static_cast<qsizetype>(ReadConnectionPool::MAX_CONNECTIONS) *
+                 ReadConnectionPool::CHANNELS_PER_CONNECTION;
+    for (qsizetype i = 0; i < total + 10; i++)
+    {
+        ASSERT_NE(pool.assign(channelName(i)), nullptr);
+    }
+    ASSERT_EQ(pool.size(), ReadConnectionPool::MAX_CONNECTIONS);
+}
+
+TEST_F(ReadConnectionPoolTest, RemovingReleasesSignals)
+{
+    pajlada::Signals::NoArgSignal signal;
+    size_t calls = 0;
+    ReadConnectionPool pool(
+        [&](auto * /*connection*/, auto &signalHolder) {
+            signalHolder.managedConnect(signal, [&] {
+                calls++;
+            });
+        });
+
+    for (qsizetype i = 0; i <= ReadConnectionPool::CHANNELS_PER_CONNECTION;
+         i++)
+    {
+        pool.assign(channelName(i));
+    }
+    ASSERT_EQ(pool.size(), 2U);
+    signal.invoke();
+    ASSERT_EQ(calls, 2U);
+
+    pool.unassign(channelName(ReadConnectionPool::CHANNELS_PER_CONNECTION));
+    ASSERT_EQ(pool.size(), 1U);
+    signal.invoke();
+    ASSERT_EQ(calls, 3U);
+
+    // rebalancing releases them as well
+    for (qsizetype i = 0; i <= ReadConnectionPool::CHANNELS_PER_CONNECTION;
+         i++)
+    {
+        pool.assign(channelName(i));
+    }
+    ASSERT_EQ(pool.size(), 2U);
+    pool.rebalance({});
+    signal.invoke();
+    ASSERT_EQ(calls, 4U);
+}
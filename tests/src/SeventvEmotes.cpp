@@ -0,0 +1,161 @@
+#include "providers/seventv/SeventvEmotes.hpp"
+
+#include "messages/Emote.hpp"
+#include "messages/Image.hpp"
+#include "messages/ImageSet.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace chatterino;
+
+namespace {
+
+const QByteArray USER_JSON{R"({
+    "id": "11148817",
+    "emote_set": {
+        "id": "6100ea6c8a3a2b6b2a7ba123",
+        "name": "pajlada's Emotes",
+        "emotes": [
+            {
+                "id": "60ae958e229664e8667aea38",
+                "name": "Clap",
+                "flags": 0,
+                "data": {
+                    "name": "Clap",
+                    "flags": 0,
+                    "listed": true,
+                    "owner": {"id": "1", "display_name": "forsen"},
+                    "host": {
+                        "url": "//cdn.7tv.app/emote/60ae958e229664e8667aea38",
+                        "files": [
+                            {"name": "1x.avif", "width": 32, "height": 32,
+                             "format": "AVIF"},
+                            {"name": "1x.webp", "static_name": "1x_static.webp",
+                             "width": 32, "height": 32, "format": "WEBP"},
+                            {"name": "2x.webp", "width": 64, "height": 64,
+                             "format": "WEBP"},
+                            {"name": "3x.webp", "width": 96, "height": 96,
+                             "format": "WEBP"},
+                            {"name": "4x.webp", "width": 128, "height": 128,
+                             "format": "WEBP"}
+                        ]
+                    }
+                }
+            },
+            {
+                "id": "60aed217a0dd4c1a6d9cb3c5",
+                "name": "RainTime2",
+                "flags": 1,
+                "data": {
+                    "name": "RainTime",
+                    "flags": 256,
+                    "listed": true,
+                    "state": ["LISTED"],
+                    "owner": null,
+                    "host": {
+                        "url": "//cdn.7tv.app/emote/60aed217a0dd4c1a6d9cb3c5",
+                        "files": [
+                            {"name": "1x.webp", "width": 27.0,
+                             "format": "WEBP"},
+                            {"name": "2x.webp", "width": 54, "height": 64,
+                             "format": "WEBP"}
+                        ]
+                    }
+                }
+            },
+            {
+                "id": "60b0c36388e8246a4b120d7e",
+                "name": "Unlisted",
+                "flags": 0,
+                "data": {
+                    "name": "Unlisted",
+                    "flags": 0,
+                    "listed": false,
+                    "host": {
+                        "url": "//cdn.7tv.app/emote/60b0c36388e8246a4b120d7e",
+                        "files": [
+                            {"name": "1x.webp", "width": 32, "height": 32,
+                             "format": "WEBP"}
+                        ]
+                    }
+                }
+            },
+            {"id": "60b0c36388e8246a4b120d7f", "name": "Deleted", "data": {}}
+        ]
+    },
+    "user": {
+        "id": "60b39e943e203cc169dfc106",
+        "connections": [
+            {"id": "UCxyz", "platform": "YOUTUBE"},
+            {"id": "11148817", "platform": "TWITCH"}
+        ]
+    }
+})"};
+
+void expectSameEmote(const Emote &expected, const Emote &actual)
+{
+    ASSERT_EQ(expected.name, actual.name);
+    ASSERT_EQ(expected.tooltip, actual.tooltip);
+    ASSERT_EQ(expected.homePage, actual.homePage);
+    ASSERT_EQ(expected.zeroWidth, actual.zeroWidth);
+    ASSERT_EQ(expected.author, actual.author);
+    ASSERT_EQ(expected.baseName, actual.baseName);
+    ASSERT_EQ(expected.images.getImage1(), actual.images.getImage1());
+    ASSERT_EQ(expected.images.getImage2(), actual.images.getImage2());
+    ASSERT_EQ(expected.images.getImage3(), actual.images.getImage3());
+}
+
+}  // namespace
+
+TEST(SeventvEmotes, ReadUser)
+{
+    mock::BaseApplication app;
+
+    auto user = seventv::detail::readEmoteSet(USER_JSON, false);
+    ASSERT_TRUE(user.has_value());
+    ASSERT_EQ(user->id, "6100ea6c8a3a2b6b2a7ba123");
+    ASSERT_EQ(user->name, "pajlada's Emotes");
+    ASSERT_EQ(user->userID, "60b39e943e203cc169dfc106");
+    ASSERT_EQ(user->twitchConnectionIndex, 1U);
+
+    // the same emotes as with the QJsonDocument based parser
+    auto json = QJsonDocument::fromJson(USER_JSON).object();
+    auto expected = seventv::detail::parseEmotes(
+        json["emote_set"].toObject()["emotes"].toArray(), false);
+    ASSERT_EQ(expected.size(), 2U);
+    ASSERT_EQ(user->emotes->size(), expected.size());
+    for (const auto &[name, emote] : expected)
+    {
+        auto it = user->emotes->find(name);
+        ASSERT_NE(it, user->emotes->end());
+        expectSameEmote(*emote, *it->second);
+    }
+
+    auto clap = user->emotes->at(EmoteName{"Clap"});
+    ASSERT_EQ(clap->images.getImage1()->url().string,
+              "https://cdn.7tv.app/emote/60ae958e229664e8667aea38/1x.webp");
+    ASSERT_EQ(clap->images.getImage3()->url().string,
+              "https://cdn.7tv.app/emote/60ae958e229664e8667aea38/4x.webp");
+    auto rainTime = user->emotes->at(EmoteName{"RainTime2"});
+    ASSERT_TRUE(rainTime->zeroWidth);
+    ASSERT_EQ(rainTime->baseName, EmoteName{"RainTime"});
+}
+
+TEST(SeventvEmotes, ReadEmoteSet)
+{
+    mock::BaseApplication app;
+
+    auto emoteSet = seventv::detail::readEmoteSet(
+        R"({"id": "global", "name": "Global Emotes", "emotes": []})", true);
+    ASSERT_TRUE(emoteSet.has_value());
+    ASSERT_EQ(emoteSet->id, "global");
+    ASSERT_EQ(emoteSet->name, "Global Emotes");
+    ASSERT_TRUE(emoteSet->emotes->empty());
+    ASSERT_TRUE(emoteSet->userID.isEmpty());
+
+    ASSERT_FALSE(
+        seventv::detail::readEmoteSet(R"({"emotes": [)", true).has_value());
+}